@@ -55,6 +55,7 @@
 #include <App/MaterialPy.h>
 #include <App/MetadataPy.h>
 // FreeCAD Base header
+#include <Base/ArrayBufferPy.h>
 #include <Base/AxisPy.h>
 #include <Base/BaseClass.h>
 #include <Base/BoundBoxPy.h>
@@ -340,6 +341,10 @@ void Application::setupPythonTypes()
     Base::Interpreter().addType(Base::ProgressIndicatorPy::type_object(),
         pBaseModule,"ProgressIndicator");
 
+    Base::ArrayBufferPy::init_type();
+    Base::Interpreter().addType(Base::ArrayBufferPy::type_object(),
+        pBaseModule,"ArrayBuffer");
+
     Base::Vector2dPy::init_type();
     Base::Interpreter().addType(Base::Vector2dPy::type_object(),
         pBaseModule,"Vector2d");
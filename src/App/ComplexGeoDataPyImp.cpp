@@ -31,6 +31,7 @@
 // inclusion of the generated files (generated out of ComplexGeoDataPy.xml)
 #include <App/ComplexGeoDataPy.h>
 #include <App/ComplexGeoDataPy.cpp>
+#include <Base/ArrayBufferPy.h>
 #include <Base/BoundBoxPy.h>
 #include <Base/MatrixPy.h>
 #include <Base/PlacementPy.h>
@@ -251,6 +252,50 @@ PyObject* ComplexGeoDataPy::getFaces(PyObject *args)
     return Py::new_reference_to(tuple);
 }
 
+PyObject* ComplexGeoDataPy::getPointsBuffer(PyObject *args)
+{
+    double accuracy = 0.05;
+    if (!PyArg_ParseTuple(args, "d", &accuracy))
+        return nullptr;
+
+    std::vector<Base::Vector3d> points;
+    std::vector<Base::Vector3d> normals;
+    try {
+        getComplexGeoDataPtr()->getPoints(points, normals, accuracy);
+    }
+    catch (...) {
+        PyErr_SetString(PyExc_RuntimeError, "failed to get sub-element from object");
+        return nullptr;
+    }
+
+    // the buffers take over the arrays, no element is copied
+    Py::TupleN tuple(Base::ArrayBufferPy::create<double>(std::move(points)),
+                     Base::ArrayBufferPy::create<double>(std::move(normals)));
+    return Py::new_reference_to(tuple);
+}
+
+PyObject* ComplexGeoDataPy::getFacesBuffer(PyObject *args)
+{
+    double accuracy = 0.05;
+    if (!PyArg_ParseTuple(args, "d", &accuracy))
+        return nullptr;
+
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    try {
+        getComplexGeoDataPtr()->getFaces(points, facets, accuracy);
+    }
+    catch (...) {
+        PyErr_SetString(PyExc_RuntimeError, "failed to get sub-element from object");
+        return nullptr;
+    }
+
+    // the buffers take over the arrays, no element is copied
+    Py::TupleN tuple(Base::ArrayBufferPy::create<double>(std::move(points)),
+                     Base::ArrayBufferPy::create<uint32_t>(std::move(facets)));
+    return Py::new_reference_to(tuple);
+}
+
 PyObject* ComplexGeoDataPy::applyTranslation(PyObject *args)
 {
     PyObject *obj;
@@ -64,6 +64,7 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #endif
 
 #include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/graph/graphviz.hpp>
 #include <boost/graph/strong_components.hpp>
 
@@ -86,6 +87,7 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Matrix.h>
 #include <Base/TimeInfo.h>
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -154,6 +156,34 @@ namespace App {
 static bool globalIsRestoring;
 static bool globalIsRelabeling;
 // Pimpl class
+struct SubObjectCacheKey
+{
+    const DocumentObject *obj = nullptr;
+    std::string subname;
+    bool transform = true;
+
+    bool operator==(const SubObjectCacheKey &other) const {
+        return obj == other.obj && transform == other.transform
+            && subname == other.subname;
+    }
+};
+
+struct SubObjectCacheKeyHasher
+{
+    std::size_t operator()(const SubObjectCacheKey &key) const {
+        std::size_t seed = std::hash<std::string>()(key.subname);
+        boost::hash_combine(seed, key.obj);
+        boost::hash_combine(seed, key.transform);
+        return seed;
+    }
+};
+
+struct SubObjectCacheEntry
+{
+    DocumentObject *obj;
+    Base::Matrix4D mat;
+};
+
 struct DocumentP
 {
     // Array to preserve the creation order of created objects
@@ -185,6 +215,19 @@ struct DocumentP
 #endif //USE_OLD_DAG
     std::multimap<const App::DocumentObject*,
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
+    std::unordered_map<SubObjectCacheKey, SubObjectCacheEntry,
+                       SubObjectCacheKeyHasher> subObjectCache;
+    // reused for lookups to avoid an allocation per call
+    SubObjectCacheKey subObjectKey;
+    // bumped on every change that may affect the result of
+    // DocumentObject::getSubObject()
+    unsigned long subObjectRevision = 1;
+    // the revision the cached results belong to
+    unsigned long subObjectCacheRevision = 0;
+    // documents linking into this one, directly or through other documents
+    std::vector<Document*> linkingDocuments;
+    // the revision of the external links linkingDocuments was collected for
+    unsigned long linkingDocumentsRevision = 0;
 
     DocumentP() {
         static std::random_device _RD;
@@ -1503,11 +1546,108 @@ void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Prop
     }
 }
 
+// Checks if the property takes part in resolving a subname, i.e. if it
+// defines the tree structure, a placement or a label.
+static bool isSubObjectProperty(const DocumentObject *obj, const Property *prop)
+{
+    // the out-list, groups and linked objects
+    if (prop->isDerivedFrom(PropertyLinkBase::getClassTypeId()))
+        return true;
+    if (prop->isDerivedFrom(PropertyPlacement::getClassTypeId()))
+        return true;
+    // subnames may refer to objects by label
+    if (prop == &obj->Label)
+        return true;
+
+    // the element count, scales and placement lists of links
+    auto ext = obj->getExtensionByType<LinkBaseExtension>(true);
+    if (ext) {
+        for (int i = 0; i < LinkBaseExtension::PropMax; ++i) {
+            if (ext->getProperty(i) == prop)
+                return true;
+        }
+    }
+    return false;
+}
+
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    if (isSubObjectProperty(Who, What))
+        invalidateSubObjectCache();
     signalChangedObject(*Who, *What);
 }
 
+void Document::invalidateSubObjectCache()
+{
+    ++d->subObjectRevision;
+
+    // Paths of other documents may lead into this one through external links,
+    // so their results are discarded as well. The linking documents are only
+    // collected again after an external link has changed.
+    unsigned long revision = PropertyXLink::getDocumentLinkRevision();
+    if (d->linkingDocumentsRevision != revision) {
+        d->linkingDocumentsRevision = revision;
+        d->linkingDocuments.clear();
+        std::set<Document*> docs;
+        std::vector<Document*> pending(1, this);
+        while (!pending.empty()) {
+            Document* doc = pending.back();
+            pending.pop_back();
+            for (const auto &v : PropertyXLink::getDocumentInList(doc)) {
+                for (Document* linker : v.second) {
+                    if (linker != this && docs.insert(linker).second) {
+                        d->linkingDocuments.push_back(linker);
+                        pending.push_back(linker);
+                    }
+                }
+            }
+        }
+    }
+
+    for (Document* linker : d->linkingDocuments)
+        ++linker->d->subObjectRevision;
+}
+
+bool Document::getCachedSubObject(const DocumentObject *obj, const char *subname,
+        bool transform, DocumentObject *&ret, Base::Matrix4D &mat, unsigned long &revision) const
+{
+    revision = d->subObjectRevision;
+    if (d->subObjectCacheRevision != d->subObjectRevision) {
+        d->subObjectCache.clear();
+        d->subObjectCacheRevision = d->subObjectRevision;
+        return false;
+    }
+
+    auto &key = d->subObjectKey;
+    key.obj = obj;
+    key.subname.assign(subname);
+    key.transform = transform;
+    auto it = d->subObjectCache.find(key);
+    if (it == d->subObjectCache.end())
+        return false;
+    ret = it->second.obj;
+    mat = it->second.mat;
+    return true;
+}
+
+void Document::setCachedSubObject(const DocumentObject *obj, const char *subname,
+        bool transform, DocumentObject *ret, const Base::Matrix4D &mat, unsigned long revision) const
+{
+    // something changed while resolving, the result may already be stale
+    if (revision != d->subObjectRevision)
+        return;
+
+    // keep the memory bounded
+    if (d->subObjectCache.size() >= 100000)
+        d->subObjectCache.clear();
+
+    SubObjectCacheKey key;
+    key.obj = obj;
+    key.subname = subname;
+    key.transform = transform;
+    d->subObjectCache[std::move(key)] = SubObjectCacheEntry{ret, mat};
+}
+
 void Document::setTransactionMode(int iMode)
 {
     d->iTransactionMode = iMode;
@@ -2655,6 +2795,9 @@ bool Document::saveToFile(const char* filename) const
 
         if (hGrp->GetBool("SaveBinaryBrep", false))
             writer.setMode("BinaryBrep");
+        // older versions can't read the compact mesh format
+        if (hGrp->GetBool("SaveCompactMesh", false))
+            writer.setMode("CompactMesh");
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
                         << "<!--" << endl
@@ -4144,6 +4287,7 @@ void Document::removeObject(const char* sName)
         pos->second->unsetupObject();
     }
 
+    invalidateSubObjectCache();
     signalDeletedObject(*(pos->second));
 
     // do no transactions if we do a rollback!
@@ -4249,6 +4393,7 @@ void Document::_removeObject(DocumentObject* pcObject)
     if (!d->undoing && !d->rollback) {
         pcObject->unsetupObject();
     }
+    invalidateSubObjectCache();
     signalDeletedObject(*pcObject);
     // TODO Check me if it's needed (2015-09-01, Fat-Zer)
 
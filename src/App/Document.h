@@ -31,6 +31,7 @@
 #include <vector>
 
 namespace Base {
+    class Matrix4D;
     class Writer;
 }
 
@@ -527,6 +528,17 @@ protected:
     void onBeforeChangeProperty(const TransactionalObject *Who, const Property *What);
     /// callback from the Document objects after property was changed
     void onChangedProperty(const DocumentObject *Who, const Property *What);
+    /** look up a result of DocumentObject::getSubObject() cached by this document
+     * On a miss \a revision is set to the current cache revision to be passed to
+     * setCachedSubObject().
+     */
+    bool getCachedSubObject(const DocumentObject *obj, const char *subname, bool transform,
+                            DocumentObject *&ret, Base::Matrix4D &mat, unsigned long &revision) const;
+    /// cache a result of DocumentObject::getSubObject() computed at the given cache revision
+    void setCachedSubObject(const DocumentObject *obj, const char *subname, bool transform,
+                            DocumentObject *ret, const Base::Matrix4D &mat, unsigned long revision) const;
+    /// discard the cached sub-object results of this document and of documents linking to it
+    void invalidateSubObjectCache();
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
@@ -43,6 +43,7 @@
 #include "ObjectIdentifier.h"
 #include "PropertyExpressionEngine.h"
 #include "PropertyLinks.h"
+#include "PropertyPythonObject.h"
 
 
 FC_LOG_LEVEL_INIT("App",true,true)
@@ -83,6 +84,10 @@ DocumentObject::DocumentObject()
 
 DocumentObject::~DocumentObject()
 {
+    // the address may be reused by a new object
+    if (_pDoc)
+        _pDoc->invalidateSubObjectCache();
+
     if (!PythonObject.is(Py::_None())){
         Base::PyGILStateLocker lock;
         // Remark: The API of Py::Object has been changed to set whether the wrapper owns the passed
@@ -648,6 +653,8 @@ App::Document *DocumentObject::getDocument() const
 void DocumentObject::setDocument(App::Document* doc)
 {
     _pDoc=doc;
+    if (_pDoc)
+        _pDoc->invalidateSubObjectCache();
     onSettingDocument();
 }
 
@@ -772,6 +779,39 @@ PyObject *DocumentObject::getPyObject()
 
 DocumentObject *DocumentObject::getSubObject(const char *subname,
         PyObject **pyObj, Base::Matrix4D *mat, bool transform, int depth) const
+{
+    // Resolving an object path without asking for its Python object only
+    // depends on the document tree, so the result is kept in a per-document
+    // cache that is invalidated on changes of links, placements and labels.
+    // The cache stores the transformation accumulated along the path, so it's
+    // only used if resolving starts with an identity matrix. Without a matrix
+    // the path is resolved as is, because implementations may skip work or
+    // take a different route if no matrix is requested.
+    if(pyObj || !mat || !mat->isUnity() || depth || !_pDoc || !subname
+             || !strchr(subname,'.') || Document::isAnyRestoring())
+        return resolveSubObject(subname,pyObj,mat,transform,depth);
+
+    // Python code may give a different answer on each call
+    if(Base::freecad_dynamic_cast<PropertyPythonObject>(getPropertyByName("Proxy")))
+        return resolveSubObject(subname,pyObj,mat,transform,depth);
+    for(auto ext : getExtensionsDerivedFromType<App::Extension>()) {
+        if(ext->isPythonExtension())
+            return resolveSubObject(subname,pyObj,mat,transform,depth);
+    }
+
+    DocumentObject *ret = nullptr;
+    Base::Matrix4D subMat;
+    unsigned long revision;
+    if(!_pDoc->getCachedSubObject(this,subname,transform,ret,subMat,revision)) {
+        ret = resolveSubObject(subname,nullptr,&subMat,transform,depth);
+        _pDoc->setCachedSubObject(this,subname,transform,ret,subMat,revision);
+    }
+    *mat = subMat;
+    return ret;
+}
+
+DocumentObject *DocumentObject::resolveSubObject(const char *subname,
+        PyObject **pyObj, Base::Matrix4D *mat, bool transform, int depth) const
 {
     DocumentObject *ret = nullptr;
     auto exts = getExtensionsDerivedFromType<App::DocumentObjectExtension>();
@@ -616,6 +616,9 @@ protected:
 
 private:
     void printInvalidLinks() const;
+    /// The uncached part of getSubObject()
+    DocumentObject *resolveSubObject(const char *subname, PyObject **pyObj,
+            Base::Matrix4D *mat, bool transform, int depth) const;
 
      /// python object of this class and all descendent
 protected: // attributes
@@ -73,6 +73,9 @@ void DynamicProperty::getPropertyMap(std::map<std::string,Property*> &Map) const
 
 Property *DynamicProperty::getDynamicPropertyByName(const char* name) const
 {
+    // most containers have no dynamic properties, skip hashing the name then
+    if (props.empty())
+        return nullptr;
     auto &index = props.get<0>();
     auto it = index.find(name);
     if (it != index.end())
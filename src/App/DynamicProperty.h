@@ -24,6 +24,8 @@
 #ifndef APP_DYNAMICPROPERTY_H
 #define APP_DYNAMICPROPERTY_H
 
+#include <cstdint>
+#include <cstring>
 #include <map>
 #include <string>
 #include <vector>
@@ -49,9 +51,15 @@ class PropertyContainer;
 namespace bmi = boost::multi_index;
 
 struct CStringHasher {
+    // Single-pass FNV-1a, avoids the separate strlen() of a range hash
     inline std::size_t operator()(const char *s) const {
         if(!s) return 0;
-        return boost::hash_range(s,s+std::strlen(s));
+        std::uint64_t hash = 14695981039346656037ULL;
+        for(;*s;++s) {
+            hash ^= static_cast<unsigned char>(*s);
+            hash *= 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(hash);
     }
     inline bool operator()(const char *a, const char *b) const {
         if(!a) return !b;
@@ -29,7 +29,10 @@
 
 #include "PropertyContainer.h"
 #include "Property.h"
+#include "PropertyGeo.h"
+#include "PropertyStandard.h"
 #include "DocumentObject.h"
+#include <Base/ArrayBufferPy.h>
 
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -99,6 +102,36 @@ PyObject*  PropertyContainerPy::getPropertyTouchList(PyObject *args)
     }
 }
 
+PyObject*  PropertyContainerPy::getPropertyBuffer(PyObject *args)
+{
+    char *pstr;
+    if (!PyArg_ParseTuple(args, "s", &pstr))
+        return nullptr;
+
+    App::Property* prop = getPropertyContainerPtr()->getPropertyByName(pstr);
+    if (!prop) {
+        PyErr_Format(PyExc_AttributeError, "Property container has no property '%s'", pstr);
+        return nullptr;
+    }
+
+    PY_TRY {
+        // The values are copied with a single memcpy which is negligible compared to
+        // creating a Python object per element. This way the buffer is independent
+        // of later modifications of the property.
+        if (prop->isDerivedFrom(PropertyVectorList::getClassTypeId())) {
+            std::vector<Base::Vector3d> values = static_cast<PropertyVectorList*>(prop)->getValues();
+            return Py::new_reference_to(Base::ArrayBufferPy::create<double>(std::move(values)));
+        }
+        if (prop->isDerivedFrom(PropertyFloatList::getClassTypeId())) {
+            std::vector<double> values = static_cast<PropertyFloatList*>(prop)->getValues();
+            return Py::new_reference_to(Base::ArrayBufferPy::create<double>(std::move(values)));
+        }
+    } PY_CATCH
+
+    PyErr_Format(PyExc_TypeError, "Property '%s' is neither a vector nor a float list", pstr);
+    return nullptr;
+}
+
 PyObject*  PropertyContainerPy::getTypeOfProperty(PyObject *args)
 {
     Py::List ret;
@@ -2509,6 +2509,8 @@ bool PropertyLinkSubList::adjustLink(const std::set<App::DocumentObject*> &inLis
 // some user (especially Linux user) use symlink to organize file tree.
 using DocInfoMap = std::map<QString, DocInfoPtr>;
 DocInfoMap _DocInfoMap;
+// changed whenever an external link is added or removed, or a document is attached
+static unsigned long _DocLinkRevision = 1;
 
 class App::DocInfo :
     public std::enable_shared_from_this<App::DocInfo>
@@ -2607,6 +2609,7 @@ public:
         }
 
         info->links.insert(l);
+        ++_DocLinkRevision;
         return info;
     }
 
@@ -2644,6 +2647,7 @@ public:
     void deinit() {
         FC_LOG("deinit " << (pcDoc?pcDoc->getName():filePath()));
         assert(links.empty());
+        ++_DocLinkRevision;
         connFinishRestoreDocument.disconnect();
         connPendingReloadDocument.disconnect();
         connDeleteDocument.disconnect();
@@ -2691,6 +2695,7 @@ public:
     void attach(Document *doc) {
         assert(!pcDoc);
         pcDoc = doc;
+        ++_DocLinkRevision;
         FC_LOG("attaching " << doc->getName() << ", " << doc->getFileName());
         std::map<App::PropertyLinkBase*,std::vector<App::PropertyXLink*> > parentLinks;
         for(auto it=links.begin(),itNext=it;it!=links.end();it=itNext) {
@@ -2743,6 +2748,7 @@ public:
         auto it = links.find(l);
         if(it != links.end()) {
             links.erase(it);
+            ++_DocLinkRevision;
             if(links.empty())
                 deinit();
         }
@@ -2813,6 +2819,7 @@ public:
     }
 
     void slotDeleteDocument(const App::Document &doc) {
+        ++_DocLinkRevision;
         for(auto it=links.begin(),itNext=it;it!=links.end();it=itNext) {
             ++itNext;
             auto link = *it;
@@ -3595,6 +3602,10 @@ PropertyXLink::getDocumentInList(App::Document *doc) {
     return ret;
 }
 
+unsigned long PropertyXLink::getDocumentLinkRevision() {
+    return _DocLinkRevision;
+}
+
 PyObject *PropertyXLink::getPyObject()
 {
     if(!_pcLink)
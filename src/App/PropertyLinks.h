@@ -1114,6 +1114,8 @@ public:
     static bool hasXLink(const std::vector<App::DocumentObject*> &objs, std::vector<App::Document*> *unsaved=nullptr);
     static std::map<App::Document*,std::set<App::Document*> > getDocumentOutList(App::Document *doc=nullptr);
     static std::map<App::Document*,std::set<App::Document*> > getDocumentInList(App::Document *doc=nullptr);
+    /// Returns a number that changes whenever the external links between documents may have changed
+    static unsigned long getDocumentLinkRevision();
     static void restoreDocument(const App::Document &doc);
 
     void updateElementReference(
@@ -0,0 +1,115 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <sstream>
+#endif
+
+#include "ArrayBufferPy.h"
+
+
+using namespace Base;
+
+void ArrayBufferPy::init_type()
+{
+    behaviors().name("ArrayBuffer");
+    behaviors().doc("Read-only array exposed through the buffer protocol");
+    // you must have overwritten the virtual functions
+    behaviors().supportRepr();
+    behaviors().supportGetattr();
+    behaviors().supportBufferType();
+
+    add_varargs_method("getShape",&ArrayBufferPy::getShape,"getShape() -> tuple");
+}
+
+ArrayBufferPy::ArrayBufferPy(std::shared_ptr<const void> owner, const void* data,
+                             const char* format, Py_ssize_t itemsize,
+                             Py_ssize_t rows, Py_ssize_t columns)
+  : owner(std::move(owner))
+  , data(data)
+  , format(format)
+  , itemsize(itemsize)
+  , ndim(columns > 1 ? 2 : 1)
+{
+    shape[0] = rows;
+    shape[1] = columns;
+    strides[0] = columns * itemsize;
+    strides[1] = itemsize;
+}
+
+ArrayBufferPy::~ArrayBufferPy() = default;
+
+Py::Object ArrayBufferPy::repr()
+{
+    std::stringstream str;
+    str << "Base.ArrayBuffer(format='" << format << "', shape=(" << shape[0];
+    if (ndim > 1)
+        str << ", " << shape[1];
+    else
+        str << ",";
+    str << "))";
+    return Py::String(str.str());
+}
+
+int ArrayBufferPy::buffer_get(Py_buffer* view, int flags)
+{
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "Array buffer is read-only");
+        view->obj = nullptr;
+        return -1;
+    }
+
+    view->obj = selfPtr();
+    Py_INCREF(view->obj);
+    view->buf = const_cast<void*>(data);
+    view->len = shape[0] * shape[1] * itemsize;
+    view->readonly = 1;
+    view->itemsize = itemsize;
+    // a missing format would be taken as unsigned bytes which doesn't match the item size
+    view->format = const_cast<char*>(format.c_str());
+    view->ndim = ndim;
+    view->shape = (flags & PyBUF_ND) ? shape : nullptr;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+int ArrayBufferPy::buffer_release(Py_buffer*)
+{
+    // the memory is owned by this object and released with it
+    return 0;
+}
+
+Py::Object ArrayBufferPy::getShape(const Py::Tuple& args)
+{
+    if (!PyArg_ParseTuple(args.ptr(), ""))
+        throw Py::Exception();
+    Py::Tuple tuple(ndim);
+    for (int i = 0; i < ndim; i++)
+        tuple.setItem(i, Py::Long(static_cast<long>(shape[i])));
+    return tuple;
+}
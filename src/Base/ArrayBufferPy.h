@@ -0,0 +1,104 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_ARRAYBUFFERPY_H
+#define BASE_ARRAYBUFFERPY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <CXX/Extensions.hxx>
+
+namespace Base
+{
+
+/// Maps a scalar type to its format character of the struct module
+template <typename T> struct ArrayBufferFormat;
+template <> struct ArrayBufferFormat<float>    { static const char* format() { return "f"; } };
+template <> struct ArrayBufferFormat<double>   { static const char* format() { return "d"; } };
+template <> struct ArrayBufferFormat<int32_t>  { static const char* format() { return "i"; } };
+template <> struct ArrayBufferFormat<uint32_t> { static const char* format() { return "I"; } };
+template <> struct ArrayBufferFormat<int64_t>  { static const char* format() { return "q"; } };
+template <> struct ArrayBufferFormat<uint64_t> { static const char* format() { return "Q"; } };
+
+/**
+ * The ArrayBufferPy class exposes a contiguous array through the Python buffer
+ * protocol. numpy.asarray() or memoryview() can wrap it without touching a single
+ * element, which avoids creating one Python object per point or triangle of a
+ * large geometry.
+ *
+ * The buffer is read-only and holds a reference to the array it was created from.
+ * Thus it stays valid even if the geometry it was taken from is modified or
+ * destroyed later on.
+ * @code
+ * import numpy
+ * points, triangles = mesh.getFacesBuffer(0.0)
+ * pts = numpy.asarray(points)     # shape (n, 3), float64
+ * tri = numpy.asarray(triangles)  # shape (m, 3), uint32
+ * @endcode
+ */
+class BaseExport ArrayBufferPy : public Py::PythonExtension<ArrayBufferPy>
+{
+public:
+    static void init_type();    // announce properties and methods
+
+    /** Takes over the elements of \a data. Each element of type \a T is exposed
+     * as one row of scalars of type \a Scalar, e.g. a Base::Vector3d becomes a
+     * row of three doubles.
+     */
+    template <typename Scalar, typename T>
+    static Py::Object create(std::vector<T>&& data)
+    {
+        static_assert(sizeof(T) % sizeof(Scalar) == 0, "Element is not an array of scalars");
+        auto array = std::make_shared<const std::vector<T>>(std::move(data));
+        return Py::asObject(new ArrayBufferPy(array, array->data(),
+                                              ArrayBufferFormat<Scalar>::format(),
+                                              sizeof(Scalar), array->size(),
+                                              sizeof(T) / sizeof(Scalar)));
+    }
+
+    ArrayBufferPy(std::shared_ptr<const void> owner, const void* data,
+                  const char* format, Py_ssize_t itemsize,
+                  Py_ssize_t rows, Py_ssize_t columns);
+    ~ArrayBufferPy() override;
+
+    Py::Object repr() override;
+    int buffer_get(Py_buffer* view, int flags) override;
+    int buffer_release(Py_buffer* view) override;
+
+    Py::Object getShape(const Py::Tuple&);
+
+private:
+    std::shared_ptr<const void> owner;
+    const void* data;
+    std::string format;
+    Py_ssize_t itemsize;
+    int ndim;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
+
+} // namespace Base
+
+#endif // BASE_ARRAYBUFFERPY_H
@@ -196,6 +196,31 @@ private:
     PyThreadState* state;
 };
 
+/**
+ * Runs \a func with the global interpreter lock (GIL) temporarily released so that
+ * other Python threads are not blocked while a long C++ operation, like a boolean,
+ * is running. The GIL is re-acquired before the result is returned or an exception
+ * propagates, so the caller can convert the result or set the Python error as usual.
+ * Another thread may access the object meanwhile. So an operation that modifies the
+ * object in place must either work on a copy that is assigned afterwards or hold a
+ * lock of the object that all other accesses take as well.
+ * \a func must not touch any Python object. This also includes evaluating
+ * Python arguments which thus must be converted to C++ values beforehand. Code
+ * that may call back into Python, e.g. observers, must use PyGILStateLocker which
+ * is safe to use while the GIL is released.
+ * @code
+ * TopoDS_Shape result = Base::runWithoutGIL([&] {
+ *     return getTopoShapePtr()->fuse(shape);
+ * });
+ * @endcode
+ */
+template <typename Function>
+inline auto runWithoutGIL(Function&& func) -> decltype(func())
+{
+    PyGILStateRelease release;
+    return func();
+}
+
 
 /** The Interpreter class
  *  This class manage the python interpreter and hold a lot
@@ -112,6 +112,7 @@ void Persistence::dumpToStream(std::ostream& stream, int compression)
         writer.setLevel(compression);
         writer.putNextEntry("Persistence.xml");
         writer.setMode("BinaryBrep");
+        writer.setMode("CompactMesh");
 
         //save the content (we need to encapsulte it with xml tags to be able to read single element xmls like happen for properties)
         writer.Stream() << "<Content>" << std::endl;
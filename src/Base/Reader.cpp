@@ -27,7 +27,10 @@
 # include <xercesc/sax2/XMLReaderFactory.hpp>
 #endif
 
+#include <cctype>
+#include <charconv>
 #include <locale>
+#include <type_traits>
 
 #include "Reader.h"
 #include "Base64.h"
@@ -48,6 +51,42 @@ XERCES_CPP_NAMESPACE_USE
 
 using namespace std;
 
+namespace {
+
+/*!
+ * \brief parseNumber
+ * Parses the number directly from the attribute buffer with std::from_chars which
+ * neither allocates nor depends on the C locale. Leading blanks and a plus sign
+ * are skipped to match atol()/atof(). Returns false if the value cannot be parsed
+ * this way so that the caller falls back to the C library functions.
+ */
+template <typename T>
+bool parseNumber(const std::string& value, T& num)
+{
+    const char* first = value.data();
+    const char* last = first + value.size();
+    while (first != last && isspace(static_cast<unsigned char>(*first)))
+        ++first;
+    if (first != last && *first == '+')
+        ++first;
+    // strtoul accepts negative input and wraps it around, leave this case to it
+    if (std::is_unsigned<T>::value && first != last && *first == '-')
+        return false;
+    std::from_chars_result res = std::from_chars(first, last, num);
+    return res.ec == std::errc();
+}
+
+#if !defined(__cpp_lib_to_chars)
+// Floating-point std::from_chars is not provided by all supported standard libraries
+template <>
+bool parseNumber<double>(const std::string&, double&)
+{
+    return false;
+}
+#endif
+
+}
+
 
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Constructors and Destructor
@@ -55,7 +94,7 @@ using namespace std;
 
 Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
   : DocumentSchema(0), ProgramVersion(""), FileVersion(0), Level(0),
-    CharacterCount(0), ReadType(None), _File(FileName), _valid(false),
+    CharacterCount(0), AttrCount(0), ReadType(None), _File(FileName), _valid(false),
     _verbose(true)
 {
 #ifdef _MSC_VER
@@ -114,72 +153,63 @@ const char* Base::XMLReader::localName() const
 
 unsigned int Base::XMLReader::getAttributeCount() const
 {
-    return static_cast<unsigned int>(AttrMap.size());
+    return static_cast<unsigned int>(AttrCount);
 }
 
-long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
+const std::string& Base::XMLReader::findAttribute(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return atol(pos->second.c_str());
-    }
-    else {
-        // wrong name, use hasAttribute if not sure!
-        std::ostringstream msg;
-        msg << "XML Attribute: \"" << AttrName << "\" not found";
-        throw Base::XMLAttributeError(msg.str());
+    // Elements carry only a handful of attributes, so a linear scan is faster
+    // than any tree or hash lookup and needs no temporary std::string.
+    for (std::size_t i = 0; i < AttrCount; i++) {
+        if (AttrList[i].name == AttrName)
+            return AttrList[i].value;
     }
+
+    // wrong name, use hasAttribute if not sure!
+    std::ostringstream msg;
+    msg << "XML Attribute: \"" << AttrName << "\" not found";
+    throw Base::XMLAttributeError(msg.str());
 }
 
-unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) const
+long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const std::string& value = findAttribute(AttrName);
+    long num;
+    if (parseNumber(value, num))
+        return num;
+    return atol(value.c_str());
+}
 
-    if (pos != AttrMap.end()) {
-        return strtoul(pos->second.c_str(),nullptr,10);
-    }
-    else {
-        // wrong name, use hasAttribute if not sure!
-        std::ostringstream msg;
-        msg << "XML Attribute: \"" << AttrName << "\" not found";
-        throw Base::XMLAttributeError(msg.str());
-    }
+unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) const
+{
+    const std::string& value = findAttribute(AttrName);
+    unsigned long num;
+    if (parseNumber(value, num))
+        return num;
+    return strtoul(value.c_str(),nullptr,10);
 }
 
 double Base::XMLReader::getAttributeAsFloat  (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return atof(pos->second.c_str());
-    }
-    else {
-        // wrong name, use hasAttribute if not sure!
-        std::ostringstream msg;
-        msg << "XML Attribute: \"" << AttrName << "\" not found";
-        throw Base::XMLAttributeError(msg.str());
-    }
+    const std::string& value = findAttribute(AttrName);
+    double num;
+    if (parseNumber(value, num))
+        return num;
+    return atof(value.c_str());
 }
 
 const char*  Base::XMLReader::getAttribute (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return pos->second.c_str();
-    }
-    else {
-        // wrong name, use hasAttribute if not sure!
-        std::ostringstream msg;
-        msg << "XML Attribute: \"" << AttrName << "\" not found";
-        throw Base::XMLAttributeError(msg.str());
-    }
+    return findAttribute(AttrName).c_str();
 }
 
 bool Base::XMLReader::hasAttribute (const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    for (std::size_t i = 0; i < AttrCount; i++) {
+        if (AttrList[i].name == AttrName)
+            return true;
+    }
+    return false;
 }
 
 bool Base::XMLReader::read()
@@ -419,12 +449,15 @@ void Base::XMLReader::endDocument()
 void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* const localname, const XMLCh* const /*qname*/, const XERCES_CPP_NAMESPACE_QUALIFIER Attributes& attrs)
 {
     Level++; // new scope
-    LocalName = StrX(localname).c_str();
-
-    // saving attributes of the current scope, delete all previously stored ones
-    AttrMap.clear();
-    for (unsigned int i = 0; i < attrs.getLength(); i++) {
-        AttrMap[StrX(attrs.getQName(i)).c_str()] = StrXUTF8(attrs.getValue(i)).c_str();
+    XMLTools::toStdString(localname, LocalName);
+
+    // saving attributes of the current scope, overwrite all previously stored ones
+    AttrCount = attrs.getLength();
+    if (AttrList.size() < AttrCount)
+        AttrList.resize(AttrCount);
+    for (std::size_t i = 0; i < AttrCount; i++) {
+        XMLTools::toStdString(attrs.getQName(i), AttrList[i].name);
+        XMLTools::toStdString(attrs.getValue(i), AttrList[i].value);
     }
 
     ReadType = StartElement;
@@ -433,7 +466,7 @@ void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* cons
 void Base::XMLReader::endElement  (const XMLCh* const /*uri*/, const XMLCh *const localname, const XMLCh *const /*qname*/)
 {
     Level--; // end of scope
-    LocalName = StrX(localname).c_str();
+    XMLTools::toStdString(localname, LocalName);
 
     if (ReadType == StartElement)
         ReadType = StartEndElement;
@@ -28,6 +28,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <xercesc/framework/XMLPScanToken.hpp>
 #include <xercesc/sax2/Attributes.hpp>
@@ -260,8 +261,20 @@ protected:
     std::string Characters;
     unsigned int CharacterCount;
 
-    std::map<std::string,std::string> AttrMap;
-    using AttrMapType = std::map<std::string,std::string>;
+    /** The attributes of the current element. The entries are kept alive between
+     * elements so that their string buffers are re-used and reading an element
+     * does not allocate once the buffers have grown. Only the first AttrCount
+     * entries are valid.
+     */
+    struct AttrEntry {
+        std::string name;
+        std::string value;
+    };
+    std::vector<AttrEntry> AttrList;
+    std::size_t AttrCount;
+
+    /// return the value of the named attribute or throw an XMLAttributeError
+    const std::string& findAttribute(const char* AttrName) const;
 
     enum {
         None = 0,
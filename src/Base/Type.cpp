@@ -24,6 +24,8 @@
 
 #ifndef _PreComp_
 # include <cassert>
+# include <cstdint>
+# include <cstring>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -51,7 +53,113 @@ struct Base::TypeData
   Type::instantiationMethod instMethod;
 };
 
-map<string,unsigned int> Type::typemap;
+namespace {
+
+/// Single-pass FNV-1a hash of a zero-terminated type name
+inline std::size_t hashTypeName(const char *name)
+{
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (; *name; ++name) {
+    hash ^= static_cast<unsigned char>(*name);
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<std::size_t>(hash);
+}
+
+/** Open-addressing hash table mapping type names to their key.
+ * The names are not copied: a slot only holds the precomputed hash and the
+ * type key, and the name is compared against the one stored in TypeData.
+ * Looking up a name therefore never allocates, which matters because
+ * Type::fromName() is called for every object and property on restore.
+ */
+class TypeNameTable
+{
+public:
+  unsigned int find(const char *name, const std::vector<TypeData*> &data) const;
+  void insert(const char *name, unsigned int key, const std::vector<TypeData*> &data);
+  void clear();
+
+private:
+  static const unsigned int EmptySlot = ~0u;
+  struct Slot
+  {
+    std::size_t hash;
+    unsigned int key;
+  };
+
+  void grow();
+
+  std::vector<Slot> slots;
+  std::size_t count = 0;
+};
+
+unsigned int TypeNameTable::find(const char *name, const std::vector<TypeData*> &data) const
+{
+  if (!name || slots.empty())
+    return EmptySlot;
+
+  std::size_t hash = hashTypeName(name);
+  std::size_t mask = slots.size() - 1;
+  for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+    const Slot &slot = slots[i];
+    if (slot.key == EmptySlot)
+      return EmptySlot;
+    if (slot.hash == hash && std::strcmp(data[slot.key]->name.c_str(), name) == 0)
+      return slot.key;
+  }
+}
+
+void TypeNameTable::insert(const char *name, unsigned int key, const std::vector<TypeData*> &data)
+{
+  // keep the load factor at or below one half
+  if ((count + 1) * 2 > slots.size())
+    grow();
+
+  std::size_t hash = hashTypeName(name);
+  std::size_t mask = slots.size() - 1;
+  for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+    Slot &slot = slots[i];
+    if (slot.key == EmptySlot) {
+      slot.hash = hash;
+      slot.key = key;
+      ++count;
+      return;
+    }
+    // a re-registered name refers to the newest type
+    if (slot.hash == hash && std::strcmp(data[slot.key]->name.c_str(), name) == 0) {
+      slot.key = key;
+      return;
+    }
+  }
+}
+
+void TypeNameTable::grow()
+{
+  std::vector<Slot> old;
+  old.swap(slots);
+  slots.resize(old.empty() ? 1024 : old.size() * 2, Slot{0, EmptySlot});
+
+  std::size_t mask = slots.size() - 1;
+  for (const Slot &slot : old) {
+    if (slot.key == EmptySlot)
+      continue;
+    std::size_t i = slot.hash & mask;
+    while (slots[i].key != EmptySlot)
+      i = (i + 1) & mask;
+    slots[i] = slot;
+  }
+}
+
+void TypeNameTable::clear()
+{
+  slots.clear();
+  count = 0;
+}
+
+TypeNameTable typeNames;
+
+}
+
 vector<TypeData*>        Type::typedata;
 set<string>              Type::loadModuleSet;
 
@@ -146,7 +254,7 @@ const Type Type::createType(const Type parent, const char *name, instantiationMe
   Type::typedata.push_back(typeData);
 
   // add to dictionary for fast lookup
-  Type::typemap[name] = newType.getKey();
+  typeNames.insert(typeData->name.c_str(), newType.getKey(), Type::typedata);
 
   return newType;
 }
@@ -158,7 +266,7 @@ void Type::init()
 
 
   Type::typedata.push_back(new TypeData("BadType"));
-  Type::typemap["BadType"] = 0;
+  typeNames.insert(Type::typedata[0]->name.c_str(), 0, Type::typedata);
 
 
 }
@@ -168,17 +276,15 @@ void Type::destruct()
   for(std::vector<TypeData*>::const_iterator it = typedata.begin();it!= typedata.end();++it)
     delete *it;
   typedata.clear();
-  typemap.clear();
+  typeNames.clear();
   loadModuleSet.clear();
 }
 
 Type Type::fromName(const char *name)
 {
-  std::map<std::string,unsigned int>::const_iterator pos;
-
-  pos = typemap.find(name);
-  if (pos != typemap.end())
-    return typedata[pos->second]->type;
+  unsigned int key = typeNames.find(name, typedata);
+  if (key < typedata.size())
+    return typedata[key]->type;
   else
     return Type::badType();
 }
@@ -29,26 +29,51 @@ using namespace Base;
 
 std::unique_ptr<XERCES_CPP_NAMESPACE::XMLTranscoder> XMLTools::transcoder;
 
-void XMLTools::initialize()
+static std::unique_ptr<XERCES_CPP_NAMESPACE::XMLTranscoder> createTranscoder()
 {
     XERCES_CPP_NAMESPACE_USE;
-    if (!transcoder.get()) {
-        XMLTransService::Codes  res;
-        transcoder.reset(XERCES_CPP_NAMESPACE_QUALIFIER XMLPlatformUtils::fgTransService->makeNewTranscoderFor(XERCES_CPP_NAMESPACE_QUALIFIER XMLRecognizer::UTF_8, res, 4096, XERCES_CPP_NAMESPACE_QUALIFIER XMLPlatformUtils::fgMemoryManager));
-        if (res != XMLTransService::Ok)
-            throw Base::UnicodeError("Can\'t create transcoder");
-    }
+    XMLTransService::Codes  res;
+    std::unique_ptr<XMLTranscoder> utf8(XMLPlatformUtils::fgTransService->makeNewTranscoderFor(XMLRecognizer::UTF_8, res, 4096, XMLPlatformUtils::fgMemoryManager));
+    if (res != XMLTransService::Ok)
+        throw Base::UnicodeError("Can\'t create transcoder");
+    return utf8;
+}
+
+void XMLTools::initialize()
+{
+    if (!transcoder.get())
+        transcoder = createTranscoder();
 }
 
 std::string XMLTools::toStdString(const XMLCh* const toTranscode)
 {
     std::string str;
+    toStdString(toTranscode, str);
+    return str;
+}
 
+void XMLTools::toStdString(const XMLCh* const toTranscode, std::string& str)
+{
     XERCES_CPP_NAMESPACE_USE;
-    initialize();
+    str.clear();
+
+    // Element names and attribute values are nearly always plain ASCII. Then the
+    // UTF-8 form is a narrowing copy and the transcoder can be skipped.
+    const XMLCh* it = toTranscode;
+    while (*it && *it < 0x80)
+        ++it;
+    if (*it == 0) {
+        str.reserve(static_cast<std::size_t>(it - toTranscode));
+        for (const XMLCh* jt = toTranscode; jt != it; ++jt)
+            str.push_back(static_cast<char>(*jt));
+        return;
+    }
 
-    //char outBuff[128];
-    static XMLByte outBuff[128];
+    // the documents may be read by several threads at once, so the shared
+    // transcoder cannot be used here
+    std::unique_ptr<XMLTranscoder> utf8 = createTranscoder();
+
+    XMLByte outBuff[128];
     XMLSize_t outputLength;
     XMLSize_t eaten = 0;
     XMLSize_t offset = 0;
@@ -56,7 +81,7 @@ std::string XMLTools::toStdString(const XMLCh* const toTranscode)
 
     while (inputLength)
     {
-        outputLength = transcoder->transcodeTo(toTranscode + offset, inputLength, outBuff, 128, eaten, XMLTranscoder::UnRep_RepChar);
+        outputLength = utf8->transcodeTo(toTranscode + offset, inputLength, outBuff, 128, eaten, XMLTranscoder::UnRep_RepChar);
         str.append(reinterpret_cast<const char*>(outBuff), outputLength);
         offset += eaten;
         inputLength -= eaten;
@@ -65,8 +90,6 @@ std::string XMLTools::toStdString(const XMLCh* const toTranscode)
         if (outputLength == 0)
             break;
     }
-
-    return str;
 }
 
 std::basic_string<XMLCh> XMLTools::toXMLString(const char* const fromTranscode)
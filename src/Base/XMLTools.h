@@ -43,6 +43,8 @@ class BaseExport XMLTools
 {
 public:
     static std::string toStdString(const XMLCh* const toTranscode);
+    /// Transcodes into \a str and re-uses its capacity. Pure ASCII input bypasses the transcoder.
+    static void toStdString(const XMLCh* const toTranscode, std::string& str);
     static std::basic_string<XMLCh> toXMLString(const char* const fromTranscode);
     static void initialize();
     static void terminate();
@@ -178,6 +178,8 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
                 // So, always force binary format because ASCII
                 // is not reentrant. See PropertyPartShape::SaveDocFile
                 writer.setMode("BinaryBrep");
+                // a recovery file is read by the same version
+                writer.setMode("CompactMesh");
 
                 writer.putNextEntry("Document.xml");
 
@@ -200,6 +202,8 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
                     Base::ZipWriter writer(file);
                     if (hGrp->GetBool("SaveBinaryBrep", true))
                         writer.setMode("BinaryBrep");
+                    if (hGrp->GetBool("SaveCompactMesh", true))
+                        writer.setMode("CompactMesh");
 
                     writer.setComment("AutoRecovery file");
                     writer.setLevel(1); // apparently the fastest compression
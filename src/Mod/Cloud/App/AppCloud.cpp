@@ -1239,6 +1239,8 @@ bool Cloud::Module::cloudSave(const char *BucketName)
 
         if (hGrp->GetBool("SaveBinaryBrep", false))
             mywriter.setMode("BinaryBrep");
+        if (hGrp->GetBool("SaveCompactMesh", false))
+            mywriter.setMode("CompactMesh");
         mywriter.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
                         << "<!--" << endl
                         << " FreeCAD Document, see https://www.freecadweb.org for more information..." << endl
@@ -37,6 +37,7 @@
 # include <TopoDS_Shape.hxx>
 #endif
 
+#include <Base/Interpreter.h>
 #include <Base/PlacementPy.h>
 #include <Base/QuantityPy.h>
 #include <Base/VectorPy.h>
@@ -670,7 +671,9 @@ PyObject* FemMeshPy::getFacesByFace(PyObject *args)
         const TopoDS_Face& fc = TopoDS::Face(sh);
 
         Py::List ret;
-        std::list<int> resultSet = getFemMeshPtr()->getFacesByFace(fc);
+        std::list<int> resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getFacesByFace(fc);
+        });
         for (std::list<int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it) {
             ret.append(Py::Long(*it));
         }
@@ -700,7 +703,9 @@ PyObject* FemMeshPy::getEdgesByEdge(PyObject *args)
         const TopoDS_Edge& fc = TopoDS::Edge(sh);
 
         Py::List ret;
-        std::list<int> resultSet = getFemMeshPtr()->getEdgesByEdge(fc);
+        std::list<int> resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getEdgesByEdge(fc);
+        });
         for (std::list<int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it) {
             ret.append(Py::Long(*it));
         }
@@ -729,7 +734,9 @@ PyObject* FemMeshPy::getVolumesByFace(PyObject *args)
         const TopoDS_Face& fc = TopoDS::Face(sh);
 
         Py::List ret;
-        std::list<std::pair<int, int> > resultSet = getFemMeshPtr()->getVolumesByFace(fc);
+        std::list<std::pair<int, int> > resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getVolumesByFace(fc);
+        });
         for (std::list<std::pair<int, int> >::const_iterator it = resultSet.begin();it!=resultSet.end();++it) {
             Py::Tuple vol_face(2);
             vol_face.setItem(0, Py::Long(it->first));
@@ -761,7 +768,9 @@ PyObject* FemMeshPy::getccxVolumesByFace(PyObject *args)
         const TopoDS_Face& fc = TopoDS::Face(sh);
 
         Py::List ret;
-        std::map<int, int> resultSet = getFemMeshPtr()->getccxVolumesByFace(fc);
+        std::map<int, int> resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getccxVolumesByFace(fc);
+        });
         for (std::map<int, int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it) {
             Py::Tuple vol_face(2);
             vol_face.setItem(0, Py::Long(it->first));
@@ -810,7 +819,9 @@ PyObject* FemMeshPy::getNodesBySolid(PyObject *args)
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesBySolid(fc);
+        std::set<int> resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getNodesBySolid(fc);
+        });
         for (std::set<int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it)
             ret.append(Py::Long(*it));
 
@@ -837,7 +848,9 @@ PyObject* FemMeshPy::getNodesByFace(PyObject *args)
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesByFace(fc);
+        std::set<int> resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getNodesByFace(fc);
+        });
         for (std::set<int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it)
             ret.append(Py::Long(*it));
 
@@ -864,7 +877,9 @@ PyObject* FemMeshPy::getNodesByEdge(PyObject *args)
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesByEdge(fc);
+        std::set<int> resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getNodesByEdge(fc);
+        });
         for (std::set<int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it)
             ret.append(Py::Long(*it));
 
@@ -891,7 +906,9 @@ PyObject* FemMeshPy::getNodesByVertex(PyObject *args)
             return nullptr;
         }
         Py::List ret;
-        std::set<int> resultSet = getFemMeshPtr()->getNodesByVertex(fc);
+        std::set<int> resultSet = Base::runWithoutGIL([&] {
+            return getFemMeshPtr()->getNodesByVertex(fc);
+        });
         for (std::set<int>::const_iterator it = resultSet.begin();it!=resultSet.end();++it)
             ret.append(Py::Long(*it));
 
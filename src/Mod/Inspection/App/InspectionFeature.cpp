@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <numeric>
 
 #include <BRepExtrema_DistShapeShape.hxx>
@@ -196,7 +197,8 @@ namespace Inspection {
             assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
         }
 
-        void AddFacet (const MeshCore::MeshGeomFacet &rclFacet, unsigned long ulFacetIndex)
+        void AddFacet (const MeshCore::MeshGeomFacet &rclFacet, unsigned long ulFacetIndex,
+                       std::vector<GridEntry> &entries) const
         {
             unsigned long ulX, ulY, ulZ;
             unsigned long ulX1, ulY1, ulZ1, ulX2, ulY2, ulZ2;
@@ -215,19 +217,17 @@ namespace Inspection {
                     for (ulY = ulY1; ulY <= ulY2; ulY++) {
                         for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                             if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ)))
-                                _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                                entries.emplace_back(GridIndex(ulX, ulY, ulZ), ulFacetIndex);
                         }
                     }
                 }
             }
             else
-                _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+                entries.emplace_back(GridIndex(ulX1, ulY1, ulZ1), ulFacetIndex);
         }
 
         void InitGrid (void) override
         {
-            unsigned long i, j;
-
             Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
             float fLengthX = clBBMesh.LengthX(); 
@@ -243,26 +243,22 @@ namespace Inspection {
             _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
             _fMinZ = clBBMesh.MinZ - 0.5f;
 
-            _aulGrid.clear();
-            _aulGrid.resize(_ulCtGridsX);
-            for (i = 0; i < _ulCtGridsX; i++) {
-                _aulGrid[i].resize(_ulCtGridsY);
-                for (j = 0; j < _ulCtGridsY; j++)
-                    _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
+            _aulGridOffsets.assign(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ + 1, 0);
+            _aulGridElements.clear();
         }
 
         void RebuildGrid (void) override
         {
             _ulCtElements = _pclMesh->CountFacets();
             InitGrid();
- 
-            unsigned long i = 0;
-            MeshCore::MeshFacetIterator clFIter(*_pclMesh);
-            clFIter.Transform(_transform);
-            for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-                AddFacet(*clFIter, i++);
-            }
+
+            FillGrid(_ulCtElements, [this](unsigned long begin, unsigned long end, std::vector<GridEntry>& entries) {
+                for (unsigned long i = begin; i < end; i++) {
+                    MeshCore::MeshGeomFacet facet = _pclMesh->GetFacet(i);
+                    facet.Transform(_transform);
+                    AddFacet(facet, i, entries);
+                }
+            });
         }
 
     private:
@@ -309,9 +305,7 @@ float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
     std::vector<unsigned long> indices;
     //_pGrid->GetElements(point, indices);
     if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
+        _pGrid->MeshGrid::SearchNearestFromPoint(point, indices);
     }
 
     float fMinDist=FLT_MAX;
@@ -379,11 +373,9 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
     if (!_box.IsInBox(point))
         return FLT_MAX; // must be inside bbox
 
-    std::set<unsigned long> indices;
+    std::vector<unsigned long> indices;
 #if 0 // a point in a neighbour grid can be nearer
-    std::vector<unsigned long> elements;
-    _pGrid->GetElements(point, elements);
-    indices.insert(elements.begin(), elements.end());
+    _pGrid->GetElements(point, indices);
 #else
     unsigned long ulX, ulY, ulZ;
     _pGrid->Position(point, ulX, ulY, ulZ);
@@ -392,11 +384,13 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
         _pGrid->GetHull(ulX, ulY, ulZ, ulLevel++, indices);
     if (indices.empty() || ulLevel==1)
         _pGrid->GetHull(ulX, ulY, ulZ, ulLevel, indices);
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
 #endif
 
     float fMinDist=FLT_MAX;
     bool positive = true;
-    for (std::set<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
+    for (std::vector<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
         MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(*it);
         if (_bApply) {
             geomFace.Transform(_clTrf);
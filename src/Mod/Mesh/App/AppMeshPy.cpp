@@ -30,15 +30,19 @@
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
+#include <Base/FileInfo.h>
 #include <Base/GeometryPyCXX.h>
 #include <Base/Interpreter.h>
+#include <Base/MatrixPy.h>
 #include <Base/PlacementPy.h>
+#include <Base/Stream.h>
 #include <Base/VectorPy.h>
 #include "Core/Approximation.h"
 #include "Core/Evaluation.h"
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
+#include "Core/Streaming.h"
 #include "WildMagic4/Wm4ContBox3.h"
 
 #include "MeshPy.h"
@@ -76,6 +80,16 @@ public:
             "exportAmfCompressed specifies whether exported AMF files should be\n"
             "compressed.\n"
         );
+        add_keyword_method("convert",&Module::convert,
+            "convert(input, output, [matrix, weld=0.0, reduction=0.0, maxError=1e-3,\n"
+            "        normals=False, chunkSize=1048576]) -> (read, written)\n"
+            "Converts a mesh file chunk by chunk without loading it as a whole.\n"
+            "Supported input formats are STL, OBJ and PLY, supported output formats\n"
+            "are STL and OBJ. Optionally the facets are transformed by 'matrix',\n"
+            "their points are welded within 'weld', the facets are reduced by the\n"
+            "fraction 'reduction' with the maximum error 'maxError' and the normals\n"
+            "are recomputed. Returns the number of read and written facets."
+        );
         add_varargs_method("show",&Module::show,
             "show(shape,[string]) -- Add the mesh to the active document or create one if no document exists."
         );
@@ -144,6 +158,18 @@ private:
             throw Py::RuntimeError(e.what());
         }
     }
+    Py::Object invoke_method_keyword(void *method_def, const Py::Tuple &args, const Py::Dict &keywds) override
+    {
+        try {
+            return Py::ExtensionModule<Module>::invoke_method_keyword(method_def, args, keywds);
+        }
+        catch (const Base::Exception &e) {
+            throw Py::RuntimeError(e.what());
+        }
+        catch (const std::exception &e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
     Py::Object read(const Py::Tuple& args)
     {
         char* Name;
@@ -281,6 +307,72 @@ private:
         return Py::None();
     }
 
+    Py::Object convert(const Py::Tuple &args, const Py::Dict &keywds)
+    {
+        char *inputPy;
+        char *outputPy;
+        PyObject *matrix = nullptr;
+        double weld = 0.0;
+        double reduction = 0.0;
+        double maxError = 1e-3;
+        int normals = 0;
+        Py_ssize_t chunkSize = 1048576;
+
+        static char *kwList[] = {"input", "output", "matrix", "weld", "reduction",
+                                 "maxError", "normals", "chunkSize", nullptr};
+
+        if (!PyArg_ParseTupleAndKeywords( args.ptr(), keywds.ptr(),
+                                          "etet|O!dddpn",
+                                          kwList, "utf-8", &inputPy, "utf-8", &outputPy,
+                                          &(Base::MatrixPy::Type), &matrix,
+                                          &weld, &reduction, &maxError, &normals, &chunkSize )) {
+            throw Py::Exception();
+        }
+
+        std::string inputFileName(inputPy);
+        PyMem_Free(inputPy);
+        std::string outputFileName(outputPy);
+        PyMem_Free(outputPy);
+
+        if (chunkSize <= 0)
+            throw Py::ValueError("Chunk size must be positive");
+        if (reduction < 0.0 || reduction >= 1.0)
+            throw Py::ValueError("Reduction must be in the range [0, 1)");
+
+        Base::FileInfo fi(inputFileName);
+        if (!fi.exists() || !fi.isFile())
+            throw Py::RuntimeError("File does not exist");
+
+        MeshStreamPipeline pipeline(static_cast<std::size_t>(chunkSize));
+        if (matrix) {
+            Base::Matrix4D mat = static_cast<Base::MatrixPy*>(matrix)->value();
+            pipeline.AddStage(std::make_unique<MeshStreamTransform>(mat));
+        }
+        if (weld > 0.0)
+            pipeline.AddStage(std::make_unique<MeshStreamWeld>(static_cast<float>(weld)));
+        if (reduction > 0.0)
+            pipeline.AddStage(std::make_unique<MeshStreamDecimate>(static_cast<float>(reduction),
+                                                                   static_cast<float>(maxError)));
+        if (normals)
+            pipeline.AddStage(std::make_unique<MeshStreamNormals>());
+
+        Base::runWithoutGIL([&]() {
+            Base::ifstream istr(fi, std::ios::in | std::ios::binary);
+            auto reader = MeshStreamReader::Create(istr, MeshInput::getFormat(inputFileName.c_str()));
+
+            Base::FileInfo fo(outputFileName);
+            Base::ofstream ostr(fo, std::ios::out | std::ios::binary);
+            auto writer = MeshStreamWriter::Create(ostr, MeshOutput::GetFormat(outputFileName.c_str()));
+
+            pipeline.Run(*reader, *writer);
+        });
+
+        Py::Tuple count(2);
+        count.setItem(0, Py::Long(static_cast<unsigned long>(pipeline.CountRead())));
+        count.setItem(1, Py::Long(static_cast<unsigned long>(pipeline.CountWritten())));
+        return count;
+    }
+
     Py::Object show(const Py::Tuple& args)
     {
         PyObject *pcObj;
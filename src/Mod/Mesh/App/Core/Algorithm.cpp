@@ -24,6 +24,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <unordered_map>
 #endif
 
 #include <Base/Console.h>
@@ -32,6 +33,7 @@
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "Grid.h"
 #include "Triangulation.h"
@@ -66,6 +68,13 @@ bool MeshAlgorithm::IsVertexVisible (const Base::Vector3f &rcVertex, const Base:
     return true; // no facet between the two points
 }
 
+void MeshAlgorithm::NearestFacetsOnRays (const std::vector<Base::Vector3f> &rclPts, const std::vector<Base::Vector3f> &rclDirs,
+                                         float fMaxAngle, std::vector<MeshFacetBVH::RayHit> &rclHits) const
+{
+    MeshFacetBVH bvh(_rclMesh);
+    bvh.NearestFacetsOnRays(rclPts, rclDirs, fMaxAngle, rclHits);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, Base::Vector3f &rclRes,
                                        FacetIndex &rulFacet) const
 {
@@ -334,6 +343,45 @@ void MeshAlgorithm::GetFacetBorders (const std::vector<FacetIndex> &raulInd, std
   }
 }
 
+namespace {
+/**
+ * Gives access to the boundary edges starting (or ending) at a point in the
+ * order of the edge list. Used edges are skipped lazily so that looking up the
+ * first remaining edge is constant in amortized time.
+ */
+class BorderEdgeLookup
+{
+public:
+    BorderEdgeLookup(const std::vector<std::pair<PointIndex, PointIndex> >& edges,
+                     const std::vector<bool>& used, bool endPoint)
+      : used(used)
+    {
+        for (std::size_t i = 0; i < edges.size(); i++) {
+            PointIndex p = endPoint ? edges[i].second : edges[i].first;
+            points[p].first.push_back(i);
+        }
+    }
+    /** Returns the position of the first unused edge of point \a p or npos. */
+    std::size_t first(PointIndex p)
+    {
+        auto it = points.find(p);
+        if (it == points.end())
+            return npos;
+        std::vector<std::size_t>& edges = it->second.first;
+        std::size_t& cursor = it->second.second;
+        while (cursor < edges.size() && used[edges[cursor]])
+            cursor++;
+        return cursor < edges.size() ? edges[cursor] : npos;
+    }
+
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+    const std::vector<bool>& used;
+    std::unordered_map<PointIndex, std::pair<std::vector<std::size_t>, std::size_t> > points;
+};
+}
+
 void MeshAlgorithm::GetFacetBorders (const std::vector<FacetIndex> &raulInd,
                                      std::list<std::vector<PointIndex> > &rclBorders,
                                      bool ignoreOrientation) const
@@ -346,7 +394,7 @@ void MeshAlgorithm::GetFacetBorders (const std::vector<FacetIndex> &raulInd,
         rclFAry[*it].SetFlag(MeshFacet::VISIT);
 
     // collect all boundary edges (unsorted)
-    std::list<std::pair<PointIndex, PointIndex> >  aclEdges;
+    std::vector<std::pair<PointIndex, PointIndex> >  aclEdges;
     for (std::vector<FacetIndex>::const_iterator it = raulInd.begin(); it != raulInd.end(); ++it) {
         const MeshFacet  &rclFacet = rclFAry[*it];
         for (unsigned short i = 0; i < 3; i++) {
@@ -363,65 +411,74 @@ void MeshAlgorithm::GetFacetBorders (const std::vector<FacetIndex> &raulInd,
     if (aclEdges.empty())
         return; // no borders found (=> solid)
 
+    // Always take the first unused edge in the list that continues the current
+    // boundary. Looking it up by its end points instead of scanning the list
+    // keeps this linear for meshes with thousands of holes.
+    std::vector<bool> used(aclEdges.size(), false);
+    BorderEdgeLookup startsAt(aclEdges, used, false);
+    BorderEdgeLookup endsAt(aclEdges, used, true);
+    std::size_t remaining = aclEdges.size();
+    std::size_t next = 0;
+
     // search for edges in the unsorted list
     PointIndex ulFirst, ulLast;
     std::list<PointIndex> clBorder;
-    ulFirst = aclEdges.begin()->first;
-    ulLast  = aclEdges.begin()->second;
+    ulFirst = aclEdges[next].first;
+    ulLast  = aclEdges[next].second;
 
-    aclEdges.erase(aclEdges.begin());
+    used[next] = true;
+    remaining--;
     clBorder.push_back(ulFirst);
     clBorder.push_back(ulLast);
 
-    while (!aclEdges.empty()) {
+    while (remaining > 0) {
         // get adjacent edge
-        std::list<std::pair<PointIndex, PointIndex> >::iterator pEI;
-        for (pEI = aclEdges.begin(); pEI != aclEdges.end(); ++pEI) {
-            if (pEI->first == ulLast) {
-                ulLast = pEI->second;
+        std::size_t pos = std::min(startsAt.first(ulLast), endsAt.first(ulFirst));
+        // Note: Using this might result into boundaries with wrong orientation.
+        // But if the mesh has some facets with wrong orientation we might get
+        // broken boundary curves.
+        if (ignoreOrientation) {
+            pos = std::min(pos, endsAt.first(ulLast));
+            pos = std::min(pos, startsAt.first(ulFirst));
+        }
+
+        bool found = (pos != BorderEdgeLookup::npos);
+        if (found) {
+            const std::pair<PointIndex, PointIndex>& edge = aclEdges[pos];
+            if (edge.first == ulLast) {
+                ulLast = edge.second;
                 clBorder.push_back(ulLast);
-                aclEdges.erase(pEI);
-                pEI = aclEdges.begin();
-                break;
             }
-            else if (pEI->second == ulFirst) {
-                ulFirst = pEI->first;
+            else if (edge.second == ulFirst) {
+                ulFirst = edge.first;
                 clBorder.push_front(ulFirst);
-                aclEdges.erase(pEI);
-                pEI = aclEdges.begin();
-                break;
             }
-            // Note: Using this might result into boundaries with wrong orientation.
-            // But if the mesh has some facets with wrong orientation we might get
-            // broken boundary curves.
-            else if (pEI->second == ulLast && ignoreOrientation) {
-                ulLast = pEI->first;
+            else if (edge.second == ulLast) {
+                ulLast = edge.first;
                 clBorder.push_back(ulLast);
-                aclEdges.erase(pEI);
-                pEI = aclEdges.begin();
-                break;
             }
-            else if (pEI->first == ulFirst && ignoreOrientation) {
-                ulFirst = pEI->second;
+            else {
+                ulFirst = edge.second;
                 clBorder.push_front(ulFirst);
-                aclEdges.erase(pEI);
-                pEI = aclEdges.begin();
-                break;
             }
+
+            used[pos] = true;
+            remaining--;
         }
 
-        // Note: Calling erase on list iterators doesn't force a re-allocation and
-        // thus doesn't invalidate the iterator itself, only the referenced object
-        if ((pEI == aclEdges.end()) || aclEdges.empty() || (ulLast == ulFirst)) {
+        if (!found || remaining == 0 || (ulLast == ulFirst)) {
             // no further edge found or closed polyline, respectively
             rclBorders.emplace_back(clBorder.begin(), clBorder.end());
             clBorder.clear();
 
-            if (!aclEdges.empty()) {
+            if (remaining > 0) {
                 // start new boundary
-                ulFirst = aclEdges.begin()->first;
-                ulLast  = aclEdges.begin()->second;
-                aclEdges.erase(aclEdges.begin());
+                while (used[next])
+                    next++;
+                ulFirst = aclEdges[next].first;
+                ulLast  = aclEdges[next].second;
+                used[next] = true;
+                remaining--;
                 clBorder.push_back(ulFirst);
                 clBorder.push_back(ulLast);
             }
@@ -631,8 +688,8 @@ bool MeshAlgorithm::FillupHole(const std::vector<PointIndex>& boundary,
     PointIndex refPoint0 = *(boundary.begin());
     PointIndex refPoint1 = *(boundary.begin()+1);
     if (pP2FStructure) {
-        const std::set<FacetIndex>& ring1 = (*pP2FStructure)[refPoint0];
-        const std::set<FacetIndex>& ring2 = (*pP2FStructure)[refPoint1];
+        MeshIndexRange ring1 = (*pP2FStructure)[refPoint0];
+        MeshIndexRange ring2 = (*pP2FStructure)[refPoint1];
         std::vector<FacetIndex> f_int;
         std::set_intersection(ring1.begin(), ring1.end(), ring2.begin(), ring2.end(),
             std::back_insert_iterator<std::vector<FacetIndex> >(f_int));
@@ -1686,28 +1743,130 @@ float MeshAlgorithm::CalculateMinimumGridLength(float fLength, const Base::Bound
 
 // ----------------------------------------------------
 
-void MeshRefPointToFacets::Rebuild ()
+void MeshNeighbourhood::Clear()
 {
-    _map.clear();
+    _offsets.clear();
+    _indices.clear();
+    _overlay.clear();
+}
+
+void MeshNeighbourhood::Build(ElementIndex ulCtRows, const RowFunction& row)
+{
+    struct Block {
+        std::vector<ElementIndex> sizes;
+        std::vector<ElementIndex> indices;
+    };
+
+    // compute the rows of consecutive element ranges in parallel
+    const std::size_t ulMinBlockSize = 10000;
+    std::vector<Block> blocks(parallel_block_count(ulCtRows, ulMinBlockSize));
+    parallel_blocks(ulCtRows, ulMinBlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        Block& data = blocks[block];
+        data.sizes.reserve(end - begin);
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t first = data.indices.size();
+            row(static_cast<ElementIndex>(i), data.indices);
+            std::sort(data.indices.begin() + first, data.indices.end());
+            data.indices.erase(std::unique(data.indices.begin() + first, data.indices.end()), data.indices.end());
+            data.sizes.push_back(static_cast<ElementIndex>(data.indices.size() - first));
+        }
+    });
+
+    // and concatenate them in block order
+    Clear();
+    _offsets.reserve(ulCtRows + 1);
+    _offsets.push_back(0);
+    for (const auto& data : blocks) {
+        for (auto size : data.sizes)
+            _offsets.push_back(_offsets.back() + size);
+    }
+
+    _indices.reserve(_offsets.back());
+    for (auto& data : blocks) {
+        _indices.insert(_indices.end(), data.indices.begin(), data.indices.end());
+        std::vector<ElementIndex>().swap(data.indices);
+    }
+}
+
+void MeshNeighbourhood::Assign(std::vector<ElementIndex>& offsets, std::vector<ElementIndex>& indices)
+{
+    _overlay.clear();
+    _offsets.swap(offsets);
+    _indices.swap(indices);
+}
 
+std::vector<ElementIndex>& MeshNeighbourhood::Modify(ElementIndex pos)
+{
+    auto it = _overlay.find(pos);
+    if (it == _overlay.end()) {
+        const ElementIndex* data = _indices.data();
+        std::vector<ElementIndex> row(data + _offsets[pos], data + _offsets[pos + 1]);
+        it = _overlay.emplace(pos, std::move(row)).first;
+    }
+
+    return it->second;
+}
+
+void MeshNeighbourhood::Insert(ElementIndex pos, ElementIndex index)
+{
+    std::vector<ElementIndex>& row = Modify(pos);
+    auto it = std::lower_bound(row.begin(), row.end(), index);
+    if (it == row.end() || *it != index)
+        row.insert(it, index);
+}
+
+void MeshNeighbourhood::Erase(ElementIndex pos, ElementIndex index)
+{
+    std::vector<ElementIndex>& row = Modify(pos);
+    auto it = std::lower_bound(row.begin(), row.end(), index);
+    if (it != row.end() && *it == index)
+        row.erase(it);
+}
+
+// ----------------------------------------------------
+
+void MeshRefPointToFacets::Rebuild ()
+{
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rPoints.size());
+    std::size_t ulCtPoints = rPoints.size();
 
+    // count the facets per point, a facet referencing a point twice is only counted once
+    std::vector<ElementIndex> offsets(ulCtPoints + 1, 0);
+    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
+        const PointIndex* p = pFIter->_aulPoints;
+        offsets[p[0] + 1]++;
+        if (p[1] != p[0])
+            offsets[p[1] + 1]++;
+        if (p[2] != p[0] && p[2] != p[1])
+            offsets[p[2] + 1]++;
+    }
+    for (std::size_t i = 0; i < ulCtPoints; i++)
+        offsets[i + 1] += offsets[i];
+
+    // as the facets are visited in ascending order each point's facets end up sorted
+    std::vector<ElementIndex> indices(offsets.back());
+    std::vector<ElementIndex> fill(offsets.begin(), offsets.end() - 1);
     MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
     for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
+        const PointIndex* p = pFIter->_aulPoints;
+        FacetIndex index = pFIter - pFBegin;
+        indices[fill[p[0]]++] = index;
+        if (p[1] != p[0])
+            indices[fill[p[1]]++] = index;
+        if (p[2] != p[0] && p[2] != p[1])
+            indices[fill[p[2]]++] = index;
     }
+
+    _map.Assign(offsets, indices);
 }
 
 Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
 {
-    const std::set<FacetIndex>& n = _map[pos];
+    MeshIndexRange n = _map[pos];
     Base::Vector3f normal;
     MeshGeomFacet f;
-    for (std::set<FacetIndex>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshIndexRange::const_iterator it = n.begin(); it != n.end(); ++it) {
         f = _rclMesh.GetFacet(*it);
         normal += f.Area() * f.GetNormal();
     }
@@ -1725,8 +1884,8 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<Poi
     for (int i=0; i < level; i++) {
         std::set<PointIndex> cur;
         for (std::set<PointIndex>::iterator it = lp.begin(); it != lp.end(); ++it) {
-            const std::set<FacetIndex>& ft = (*this)[*it];
-            for (std::set<FacetIndex>::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
+            MeshIndexRange ft = (*this)[*it];
+            for (MeshIndexRange::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
                 for (int j = 0; j < 3; j++) {
                     PointIndex index = f_it[*jt]._aulPoints[j];
                     if (cp.find(index) == cp.end() && nb.find(index) == nb.end()) {
@@ -1747,8 +1906,8 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<Poi
 std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(PointIndex pos) const
 {
     std::set<PointIndex> p;
-    const std::set<FacetIndex>& vf = _map[pos];
-    for (std::set<FacetIndex>::const_iterator it = vf.begin(); it != vf.end(); ++it) {
+    MeshIndexRange vf = _map[pos];
+    for (MeshIndexRange::const_iterator it = vf.begin(); it != vf.end(); ++it) {
         PointIndex p1, p2, p3;
         _rclMesh.GetFacetPoints(*it, p1, p2, p3);
         if (p1 != pos)
@@ -1784,9 +1943,9 @@ void MeshRefPointToFacets::SearchNeighbours(const MeshFacetArray& rFacets, Facet
     visited.insert(index);
     collect.Append(_rclMesh, index);
     for (int i = 0; i < 3; i++) {
-        const std::set<FacetIndex> &f = (*this)[face._aulPoints[i]];
+        MeshIndexRange f = (*this)[face._aulPoints[i]];
 
-        for (std::set<FacetIndex>::const_iterator j = f.begin(); j != f.end(); ++j) {
+        for (MeshIndexRange::const_iterator j = f.begin(); j != f.end(); ++j) {
             SearchNeighbours(rFacets, *j, rclCenter, fMaxDist2, visited, collect);
         }
     }
@@ -1798,19 +1957,13 @@ MeshRefPointToFacets::GetFacet (FacetIndex index) const
     return _rclMesh.GetFacets().begin() + index;
 }
 
-const std::set<FacetIndex>&
-MeshRefPointToFacets::operator[] (PointIndex pos) const
-{
-    return _map[pos];
-}
-
 std::vector<FacetIndex>
 MeshRefPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2) const
 {
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex> > result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
+    MeshIndexRange set1 = _map[pos1];
+    MeshIndexRange set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -1821,19 +1974,19 @@ MeshRefPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2, PointIndex po
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex> > result(intersection);
     std::vector<FacetIndex> set1 = GetIndices(pos1, pos2);
-    const std::set<FacetIndex>& set2 = _map[pos3];
+    MeshIndexRange set2 = _map[pos3];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
 
 void MeshRefPointToFacets::AddNeighbour(PointIndex pos, FacetIndex facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveNeighbour(PointIndex pos, FacetIndex facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveFacet(FacetIndex facetIndex)
@@ -1841,35 +1994,25 @@ void MeshRefPointToFacets::RemoveFacet(FacetIndex facetIndex)
     PointIndex p0, p1, p2;
     _rclMesh.GetFacetPoints(facetIndex, p0, p1, p2);
 
-    _map[p0].erase(facetIndex);
-    _map[p1].erase(facetIndex);
-    _map[p2].erase(facetIndex);
+    _map.Erase(p0, facetIndex);
+    _map.Erase(p1, facetIndex);
+    _map.Erase(p2, facetIndex);
 }
 
 //----------------------------------------------------------------------------
 
 void MeshRefFacetToFacets::Rebuild ()
 {
-    _map.clear();
-
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rFacets.size());
-
     MeshRefPointToFacets  vertexFace(_rclMesh);
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
-    for (MeshFacetArray::_TConstIterator pFIter = pFBegin; pFIter != rFacets.end(); ++pFIter) {
+
+    _map.Build(rFacets.size(), [&](FacetIndex index, std::vector<FacetIndex>& row) {
+        const MeshFacet& face = rFacets[index];
         for (int i = 0; i < 3; i++) {
-            const std::set<FacetIndex>& faces = vertexFace[pFIter->_aulPoints[i]];
-            for (std::set<FacetIndex>::const_iterator it = faces.begin(); it != faces.end(); ++it)
-                _map[pFIter - pFBegin].insert(*it);
+            MeshIndexRange faces = vertexFace[face._aulPoints[i]];
+            row.insert(row.end(), faces.begin(), faces.end());
         }
-    }
-}
-
-const std::set<FacetIndex>&
-MeshRefFacetToFacets::operator[] (FacetIndex pos) const
-{
-    return _map[pos];
+    });
 }
 
 std::vector<FacetIndex>
@@ -1877,8 +2020,8 @@ MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetIndex pos2) const
 {
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex> > result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
+    MeshIndexRange set1 = _map[pos1];
+    MeshIndexRange set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -1887,24 +2030,23 @@ MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetIndex pos2) const
 
 void MeshRefPointToPoints::Rebuild ()
 {
-    _map.clear();
-
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    _map.resize(rPoints.size());
-
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        PointIndex ulP0 = pFIter->_aulPoints[0];
-        PointIndex ulP1 = pFIter->_aulPoints[1];
-        PointIndex ulP2 = pFIter->_aulPoints[2];
+    MeshRefPointToFacets  vertexFace(_rclMesh);
 
-        _map[ulP0].insert(ulP1);
-        _map[ulP0].insert(ulP2);
-        _map[ulP1].insert(ulP0);
-        _map[ulP1].insert(ulP2);
-        _map[ulP2].insert(ulP0);
-        _map[ulP2].insert(ulP1);
-    }
+    // two points are neighbours if a facet has an edge between them
+    _map.Build(rPoints.size(), [&](PointIndex index, std::vector<PointIndex>& row) {
+        MeshIndexRange faces = vertexFace[index];
+        for (MeshIndexRange::const_iterator it = faces.begin(); it != faces.end(); ++it) {
+            const PointIndex* p = rFacets[*it]._aulPoints;
+            for (int i = 0; i < 3; i++) {
+                if (p[i] == index) {
+                    row.push_back(p[(i+1)%3]);
+                    row.push_back(p[(i+2)%3]);
+                }
+            }
+        }
+    });
 }
 
 Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
@@ -1913,8 +2055,8 @@ Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
     MeshCore::PlaneFit pf;
     pf.AddPoint(rPoints[pos]);
     MeshCore::MeshPoint center = rPoints[pos];
-    const std::set<PointIndex>& cv = _map[pos];
-    for (std::set<PointIndex>::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+    MeshIndexRange cv = _map[pos];
+    for (MeshIndexRange::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
         pf.AddPoint(rPoints[*cv_it]);
         center += rPoints[*cv_it];
     }
@@ -1930,28 +2072,22 @@ float MeshRefPointToPoints::GetAverageEdgeLength(PointIndex index) const
 {
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     float len=0.0f;
-    const std::set<PointIndex>& n = (*this)[index];
+    MeshIndexRange n = (*this)[index];
     const Base::Vector3f& p = rPoints[index];
-    for (std::set<PointIndex>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshIndexRange::const_iterator it = n.begin(); it != n.end(); ++it) {
         len += Base::Distance(p, rPoints[*it]);
     }
     return (len/n.size());
 }
 
-const std::set<PointIndex>&
-MeshRefPointToPoints::operator[] (PointIndex pos) const
-{
-    return _map[pos];
-}
-
 void MeshRefPointToPoints::AddNeighbour(PointIndex pos, PointIndex facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToPoints::RemoveNeighbour(PointIndex pos, PointIndex facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 //----------------------------------------------------------------------------
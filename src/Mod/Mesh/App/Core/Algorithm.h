@@ -23,10 +23,14 @@
 #ifndef MESHALGORITHM_H
 #define MESHALGORITHM_H
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
+#include "BVH.h"
 #include "Elements.h"
 #include "MeshKernel.h"
 
@@ -55,7 +59,7 @@ class MeshExport MeshAlgorithm
 {
 public:
   /// Construction
-  explicit MeshAlgorithm (const MeshKernel &rclM) : _rclMesh(rclM) { }
+  explicit MeshAlgorithm (const MeshKernel &rclM) : _rclMesh(rclM) { rclM.Unpack(); }
   /// Destruction
   ~MeshAlgorithm () { }
 
@@ -121,6 +125,16 @@ public:
    * If the vertex is visible true is returned, false otherwise.
    */
   bool IsVertexVisible (const Base::Vector3f &rcVertex, const Base::Vector3f &rcView, const MeshFacetGrid &rclGrid ) const;
+  /**
+   * Searches for the nearest facet hit by each of the rays (\a rclPts, \a rclDirs) and writes one
+   * entry per ray to \a rclHits. The angle between a ray and the normal of the hit facet must be less
+   * than or equal to \a fMaxAngle. Other than NearestFacetOnRay only facets in front of the ray origin
+   * are hit. If \a rclPts has a single point all rays start there.
+   * \note The rays are cast in packets through a bounding volume hierarchy of the mesh and the packets
+   * run in parallel. So this method should be used instead of NearestFacetOnRay for many rays.
+   */
+  void NearestFacetsOnRays (const std::vector<Base::Vector3f> &rclPts, const std::vector<Base::Vector3f> &rclDirs,
+                            float fMaxAngle, std::vector<MeshFacetBVH::RayHit> &rclHits) const;
   /**
    * Calculates the average length of edges.
    */
@@ -381,6 +395,92 @@ private:
     std::vector<FacetIndex>& indices;
 };
 
+/**
+ * The MeshIndexRange class is a read-only view of the sorted, unique indices the
+ * MeshRef* structures store for one element.
+ * \note The view becomes invalid when the structure it was taken from is rebuilt or
+ * the element's indices get modified.
+ */
+class MeshExport MeshIndexRange
+{
+public:
+    using value_type = ElementIndex;
+    using const_iterator = const ElementIndex*;
+
+    MeshIndexRange() : _first(nullptr), _last(nullptr)
+    { }
+    MeshIndexRange(const ElementIndex* first, const ElementIndex* last) : _first(first), _last(last)
+    { }
+
+    const_iterator begin() const
+    { return _first; }
+    const_iterator end() const
+    { return _last; }
+    std::size_t size() const
+    { return static_cast<std::size_t>(_last - _first); }
+    bool empty() const
+    { return _first == _last; }
+    /// Returns the position of \a index or end() if it's not part of the range.
+    const_iterator find(ElementIndex index) const
+    {
+        const_iterator it = std::lower_bound(_first, _last, index);
+        return (it != _last && *it == index) ? it : _last;
+    }
+    std::size_t count(ElementIndex index) const
+    { return find(index) != _last ? 1 : 0; }
+
+private:
+    const ElementIndex* _first;
+    const ElementIndex* _last;
+};
+
+/**
+ * The MeshNeighbourhood class stores the sorted neighbour indices of all elements of a
+ * mesh in compressed row form, i.e. an offset array and one contiguous index array.
+ * Elements whose indices get modified afterwards are moved into an overlay so that the
+ * few algorithms changing the topology can keep the structure up to date.
+ */
+class MeshExport MeshNeighbourhood
+{
+public:
+    /// Appends the indices of one element to the passed array.
+    using RowFunction = std::function<void (ElementIndex, std::vector<ElementIndex>&)>;
+
+    /// Removes all elements.
+    void Clear();
+    /// Builds up the data structure of \a ulCtRows elements in parallel. The indices
+    /// \a row appends for an element get sorted and duplicates are removed.
+    void Build(ElementIndex ulCtRows, const RowFunction& row);
+    /// Takes over already computed offsets and indices.
+    void Assign(std::vector<ElementIndex>& offsets, std::vector<ElementIndex>& indices);
+    /// Returns the number of elements.
+    ElementIndex Size() const
+    { return _offsets.empty() ? 0 : static_cast<ElementIndex>(_offsets.size() - 1); }
+    /// Returns the indices of element \a pos.
+    MeshIndexRange operator[] (ElementIndex pos) const
+    {
+        if (!_overlay.empty()) {
+            auto it = _overlay.find(pos);
+            if (it != _overlay.end())
+                return MeshIndexRange(it->second.data(), it->second.data() + it->second.size());
+        }
+        const ElementIndex* data = _indices.data();
+        return MeshIndexRange(data + _offsets[pos], data + _offsets[pos + 1]);
+    }
+    /// Adds \a index to the indices of element \a pos.
+    void Insert(ElementIndex pos, ElementIndex index);
+    /// Removes \a index from the indices of element \a pos.
+    void Erase(ElementIndex pos, ElementIndex index);
+
+private:
+    std::vector<ElementIndex>& Modify(ElementIndex pos);
+
+private:
+    std::vector<ElementIndex> _offsets;
+    std::vector<ElementIndex> _indices;
+    std::unordered_map<ElementIndex, std::vector<ElementIndex> > _overlay;
+};
+
 /**
  * The MeshRefPointToFacets builds up a structure to have access to all facets indexing
  * a point.
@@ -399,7 +499,8 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild ();
-    const std::set<FacetIndex>& operator[] (PointIndex) const;
+    MeshIndexRange operator[] (PointIndex pos) const
+    { return _map[pos]; }
     std::vector<FacetIndex> GetIndices(PointIndex, PointIndex) const;
     std::vector<FacetIndex> GetIndices(PointIndex, PointIndex, PointIndex) const;
     MeshFacetArray::_TConstIterator GetFacet (FacetIndex) const;
@@ -417,7 +518,7 @@ protected:
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<FacetIndex> > _map;
+    MeshNeighbourhood _map;
 };
 
 /**
@@ -438,15 +539,16 @@ public:
     /// Rebuilds up data structure
     void Rebuild ();
 
-    /// Returns a set of facets sharing one or more points with the facet with
-    /// index \a ulFacetIndex.
-    const std::set<FacetIndex>& operator[] (FacetIndex) const;
+    /// Returns the facets sharing one or more points with the facet with
+    /// index \a pos.
+    MeshIndexRange operator[] (FacetIndex pos) const
+    { return _map[pos]; }
     /// Returns an array of common facets of the passed facet indexes.
     std::vector<FacetIndex> GetIndices(FacetIndex, FacetIndex) const;
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<FacetIndex> > _map;
+    MeshNeighbourhood _map;
 };
 
 /**
@@ -467,7 +569,8 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild ();
-    const std::set<PointIndex>& operator[] (PointIndex) const;
+    MeshIndexRange operator[] (PointIndex pos) const
+    { return _map[pos]; }
     Base::Vector3f GetNormal(PointIndex) const;
     float GetAverageEdgeLength(PointIndex) const;
     void AddNeighbour(PointIndex, PointIndex);
@@ -475,7 +578,7 @@ public:
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<PointIndex> > _map;
+    MeshNeighbourhood _map;
 };
 
 /**
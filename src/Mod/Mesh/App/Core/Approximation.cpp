@@ -140,28 +140,71 @@ PlaneFit::PlaneFit()
   , _vDirV(0,1,0)
   , _vDirW(0,0,1)
 {
+    ResetSums();
+}
+
+PlaneFit::PlaneFit(const PlaneFit& fit)
+  : Approximation(fit)
+  , _vBase(fit._vBase)
+  , _vDirU(fit._vDirU)
+  , _vDirV(fit._vDirV)
+  , _vDirW(fit._vDirW)
+{
+    // the iterator refers to the list of the other object
+    ResetSums();
+}
+
+PlaneFit& PlaneFit::operator=(const PlaneFit& fit)
+{
+    if (this != &fit) {
+        Approximation::operator=(fit);
+        _vBase = fit._vBase;
+        _vDirU = fit._vDirU;
+        _vDirV = fit._vDirV;
+        _vDirW = fit._vDirW;
+        ResetSums();
+    }
+    return *this;
 }
 
 PlaneFit::~PlaneFit()
 {
 }
 
+void PlaneFit::ResetSums()
+{
+    _sxx = _sxy = _sxz = _syy = _syz = _szz = _mx = _my = _mz = 0.0;
+    _ulSummed = 0;
+}
+
+void PlaneFit::Clear()
+{
+    Approximation::Clear();
+    ResetSums();
+}
+
 float PlaneFit::Fit()
 {
     _bIsFitted = true;
     if (CountPoints() < 3)
         return FLOAT_MAX;
 
-    double sxx,sxy,sxz,syy,syz,szz,mx,my,mz;
-    sxx=sxy=sxz=syy=syz=szz=mx=my=mz=0.0;
-
-    for (std::list<Base::Vector3f>::iterator it = _vPoints.begin(); it!=_vPoints.end(); ++it) {
-        sxx += double(it->x * it->x); sxy += double(it->x * it->y);
-        sxz += double(it->x * it->z); syy += double(it->y * it->y);
-        syz += double(it->y * it->z); szz += double(it->z * it->z);
-        mx  += double(it->x); my += double(it->y); mz += double(it->z);
+    // only the points added since the last fit must be summed up
+    std::list<Base::Vector3f>::const_iterator it = _vPoints.begin();
+    if (_ulSummed > 0)
+        it = std::next(_itSummed);
+    for (; it!=_vPoints.end(); ++it) {
+        _sxx += double(it->x * it->x); _sxy += double(it->x * it->y);
+        _sxz += double(it->x * it->z); _syy += double(it->y * it->y);
+        _syz += double(it->y * it->z); _szz += double(it->z * it->z);
+        _mx  += double(it->x); _my += double(it->y); _mz += double(it->z);
+        _itSummed = it;
+        _ulSummed++;
     }
 
+    double sxx = _sxx, sxy = _sxy, sxz = _sxz, syy = _syy, syz = _syz, szz = _szz;
+    double mx = _mx, my = _my, mz = _mz;
+
     size_t nSize = _vPoints.size();
     sxx = sxx - mx*mx/(double(nSize));
     sxy = sxy - mx*my/(double(nSize));
@@ -382,6 +425,8 @@ void PlaneFit::ProjectToPlane ()
         float fD = (cPnt - cGravity) * cNormal;
         cPnt = cPnt - fD * cNormal;
     }
+
+    ResetSums();
 }
 
 void PlaneFit::Dimension(float& length, float& width) const
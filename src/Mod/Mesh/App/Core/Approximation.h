@@ -148,7 +148,7 @@ public:
     /**
      * Deletes the inserted points and frees any allocated resources.
      */
-    void Clear();
+    virtual void Clear();
     /**
      * Returns the result of the last fit.
      * @return float Quality of the last fit.
@@ -188,10 +188,13 @@ public:
      * Construction
      */
     PlaneFit();
+    PlaneFit(const PlaneFit&);
+    PlaneFit& operator=(const PlaneFit&);
     /**
      * Destruction
      */
     ~PlaneFit() override;
+    void Clear() override;
     Base::Vector3f GetBase() const;
     Base::Vector3f GetDirU() const;
     Base::Vector3f GetDirV() const;
@@ -203,6 +206,8 @@ public:
     /**
      * Fit a plane into the given points. We must have at least three non-collinear points
      * to succeed. If the fit fails FLOAT_MAX is returned.
+     * The sums over the points are kept, so that a fit after adding further points only
+     * has to process the new ones. This makes growing a region point by point linear.
      */
     float Fit() override;
     /**
@@ -246,6 +251,15 @@ protected:
     Base::Vector3f _vDirU;
     Base::Vector3f _vDirV;
     Base::Vector3f _vDirW; /**< Normal of the plane. */
+
+private:
+    void ResetSums();
+
+private:
+    // Sums of the first _ulSummed points, _itSummed refers to the last of them
+    double _sxx, _sxy, _sxz, _syy, _syz, _szz, _mx, _my, _mz;
+    std::size_t _ulSummed;
+    std::list<Base::Vector3f>::const_iterator _itSummed;
 };
 
 // -------------------------------------------------------------------------------
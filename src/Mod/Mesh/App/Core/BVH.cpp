@@ -0,0 +1,700 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <cmath>
+# include <limits>
+# include <memory>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Sequencer.h>
+
+#include "BVH.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+/// Maximum number of facets of a leaf.
+const std::size_t LeafSize = 4;
+/// Subtrees with at least this number of facets are built in parallel.
+const std::size_t ParallelSize = 65536;
+/// Number of bits per axis of the Morton codes.
+const int MortonBits = 21;
+/// Number of rays traversing the hierarchy together.
+const int PacketSize = 8;
+/// Number of rays a thread processes at least.
+const std::size_t RayBlockSize = 1024;
+
+/// Spreads the lower 21 bits of \a v so that two zero bits follow each bit.
+std::uint64_t spreadBits(std::uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+bool sharePoint(const MeshFacet& rclF1, const MeshFacet& rclF2)
+{
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            if (rclF1._aulPoints[i] == rclF2._aulPoints[j])
+                return true;
+        }
+    }
+    return false;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Traverses the hierarchies of two meshes, or twice the same hierarchy for
+ * the self-intersection, and tests the facets of overlapping leaves.
+ */
+class MeshFacetBVH::Traversal
+{
+public:
+    Traversal(const MeshFacetBVH& bvh1, const MeshFacetBVH& bvh2, bool stopAtFirst)
+        : _bvh1(bvh1)
+        , _bvh2(bvh2)
+        , _self(&bvh1 == &bvh2)
+        , _stopAtFirst(stopAtFirst)
+        , _stop(false)
+    {
+    }
+
+    bool Overlap(std::uint32_t n1, std::uint32_t n2) const
+    {
+        return _bvh1._nodes[n1].box && _bvh2._nodes[n2].box;
+    }
+
+    /// Lets all running traversals return as soon as possible.
+    void Stop()
+    {
+        _stop = true;
+    }
+
+    /// Appends the overlapping child pairs of \a pair to \a pairs, or \a pair itself
+    /// if it cannot be split anymore. Returns true if the pair has been split.
+    bool Expand(const NodePair& pair, std::vector<NodePair>& pairs) const
+    {
+        const Node& n1 = _bvh1._nodes[pair.first];
+        const Node& n2 = _bvh2._nodes[pair.second];
+        if (_self && pair.first == pair.second) {
+            if (n1.count > 0) {
+                pairs.push_back(pair);
+                return false;
+            }
+            std::uint32_t left = pair.first + 1;
+            std::uint32_t right = n1.index;
+            pairs.emplace_back(left, left);
+            if (Overlap(left, right))
+                pairs.emplace_back(left, right);
+            pairs.emplace_back(right, right);
+            return true;
+        }
+
+        if (n1.count > 0 && n2.count > 0) {
+            pairs.push_back(pair);
+            return false;
+        }
+
+        // descend into the larger node
+        bool first = n2.count > 0 ||
+            (n1.count == 0 && n1.box.CalcDiagonalLength() >= n2.box.CalcDiagonalLength());
+        if (first) {
+            std::uint32_t children[2] = {pair.first + 1, n1.index};
+            for (std::uint32_t child : children) {
+                if (Overlap(child, pair.second))
+                    pairs.emplace_back(child, pair.second);
+            }
+        }
+        else {
+            std::uint32_t children[2] = {pair.second + 1, n2.index};
+            for (std::uint32_t child : children) {
+                if (Overlap(pair.first, child))
+                    pairs.emplace_back(pair.first, child);
+            }
+        }
+        return true;
+    }
+
+    /// Traverses the subtrees of \a pair and appends the found intersections to \a result.
+    void Run(const NodePair& pair, std::vector<NodePair>& stack,
+             std::vector<Intersection>& result)
+    {
+        stack.clear();
+        stack.push_back(pair);
+        while (!stack.empty() && !_stop) {
+            NodePair top = stack.back();
+            stack.pop_back();
+            std::size_t size = stack.size();
+            if (!Expand(top, stack)) {
+                stack.resize(size);
+                TestLeaves(top, result);
+            }
+        }
+    }
+
+    /// Tests all facets of two leaves against each other.
+    void TestLeaves(const NodePair& pair, std::vector<Intersection>& result)
+    {
+        const MeshKernel& rclMesh1 = _bvh1._rclMesh;
+        const MeshKernel& rclMesh2 = _bvh2._rclMesh;
+        const MeshFacetArray& rFacets = rclMesh1.GetFacets();
+        const Node& n1 = _bvh1._nodes[pair.first];
+        const Node& n2 = _bvh2._nodes[pair.second];
+        bool sameLeaf = _self && pair.first == pair.second;
+
+        Base::Vector3f pt1, pt2;
+        for (std::uint32_t i = n1.index; i < n1.index + n1.count; i++) {
+            FacetIndex f1 = _bvh1._facets[i];
+            bool loaded = false;
+            MeshGeomFacet facet1;
+            std::uint32_t j = sameLeaf ? i + 1 : n2.index;
+            for (; j < n2.index + n2.count; j++) {
+                if (!(_bvh1._boxes[i] && _bvh2._boxes[j]))
+                    continue;
+                FacetIndex f2 = _bvh2._facets[j];
+                // Facets sharing a point usually don't intersect each other but the
+                // test below would detect false-positives for them.
+                if (_self && sharePoint(rFacets[f1], rFacets[f2]))
+                    continue;
+                if (!loaded) {
+                    facet1 = rclMesh1.GetFacet(f1);
+                    loaded = true;
+                }
+                MeshGeomFacet facet2 = rclMesh2.GetFacet(f2);
+                // the test isn't symmetric for nearly degenerate cases, so test the pairs
+                // of the same mesh always in the same order
+                int ret = (_self && f2 < f1) ? facet2.IntersectWithFacet(facet1, pt1, pt2)
+                                             : facet1.IntersectWithFacet(facet2, pt1, pt2);
+                if (ret == 2) {
+                    Intersection section;
+                    section.f1 = f1;
+                    section.f2 = f2;
+                    section.p1 = pt1;
+                    section.p2 = pt2;
+                    result.push_back(section);
+                    if (_stopAtFirst) {
+                        _stop = true;
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const MeshFacetBVH& _bvh1;
+    const MeshFacetBVH& _bvh2;
+    bool _self;
+    bool _stopAtFirst;
+    std::atomic<bool> _stop;
+};
+
+// ----------------------------------------------------------------------------
+
+/**
+ * A packet of rays in structure-of-arrays layout so that the box tests of all
+ * rays compile to vector instructions. Unused slots have a negative distance
+ * which fails every box test.
+ */
+struct MeshFacetBVH::RayPacket
+{
+    float org[3][PacketSize];
+    float dir[3][PacketSize];
+    float inv[3][PacketSize];
+    /// The distance of the nearest hit so far.
+    float dist[PacketSize];
+    float u[PacketSize];
+    float v[PacketSize];
+    FacetIndex facet[PacketSize];
+    /// The sum of all directions to decide which child to visit first.
+    float mean[3];
+    /// The cosine of the maximum angle between ray and facet normal.
+    float cosMaxAngle;
+    bool checkAngle;
+
+    explicit RayPacket(float fMaxAngle)
+    {
+        cosMaxAngle = std::cos(fMaxAngle);
+        checkAngle = fMaxAngle < Mathf::PI;
+        mean[0] = mean[1] = mean[2] = 0.0f;
+        for (int i = 0; i < PacketSize; i++) {
+            for (int j = 0; j < 3; j++) {
+                org[j][i] = 0.0f;
+                dir[j][i] = 0.0f;
+                inv[j][i] = 0.0f;
+            }
+            dist[i] = -1.0f;
+            u[i] = v[i] = 0.0f;
+            facet[i] = FACET_INDEX_MAX;
+        }
+        // no facet has a negative angle to the ray
+        if (fMaxAngle < 0.0f)
+            cosMaxAngle = 2.0f;
+    }
+
+    void SetRay(int i, const Base::Vector3f& pnt, Base::Vector3f dir3)
+    {
+        float len = dir3.Length();
+        facet[i] = FACET_INDEX_MAX;
+        dist[i] = -1.0f;
+        if (len <= 0.0f || !std::isfinite(len))
+            return;
+        dir3 /= len;
+        const float coords[3] = {dir3.x, dir3.y, dir3.z};
+        const float origin[3] = {pnt.x, pnt.y, pnt.z};
+        for (int j = 0; j < 3; j++) {
+            org[j][i] = origin[j];
+            dir[j][i] = coords[j];
+            // a huge instead of an infinite inverse avoids 0 * inf for rays in box planes
+            float d = coords[j] != 0.0f ? coords[j] : 1e-30f;
+            inv[j][i] = 1.0f / d;
+            mean[j] += coords[j];
+        }
+        dist[i] = std::numeric_limits<float>::max();
+    }
+
+    /// Sets \a mask for all rays hitting \a box before their nearest hit.
+    /// Returns true if at least one ray hits it.
+    bool Hit(const Base::BoundBox3f& box, bool* mask) const
+    {
+        const float lo[3] = {box.MinX, box.MinY, box.MinZ};
+        const float hi[3] = {box.MaxX, box.MaxY, box.MaxZ};
+        int hits = 0;
+        for (int i = 0; i < PacketSize; i++) {
+            float tnear = 0.0f;
+            float tfar = dist[i];
+            for (int j = 0; j < 3; j++) {
+                float t0 = (lo[j] - org[j][i]) * inv[j][i];
+                float t1 = (hi[j] - org[j][i]) * inv[j][i];
+                tnear = std::max(tnear, std::min(t0, t1));
+                tfar = std::min(tfar, std::max(t0, t1));
+            }
+            mask[i] = tnear <= tfar;
+            hits += mask[i] ? 1 : 0;
+        }
+        return hits > 0;
+    }
+
+    /// Intersects the rays set in \a mask with the facet \a index.
+    void Intersect(const MeshGeomFacet& facet3, FacetIndex index, const bool* mask)
+    {
+        const Base::Vector3f& p0 = facet3._aclPoints[0];
+        Base::Vector3f e1 = facet3._aclPoints[1] - p0;
+        Base::Vector3f e2 = facet3._aclPoints[2] - p0;
+        Base::Vector3f n = e1 % e2;
+        float nn = n * n;
+        float len = std::sqrt(nn);
+        for (int i = 0; i < PacketSize; i++) {
+            if (!mask[i])
+                continue;
+            Base::Vector3f d(dir[0][i], dir[1][i], dir[2][i]);
+            // the same criteria as MeshGeomFacet::Foraminate
+            float nd = n * d;
+            if (checkAngle && nd < cosMaxAngle * len)
+                continue;
+            if (nd * nd <= 1e-06f * nn)
+                continue;
+
+            // Moeller-Trumbore, det is -nd
+            Base::Vector3f pvec = d % e2;
+            float invDet = 1.0f / (e1 * pvec);
+            Base::Vector3f s = Base::Vector3f(org[0][i], org[1][i], org[2][i]) - p0;
+            float bu = (s * pvec) * invDet;
+            if (bu < 0.0f || bu > 1.0f)
+                continue;
+            Base::Vector3f q = s % e1;
+            float bv = (d * q) * invDet;
+            if (bv < 0.0f || bu + bv > 1.0f)
+                continue;
+            float t = (e2 * q) * invDet;
+            if (t < 0.0f || t > dist[i])
+                continue;
+            // independent of the traversal order keep the lowest index of equally near facets
+            if (t == dist[i] && index > facet[i])
+                continue;
+            dist[i] = t;
+            u[i] = bu;
+            v[i] = bv;
+            facet[i] = index;
+        }
+    }
+
+    void GetHit(int i, RayHit& hit) const
+    {
+        hit.facet = facet[i];
+        hit.u = u[i];
+        hit.v = v[i];
+        hit.distance = facet[i] != FACET_INDEX_MAX ? dist[i] : 0.0f;
+    }
+};
+
+// ----------------------------------------------------------------------------
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclMesh)
+  : _rclMesh(rclMesh)
+{
+    Build();
+}
+
+MeshFacetBVH::~MeshFacetBVH() = default;
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    if (_nodes.empty())
+        return Base::BoundBox3f();
+    return _nodes.front().box;
+}
+
+void MeshFacetBVH::Build()
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t count = rFacets.size();
+    if (count == 0)
+        return;
+    // the nodes use 32-bit indices and there are less than twice as many nodes as facets
+    if (count > UINT32_MAX / 2)
+        throw Base::ValueError("Too many facets for a bounding volume hierarchy");
+
+    // the boxes of the facets and the box of their centers
+    std::vector<Base::BoundBox3f> boxes(count);
+    std::vector<Base::BoundBox3f> centers(parallel_block_count(count, 4096));
+    parallel_blocks(count, 4096, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& rFace = rFacets[i];
+            Base::BoundBox3f& box = boxes[i];
+            box.Add(rPoints[rFace._aulPoints[0]]);
+            box.Add(rPoints[rFace._aulPoints[1]]);
+            box.Add(rPoints[rFace._aulPoints[2]]);
+            centers[block].Add(box.GetCenter());
+        }
+    });
+    Base::BoundBox3f bounds;
+    for (const auto& it : centers)
+        bounds.Add(it);
+
+    // sort the facets along the Morton curve of their centers
+    const float maxCell = static_cast<float>((1 << MortonBits) - 1);
+    auto scale = [maxCell](float length) {
+        return length > 0.0f ? maxCell / length : 0.0f;
+    };
+    float sx = scale(bounds.LengthX());
+    float sy = scale(bounds.LengthY());
+    float sz = scale(bounds.LengthZ());
+    auto cell = [maxCell](float value) {
+        return static_cast<std::uint64_t>(std::min(std::max(value, 0.0f), maxCell));
+    };
+
+    std::vector<std::pair<std::uint64_t, FacetIndex> > keys(count);
+    parallel_blocks(count, 4096, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Base::Vector3f center = boxes[i].GetCenter();
+            std::uint64_t x = cell((center.x - bounds.MinX) * sx);
+            std::uint64_t y = cell((center.y - bounds.MinY) * sy);
+            std::uint64_t z = cell((center.z - bounds.MinZ) * sz);
+            keys[i].first = (spreadBits(x) << 2) | (spreadBits(y) << 1) | spreadBits(z);
+            keys[i].second = i;
+        }
+    });
+
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_sort(keys.begin(), keys.end(),
+                            std::less<std::pair<std::uint64_t, FacetIndex> >(), threads);
+
+    std::vector<std::uint64_t> codes(count);
+    _facets.resize(count);
+    _boxes.resize(count);
+    parallel_blocks(count, 4096, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            codes[i] = keys[i].first;
+            _facets[i] = keys[i].second;
+            _boxes[i] = boxes[keys[i].second];
+        }
+    });
+
+    keys.clear();
+    keys.shrink_to_fit();
+    boxes.clear();
+    boxes.shrink_to_fit();
+
+    _nodes.reserve(2 * count / LeafSize + 1);
+    BuildRange(0, count, codes, _nodes);
+}
+
+std::size_t MeshFacetBVH::FindSplit(std::size_t first, std::size_t last,
+                                    const std::vector<std::uint64_t>& codes)
+{
+    std::uint64_t diff = codes[first] ^ codes[last - 1];
+    if (diff == 0)
+        return first + (last - first) / 2;
+
+    // The codes of the range share all bits above the highest differing bit,
+    // so the facets with this bit set follow all the others.
+    std::uint64_t bit = 1;
+    while (diff >>= 1)
+        bit <<= 1;
+    auto it = std::partition_point(codes.begin() + first, codes.begin() + last,
+                                   [bit](std::uint64_t code) {
+        return (code & bit) == 0;
+    });
+    return static_cast<std::size_t>(it - codes.begin());
+}
+
+void MeshFacetBVH::BuildRange(std::size_t first, std::size_t last,
+                              const std::vector<std::uint64_t>& codes, Nodes& nodes) const
+{
+    if (last - first <= LeafSize) {
+        Node leaf;
+        leaf.index = static_cast<std::uint32_t>(first);
+        leaf.count = static_cast<std::uint32_t>(last - first);
+        for (std::size_t i = first; i < last; i++)
+            leaf.box.Add(_boxes[i]);
+        nodes.push_back(leaf);
+        return;
+    }
+
+    std::size_t split = FindSplit(first, last, codes);
+    std::size_t parent = nodes.size();
+    nodes.emplace_back();
+    nodes[parent].count = 0;
+
+    if (last - first >= ParallelSize) {
+        // build the left subtree in another thread and append both subtrees
+        Nodes left;
+        QFuture<void> future = QtConcurrent::run([&]() {
+            BuildRange(first, split, codes, left);
+        });
+        Nodes right;
+        BuildRange(split, last, codes, right);
+        future.waitForFinished();
+
+        auto append = [&nodes](const Nodes& subtree) {
+            std::uint32_t offset = static_cast<std::uint32_t>(nodes.size());
+            for (Node node : subtree) {
+                if (node.count == 0)
+                    node.index += offset;
+                nodes.push_back(node);
+            }
+        };
+        append(left);
+        nodes[parent].index = static_cast<std::uint32_t>(nodes.size());
+        append(right);
+    }
+    else {
+        BuildRange(first, split, codes, nodes);
+        nodes[parent].index = static_cast<std::uint32_t>(nodes.size());
+        BuildRange(split, last, codes, nodes);
+    }
+
+    Node& node = nodes[parent];
+    node.box = nodes[parent + 1].box;
+    node.box.Add(nodes[node.index].box);
+}
+
+void MeshFacetBVH::Intersect(const MeshFacetBVH& rclOther, bool stopAtFirst,
+                             std::vector<Intersection>& result, const char* progress) const
+{
+    result.clear();
+    if (_nodes.empty() || rclOther._nodes.empty())
+        return;
+
+    Traversal traversal(*this, rclOther, stopAtFirst);
+    if (!traversal.Overlap(0, 0))
+        return;
+
+    // Split the traversal into enough independent node pairs to keep all threads busy.
+    std::size_t threads = static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    std::vector<NodePair> tasks, next;
+    tasks.emplace_back(0, 0);
+    bool expanded = true;
+    while (expanded && tasks.size() < 64 * threads) {
+        expanded = false;
+        next.clear();
+        for (const auto& it : tasks) {
+            if (traversal.Expand(it, next))
+                expanded = true;
+        }
+        tasks.swap(next);
+    }
+
+    // The sequencer is only used by the calling thread which runs the first block
+    // and reports the pairs finished by all threads.
+    std::unique_ptr<Base::SequencerLauncher> seq;
+    if (progress)
+        seq.reset(new Base::SequencerLauncher(progress, tasks.size()));
+    std::atomic<std::size_t> finished(0);
+    std::size_t reported = 0;
+    auto report = [&]() {
+        for (std::size_t count = finished; reported < count; reported++)
+            seq->next(true);
+    };
+
+    // The pairs differ a lot in their costs, so each thread fetches the next pending pair.
+    std::vector<std::vector<Intersection> > found(tasks.size());
+    std::atomic<std::size_t> pending(0);
+    parallel_blocks(tasks.size(), 1, [&](std::size_t block, std::size_t, std::size_t) {
+        std::vector<NodePair> stack;
+        try {
+            for (std::size_t i = pending++; i < tasks.size(); i = pending++) {
+                traversal.Run(tasks[i], stack, found[i]);
+                finished++;
+                if (seq && block == 0)
+                    report();
+            }
+        }
+        catch (...) {
+            // the other threads don't need to finish their pairs
+            traversal.Stop();
+            throw;
+        }
+    });
+    if (seq)
+        report();
+
+    for (const auto& it : found)
+        result.insert(result.end(), it.begin(), it.end());
+}
+
+bool MeshFacetBVH::HasSelfIntersection() const
+{
+    std::vector<Intersection> result;
+    Intersect(*this, true, result, "Checking for self-intersections...");
+    return !result.empty();
+}
+
+void MeshFacetBVH::GetSelfIntersections(std::vector<Intersection>& result) const
+{
+    Intersect(*this, false, result, "Checking for self-intersections...");
+    for (auto& it : result) {
+        if (it.f1 > it.f2)
+            std::swap(it.f1, it.f2);
+    }
+    std::sort(result.begin(), result.end(), [](const Intersection& a, const Intersection& b) {
+        return a.f1 < b.f1 || (a.f1 == b.f1 && a.f2 < b.f2);
+    });
+}
+
+bool MeshFacetBVH::HasIntersection(const MeshFacetBVH& rclOther) const
+{
+    std::vector<Intersection> result;
+    Intersect(rclOther, true, result);
+    return !result.empty();
+}
+
+void MeshFacetBVH::GetIntersections(const MeshFacetBVH& rclOther,
+                                    std::vector<Intersection>& result) const
+{
+    Intersect(rclOther, false, result);
+}
+
+void MeshFacetBVH::Cast(RayPacket& packet, std::vector<std::uint32_t>& stack) const
+{
+    if (_nodes.empty())
+        return;
+
+    bool mask[PacketSize];
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+        std::uint32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[index];
+        if (!packet.Hit(node.box, mask))
+            continue;
+
+        if (node.count > 0) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                FacetIndex facet = _facets[i];
+                packet.Intersect(_rclMesh.GetFacet(facet), facet, mask);
+            }
+            continue;
+        }
+
+        // visit the child first that lies ahead in the mean ray direction
+        std::uint32_t left = index + 1;
+        std::uint32_t right = node.index;
+        Base::Vector3f delta = _nodes[right].box.GetCenter() - _nodes[left].box.GetCenter();
+        float ahead = delta.x * packet.mean[0] + delta.y * packet.mean[1] + delta.z * packet.mean[2];
+        if (ahead >= 0.0f) {
+            stack.push_back(right);
+            stack.push_back(left);
+        }
+        else {
+            stack.push_back(left);
+            stack.push_back(right);
+        }
+    }
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt, const Base::Vector3f& rclDir,
+                                     float fMaxAngle, RayHit& rclHit) const
+{
+    RayPacket packet(fMaxAngle);
+    packet.SetRay(0, rclPt, rclDir);
+    std::vector<std::uint32_t> stack;
+    Cast(packet, stack);
+    packet.GetHit(0, rclHit);
+    return rclHit.facet != FACET_INDEX_MAX;
+}
+
+void MeshFacetBVH::NearestFacetsOnRays(const std::vector<Base::Vector3f>& rclPts,
+                                       const std::vector<Base::Vector3f>& rclDirs,
+                                       float fMaxAngle, std::vector<RayHit>& rclHits) const
+{
+    std::size_t count = rclDirs.size();
+    bool commonOrigin = rclPts.size() == 1;
+    if (!commonOrigin && rclPts.size() != count)
+        throw Base::ValueError("Number of ray origins and directions differ");
+
+    rclHits.resize(count);
+    parallel_blocks(count, RayBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::vector<std::uint32_t> stack;
+        for (std::size_t first = begin; first < end; first += PacketSize) {
+            int size = static_cast<int>(std::min<std::size_t>(PacketSize, end - first));
+            RayPacket packet(fMaxAngle);
+            for (int i = 0; i < size; i++) {
+                std::size_t ray = first + i;
+                packet.SetRay(i, commonOrigin ? rclPts.front() : rclPts[ray], rclDirs[ray]);
+            }
+            Cast(packet, stack);
+            for (int i = 0; i < size; i++)
+                packet.GetHit(i, rclHits[first + i]);
+        }
+    });
+}
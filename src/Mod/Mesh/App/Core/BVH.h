@@ -0,0 +1,168 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Elements.h"
+
+
+namespace MeshCore {
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh kernel.
+ * It's built as a linear BVH: the facets are sorted along a Morton curve of their box
+ * centers and the sorted range is split recursively at the highest differing bit of the
+ * Morton codes. The sorting and the subtrees near the root are processed in parallel.
+ *
+ * Compared to MeshFacetGrid it adapts to meshes with strongly varying facet sizes and
+ * doesn't report a facet pair more than once. The intersection queries traverse two trees
+ * at once and run the triangle-triangle tests of the independent subtrees in parallel.
+ * \note The hierarchy refers to the kernel and must be rebuilt if the kernel is modified.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// An intersection segment between two facets.
+    struct Intersection
+    {
+        FacetIndex f1, f2;
+        Base::Vector3f p1, p2;
+    };
+    /// The nearest hit of a ray with the mesh.
+    struct RayHit
+    {
+        /// The hit facet or FACET_INDEX_MAX if the ray misses the mesh.
+        FacetIndex facet;
+        /// The barycentric coordinates of the hit point with respect to the second
+        /// and third point of the facet.
+        float u, v;
+        /// The distance of the hit point from the origin of the ray.
+        float distance;
+    };
+
+    /** @name Construction */
+    //@{
+    explicit MeshFacetBVH(const MeshKernel& rclMesh);
+    ~MeshFacetBVH();
+    //@}
+
+    /** @name Querying */
+    //@{
+    const MeshKernel& GetMesh() const
+    { return _rclMesh; }
+    /// Returns the number of nodes of the hierarchy.
+    std::size_t CountNodes() const
+    { return _nodes.size(); }
+    /// Returns the bounding box of all facets.
+    Base::BoundBox3f GetBoundBox() const;
+    //@}
+
+    /** @name Intersection */
+    //@{
+    /** Checks whether two facets of the mesh intersect each other. Facets sharing a
+     * point are not checked. Stops at the first intersection found.
+     * Like GetSelfIntersections() it shows the progress and can be aborted.
+     */
+    bool HasSelfIntersection() const;
+    /** Collects all pairs of intersecting facets of the mesh. Facets sharing a point are
+     * not checked. The pairs are sorted and have f1 < f2.
+     */
+    void GetSelfIntersections(std::vector<Intersection>&) const;
+    /** Checks whether a facet of this mesh intersects a facet of the mesh of \a rclOther.
+     * Stops at the first intersection found.
+     */
+    bool HasIntersection(const MeshFacetBVH& rclOther) const;
+    /** Collects all pairs of intersecting facets where f1 refers to this mesh and f2 to
+     * the mesh of \a rclOther.
+     */
+    void GetIntersections(const MeshFacetBVH& rclOther, std::vector<Intersection>&) const;
+    //@}
+
+    /** @name Ray casting
+     * Only facets whose normal has an angle of at most \a fMaxAngle to the ray direction
+     * are hit. Unlike MeshGeomFacet::Foraminate the rays start at their origin, so facets
+     * behind it are never hit.
+     */
+    //@{
+    /** Searches for the nearest facet hit by the ray starting at \a rclPt in direction
+     * \a rclDir. Returns false if the ray misses the mesh.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt, const Base::Vector3f& rclDir,
+                           float fMaxAngle, RayHit& rclHit) const;
+    /** Searches for the nearest facet hit by each ray and writes one entry per ray to
+     * \a rclHits. If \a rclPts has a single point all rays start there, otherwise it must
+     * have as many points as \a rclDirs has directions.
+     * Consecutive rays traverse the hierarchy in packets that share the node tests, so
+     * coherent rays like the ones of a view should be passed in neighbouring order.
+     * The packets are distributed over all threads.
+     */
+    void NearestFacetsOnRays(const std::vector<Base::Vector3f>& rclPts,
+                             const std::vector<Base::Vector3f>& rclDirs,
+                             float fMaxAngle, std::vector<RayHit>& rclHits) const;
+    //@}
+
+private:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        /// For leaves the first entry in _facets, otherwise the right child.
+        /// The left child of an inner node always directly follows its parent.
+        std::uint32_t index;
+        /// For leaves the number of facets, zero for inner nodes.
+        std::uint32_t count;
+    };
+    using Nodes = std::vector<Node>;
+    using NodePair = std::pair<std::uint32_t, std::uint32_t>;
+    class Traversal;
+    struct RayPacket;
+
+    void Build();
+    void BuildRange(std::size_t first, std::size_t last,
+                    const std::vector<std::uint64_t>& codes, Nodes& nodes) const;
+    static std::size_t FindSplit(std::size_t first, std::size_t last,
+                                 const std::vector<std::uint64_t>& codes);
+    /// If \a progress is set a sequencer with this text is advanced per traversal block.
+    void Intersect(const MeshFacetBVH& rclOther, bool stopAtFirst,
+                   std::vector<Intersection>& result, const char* progress = nullptr) const;
+    void Cast(RayPacket& packet, std::vector<std::uint32_t>& stack) const;
+
+private:
+    const MeshKernel& _rclMesh;
+    Nodes _nodes;
+    /// The facet indices in Morton order, each leaf refers to a range of it.
+    std::vector<FacetIndex> _facets;
+    /// The bounding boxes of the facets in Morton order.
+    std::vector<Base::BoundBox3f> _boxes;
+
+    MeshFacetBVH(const MeshFacetBVH&) = delete;
+    void operator= (const MeshFacetBVH&) = delete;
+};
+
+} // namespace MeshCore
+
+#endif // MESH_BVH_H
@@ -24,6 +24,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cstdint>
 #endif
 
 #include <Base/Exception.h>
@@ -32,7 +33,6 @@
 #include "Builder.h"
 #include "Functional.h"
 #include "MeshKernel.h"
-#include <QVector>
 
 
 using namespace MeshCore;
@@ -40,6 +40,7 @@ using namespace MeshCore;
 
 MeshBuilder::MeshBuilder (MeshKernel& kernel) : _meshKernel(kernel), _seq(nullptr), _ptIdx(0)
 {
+    _meshKernel.Expand();
     _fSaveTolerance = MeshDefinitions::_fMinPointDistanceD1;
 }
 
@@ -267,7 +268,7 @@ struct MeshFastBuilder::Private {
         Vertex(float x, float y, float z) : x(x), y(y), z(z), i(0) {}
 
         float x, y, z;
-        size_type i;
+        std::uint32_t i;
 
         bool operator!=(const Vertex& rhs) const
         {
@@ -286,8 +287,16 @@ struct MeshFastBuilder::Private {
         }
     };
 
-    // Hint: Using a QVector instead of std::vector is a bit faster
-    QVector<Vertex> verts;
+    void Append(const Base::Vector3f& pnt)
+    {
+        if (verts.size() >= UINT32_MAX)
+            throw Base::ValueError("Too many facets");
+        Vertex v(pnt.x, pnt.y, pnt.z);
+        v.i = static_cast<std::uint32_t>(verts.size());
+        verts.push_back(v);
+    }
+
+    std::vector<Vertex> verts;
 };
 
 MeshFastBuilder::MeshFastBuilder(MeshKernel &rclM) : _meshKernel(rclM), p(new Private)
@@ -301,69 +310,93 @@ MeshFastBuilder::~MeshFastBuilder()
 
 void MeshFastBuilder::Initialize (size_type ctFacets)
 {
-    p->verts.reserve(ctFacets * 3);
+    p->verts.reserve(static_cast<std::size_t>(ctFacets) * 3);
 }
 
 void MeshFastBuilder::AddFacet (const Base::Vector3f* facetPoints)
 {
-    Private::Vertex v;
     for (int i=0; i<3; i++) {
-        v.x = facetPoints[i].x;
-        v.y = facetPoints[i].y;
-        v.z = facetPoints[i].z;
-        p->verts.push_back(v);
+        p->Append(facetPoints[i]);
     }
 }
 
 void MeshFastBuilder::AddFacet (const MeshGeomFacet& facetPoints)
 {
-    Private::Vertex v;
     for (int i=0; i<3; i++) {
-        v.x = facetPoints._aclPoints[i].x;
-        v.y = facetPoints._aclPoints[i].y;
-        v.z = facetPoints._aclPoints[i].z;
-        p->verts.push_back(v);
+        p->Append(facetPoints._aclPoints[i]);
     }
 }
 
+void MeshFastBuilder::AddFacets (std::size_t ctFacets, const std::function<void (std::size_t, Base::Vector3f*)>& readFacet)
+{
+    std::vector<Private::Vertex>& verts = p->verts;
+    std::size_t ulOffset = verts.size();
+    if (ulOffset + 3 * ctFacets > UINT32_MAX)
+        throw Base::ValueError("Too many facets");
+    verts.resize(ulOffset + 3 * ctFacets);
+
+    parallel_blocks(ctFacets, 10000, [&](std::size_t, std::size_t begin, std::size_t end) {
+        Base::Vector3f points[3];
+        for (std::size_t i = begin; i < end; i++) {
+            readFacet(i, points);
+            for (int j = 0; j < 3; j++) {
+                std::size_t k = ulOffset + 3 * i + j;
+                Private::Vertex& v = verts[k];
+                v.x = points[j].x;
+                v.y = points[j].y;
+                v.z = points[j].z;
+                v.i = static_cast<std::uint32_t>(k);
+            }
+        }
+    });
+}
+
 void MeshFastBuilder::Finish ()
 {
-    using size_type = QVector<Private::Vertex>::size_type;
-    QVector<Private::Vertex>& verts = p->verts;
-    size_type ulCtPts = verts.size();
-    for (size_type i=0; i < ulCtPts; ++i) {
-        verts[i].i = i;
-    }
+    std::vector<Private::Vertex>& verts = p->verts;
+    std::size_t ulCtPts = verts.size();
 
-    //std::sort(verts.begin(), verts.end());
     int threads = std::max(1, QThread::idealThreadCount());
     MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<Private::Vertex>(), threads);
 
-    QVector<FacetIndex> indices(ulCtPts);
+    // A new point starts wherever a vertex differs from its predecessor in the sorted array.
+    // Count the new points per block to know where each block starts numbering its points.
+    const std::size_t ulMinBlockSize = 100000;
+    std::vector<std::size_t> blockStart(parallel_block_count(ulCtPts, ulMinBlockSize) + 1, 0);
+    parallel_blocks(ulCtPts, ulMinBlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            if (i == 0 || verts[i] != verts[i-1])
+                count++;
+        }
+        blockStart[block + 1] = count;
+    });
+    for (std::size_t i = 1; i < blockStart.size(); i++)
+        blockStart[i] += blockStart[i - 1];
+
+    MeshPointArray rPoints(static_cast<PointIndex>(blockStart.back()));
+    std::vector<PointIndex> indices(ulCtPts);
+    parallel_blocks(ulCtPts, ulMinBlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::size_t index = blockStart[block];
+        for (std::size_t i = begin; i < end; i++) {
+            const Private::Vertex& v = verts[i];
+            if (i == 0 || v != verts[i-1])
+                rPoints[index++].Set(v.x, v.y, v.z);
+            indices[v.i] = static_cast<PointIndex>(index - 1);
+        }
+    });
 
-    size_type vertex_count = 0;
-    for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
-        if (!vertex_count || *v != verts[vertex_count-1])
-            verts[vertex_count++] = *v;
+    std::vector<Private::Vertex>().swap(verts);
 
-        indices[v->i] = static_cast<FacetIndex>(vertex_count - 1);
-    }
-
-    size_type ulCt = verts.size()/3;
+    std::size_t ulCt = ulCtPts / 3;
     MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
-    for (size_type i=0; i < ulCt; ++i) {
-        rFacets[static_cast<size_t>(i)]._aulPoints[0] = indices[3*i];
-        rFacets[static_cast<size_t>(i)]._aulPoints[1] = indices[3*i + 1];
-        rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3*i + 2];
-    }
-
-    verts.resize(vertex_count);
-
-    MeshPointArray rPoints;
-    rPoints.reserve(static_cast<size_t>(vertex_count));
-    for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
-        rPoints.push_back(MeshPoint(v->x, v->y, v->z));
-    }
+    parallel_blocks(ulCt, ulMinBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            rFacets[i]._aulPoints[0] = indices[3*i];
+            rFacets[i]._aulPoints[1] = indices[3*i + 1];
+            rFacets[i]._aulPoints[2] = indices[3*i + 2];
+        }
+    });
 
     _meshKernel.Adopt(rPoints, rFacets, true);
 }
@@ -23,6 +23,7 @@
 #ifndef MESH_BUILDER_H
 #define MESH_BUILDER_H
 
+#include <functional>
 #include <set>
 #include <vector>
 
@@ -203,8 +204,13 @@ public:
     /** Add new facet
      */
     void AddFacet (const MeshGeomFacet& facetPoints);
+    /** Adds \a ctFacets facets at once. The corner points of the i-th facet are requested
+     * with \a readFacet(i, points) in parallel, so \a readFacet must be thread-safe.
+     */
+    void AddFacets (std::size_t ctFacets, const std::function<void (std::size_t, Base::Vector3f*)>& readFacet);
 
     /** Finishes building up the mesh structure. Must be done after adding facets.
+     * Coincident points are merged in parallel.
      */
     void Finish ();
 
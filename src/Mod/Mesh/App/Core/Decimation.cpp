@@ -21,68 +21,66 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <cfloat>
+# include <climits>
+#endif
+
+#include <Base/Sequencer.h>
 
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-  : myKernel(mesh)
+namespace {
+
+/// Meshes with more than twice this number of facets are split into clusters.
+const std::size_t ClusterSize = 262144;
+/// Ranges with at least this number of facets are split in parallel.
+const std::size_t ParallelSize = 1048576;
+
+using FacetRange = std::pair<std::size_t, std::size_t>;
+
+void addVertex(Simplify& alg, const Base::Vector3f& p, bool locked)
 {
+    Simplify::Vertex v;
+    v.tstart = 0;
+    v.tcount = 0;
+    v.border = 0;
+    v.locked = locked ? 1 : 0;
+    v.p = p;
+    alg.vertices.push_back(v);
 }
 
-MeshSimplify::~MeshSimplify()
+void addTriangle(Simplify& alg, int v0, int v1, int v2)
 {
+    Simplify::Triangle t;
+    t.deleted = 0;
+    t.dirty = 0;
+    for (int j = 0; j < 4; j++)
+        t.err[j] = 0.0;
+    t.v[0] = v0;
+    t.v[1] = v1;
+    t.v[2] = v2;
+    alg.triangles.push_back(t);
 }
 
-void MeshSimplify::simplify(float tolerance, float reduction)
+void adoptMesh(const Simplify& alg, MeshKernel& kernel)
 {
-    Simplify alg;
-
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
-    }
-
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (int j = 0; j < 4; j++)
-            t.err[j] = 0.0;
-        for (int j = 0; j < 3; j++)
-            t.v[j] = facets[i]._aulPoints[j];
-        alg.triangles.push_back(t);
-    }
-
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0f-reduction));
-
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
-
-    // Simplification done
     MeshPointArray new_points;
     new_points.reserve(alg.vertices.size());
     for (std::size_t i = 0; i < alg.vertices.size(); i++) {
         new_points.push_back(alg.vertices[i].p);
     }
 
-    std::size_t numFacets = 0;
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted)
-            numFacets++;
-    }
     MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
+    new_facets.reserve(alg.triangles.size());
     for (std::size_t i = 0; i < alg.triangles.size(); i++) {
         if (!alg.triangles[i].deleted) {
             MeshFacet face;
@@ -93,61 +91,314 @@ void MeshSimplify::simplify(float tolerance, float reduction)
         }
     }
 
-    myKernel.Adopt(new_points, new_facets, true);
+    kernel.Adopt(new_points, new_facets, true);
 }
 
-void MeshSimplify::simplify(int targetSize)
+/// Splits the facets [first, last) at the median of their centers along the longest
+/// axis until no part has more than ClusterSize facets. The parts are appended to
+/// \a ranges in the order of \a facets.
+void splitRange(std::vector<FacetIndex>& facets, std::size_t first, std::size_t last,
+                const std::vector<Base::Vector3f>& centers, std::vector<FacetRange>& ranges)
+{
+    if (last - first <= ClusterSize) {
+        ranges.emplace_back(first, last);
+        return;
+    }
+
+    Base::BoundBox3f box;
+    for (std::size_t i = first; i < last; i++)
+        box.Add(centers[facets[i]]);
+    float length = std::max(box.LengthX(), std::max(box.LengthY(), box.LengthZ()));
+    float Base::Vector3f::* axis = &Base::Vector3f::z;
+    if (length == box.LengthX())
+        axis = &Base::Vector3f::x;
+    else if (length == box.LengthY())
+        axis = &Base::Vector3f::y;
+
+    std::size_t mid = first + (last - first) / 2;
+    std::nth_element(facets.begin() + first, facets.begin() + mid, facets.begin() + last,
+                     [&centers, axis](FacetIndex a, FacetIndex b) {
+        return centers[a].*axis < centers[b].*axis;
+    });
+
+    if (last - first >= ParallelSize) {
+        std::vector<FacetRange> left;
+        QFuture<void> future = QtConcurrent::run([&]() {
+            splitRange(facets, first, mid, centers, left);
+        });
+        std::vector<FacetRange> right;
+        splitRange(facets, mid, last, centers, right);
+        future.waitForFinished();
+        ranges.insert(ranges.end(), left.begin(), left.end());
+        ranges.insert(ranges.end(), right.begin(), right.end());
+    }
+    else {
+        splitRange(facets, first, mid, centers, ranges);
+        splitRange(facets, mid, last, centers, ranges);
+    }
+}
+
+/// The simplified facets of a cluster.
+struct Cluster
+{
+    FacetRange range;
+    /// The remaining points. Points shared with other clusters keep their index
+    /// in the kernel, the others have POINT_INDEX_MAX.
+    MeshPointArray points;
+    std::vector<PointIndex> shared;
+    /// Three indices to \a points per facet.
+    std::vector<int> triangles;
+};
+
+/// Simplifies the facets of a cluster with all shared points locked. It stops early
+/// once \a canceled is set.
+void simplifyCluster(const MeshKernel& kernel, const std::vector<FacetIndex>& facets,
+                     const std::vector<bool>& shared, std::size_t targetSize,
+                     double tolerance, double maxError, const std::atomic<bool>& canceled,
+                     Cluster& cluster)
 {
+    const MeshPointArray& rPoints = kernel.GetPoints();
+    const MeshFacetArray& rFacets = kernel.GetFacets();
+
+    std::vector<PointIndex> indices;
+    indices.reserve(3 * (cluster.range.second - cluster.range.first));
+    for (std::size_t i = cluster.range.first; i < cluster.range.second; i++) {
+        const MeshFacet& face = rFacets[facets[i]];
+        indices.insert(indices.end(), face._aulPoints, face._aulPoints + 3);
+    }
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
     Simplify alg;
+    alg.vertices.reserve(indices.size());
+    for (PointIndex index : indices)
+        addVertex(alg, rPoints[index], shared[index]);
+    auto local = [&indices](PointIndex index) {
+        return static_cast<int>(std::lower_bound(indices.begin(), indices.end(), index) - indices.begin());
+    };
+    alg.triangles.reserve(cluster.range.second - cluster.range.first);
+    for (std::size_t i = cluster.range.first; i < cluster.range.second; i++) {
+        const MeshFacet& face = rFacets[facets[i]];
+        addTriangle(alg, local(face._aulPoints[0]), local(face._aulPoints[1]), local(face._aulPoints[2]));
+    }
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    alg.max_error = maxError * maxError;
+    alg.canceled = [&canceled]() {
+        return canceled.load();
+    };
+    alg.simplify_mesh(static_cast<int>(targetSize), tolerance);
+
+    cluster.points.reserve(alg.vertices.size());
+    for (const auto& it : alg.vertices)
+        cluster.points.push_back(it.p);
+    cluster.shared.assign(alg.vertices.size(), POINT_INDEX_MAX);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        int index = alg.vertex_map[i];
+        if (index >= 0 && shared[indices[i]])
+            cluster.shared[index] = indices[i];
     }
+    cluster.triangles.reserve(3 * alg.triangles.size());
+    for (const auto& it : alg.triangles)
+        cluster.triangles.insert(cluster.triangles.end(), it.v, it.v + 3);
+}
+
+}
 
+// ----------------------------------------------------------------------------
+
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+  : myKernel(mesh)
+  , myKeepBoundary(false)
+{
+}
+
+MeshSimplify::~MeshSimplify()
+{
+}
+
+void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    std::size_t numFacets = myKernel.CountFacets();
+    int target_count = static_cast<int>(static_cast<float>(numFacets) * (1.0f-reduction));
+    simplify(static_cast<std::size_t>(std::max(target_count, 0)), tolerance, DBL_MAX);
+}
+
+void MeshSimplify::simplify(int targetSize)
+{
+    simplify(static_cast<std::size_t>(std::max(targetSize, 0)), FLT_MAX, DBL_MAX);
+}
+
+void MeshSimplify::simplify(int targetSize, float maxError)
+{
+    simplify(static_cast<std::size_t>(std::max(targetSize, 0)), FLT_MAX, maxError);
+}
+
+void MeshSimplify::simplify(std::size_t targetSize, double tolerance, double maxError)
+{
+    const MeshPointArray& points = myKernel.GetPoints();
     const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (int j = 0; j < 4; j++)
-            t.err[j] = 0.0;
-        for (int j = 0; j < 3; j++)
-            t.v[j] = facets[i]._aulPoints[j];
-        alg.triangles.push_back(t);
+    std::size_t numFacets = facets.size();
+
+    // the points of open edges
+    std::vector<bool> boundary(points.size(), false);
+    if (myKeepBoundary) {
+        for (const auto& face : facets) {
+            for (int i = 0; i < 3; i++) {
+                if (face._aulNeighbours[i] == FACET_INDEX_MAX)
+                    boundary[face._aulPoints[i]] = boundary[face._aulPoints[(i + 1) % 3]] = true;
+            }
+        }
     }
 
-    // Simplification starts
-    alg.simplify_mesh(targetSize, FLT_MAX);
+    if (numFacets <= 2 * ClusterSize) {
+        Simplify alg;
+        alg.vertices.reserve(points.size());
+        for (std::size_t i = 0; i < points.size(); i++)
+            addVertex(alg, points[i], boundary[i]);
+        alg.triangles.reserve(numFacets);
+        for (std::size_t i = 0; i < numFacets; i++) {
+            const MeshFacet& face = facets[i];
+            addTriangle(alg, face._aulPoints[0], face._aulPoints[1], face._aulPoints[2]);
+        }
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (std::size_t i = 0; i < alg.vertices.size(); i++) {
-        new_points.push_back(alg.vertices[i].p);
+        // Simplification starts
+        Base::SequencerLauncher seq("Simplifying mesh...", Simplify::max_iterations);
+        alg.max_error = maxError * maxError;
+        alg.canceled = [&seq]() {
+            seq.next(true);
+            return false;
+        };
+        alg.simplify_mesh(static_cast<int>(targetSize), tolerance);
+
+        // Simplification done
+        adoptMesh(alg, myKernel);
+        return;
     }
 
-    std::size_t numFacets = 0;
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted)
-            numFacets++;
+    // Both passes may move a point, so each of them gets half of the error budget.
+    maxError *= 0.5;
+
+    // split the facets into spatial clusters
+    std::vector<Base::Vector3f> centers(numFacets);
+    std::vector<FacetIndex> order(numFacets);
+    parallel_blocks(numFacets, 4096, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& face = facets[i];
+            centers[i] = (points[face._aulPoints[0]] + points[face._aulPoints[1]] +
+                          points[face._aulPoints[2]]) / 3.0f;
+            order[i] = i;
+        }
+    });
+    std::vector<FacetRange> ranges;
+    splitRange(order, 0, numFacets, centers, ranges);
+    centers.clear();
+    centers.shrink_to_fit();
+
+    // the points used by more than one cluster are locked, as well as the boundary points
+    std::vector<bool> shared(boundary);
+    {
+        std::vector<unsigned long> owner(points.size(), ULONG_MAX);
+        for (std::size_t c = 0; c < ranges.size(); c++) {
+            for (std::size_t i = ranges[c].first; i < ranges[c].second; i++) {
+                for (PointIndex index : facets[order[i]]._aulPoints) {
+                    if (owner[index] == ULONG_MAX)
+                        owner[index] = c;
+                    else if (owner[index] != c)
+                        shared[index] = true;
+                }
+            }
+        }
     }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = alg.triangles[i].v[0];
-            face._aulPoints[1] = alg.triangles[i].v[1];
-            face._aulPoints[2] = alg.triangles[i].v[2];
-            new_facets.push_back(face);
+
+    // simplify the clusters in parallel, the sequencer is only used by this thread
+    // which also runs the iterations of the final pass over the cluster borders
+    Base::SequencerLauncher seq("Simplifying mesh...", ranges.size() + Simplify::max_iterations);
+    std::vector<Cluster> clusters(ranges.size());
+    std::atomic<bool> canceled(false);
+    std::vector<QFuture<void> > futures;
+    futures.reserve(ranges.size());
+    for (std::size_t c = 0; c < ranges.size(); c++) {
+        clusters[c].range = ranges[c];
+        std::size_t count = ranges[c].second - ranges[c].first;
+        std::size_t target = static_cast<std::size_t>(static_cast<double>(targetSize) * count / numFacets);
+        futures.push_back(QtConcurrent::run([&, c, target]() {
+            if (!canceled)
+                simplifyCluster(myKernel, order, shared, target, tolerance, maxError, canceled, clusters[c]);
+        }));
+    }
+    try {
+        for (auto& future : futures) {
+            future.waitForFinished();
+            seq.next(true);
         }
     }
+    catch (...) {
+        canceled = true;
+        for (auto& future : futures)
+            future.waitForFinished();
+        throw;
+    }
+    order.clear();
+    order.shrink_to_fit();
+
+    // merge the clusters, the shared points come first
+    std::vector<PointIndex> sharedIndex(points.size(), POINT_INDEX_MAX);
+    MeshPointArray mergedPoints;
+    std::vector<bool> mergedBoundary;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (shared[i]) {
+            sharedIndex[i] = mergedPoints.size();
+            mergedPoints.push_back(points[i]);
+            mergedBoundary.push_back(boundary[i]);
+        }
+    }
+    std::size_t numShared = mergedPoints.size();
+
+    Simplify alg;
+    std::vector<int> index;
+    for (auto& cluster : clusters) {
+        index.resize(cluster.points.size());
+        for (std::size_t i = 0; i < cluster.points.size(); i++) {
+            if (cluster.shared[i] != POINT_INDEX_MAX) {
+                index[i] = static_cast<int>(sharedIndex[cluster.shared[i]]);
+            }
+            else {
+                index[i] = static_cast<int>(mergedPoints.size());
+                mergedPoints.push_back(cluster.points[i]);
+            }
+        }
+        for (std::size_t i = 0; i < cluster.triangles.size(); i += 3) {
+            addTriangle(alg, index[cluster.triangles[i]], index[cluster.triangles[i + 1]],
+                        index[cluster.triangles[i + 2]]);
+        }
+        cluster = Cluster();
+    }
+
+    // Simplify the facets around the former cluster borders, i.e. the facets with a shared
+    // point, by the same ratio as the clusters. Only the points of these facets are free.
+    std::vector<bool> border(mergedPoints.size(), false);
+    std::size_t numBorder = 0;
+    for (const auto& it : alg.triangles) {
+        if (it.v[0] < static_cast<int>(numShared) ||
+            it.v[1] < static_cast<int>(numShared) ||
+            it.v[2] < static_cast<int>(numShared)) {
+            border[it.v[0]] = border[it.v[1]] = border[it.v[2]] = true;
+            numBorder++;
+        }
+    }
+    alg.vertices.reserve(mergedPoints.size());
+    for (std::size_t i = 0; i < mergedPoints.size(); i++)
+        addVertex(alg, mergedPoints[i], !border[i] || (i < numShared && mergedBoundary[i]));
+
+    double ratio = static_cast<double>(targetSize) / static_cast<double>(numFacets);
+    std::size_t borderTarget = alg.triangles.size() - numBorder +
+        static_cast<std::size_t>(ratio * static_cast<double>(numBorder));
+    alg.max_error = maxError * maxError;
+    alg.canceled = [&seq]() {
+        seq.next(true);
+        return false;
+    };
+    alg.simplify_mesh(static_cast<int>(std::max(borderTarget, targetSize)), tolerance);
 
-    myKernel.Adopt(new_points, new_facets, true);
+    adoptMesh(alg, myKernel);
 }
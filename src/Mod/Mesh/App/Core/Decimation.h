@@ -24,12 +24,21 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <cstddef>
 #include <Mod/Mesh/MeshGlobal.h>
 
 namespace MeshCore
 {
 class MeshKernel;
 
+/**
+ * The MeshSimplify class reduces the number of facets by quadric edge collapses.
+ * Meshes with more than a few hundred thousand facets are split into spatial clusters
+ * which are simplified in parallel while their borders are locked. Afterwards the facets
+ * around the borders are simplified again.
+ * The progress is reported by the sequencer. If it gets aborted the mesh is left unchanged
+ * and Base::AbortException is thrown.
+ */
 class MeshExport MeshSimplify
 {
 public:
@@ -37,9 +46,23 @@ public:
     ~MeshSimplify();
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /** Simplifies the mesh to about \a targetSize facets. Collapses that move a point farther
+     * than \a maxError away from the planes of the facets it replaces are rejected, so the
+     * result may have more facets.
+     */
+    void simplify(int targetSize, float maxError);
+    /** Keeps the points of open edges in place. This allows to simplify adjacent parts of a
+     * mesh independently without creating gaps between them.
+     */
+    void setKeepBoundary(bool on)
+    { myKeepBoundary = on; }
+
+private:
+    void simplify(std::size_t targetSize, double tolerance, double maxError);
 
 private:
     MeshKernel& myKernel;
+    bool myKeepBoundary;
 };
 
 } // namespace MeshCore
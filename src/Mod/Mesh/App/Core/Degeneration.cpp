@@ -24,13 +24,16 @@
 
 #ifndef _PreComp_
 # include <algorithm>
-# include <map>
+# include <array>
+# include <cmath>
+# include <cstdint>
 # include <queue>
 #endif
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
@@ -87,131 +90,202 @@ bool MeshFixInvalids::Fixup()
 
 // ----------------------------------------------------------------------
 
-namespace MeshCore {
+namespace {
+
+/// Minimum number of elements a thread processes.
+const std::size_t BlockSize = 4096;
+
+inline std::size_t hashKey(std::uint64_t x, std::uint64_t y, std::uint64_t z)
+{
+    std::uint64_t h = (x * 73856093ULL) ^ (y * 19349663ULL) ^ (z * 83492791ULL);
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 32;
+    return static_cast<std::size_t>(h);
+}
 
-using VertexIterator = MeshPointArray::_TConstIterator;
 /*
- * When building up a mesh then usually the class MeshBuilder is used. This
- * class uses internally a std::set<MeshPoint> which uses the '<' operator of
- * MeshPoint to sort the points. Thus to be consistent (and avoid using the
- * '==' operator of MeshPoint) we use the same operator when comparing the
- * points in the function object.
+ * Chains the indices of elements with the same hash value. Each bucket lists
+ * its elements in ascending order, so a search for an element with a lower
+ * index can stop when reaching higher indices.
  */
-struct Vertex_EqualTo
+class IndexBuckets
 {
-    bool operator()(const VertexIterator& x,
-                    const VertexIterator& y) const
+public:
+    static constexpr std::size_t NoIndex = std::size_t(-1);
+
+    explicit IndexBuckets(const std::vector<std::size_t>& hashes)
     {
-        if ( (*x) < (*y) )
-            return false;
-        else if ( (*y) < (*x) )
-            return false;
-        return true;
+        std::size_t size = 1;
+        while (size < hashes.size())
+            size <<= 1;
+        mask = size - 1;
+        head.resize(size, NoIndex);
+        next.resize(hashes.size());
+        for (std::size_t i = hashes.size(); i > 0; i--) {
+            std::size_t bucket = hashes[i - 1] & mask;
+            next[i - 1] = head[bucket];
+            head[bucket] = i - 1;
+        }
     }
-};
 
-struct Vertex_Less
-{
-    bool operator()(const VertexIterator& x,
-                    const VertexIterator& y) const
+    /// Returns the lowest index below \a index in the bucket of \a hash that fulfills \a pred.
+    template <class Pred>
+    std::size_t FindFirst(std::size_t hash, std::size_t index, Pred pred) const
     {
-        return (*x) < (*y);
+        for (std::size_t i = head[hash & mask]; i < index; i = next[i]) {
+            if (pred(i))
+                return i;
+        }
+        return NoIndex;
     }
+
+private:
+    std::size_t mask;
+    std::vector<std::size_t> head;
+    std::vector<std::size_t> next;
 };
 
+/*
+ * Maps each point to the first point it is equal to, i.e. where all coordinates
+ * differ by less than MeshDefinitions::_fMinPointDistanceD1 as with the '<'
+ * operator of MeshPoint. Unique points are mapped to themselves.
+ * The points are hashed into cells larger than the tolerance so that a point is
+ * only compared with the points of the few cells its tolerance box overlaps.
+ */
+std::vector<PointIndex> findDuplicatedPoints(const MeshPointArray& rPoints)
+{
+    const float tolerance = MeshDefinitions::_fMinPointDistanceD1;
+    const double cellSize = tolerance > 0.0f ? 16.0 * tolerance : 1.0;
+    auto cell = [cellSize](double value) {
+        double index = std::floor(value / cellSize);
+        // non-finite coordinates are never equal to another point
+        if (!(std::fabs(index) < 1.0e18))
+            return std::int64_t(0);
+        return static_cast<std::int64_t>(index);
+    };
+
+    std::size_t count = rPoints.size();
+    std::vector<std::size_t> hashes(count);
+    parallel_blocks(count, BlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshPoint& p = rPoints[i];
+            hashes[i] = hashKey(cell(p.x), cell(p.y), cell(p.z));
+        }
+    });
+
+    IndexBuckets buckets(hashes);
+    std::vector<PointIndex> first(count);
+    parallel_blocks(count, BlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshPoint& p = rPoints[i];
+            auto isEqual = [&rPoints, &p, tolerance](std::size_t j) {
+                const MeshPoint& q = rPoints[j];
+                return std::fabs(p.x - q.x) < tolerance &&
+                       std::fabs(p.y - q.y) < tolerance &&
+                       std::fabs(p.z - q.z) < tolerance;
+            };
+
+            std::size_t index = i;
+            for (std::int64_t x = cell(p.x - tolerance); x <= cell(p.x + tolerance); x++) {
+                for (std::int64_t y = cell(p.y - tolerance); y <= cell(p.y + tolerance); y++) {
+                    for (std::int64_t z = cell(p.z - tolerance); z <= cell(p.z + tolerance); z++) {
+                        std::size_t j = buckets.FindFirst(hashKey(x, y, z), index, isEqual);
+                        if (j != IndexBuckets::NoIndex)
+                            index = j;
+                    }
+                }
+            }
+            first[i] = index;
+        }
+    });
+
+    // an earlier point may itself be equal to an even earlier one
+    for (std::size_t i = 0; i < count; i++)
+        first[i] = first[first[i]];
+    return first;
 }
 
-bool MeshEvalDuplicatePoints::Evaluate()
+/*
+ * Maps each facet to the first facet that references the same three points,
+ * regardless of their order. Unique facets are mapped to themselves.
+ */
+std::vector<FacetIndex> findDuplicatedFacets(const MeshFacetArray& rFacets)
 {
-    // get an const iterator to each vertex and sort them in ascending order by
-    // their (x,y,z) coordinates
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    std::vector<VertexIterator> vertices;
-    vertices.reserve(rPoints.size());
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        vertices.push_back(it);
-    }
+    using PointTriple = std::array<PointIndex, 3>;
+
+    std::size_t count = rFacets.size();
+    std::vector<PointTriple> triples(count);
+    std::vector<std::size_t> hashes(count);
+    parallel_blocks(count, BlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            PointTriple& triple = triples[i];
+            std::copy(rFacets[i]._aulPoints, rFacets[i]._aulPoints + 3, triple.begin());
+            std::sort(triple.begin(), triple.end());
+            hashes[i] = hashKey(triple[0], triple[1], triple[2]);
+        }
+    });
+
+    IndexBuckets buckets(hashes);
+    std::vector<FacetIndex> first(count);
+    parallel_blocks(count, BlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t j = buckets.FindFirst(hashes[i], i, [&triples, i](std::size_t k) {
+                return triples[k] == triples[i];
+            });
+            first[i] = (j != IndexBuckets::NoIndex) ? j : i;
+        }
+    });
 
-    // if there are two adjacent vertices which have the same coordinates
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
-    if (std::adjacent_find(vertices.begin(), vertices.end(), Vertex_EqualTo()) < vertices.end() )
-        return false;
-    return true;
+    return first;
 }
 
-std::vector<PointIndex> MeshEvalDuplicatePoints::GetIndices() const
+template <class Index>
+std::vector<Index> getDuplicates(const std::vector<Index>& first)
 {
-    //Note: We must neither use map or set to get duplicated indices because
-    //the sort algorithms deliver different results compared to std::sort of
-    //a vector.
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    std::vector<VertexIterator> vertices;
-    vertices.reserve(rPoints.size());
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        vertices.push_back(it);
+    std::vector<Index> indices;
+    for (std::size_t i = 0; i < first.size(); i++) {
+        if (first[i] != i)
+            indices.push_back(i);
     }
+    return indices;
+}
 
-    // if there are two adjacent vertices which have the same coordinates
-    std::vector<PointIndex> aInds;
-    Vertex_EqualTo pred;
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
-
-    std::vector<VertexIterator>::iterator vt = vertices.begin();
-    while (vt < vertices.end()) {
-        // get first item which adjacent element has the same vertex
-        vt = std::adjacent_find(vt, vertices.end(), pred);
-        if (vt < vertices.end()) {
-            ++vt;
-            aInds.push_back(*vt - rPoints.begin());
-        }
+}
+
+bool MeshEvalDuplicatePoints::Evaluate()
+{
+    std::vector<PointIndex> first = findDuplicatedPoints(_rclMesh.GetPoints());
+    for (std::size_t i = 0; i < first.size(); i++) {
+        if (first[i] != i)
+            return false;
     }
+    return true;
+}
 
-    return aInds;
+std::vector<PointIndex> MeshEvalDuplicatePoints::GetIndices() const
+{
+    return getDuplicates(findDuplicatedPoints(_rclMesh.GetPoints()));
 }
 
 bool MeshFixDuplicatePoints::Fixup()
 {
-    //Note: We must neither use map or set to get duplicated indices because
-    //the sort algorithms deliver different results compared to std::sort of
-    //a vector.
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    std::vector<VertexIterator> vertices;
-    vertices.reserve(rPoints.size());
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it) {
-        vertices.push_back(it);
-    }
-
-    // get the indices of adjacent vertices which have the same coordinates
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
-
-    Vertex_EqualTo pred;
-    std::vector<VertexIterator>::iterator next = vertices.begin();
-    std::map<PointIndex, PointIndex> mapPointIndex;
-    std::vector<PointIndex> pointIndices;
-    while (next < vertices.end()) {
-        next = std::adjacent_find(next, vertices.end(), pred);
-        if (next < vertices.end()) {
-            std::vector<VertexIterator>::iterator first = next;
-            PointIndex first_index = *first - rPoints.begin();
-            ++next;
-            while (next < vertices.end() && pred(*first, *next)) {
-                PointIndex next_index = *next - rPoints.begin();
-                mapPointIndex[next_index] = first_index;
-                pointIndices.push_back(next_index);
-                ++next;
-            }
-        }
-    }
+    std::vector<PointIndex> first = findDuplicatedPoints(_rclMesh.GetPoints());
+    std::vector<PointIndex> pointIndices = getDuplicates(first);
+    if (pointIndices.empty())
+        return true;
 
-    // now set all facets to the correct index
+    // now set all facets to the correct index, invalid indices are kept as they are
     MeshFacetArray& rFacets = _rclMesh._aclFacetArray;
-    for (MeshFacetArray::_TIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        for (int i=0; i<3; i++) {
-            std::map<PointIndex, PointIndex>::iterator pt = mapPointIndex.find(it->_aulPoints[i]);
-            if (pt != mapPointIndex.end())
-                it->_aulPoints[i] = pt->second;
+    parallel_blocks(rFacets.size(), BlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            for (int j=0; j<3; j++) {
+                PointIndex& index = rFacets[i]._aulPoints[j];
+                if (index < first.size())
+                    index = first[index];
+            }
         }
-    }
+    });
 
     // remove invalid indices
     _rclMesh.DeletePoints(pointIndices);
@@ -263,153 +337,26 @@ bool MeshFixNaNPoints::Fixup()
 
 // ----------------------------------------------------------------------
 
-namespace MeshCore {
-
-using FaceIterator = MeshFacetArray::_TConstIterator;
-/*
- * The facet with the lowset index is regarded as 'less'.
- */
-struct MeshFacet_Less
+bool MeshEvalDuplicateFacets::Evaluate()
 {
-    bool operator()(const FaceIterator& x,
-                    const FaceIterator& y) const
-    {
-        PointIndex tmp;
-        PointIndex x0 = x->_aulPoints[0];
-        PointIndex x1 = x->_aulPoints[1];
-        PointIndex x2 = x->_aulPoints[2];
-        PointIndex y0 = y->_aulPoints[0];
-        PointIndex y1 = y->_aulPoints[1];
-        PointIndex y2 = y->_aulPoints[2];
-
-        if (x0 > x1)
-        { tmp = x0; x0 = x1; x1 = tmp; }
-        if (x0 > x2)
-        { tmp = x0; x0 = x2; x2 = tmp; }
-        if (x1 > x2)
-        { tmp = x1; x1 = x2; x2 = tmp; }
-        if (y0 > y1)
-        { tmp = y0; y0 = y1; y1 = tmp; }
-        if (y0 > y2)
-        { tmp = y0; y0 = y2; y2 = tmp; }
-        if (y1 > y2)
-        { tmp = y1; y1 = y2; y2 = tmp; }
-
-        if (x0 < y0)
-            return true;
-        else if (x0 > y0)
-            return false;
-        else if (x1 < y1)
-            return true;
-        else if (x1 > y1)
-            return false;
-        else if (x2 < y2)
-            return true;
-        else
+    std::vector<FacetIndex> first = findDuplicatedFacets(_rclMesh.GetFacets());
+    for (std::size_t i = 0; i < first.size(); i++) {
+        if (first[i] != i)
             return false;
     }
-};
-
-}
-
-/*
- * Two facets are equal if all its three point indices refer to the same
- * location in the point array of the mesh kernel they belong to.
- */
-struct MeshFacet_EqualTo
-{
-    bool operator()(const FaceIterator& x,
-                    const FaceIterator& y) const
-    {
-        for (int i=0; i<3; i++ ) {
-            if (x->_aulPoints[0] == y->_aulPoints[i]) {
-                if (x->_aulPoints[1] == y->_aulPoints[(i+1)%3] &&
-                    x->_aulPoints[2] == y->_aulPoints[(i+2)%3])
-                    return true;
-                else if (x->_aulPoints[1] == y->_aulPoints[(i+2)%3] &&
-                     x->_aulPoints[2] == y->_aulPoints[(i+1)%3])
-                    return true;
-            }
-        }
-
-        return false;
-    }
-};
-
-bool MeshEvalDuplicateFacets::Evaluate()
-{
-  std::set<FaceIterator, MeshFacet_Less> aFaces;
-  const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-  for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it)
-  {
-    std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool>
-        pI = aFaces.insert(it);
-    if (!pI.second)
-        return false;
-  }
-
-  return true;
+    return true;
 }
 
 std::vector<FacetIndex> MeshEvalDuplicateFacets::GetIndices() const
 {
-#if 1
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    std::vector<FaceIterator> faces;
-    faces.reserve(rFacets.size());
-    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        faces.push_back(it);
-    }
-
-    // if there are two adjacent faces which references the same vertices
-    std::vector<FacetIndex> aInds;
-    MeshFacet_EqualTo pred;
-    std::sort(faces.begin(), faces.end(), MeshFacet_Less());
-
-    std::vector<FaceIterator>::iterator ft = faces.begin();
-    while (ft < faces.end()) {
-        // get first item which adjacent element has the same face
-        ft = std::adjacent_find(ft, faces.end(), pred);
-        if (ft < faces.end()) {
-            ++ft;
-            aInds.push_back(*ft - rFacets.begin());
-        }
-    }
-
-    return aInds;
-#else
-  std::vector<FacetIndex> aInds;
-  const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-  FacetIndex uIndex=0;
-
-  // get all facets
-  std::set<FaceIterator, MeshFacet_Less > aFaceSet;
-  for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, uIndex++)
-  {
-    std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool>
-        pI = aFaceSet.insert(it);
-    if (!pI.second)
-      aInds.push_back(uIndex);
-  }
-
-  return aInds;
-#endif
+    return getDuplicates(findDuplicatedFacets(_rclMesh.GetFacets()));
 }
 
 bool MeshFixDuplicateFacets::Fixup()
 {
-    FacetIndex uIndex=0;
-    std::vector<FacetIndex> aRemoveFaces;
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-
-    // get all facets
-    std::set<FaceIterator, MeshFacet_Less > aFaceSet;
-    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, uIndex++) {
-        std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool>
-        pI = aFaceSet.insert(it);
-        if (!pI.second)
-            aRemoveFaces.push_back(uIndex);
-    }
+    std::vector<FacetIndex> aRemoveFaces = getDuplicates(findDuplicatedFacets(_rclMesh.GetFacets()));
+    if (aRemoveFaces.empty())
+        return true;
 
     _rclMesh.DeleteFacets(aRemoveFaces);
     _rclMesh.RebuildNeighbours(); // needs to be done here
@@ -422,19 +369,12 @@ bool MeshFixDuplicateFacets::Fixup()
 bool MeshEvalInternalFacets::Evaluate()
 {
     _indices.clear();
-    FacetIndex uIndex=0;
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-
-    // get all facets
-    std::set<FaceIterator, MeshFacet_Less > aFaceSet;
-    MeshFacetArray::_TConstIterator first = rFaces.begin();
-    for (MeshFacetArray::_TConstIterator it = rFaces.begin(); it != rFaces.end(); ++it, uIndex++) {
-        std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool>
-        pI = aFaceSet.insert(it);
-        if (!pI.second) {
+    std::vector<FacetIndex> first = findDuplicatedFacets(_rclMesh.GetFacets());
+    for (std::size_t i = 0; i < first.size(); i++) {
+        if (first[i] != i) {
             // collect both elements
-            _indices.push_back(*pI.first - first);
-            _indices.push_back(uIndex);
+            _indices.push_back(first[i]);
+            _indices.push_back(i);
         }
     }
 
@@ -565,7 +505,8 @@ bool MeshRemoveNeedles::Fixup()
         if (neighbour != FACET_INDEX_MAX)
             ce._removeFacets.push_back(neighbour);
 
-        std::set<FacetIndex> vf = vf_it[ce._fromPoint];
+        MeshIndexRange adjacent = vf_it[ce._fromPoint];
+        std::set<FacetIndex> vf(adjacent.begin(), adjacent.end());
         vf.erase(faceedge.first);
         if (neighbour != FACET_INDEX_MAX)
             vf.erase(neighbour);
@@ -786,9 +727,9 @@ bool MeshFixMergeFacets::Fixup()
         if (vv_it[i].size() == 3 && vf_it[i].size() == 3) {
             VertexCollapse vc;
             vc._point = i;
-            const std::set<PointIndex>& adjPts = vv_it[i];
+            MeshIndexRange adjPts = vv_it[i];
             vc._circumPoints.insert(vc._circumPoints.begin(), adjPts.begin(), adjPts.end());
-            const std::set<FacetIndex>& adjFts = vf_it[i];
+            MeshIndexRange adjFts = vf_it[i];
             vc._circumFacets.insert(vc._circumFacets.begin(), adjFts.begin(), adjFts.end());
             topAlg.CollapseVertex(vc);
         }
@@ -816,11 +757,11 @@ bool MeshEvalDentsOnSurface::Evaluate()
 
         // get the local neighbourhood of the point
         std::set<PointIndex> nb = clPt2Facets.NeighbourPoints(point,1);
-        const std::set<FacetIndex>& faces = clPt2Facets[index];
+        MeshIndexRange faces = clPt2Facets[index];
 
         for (std::set<PointIndex>::iterator pt = nb.begin(); pt != nb.end(); ++pt) {
             const MeshPoint& mp = rPntAry[*pt];
-            for (std::set<FacetIndex>::const_iterator
+            for (MeshIndexRange::const_iterator
                 ft = faces.begin(); ft != faces.end(); ++ft) {
                     // the point must not be part of the facet we test
                     if (f_beg[*ft]._aulPoints[0] == *pt)
@@ -832,7 +773,7 @@ bool MeshEvalDentsOnSurface::Evaluate()
                     // is the point projectable onto the facet?
                     rTriangle = _rclMesh.GetFacet(f_beg[*ft]);
                     if (rTriangle.IntersectWithLine(mp,rTriangle.GetNormal(),tmp)) {
-                        const std::set<FacetIndex>& f = clPt2Facets[*pt];
+                        MeshIndexRange f = clPt2Facets[*pt];
                         this->indices.insert(this->indices.end(), f.begin(), f.end());
                         break;
                     }
@@ -91,6 +91,7 @@ public:
  * The MeshEvalDuplicatePoints class searches for duplicated points.
  * A point is regarded as duplicated if the distances between x, y and z coordinates of two points is
  * less than an epsilon (defined by MeshDefinitions::_fMinPointDistanceD1, default value=1.0e-5f).
+ * The point with the lowest index of a group of equal points is kept, all others are duplicates.
  * @see MeshFixDuplicatePoints
  * @see MeshEvalDegeneratedFacets
  * @author Werner Mayer
@@ -127,7 +128,7 @@ public:
   /**
    * Construction.
    */
-  explicit MeshFixDuplicatePoints (MeshKernel &rclM) : MeshValidation( rclM ) { }
+  explicit MeshFixDuplicatePoints (MeshKernel &rclM) : MeshValidation( rclM ) { rclM.Expand(); }
   /**
    * Destruction.
    */
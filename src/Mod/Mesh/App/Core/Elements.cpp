@@ -1111,22 +1111,41 @@ int MeshGeomFacet::IntersectWithFacet (const MeshGeomFacet& rclFacet,
     int coplanar = 0;
     float isectpt1[3], isectpt2[3];
 
+    // The epsilon test of tri_tri_intersect_with_isectline is absolute. So, move
+    // both facets to the origin and scale them to unit size to make it relative,
+    // otherwise small facets are always considered as co-planar.
+    Base::BoundBox3f box = this->GetBoundBox();
+    box.Add(rclFacet.GetBoundBox());
+    Base::Vector3f center = box.GetCenter();
+    float length = box.CalcDiagonalLength();
+    if (length <= 0.0f)
+        return 0;
+    float scale = 1.0f / length;
+
     for (int i = 0; i < 3; i++)
     {
-        V[i][0] = _aclPoints[i].x;
-        V[i][1] = _aclPoints[i].y;
-        V[i][2] = _aclPoints[i].z;
-        U[i][0] = rclFacet._aclPoints[i].x;
-        U[i][1] = rclFacet._aclPoints[i].y;
-        U[i][2] = rclFacet._aclPoints[i].z;
+        Base::Vector3f v = (_aclPoints[i] - center) * scale;
+        Base::Vector3f u = (rclFacet._aclPoints[i] - center) * scale;
+        V[i][0] = v.x;
+        V[i][1] = v.y;
+        V[i][2] = v.z;
+        U[i][0] = u.x;
+        U[i][1] = u.y;
+        U[i][2] = u.z;
     }
 
     if (tri_tri_intersect_with_isectline(V[0], V[1], V[2], U[0], U[1], U[2],
                                          &coplanar, isectpt1, isectpt2) == 0)
         return 0; // no intersections
 
-    rclPt0.x = isectpt1[0]; rclPt0.y = isectpt1[1]; rclPt0.z = isectpt1[2];
-    rclPt1.x = isectpt2[0]; rclPt1.y = isectpt2[1]; rclPt1.z = isectpt2[2];
+    // the intersection points are not set for nearly co-planar facets
+    if (coplanar)
+        return 0;
+
+    rclPt0.Set(isectpt1[0], isectpt1[1], isectpt1[2]);
+    rclPt1.Set(isectpt2[0], isectpt2[1], isectpt2[2]);
+    rclPt0 = rclPt0 * length + center;
+    rclPt1 = rclPt1 * length + center;
 
     // With extremely acute-angled triangles it may happen that the algorithm
     // claims an intersection but the intersection points are far outside the
@@ -33,8 +33,8 @@
 #include "Evaluation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Functional.h"
-#include "Grid.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
 
@@ -424,8 +424,21 @@ bool MeshFixTopology::Fixup ()
         _rclMesh.DeleteFacets(deletedFaces);
     }
 #else
+    deletedFaces = GetFacets();
+    if (!deletedFaces.empty()) {
+        _rclMesh.DeleteFacets(deletedFaces);
+        _rclMesh.RebuildNeighbours();
+    }
+#endif
+
+    return true;
+}
+
+std::vector<FacetIndex> MeshFixTopology::GetFacets() const
+{
+    std::vector<FacetIndex> indices;
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    deletedFaces.reserve(3 * nonManifoldList.size()); // allocate some memory
+    indices.reserve(3 * nonManifoldList.size()); // allocate some memory
     std::list<std::vector<FacetIndex> >::const_iterator it;
     for (it = nonManifoldList.begin(); it != nonManifoldList.end(); ++it) {
         std::vector<FacetIndex> non_mf;
@@ -441,22 +454,16 @@ bool MeshFixTopology::Fixup ()
 
         // are we able to repair the non-manifold edge by not removing all facets?
         if (it->size() - non_mf.size() == 2)
-            deletedFaces.insert(deletedFaces.end(), non_mf.begin(), non_mf.end());
+            indices.insert(indices.end(), non_mf.begin(), non_mf.end());
         else
-            deletedFaces.insert(deletedFaces.end(), it->begin(), it->end());
+            indices.insert(indices.end(), it->begin(), it->end());
     }
 
-    if (!deletedFaces.empty()) {
-        // remove duplicates
-        std::sort(deletedFaces.begin(), deletedFaces.end());
-        deletedFaces.erase(std::unique(deletedFaces.begin(), deletedFaces.end()), deletedFaces.end());
-
-        _rclMesh.DeleteFacets(deletedFaces);
-        _rclMesh.RebuildNeighbours();
-    }
-#endif
+    // remove duplicates
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
 
-    return true;
+    return indices;
 }
 
 // ---------------------------------------------------------
@@ -472,10 +479,10 @@ bool MeshEvalPointManifolds::Evaluate ()
     unsigned long ctPoints = _rclMesh.CountPoints();
     for (PointIndex index=0; index < ctPoints; index++) {
         // get the local neighbourhood of the point
-        const std::set<FacetIndex>& nf = vf_it[index];
-        const std::set<PointIndex>& np = vv_it[index];
+        MeshIndexRange nf = vf_it[index];
+        MeshIndexRange np = vv_it[index];
 
-        std::set<unsigned long>::size_type sp, sf;
+        std::size_t sp, sf;
         sp = np.size();
         sf = nf.size();
         // for an inner point the number of adjacent points is equal to the number of shared faces
@@ -591,168 +598,43 @@ bool MeshFixSingleFacet::Fixup ()
 
 bool MeshEvalSelfIntersection::Evaluate ()
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty())
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<FacetIndex>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<FacetIndex>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
-                }
-            }
-        }
-    }
-
-    return true;
+    MeshFacetBVH bvh(_rclMesh);
+    return !bvh.HasSelfIntersection();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<FacetIndex, FacetIndex> >& indices,
                                                 std::vector<std::pair<Base::Vector3f, Base::Vector3f> >& intersection) const
 {
-    intersection.reserve(indices.size());
-    MeshFacetIterator cMF1(_rclMesh);
-    MeshFacetIterator cMF2(_rclMesh);
-
-    Base::Vector3f pt1, pt2;
-    std::vector<std::pair<FacetIndex, FacetIndex> >::const_iterator it;
-    for (it = indices.begin(); it != indices.end(); ++it) {
-        cMF1.Set(it->first);
-        cMF2.Set(it->second);
-
-        Base::BoundBox3f box1 = cMF1->GetBoundBox();
-        Base::BoundBox3f box2 = cMF2->GetBoundBox();
-        if (box1 && box2) {
-            int ret = cMF1->IntersectWithFacet(*cMF2, pt1, pt2);
-            if (ret == 2) {
-                intersection.emplace_back(pt1, pt2);
+    // test the pairs in parallel and append the lines in the order of the pairs
+    std::vector<std::vector<std::pair<Base::Vector3f, Base::Vector3f> > > lines(parallel_block_count(indices.size(), 1024));
+    parallel_blocks(indices.size(), 1024, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        Base::Vector3f pt1, pt2;
+        for (std::size_t i = begin; i < end; i++) {
+            MeshGeomFacet facet1 = _rclMesh.GetFacet(indices[i].first);
+            MeshGeomFacet facet2 = _rclMesh.GetFacet(indices[i].second);
+            if (facet1.GetBoundBox() && facet2.GetBoundBox()) {
+                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
+                if (ret == 2) {
+                    lines[block].emplace_back(pt1, pt2);
+                }
             }
         }
-    }
+    });
+
+    intersection.reserve(intersection.size() + indices.size());
+    for (const auto& it : lines)
+        intersection.insert(intersection.end(), it.begin(), it.end());
 }
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex> >& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
+    MeshFacetBVH bvh(_rclMesh);
+    std::vector<MeshFacetBVH::Intersection> sections;
+    bvh.GetSelfIntersections(sections);
 
-        seq.next(true);
-        if (aulGridElements.empty())
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<FacetIndex>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<FacetIndex>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back (*it,*jt);
-                    }
-                }
-            }
-        }
-    }
+    intersection.reserve(intersection.size() + sections.size());
+    for (const auto& it : sections)
+        intersection.emplace_back(it.f1, it.f2);
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
@@ -948,40 +830,48 @@ bool MeshFixNeighbourhood::Fixup()
 
 void MeshKernel::RebuildNeighbours (FacetIndex index)
 {
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * (this->_aclFacetArray.size() - index));
+    Expand();
+    std::size_t ulCtFacets = this->_aclFacetArray.size() - index;
+    std::vector<Edge_Index> edges(3 * ulCtFacets);
 
     // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    MeshFacetArray::_TConstIterator pB = this->_aclFacetArray.begin();
-    for (pI = pB + index; pI != this->_aclFacetArray.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item;
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i+1)%3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i+1)%3]);
-            item.f  = pI - pB;
-            edges.push_back(item);
+    const std::size_t ulMinBlockSize = 10000;
+    parallel_blocks(ulCtFacets, ulMinBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t j = begin; j < end; j++) {
+            FacetIndex f = index + j;
+            const MeshFacet& rFace = this->_aclFacetArray[f];
+            for (int i = 0; i < 3; i++) {
+                Edge_Index& item = edges[3 * j + i];
+                item.p0 = std::min<PointIndex>(rFace._aulPoints[i], rFace._aulPoints[(i+1)%3]);
+                item.p1 = std::max<PointIndex>(rFace._aulPoints[i], rFace._aulPoints[(i+1)%3]);
+                item.f  = f;
+            }
         }
-    }
+    });
 
     // sort the edges
-    //std::sort(edges.begin(), edges.end(), Edge_Less());
     int threads = std::max(1, QThread::idealThreadCount());
     MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
-    PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
-    PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
-    int count = 0;
-    std::vector<Edge_Index>::iterator pE;
-    for (pE = edges.begin(); pE != edges.end(); ++pE) {
-        if (p0 == pE->p0 && p1 == pE->p1) {
-            f1 = pE->f;
-            count++;
-        }
-        else {
+    // Each run of equal edges is handled by the block it starts in. The runs
+    // write to different sides of the facets, so blocks don't interfere.
+    auto sameEdge = [&edges](std::size_t i, std::size_t j) {
+        return edges[i].p0 == edges[j].p0 && edges[i].p1 == edges[j].p1;
+    };
+    parallel_blocks(edges.size(), ulMinBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::size_t i = begin;
+        while (i < end && i > 0 && sameEdge(i - 1, i))
+            i++;
+        while (i < end) {
+            std::size_t j = i + 1;
+            while (j < edges.size() && sameEdge(i, j))
+                j++;
+
             // we handle only the cases for 1 and 2, for all higher
             // values we have a non-manifold that is ignored here
-            if (count == 2) {
+            PointIndex p0 = edges[i].p0, p1 = edges[i].p1;
+            if (j - i == 2) {
+                FacetIndex f0 = edges[i].f, f1 = edges[i + 1].f;
                 MeshFacet& rFace0 = this->_aclFacetArray[f0];
                 MeshFacet& rFace1 = this->_aclFacetArray[f1];
                 unsigned short side0 = rFace0.Side(p0,p1);
@@ -989,34 +879,15 @@ void MeshKernel::RebuildNeighbours (FacetIndex index)
                 rFace0._aulNeighbours[side0] = f1;
                 rFace1._aulNeighbours[side1] = f0;
             }
-            else if (count == 1) {
-                MeshFacet& rFace = this->_aclFacetArray[f0];
+            else if (j - i == 1) {
+                MeshFacet& rFace = this->_aclFacetArray[edges[i].f];
                 unsigned short side = rFace.Side(p0,p1);
                 rFace._aulNeighbours[side] = FACET_INDEX_MAX;
             }
 
-            p0 = pE->p0;
-            p1 = pE->p1;
-            f0 = pE->f;
-            count = 1;
+            i = j;
         }
-    }
-
-    // we handle only the cases for 1 and 2, for all higher
-    // values we have a non-manifold that is ignored here
-    if (count == 2) {
-        MeshFacet& rFace0 = this->_aclFacetArray[f0];
-        MeshFacet& rFace1 = this->_aclFacetArray[f1];
-        unsigned short side0 = rFace0.Side(p0,p1);
-        unsigned short side1 = rFace1.Side(p0,p1);
-        rFace0._aulNeighbours[side0] = f1;
-        rFace1._aulNeighbours[side1] = f0;
-    }
-    else if (count == 1) {
-        MeshFacet& rFace = this->_aclFacetArray[f0];
-        unsigned short side = rFace.Side(p0,p1);
-        rFace._aulNeighbours[side] = FACET_INDEX_MAX;
-    }
+    });
 }
 
 void MeshKernel::RebuildNeighbours ()
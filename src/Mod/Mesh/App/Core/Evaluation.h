@@ -213,6 +213,8 @@ public:
       : MeshValidation(rclB), nonManifoldList(mf) {}
     ~MeshFixTopology () override {}
     bool Fixup() override;
+    /// Returns the facets to remove to repair the non-manifolds.
+    std::vector<FacetIndex> GetFacets() const;
 
     const std::vector<FacetIndex>& GetDeletedFaces() const { return deletedFaces; }
 
@@ -24,8 +24,10 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <vector>
 #include <QtConcurrentRun>
 #include <QFuture>
+#include <QThread>
 
 
 namespace MeshCore
@@ -57,6 +59,54 @@ namespace MeshCore
         }
     }
 
+    /** Returns the number of blocks parallel_blocks() splits \a count elements
+     * into, that is one block per thread with at least \a minBlockSize elements.
+     */
+    inline std::size_t parallel_block_count(std::size_t count, std::size_t minBlockSize)
+    {
+        std::size_t threads = static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+        std::size_t blocks = std::min(threads, count / std::max<std::size_t>(minBlockSize, 1));
+        return std::max<std::size_t>(blocks, 1);
+    }
+
+    /** Splits the index range [0, count) into consecutive blocks and calls
+     * \a func(block, begin, end) for each of them in parallel. The blocks are
+     * numbered in ascending order of their ranges, so results collected per
+     * block can be concatenated in block order. Returns the number of blocks.
+     */
+    template <class Func>
+    static std::size_t parallel_blocks(std::size_t count, std::size_t minBlockSize, Func func)
+    {
+        std::size_t blocks = parallel_block_count(count, minBlockSize);
+        if (blocks < 2) {
+            func(std::size_t(0), std::size_t(0), count);
+            return 1;
+        }
+
+        std::size_t blockSize = count / blocks;
+        std::vector<QFuture<void> > futures;
+        futures.reserve(blocks - 1);
+        for (std::size_t block = 1; block < blocks; ++block) {
+            std::size_t begin = block * blockSize;
+            std::size_t end = (block + 1 == blocks) ? count : begin + blockSize;
+            futures.push_back(QtConcurrent::run([&func, block, begin, end]() {
+                func(block, begin, end);
+            }));
+        }
+
+        try {
+            func(std::size_t(0), std::size_t(0), blockSize);
+        }
+        catch (...) {
+            for (auto& future : futures)
+                future.waitForFinished();
+            throw;
+        }
+        for (auto& future : futures)
+            future.waitForFinished();
+        return blocks;
+    }
+
 } // namespace MeshCore
 
 
@@ -28,6 +28,7 @@
 
 #include "Grid.h"
 #include "Algorithm.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 
@@ -60,7 +61,8 @@ void MeshGrid::Attach (const MeshKernel &rclM)
 
 void MeshGrid::Clear ()
 {
-  _aulGrid.clear();
+  _aulGridOffsets.clear();
+  _aulGridElements.clear();
   _pclMesh = nullptr;
 }
 
@@ -91,8 +93,6 @@ void MeshGrid::InitGrid ()
 {
   assert(_pclMesh);
 
-  unsigned long i, j;
-
   // Calculate grid length if not initialised
   //
   if ((_ulCtGridsX == 0) || (_ulCtGridsY == 0) || (_ulCtGridsZ == 0))
@@ -125,14 +125,38 @@ void MeshGrid::InitGrid ()
   }
   }
 
-  // Create data structure
-  _aulGrid.clear();
-  _aulGrid.resize(_ulCtGridsX);
-  for (i = 0; i < _ulCtGridsX; i++)
-  {
-    _aulGrid[i].resize(_ulCtGridsY);
-    for (j = 0; j < _ulCtGridsY; j++)
-      _aulGrid[i][j].resize(_ulCtGridsZ);
+  // Create an empty data structure
+  _aulGridOffsets.assign(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ + 1, 0);
+  _aulGridElements.clear();
+}
+
+void MeshGrid::FillGrid (unsigned long ulCtElements, const GridCollector& collect)
+{
+  const std::size_t ulMinBlockSize = 10000;
+  std::size_t ulCtGrids = _aulGridOffsets.size() - 1;
+
+  // Collect the entries of consecutive element ranges in parallel. As the ranges are
+  // ordered the elements of each grid end up sorted after the counting sort below.
+  std::vector<std::vector<GridEntry> > entries(parallel_block_count(ulCtElements, ulMinBlockSize));
+  parallel_blocks(ulCtElements, ulMinBlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+    collect(static_cast<ElementIndex>(begin), static_cast<ElementIndex>(end), entries[block]);
+  });
+
+  // count the elements per grid and compute the offsets
+  std::fill(_aulGridOffsets.begin(), _aulGridOffsets.end(), 0);
+  for (const auto& block : entries) {
+    for (const auto& entry : block)
+      _aulGridOffsets[entry.first + 1]++;
+  }
+  for (std::size_t i = 0; i < ulCtGrids; i++)
+    _aulGridOffsets[i + 1] += _aulGridOffsets[i];
+
+  // place the elements
+  _aulGridElements.resize(_aulGridOffsets.back());
+  std::vector<ElementIndex> aulFill(_aulGridOffsets.begin(), _aulGridOffsets.end() - 1);
+  for (const auto& block : entries) {
+    for (const auto& entry : block)
+      _aulGridElements[aulFill[entry.first]++] = entry.second;
   }
 }
 
@@ -153,7 +177,8 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<Eleme
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        Cell cell = GetCell(i, j, k);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
       }
     }
   }
@@ -187,8 +212,10 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<Eleme
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2)
-          raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2) {
+          Cell cell = GetCell(i, j, k);
+          raulElements.insert(raulElements.end(), cell.begin(), cell.end());
+        }
       }
     }
   }
@@ -219,7 +246,8 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::set<ElementI
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        Cell cell = GetCell(i, j, k);
+        raulElements.insert(cell.begin(), cell.end());
       }
     }
   }
@@ -448,7 +476,7 @@ void MeshGrid::CalculateGridLength (int iCtGridPerAxis)
   }
 }
 
-void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<ElementIndex> &raclInd) const
+void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::vector<ElementIndex> &raclInd) const
 {
   raclInd.clear();
   Base::BoundBox3f  clBB = GetBoundBox();
@@ -477,7 +505,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              GetElements(nX, i, j, raclInd);
           }
           nX++;
         }
@@ -491,7 +519,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              GetElements(nX, i, j, raclInd);
           }
           nX++;
         }
@@ -505,7 +533,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              GetElements(i, nY, j, raclInd);
           }
           nY++;
         }
@@ -519,7 +547,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              GetElements(i, nY, j, raclInd);
           }
           nY--;
         }
@@ -533,7 +561,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              GetElements(i, j, nZ, raclInd);
           }
           nZ++;
         }
@@ -547,7 +575,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              GetElements(i, j, nZ, raclInd);
           }
           nZ--;
         }
@@ -558,10 +586,22 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
         break;
     }
   }
+
+  // remove duplicate mentions
+  std::sort(raclInd.begin(), raclInd.end());
+  raclInd.erase(std::unique(raclInd.begin(), raclInd.end()), raclInd.end());
+}
+
+void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<ElementIndex> &raclInd) const
+{
+  std::vector<ElementIndex> aulInd;
+  SearchNearestFromPoint(rclPt, aulInd);
+  raclInd.clear();
+  raclInd.insert(aulInd.begin(), aulInd.end());
 }
 
 void MeshGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
-                        unsigned long ulDistance, std::set<ElementIndex> &raclInd) const
+                        unsigned long ulDistance, std::vector<ElementIndex> &raclInd) const
 {
   int nX1 = std::max<int>(0, int(ulX) - int(ulDistance));
   int nY1 = std::max<int>(0, int(ulY) - int(ulDistance));
@@ -640,17 +680,28 @@ void MeshGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
   }
 }
 
+void MeshGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
+                        unsigned long ulDistance, std::set<ElementIndex> &raclInd) const
+{
+  std::vector<ElementIndex> aulInd;
+  GetHull(ulX, ulY, ulZ, ulDistance, aulInd);
+  raclInd.insert(aulInd.begin(), aulInd.end());
+}
+
 unsigned long MeshGrid::GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
                                      std::set<ElementIndex> &raclInd) const
 {
-  const std::set<ElementIndex> &rclSet = _aulGrid[ulX][ulY][ulZ];
-  if (!rclSet.empty())
-  {
-    raclInd.insert(rclSet.begin(), rclSet.end());
-    return rclSet.size();
-  }
+  Cell cell = GetCell(ulX, ulY, ulZ);
+  raclInd.insert(cell.begin(), cell.end());
+  return static_cast<unsigned long>(cell.size());
+}
 
-  return 0;
+unsigned long MeshGrid::GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
+                                     std::vector<ElementIndex> &raclInd) const
+{
+  Cell cell = GetCell(ulX, ulY, ulZ);
+  raclInd.insert(raclInd.end(), cell.begin(), cell.end());
+  return static_cast<unsigned long>(cell.size());
 }
 
 unsigned long MeshGrid::GetElements(const Base::Vector3f &rclPoint, std::vector<ElementIndex>& aulFacets) const
@@ -659,9 +710,8 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f &rclPoint, std::vector<
   if (!CheckPosition(rclPoint, ulX, ulY, ulZ))
     return 0;
 
-  aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-  std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+  Cell cell = GetCell(ulX, ulY, ulZ);
+  aulFacets.assign(cell.begin(), cell.end());
   return aulFacets.size();
 }
 
@@ -766,15 +816,10 @@ void MeshFacetGrid::RebuildGrid ()
   InitGrid();
 
   // Fill data structure
-  MeshFacetIterator clFIter(*_pclMesh);
-
-  unsigned long i = 0;
-  for (clFIter.Init(); clFIter.More(); clFIter.Next())
-  {
-//    AddFacet(*clFIter, i++, 2.0f);
-    AddFacet(*clFIter, i++);
-  }
-
+  FillGrid(_ulCtElements, [this](ElementIndex begin, ElementIndex end, std::vector<GridEntry>& entries) {
+    for (ElementIndex i = begin; i < end; i++)
+      AddFacet(_pclMesh->GetFacet(i), i, entries);
+  });
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt) const
@@ -1005,8 +1050,8 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX, unsigned long ul
                                              const Base::Vector3f &rclPt, float &rfMinDist,
                                              ElementIndex &rulFacetInd) const
 {
-  const std::set<ElementIndex> &rclSet = _aulGrid[ulX][ulY][ulZ];
-  for (std::set<ElementIndex>::const_iterator pI = rclSet.begin(); pI != rclSet.end(); ++pI)
+  Cell cell = GetCell(ulX, ulY, ulZ);
+  for (const ElementIndex* pI = cell.begin(); pI != cell.end(); ++pI)
   {
     float fDist = _pclMesh->GetFacet(*pI).DistanceToPoint(rclPt);
     if (fDist < rfMinDist)
@@ -1051,13 +1096,12 @@ MeshPointGrid::MeshPointGrid (const MeshKernel &rclM, float fGridLen)
           std::max<unsigned long>(static_cast<unsigned long>(clBBMesh.LengthZ() / fGridLen), 1));
 }
 
-void MeshPointGrid::AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, float fEpsilon)
+void MeshPointGrid::AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, std::vector<GridEntry> &raclEntries) const
 {
-  (void)fEpsilon;
   unsigned long ulX, ulY, ulZ;
   Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
   if ( (ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ) )
-    _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+    raclEntries.emplace_back(GridIndex(ulX, ulY, ulZ), ulPtIndex);
 }
 
 void MeshPointGrid::Validate (const MeshKernel &rclMesh)
@@ -1108,14 +1152,11 @@ void MeshPointGrid::RebuildGrid ()
   InitGrid();
 
   // Fill data structure
-
-  MeshPointIterator cPIter(*_pclMesh);
-
-  unsigned long i = 0;
-  for (cPIter.Init(); cPIter.More(); cPIter.Next())
-  {
-    AddPoint(*cPIter, i++);
-  }
+  const MeshPointArray& rPoints = _pclMesh->GetPoints();
+  FillGrid(_ulCtElements, [this, &rPoints](ElementIndex begin, ElementIndex end, std::vector<GridEntry>& entries) {
+    for (ElementIndex i = begin; i < end; i++)
+      AddPoint(rPoints[i], i, entries);
+  });
 }
 
 void MeshPointGrid::Pos (const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const
@@ -1139,6 +1180,20 @@ unsigned long MeshPointGrid::FindElements (const Base::Vector3f &rclPoint, std::
   return 0;
 }
 
+unsigned long MeshPointGrid::FindElements (const Base::Vector3f &rclPoint, std::vector<ElementIndex>& aulElements) const
+{
+  unsigned long ulX, ulY, ulZ;
+  Pos(rclPoint, ulX, ulY, ulZ);
+
+  // check if the given point is inside the grid structure
+  if ( (ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ) )
+  {
+    return GetElements(ulX, ulY, ulZ, aulElements);
+  }
+
+  return 0;
+}
+
 // ----------------------------------------------------------------
 
 MeshGridIterator::MeshGridIterator (const MeshGrid &rclG)
@@ -1177,7 +1232,7 @@ bool MeshGridIterator::InitOnRay (const Base::Vector3f &rclPt, const Base::Vecto
   if (_rclGrid.GetBoundBox().IsInBox(rclPt))
   {  // Determine the voxel by the starting point
     _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    _rclGrid.GetElements(_ulX, _ulY, _ulZ, raulElements);
     _bValidRay = true;
   }
   else
@@ -1190,7 +1245,7 @@ bool MeshGridIterator::InitOnRay (const Base::Vector3f &rclPt, const Base::Vecto
       else
         _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
 
-      raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+      _rclGrid.GetElements(_ulX, _ulY, _ulZ, raulElements);
       _bValidRay = true;
     }
   }
@@ -1241,7 +1296,7 @@ bool MeshGridIterator::NextOnRay (std::vector<ElementIndex> &raulElements)
   if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ))
   {
     GridElement pos(_ulX, _ulY, _ulZ); _cSearchPositions.insert(pos);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    _rclGrid.GetElements(_ulX, _ulY, _ulZ, raulElements);
   }
   else
     _bValidRay = false;  // Beam leaked
@@ -23,7 +23,10 @@
 #ifndef MESH_GRID_H
 #define MESH_GRID_H
 
+#include <functional>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include <Base/BoundBox.h>
 
@@ -66,6 +69,18 @@ public:
   /// Destruction
   virtual ~MeshGrid () { }
 
+public:
+  /** The element indices stored in a grid element, sorted in ascending order. */
+  struct Cell
+  {
+    const ElementIndex* first;
+    const ElementIndex* last;
+    const ElementIndex* begin() const { return first; }
+    const ElementIndex* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+  };
+
 public:
   /** Attaches the mesh kernel to this grid, an already attached mesh gets detached. The grid gets rebuilt
    * automatically. */
@@ -88,13 +103,20 @@ public:
                                 const Base::Vector3f &rclOrg, float fMaxDist, bool bDelDoubles = true) const;
   /** Searches for the nearest grids that contain elements from a point, the result are grid indices. */
   void SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<ElementIndex> &rclInd) const;
+  /** Searches for the nearest grids that contain elements from a point. The element indices are
+   * returned sorted and without duplicates. */
+  void SearchNearestFromPoint (const Base::Vector3f &rclPt, std::vector<ElementIndex> &rclInd) const;
   //@}
 
   /** @name Getters */
   //@{
   /** Returns the indices of the elements in the given grid. */
   unsigned long GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,  std::set<ElementIndex> &raclInd) const;
+  /** Appends the indices of the elements in the given grid to \a raclInd. */
+  unsigned long GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,  std::vector<ElementIndex> &raclInd) const;
   unsigned long GetElements (const Base::Vector3f &rclPoint, std::vector<ElementIndex>& aulFacets) const;
+  /** Returns the element indices of the given grid without copying them. */
+  inline Cell GetCell (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const;
   //@}
 
   /** Returns the lengths of the grid elements in x,y and z direction. */
@@ -124,7 +146,7 @@ public:
   bool GetPositionToIndex(unsigned long id, unsigned long& ulX, unsigned long& ulY, unsigned long& ulZ) const;
   /** Returns the number of elements in a given grid. */
   unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
-  { return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size()); }
+  { return static_cast<unsigned long>(GetCell(ulX, ulY, ulZ).size()); }
   /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes. */
   virtual void Validate (const MeshKernel &rclM) = 0;
   /** Verifies the grid structure and returns false if inconsistencies are found. */
@@ -140,8 +162,23 @@ public:
   inline bool CheckPos (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const;
   /** Get the indices of all elements lying in the grids around a given grid with distance \a ulDistance. */
   void GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ, unsigned long ulDistance, std::set<ElementIndex> &raclInd) const;
+  /** Appends the indices of all elements lying in the grids around a given grid with distance \a ulDistance.
+   * An element may be appended more than once. */
+  void GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ, unsigned long ulDistance, std::vector<ElementIndex> &raclInd) const;
 
 protected:
+  /// A grid index and the index of an element stored in this grid
+  using GridEntry = std::pair<unsigned long, ElementIndex>;
+  /// Collects the grid entries of the elements in the range [begin, end)
+  using GridCollector = std::function<void (ElementIndex begin, ElementIndex end, std::vector<GridEntry>&)>;
+
+  /** Fills the grid structure. \a collect is called in parallel for consecutive ranges of
+   * the \a ulCtElements elements, the entries are then placed into the grids with a
+   * counting sort. */
+  void FillGrid (unsigned long ulCtElements, const GridCollector& collect);
+  /** Returns the grid index of the given grid position. */
+  inline unsigned long GridIndex (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+  { return (ulZ * _ulCtGridsY + ulY) * _ulCtGridsX + ulX; }
   /** Initializes the size of the internal structure. */
   virtual void InitGrid ();
   /** Deletes the grid structure. */
@@ -156,7 +193,10 @@ protected:
   virtual unsigned long HasElements () const = 0;
 
 protected:
-  std::vector<std::vector<std::vector<std::set<ElementIndex> > > >  _aulGrid;   /**< Grid data structure. */
+  /** Grid data structure in compressed sparse row layout: the elements of the grid with
+   * index i are _aulGridElements[_aulGridOffsets[i]] up to _aulGridElements[_aulGridOffsets[i+1]]. */
+  std::vector<ElementIndex> _aulGridOffsets;
+  std::vector<ElementIndex> _aulGridElements;  /**< Element indices of all grids. */
   const MeshKernel* _pclMesh;     /**< The mesh kernel. */
   unsigned long     _ulCtElements;/**< Number of grid elements for validation issues. */
   unsigned long     _ulCtGridsX;  /**< Number of grid elements in z. */
@@ -226,7 +266,7 @@ protected:
   /** Adds a new facet element to the grid structure. \a rclFacet is the geometric facet and \a ulFacetIndex
    * the corresponding index in the mesh kernel. The facet is added to each grid element that intersects
    * the facet. */
-  inline void AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0f);
+  inline void AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex, std::vector<GridEntry> &raclEntries) const;
   /** Returns the number of stored elements. */
   unsigned long HasElements () const override
   { return _pclMesh->CountFacets(); }
@@ -259,6 +299,8 @@ public:
 
   /** Finds all points that lie in the same grid as the point \a rclPoint. */
   unsigned long FindElements(const Base::Vector3f &rclPoint, std::set<ElementIndex>& aulElements) const;
+  /** Finds all points that lie in the same grid as the point \a rclPoint and appends them to \a aulElements. */
+  unsigned long FindElements(const Base::Vector3f &rclPoint, std::vector<ElementIndex>& aulElements) const;
   /** Validates the grid structure and rebuilds it if needed. */
   void Validate (const MeshKernel &rclM) override;
   /** Validates the grid structure and rebuilds it if needed. */
@@ -269,7 +311,7 @@ public:
 protected:
   /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a ulPtIndex
    * the corresponding index in the mesh kernel. */
-  void AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, float fEpsilon = 0.0f);
+  void AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, std::vector<GridEntry> &raclEntries) const;
   /** Returns the grid numbers to the given point \a rclPoint. */
   void Pos(const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const;
   /** Returns the number of stored elements. */
@@ -294,7 +336,8 @@ public:
   /** Returns indices of the elements in the current grid. */
   void GetElements (std::vector<ElementIndex> &raulElements) const
   {
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    MeshGrid::Cell cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+    raulElements.insert(raulElements.end(), cell.begin(), cell.end());
   }
   /** Returns the number of elements in the current grid. */
   unsigned long GetCtElements() const
@@ -390,6 +433,13 @@ inline bool MeshGrid::CheckPos (unsigned long ulX, unsigned long ulY, unsigned l
   return ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ));
 }
 
+inline MeshGrid::Cell MeshGrid::GetCell (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+{
+  unsigned long ulIndex = GridIndex(ulX, ulY, ulZ);
+  const ElementIndex* data = _aulGridElements.data();
+  return Cell{data + _aulGridOffsets[ulIndex], data + _aulGridOffsets[ulIndex + 1]};
+}
+
 // --------------------------------------------------------------
 
 inline void MeshFacetGrid::Pos (const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const
@@ -433,7 +483,8 @@ inline void MeshFacetGrid::PosWithCheck (const Base::Vector3f &rclPoint, unsigne
   assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
 }
 
-inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex, float /*fEpsilon*/)
+inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex,
+                                     std::vector<GridEntry> &raclEntries) const
 {
   unsigned long ulX, ulY, ulZ;
 
@@ -472,13 +523,13 @@ inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, ElementIndex
         for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++)
         {
           if ( rclFacet.IntersectBoundingBox( GetBoundBox(ulX, ulY, ulZ) ) )
-            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+            raclEntries.emplace_back(GridIndex(ulX, ulY, ulZ), ulFacetIndex);
         }
       }
     }
   }
   else
-    _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+    raclEntries.emplace_back(GridIndex(ulX1, ulY1, ulZ1), ulFacetIndex);
 }
 
 } // namespace MeshCore
@@ -22,12 +22,18 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <cerrno>
+# include <cstdlib>
+# include <limits>
 # include <memory>
 # include <ostream>
 # include <sstream>
+# include <stdexcept>
 # include <boost/tokenizer.hpp>
-# include <xercesc/dom/DOM.hpp>
-# include <xercesc/parsers/XercesDOMParser.hpp>
+# include <xercesc/sax2/Attributes.hpp>
+# include <xercesc/sax2/DefaultHandler.hpp>
+# include <xercesc/sax2/SAX2XMLReader.hpp>
+# include <xercesc/sax2/XMLReaderFactory.hpp>
 #endif
 
 #include <Base/InputSource.h>
@@ -43,6 +49,243 @@
 using namespace MeshCore;
 XERCES_CPP_NAMESPACE_USE
 
+namespace {
+
+// Numbers in the model are plain ASCII, so copying them into a small buffer
+// avoids running the transcoder for each of the millions of attributes.
+const char* asciiValue(const XMLCh* value, char* buf, std::size_t size, std::string& fallback)
+{
+    std::size_t len = 0;
+    for (; value[len] != 0; len++) {
+        if (len + 1 >= size || value[len] > 0x7f) {
+            fallback = StrX(value).c_str();
+            return fallback.c_str();
+        }
+        buf[len] = static_cast<char>(value[len]);
+    }
+    buf[len] = 0;
+    return buf;
+}
+
+// Converts like std::stof and friends but without the temporary strings
+template <typename T, typename Func>
+T toNumber(const XMLCh* value, Func func)
+{
+    char buf[64];
+    std::string fallback;
+    const char* str = asciiValue(value, buf, sizeof(buf), fallback);
+    char* end = nullptr;
+    errno = 0;
+    auto number = func(str, &end);
+    if (end == str)
+        throw std::invalid_argument(str);
+    if (errno == ERANGE)
+        throw std::out_of_range(str);
+    return static_cast<T>(number);
+}
+
+float toFloat(const XMLCh* value)
+{
+    return toNumber<float>(value, [](const char* str, char** end) {
+        return std::strtof(str, end);
+    });
+}
+
+int toInt(const XMLCh* value)
+{
+    long number = toNumber<long>(value, [](const char* str, char** end) {
+        return std::strtol(str, end, 10);
+    });
+    if (number < std::numeric_limits<int>::min() || number > std::numeric_limits<int>::max())
+        throw std::out_of_range("id");
+    return static_cast<int>(number);
+}
+
+PointIndex toIndex(const XMLCh* value)
+{
+    return toNumber<PointIndex>(value, [](const char* str, char** end) {
+        return std::strtoul(str, end, 10);
+    });
+}
+
+}
+
+/*!
+ * \brief The ModelHandler class
+ * SAX handler for the 3D/3dmodel.model part. The vertices and triangles of an
+ * object are appended to the arrays as they are parsed and handed over to the
+ * reader at the end of the mesh element.
+ */
+class Reader3MF::ModelHandler : public DefaultHandler
+{
+public:
+    explicit ModelHandler(Reader3MF& reader)
+        : reader(reader)
+    {
+    }
+
+    bool isValid() const
+    {
+        return modelFound && resourcesFound && buildFound && !reader.meshes.empty();
+    }
+
+    void startElement(const XMLCh* const /*uri*/, const XMLCh* const /*localname*/,
+                      const XMLCh* const qname, const Attributes& attrs) override
+    {
+        // the vertices and triangles are checked first as they are by far the most elements
+        if (inVertices) {
+            if (XMLString::equals(qname, tagVertex.unicodeForm()))
+                addVertex(attrs);
+        }
+        else if (inTriangles) {
+            if (XMLString::equals(qname, tagTriangle.unicodeForm()))
+                addTriangle(attrs);
+        }
+        else if (inMesh) {
+            if (XMLString::equals(qname, tagVertices.unicodeForm()))
+                inVertices = true;
+            else if (XMLString::equals(qname, tagTriangles.unicodeForm()))
+                inTriangles = true;
+        }
+        else if (inObject) {
+            if (objectId && XMLString::equals(qname, tagMesh.unicodeForm()))
+                inMesh = true;
+        }
+        else if (inResources) {
+            if (XMLString::equals(qname, tagObject.unicodeForm())) {
+                inObject = true;
+                const XMLCh* id = attrs.getValue(attrId.unicodeForm());
+                objectId = id != nullptr;
+                if (objectId)
+                    currentId = toInt(id);
+            }
+        }
+        else if (inBuild) {
+            if (XMLString::equals(qname, tagItem.unicodeForm()))
+                addItem(attrs);
+        }
+        else if (inModel) {
+            if (!resourcesFound && XMLString::equals(qname, tagResources.unicodeForm()))
+                inResources = resourcesFound = true;
+            else if (!buildFound && XMLString::equals(qname, tagBuild.unicodeForm()))
+                inBuild = buildFound = true;
+        }
+        else if (!modelFound && XMLString::equals(qname, tagModel.unicodeForm())) {
+            inModel = modelFound = true;
+        }
+    }
+
+    void endElement(const XMLCh* const /*uri*/, const XMLCh* const /*localname*/,
+                    const XMLCh* const qname) override
+    {
+        if (inVertices) {
+            if (XMLString::equals(qname, tagVertices.unicodeForm()))
+                inVertices = false;
+        }
+        else if (inTriangles) {
+            if (XMLString::equals(qname, tagTriangles.unicodeForm()))
+                inTriangles = false;
+        }
+        else if (inMesh) {
+            if (XMLString::equals(qname, tagMesh.unicodeForm())) {
+                inMesh = false;
+                reader.LoadMesh(currentId, points, facets);
+                points.clear();
+                facets.clear();
+            }
+        }
+        else if (inObject) {
+            if (XMLString::equals(qname, tagObject.unicodeForm()))
+                inObject = false;
+        }
+        else if (inResources) {
+            if (XMLString::equals(qname, tagResources.unicodeForm()))
+                inResources = false;
+        }
+        else if (inBuild) {
+            if (XMLString::equals(qname, tagBuild.unicodeForm()))
+                inBuild = false;
+        }
+        else if (inModel) {
+            if (XMLString::equals(qname, tagModel.unicodeForm()))
+                inModel = false;
+        }
+    }
+
+    void endDocument() override
+    {
+        // apply the placements once all objects are known
+        for (const auto& it : items)
+            reader.LoadItem(it.first, it.second);
+        items.clear();
+    }
+
+private:
+    void addVertex(const Attributes& attrs)
+    {
+        const XMLCh* x = attrs.getValue(attrX.unicodeForm());
+        const XMLCh* y = attrs.getValue(attrY.unicodeForm());
+        const XMLCh* z = attrs.getValue(attrZ.unicodeForm());
+        if (x && y && z)
+            points.emplace_back(toFloat(x), toFloat(y), toFloat(z));
+    }
+
+    void addTriangle(const Attributes& attrs)
+    {
+        const XMLCh* v1 = attrs.getValue(attrV1.unicodeForm());
+        const XMLCh* v2 = attrs.getValue(attrV2.unicodeForm());
+        const XMLCh* v3 = attrs.getValue(attrV3.unicodeForm());
+        if (v1 && v2 && v3)
+            facets.emplace_back(toIndex(v1), toIndex(v2), toIndex(v3));
+    }
+
+    void addItem(const Attributes& attrs)
+    {
+        const XMLCh* id = attrs.getValue(attrObjectId.unicodeForm());
+        const XMLCh* transform = attrs.getValue(attrTransform.unicodeForm());
+        if (id && transform)
+            items.emplace_back(toInt(id), StrX(transform).c_str());
+    }
+
+private:
+    Reader3MF& reader;
+    MeshPointArray points;
+    MeshFacetArray facets;
+    std::vector<std::pair<int, std::string>> items;
+    int currentId = 0;
+    bool objectId = false;
+    bool modelFound = false;
+    bool resourcesFound = false;
+    bool buildFound = false;
+    bool inModel = false;
+    bool inResources = false;
+    bool inObject = false;
+    bool inMesh = false;
+    bool inVertices = false;
+    bool inTriangles = false;
+    bool inBuild = false;
+
+    const XStr tagModel{"model"};
+    const XStr tagResources{"resources"};
+    const XStr tagObject{"object"};
+    const XStr tagMesh{"mesh"};
+    const XStr tagVertices{"vertices"};
+    const XStr tagVertex{"vertex"};
+    const XStr tagTriangles{"triangles"};
+    const XStr tagTriangle{"triangle"};
+    const XStr tagBuild{"build"};
+    const XStr tagItem{"item"};
+    const XStr attrId{"id"};
+    const XStr attrX{"x"};
+    const XStr attrY{"y"};
+    const XStr attrZ{"z"};
+    const XStr attrV1{"v1"};
+    const XStr attrV2{"v2"};
+    const XStr attrV3{"v3"};
+    const XStr attrObjectId{"objectid"};
+    const XStr attrTransform{"transform"};
+};
+
 Reader3MF::Reader3MF(std::istream &str)
 {
     zipios::ZipHeader zipHeader(str);
@@ -85,226 +328,75 @@ bool Reader3MF::Load()
 bool Reader3MF::LoadModel(std::istream& str)
 {
     try {
-        std::unique_ptr<XercesDOMParser> parser(new XercesDOMParser);
-        parser->setValidationScheme(XercesDOMParser::Val_Auto);
-        parser->setDoNamespaces(false);
-        parser->setDoSchema(false);
-        parser->setValidationSchemaFullChecking(false);
-        parser->setCreateEntityReferenceNodes(false);
+        std::unique_ptr<SAX2XMLReader> parser(XMLReaderFactory::createXMLReader());
+        parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
+        parser->setFeature(XMLUni::fgSAX2CoreValidation, true);
+        parser->setFeature(XMLUni::fgXercesDynamic, true);
+        parser->setFeature(XMLUni::fgXercesSchema, false);
+        parser->setFeature(XMLUni::fgXercesSchemaFullChecking, false);
+
+        ModelHandler handler(*this);
+        parser->setContentHandler(&handler);
+        parser->setErrorHandler(&handler);
 
         Base::StdInputSource inputSource(str, "3dmodel.model");
         parser->parse(inputSource);
-        std::unique_ptr<DOMDocument> xmlDocument(parser->adoptDocument());
-        return LoadModel(*xmlDocument);
+        return handler.isValid();
     }
     catch (const XMLException&) {
+        meshes.clear();
         return false;
     }
-    catch (const DOMException&) {
-        return false;
-    }
-}
-
-bool Reader3MF::LoadModel(DOMDocument& xmlDocument)
-{
-    DOMNodeList *nodes = xmlDocument.getElementsByTagName(XStr("model").unicodeForm());
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            bool resource = LoadResources(static_cast<DOMElement*>(node)->getElementsByTagName(XStr("resources").unicodeForm()));
-            bool build = LoadBuild(static_cast<DOMElement*>(node)->getElementsByTagName(XStr("build").unicodeForm()));
-            return (resource && build);
-        }
-    }
-
-    return false;
-}
-
-bool Reader3MF::LoadResources(DOMNodeList* nodes)
-{
-    if (!nodes)
-        return false;
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            DOMNodeList *objectList = static_cast<DOMElement*>(node)->getElementsByTagName(XStr("object").unicodeForm());
-            return LoadObjects(objectList);
-        }
-    }
-
-    return false;
-}
-
-bool Reader3MF::LoadBuild(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList* nodes)
-{
-    if (!nodes)
+    catch (const SAXException&) {
+        meshes.clear();
         return false;
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            DOMNodeList *objectList = static_cast<DOMElement*>(node)->getElementsByTagName(XStr("item").unicodeForm());
-            return LoadItems(objectList);
-        }
     }
-
-    return false;
-}
-
-bool Reader3MF::LoadItems(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList* nodes)
-{
-    const std::size_t numEntries = 12;
-    if (!nodes)
-        return false;
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* itemNode = nodes->item(i);
-        DOMNode* idAttr = itemNode->getAttributes()->getNamedItem(XStr("objectid").unicodeForm());
-        if (idAttr) {
-            std::string id = StrX(idAttr->getNodeValue()).c_str();
-            int idValue = std::stoi(id);
-            Base::Matrix4D mat;
-
-            DOMNode* transformAttr = itemNode->getAttributes()->getNamedItem(XStr("transform").unicodeForm());
-            if (transformAttr) {
-                std::string transform = StrX(transformAttr->getNodeValue()).c_str();
-                boost::char_separator<char> sep(" ,");
-                boost::tokenizer<boost::char_separator<char> > tokens(transform, sep);
-                std::vector<std::string> token_results;
-                token_results.assign(tokens.begin(), tokens.end());
-                if (token_results.size() == numEntries) {
-                    mat[0][0] = std::stod(token_results[0]);
-                    mat[1][0] = std::stod(token_results[1]);
-                    mat[2][0] = std::stod(token_results[2]);
-                    mat[0][1] = std::stod(token_results[3]);
-                    mat[1][1] = std::stod(token_results[4]);
-                    mat[2][1] = std::stod(token_results[5]);
-                    mat[0][2] = std::stod(token_results[6]);
-                    mat[1][2] = std::stod(token_results[7]);
-                    mat[2][2] = std::stod(token_results[8]);
-                    mat[0][3] = std::stod(token_results[9]);
-                    mat[1][3] = std::stod(token_results[10]);
-                    mat[2][3] = std::stod(token_results[11]);
-
-                    try {
-                        meshes.at(idValue).second = mat;
-                    }
-                    catch (const std::exception&) {
-                    }
-                }
-            }
-        }
-    }
-
-    return true;
-}
-
-bool Reader3MF::LoadObjects(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList* nodes)
-{
-    if (!nodes)
+    catch (const std::exception&) {
+        // invalid numbers of the attributes
+        meshes.clear();
         return false;
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* objectNode = nodes->item(i);
-        if (objectNode->getNodeType() == DOMNode::ELEMENT_NODE) {
-            DOMNode* idAttr = objectNode->getAttributes()->getNamedItem(XStr("id").unicodeForm());
-            if (idAttr) {
-                int id = std::stoi(StrX(idAttr->getNodeValue()).c_str());
-                DOMNodeList *meshList = static_cast<DOMElement*>(objectNode)->getElementsByTagName(XStr("mesh").unicodeForm());
-                LoadMesh(meshList, id);
-            }
-        }
     }
-
-    return (!meshes.empty());
 }
 
-void Reader3MF::LoadMesh(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList* nodes, int id)
+void Reader3MF::LoadMesh(int id, MeshPointArray& points, MeshFacetArray& facets)
 {
-    if (!nodes)
+    // only the first mesh of an object is used
+    if (meshes.find(id) != meshes.end())
         return;
 
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            MeshPointArray points;
-            MeshFacetArray facets;
-            LoadVertices(static_cast<DOMElement*>(node)->getElementsByTagName(XStr("vertices").unicodeForm()), points);
-            LoadTriangles(static_cast<DOMElement*>(node)->getElementsByTagName(XStr("triangles").unicodeForm()), facets);
-
-            MeshCleanup meshCleanup(points, facets);
-            meshCleanup.RemoveInvalids();
-            MeshPointFacetAdjacency meshAdj(points.size(), facets);
-            meshAdj.SetFacetNeighbourhood();
-
-            MeshKernel kernel;
-            kernel.Adopt(points, facets);
-            meshes.emplace(id, std::make_pair(kernel, Base::Matrix4D()));
-        }
-    }
-}
+    MeshCleanup meshCleanup(points, facets);
+    meshCleanup.RemoveInvalids();
+    MeshPointFacetAdjacency meshAdj(points.size(), facets);
+    meshAdj.SetFacetNeighbourhood();
 
-void Reader3MF::LoadVertices(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList* nodes, MeshPointArray& points)
-{
-    if (!nodes)
-        return;
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            DOMNodeList *vertexList = static_cast<DOMElement*>(node)->getElementsByTagName(XStr("vertex").unicodeForm());
-            if (vertexList) {
-                XMLSize_t numVertices = vertexList->getLength();
-                points.reserve(numVertices);
-                for (XMLSize_t j = 0; j < numVertices; j++) {
-                    DOMNode* vertexNode = vertexList->item(j);
-                    DOMNamedNodeMap* attr = vertexNode->getAttributes();
-                    if (attr) {
-                        DOMNode* xAttr = attr->getNamedItem(XStr("x").unicodeForm());
-                        DOMNode* yAttr = attr->getNamedItem(XStr("y").unicodeForm());
-                        DOMNode* zAttr = attr->getNamedItem(XStr("z").unicodeForm());
-                        if (xAttr && yAttr && zAttr) {
-                            float x = std::stof(StrX(xAttr->getNodeValue()).c_str());
-                            float y = std::stof(StrX(yAttr->getNodeValue()).c_str());
-                            float z = std::stof(StrX(zAttr->getNodeValue()).c_str());
-                            points.emplace_back(x, y, z);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    // adopt the arrays in place to avoid copying the kernel
+    meshes[id].first.Adopt(points, facets);
 }
 
-void Reader3MF::LoadTriangles(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList* nodes, MeshFacetArray& facets)
+void Reader3MF::LoadItem(int id, const std::string& transform)
 {
-    if (!nodes)
-        return;
-
-    for (XMLSize_t i = 0; i < nodes->getLength(); i++) {
-        DOMNode* node = nodes->item(i);
-        if (node->getNodeType() == DOMNode::ELEMENT_NODE) {
-            DOMNodeList *triangleList = static_cast<DOMElement*>(node)->getElementsByTagName(XStr("triangle").unicodeForm());
-            if (triangleList) {
-                XMLSize_t numTriangles = triangleList->getLength();
-                facets.reserve(numTriangles);
-                for (XMLSize_t j = 0; j < numTriangles; j++) {
-                    DOMNode* triangleNode = triangleList->item(j);
-                    DOMNamedNodeMap* attr = triangleNode->getAttributes();
-                    if (attr) {
-                        DOMNode* v1Attr = attr->getNamedItem(XStr("v1").unicodeForm());
-                        DOMNode* v2Attr = attr->getNamedItem(XStr("v2").unicodeForm());
-                        DOMNode* v3Attr = attr->getNamedItem(XStr("v3").unicodeForm());
-                        if (v1Attr && v2Attr && v3Attr) {
-                            PointIndex v1 = std::stoul(StrX(v1Attr->getNodeValue()).c_str());
-                            PointIndex v2 = std::stoul(StrX(v2Attr->getNodeValue()).c_str());
-                            PointIndex v3 = std::stoul(StrX(v3Attr->getNodeValue()).c_str());
-                            facets.emplace_back(v1, v2, v3);
-                        }
-                    }
-                }
-            }
-        }
+    const std::size_t numEntries = 12;
+    boost::char_separator<char> sep(" ,");
+    boost::tokenizer<boost::char_separator<char> > tokens(transform, sep);
+    std::vector<std::string> token_results;
+    token_results.assign(tokens.begin(), tokens.end());
+    if (token_results.size() == numEntries) {
+        Base::Matrix4D mat;
+        mat[0][0] = std::stod(token_results[0]);
+        mat[1][0] = std::stod(token_results[1]);
+        mat[2][0] = std::stod(token_results[2]);
+        mat[0][1] = std::stod(token_results[3]);
+        mat[1][1] = std::stod(token_results[4]);
+        mat[2][1] = std::stod(token_results[5]);
+        mat[0][2] = std::stod(token_results[6]);
+        mat[1][2] = std::stod(token_results[7]);
+        mat[2][2] = std::stod(token_results[8]);
+        mat[0][3] = std::stod(token_results[9]);
+        mat[1][3] = std::stod(token_results[10]);
+        mat[2][3] = std::stod(token_results[11]);
+
+        auto it = meshes.find(id);
+        if (it != meshes.end())
+            it->second.second = mat;
     }
 }
@@ -27,19 +27,16 @@
 #include <iosfwd>
 #include <memory>
 #include <unordered_map>
-#include <xercesc/util/XercesDefs.hpp>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/MeshGlobal.h>
 
-XERCES_CPP_NAMESPACE_BEGIN
-class DOMDocument;
-class DOMNodeList;
-XERCES_CPP_NAMESPACE_END
-
 namespace MeshCore
 {
 
-/** Loads the mesh object from data in 3MF format. */
+/** Loads the mesh object from data in 3MF format.
+ * The model XML is parsed as a stream, i.e. the vertices and triangles are read
+ * directly into the point and facet arrays without building a document tree.
+ */
 class MeshExport Reader3MF
 {
 public:
@@ -72,15 +69,10 @@ public:
     }
 
 private:
+    class ModelHandler;
     bool LoadModel(std::istream&);
-    bool LoadModel(XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument&);
-    bool LoadResources(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList*);
-    bool LoadBuild(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList*);
-    bool LoadItems(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList*);
-    bool LoadObjects(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList*);
-    void LoadMesh(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList*, int id);
-    void LoadVertices(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList*, MeshPointArray&);
-    void LoadTriangles(XERCES_CPP_NAMESPACE_QUALIFIER DOMNodeList*, MeshFacetArray&);
+    void LoadMesh(int id, MeshPointArray&, MeshFacetArray&);
+    void LoadItem(int id, const std::string& transform);
 
 private:
     using MeshKernelAndTransform = std::pair<MeshKernel, Base::Matrix4D>;
@@ -0,0 +1,254 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <cstring>
+# include <istream>
+# include <limits>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Stream.h>
+#include <Base/Swap.h>
+#include "Core/MeshKernel.h"
+
+#include "ReaderBMS.h"
+#include "WriterBMS.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+/* Decodes the variable-length integers of a section written by WriterBMS. */
+class Section
+{
+public:
+    Section(Base::InputStream& str, std::istream& in)
+    {
+        uint64_t size = 0;
+        str >> size;
+        if (!in || size > static_cast<uint64_t>(std::numeric_limits<std::streamsize>::max()))
+            throw Base::BadFormatError("Reading from stream failed");
+        data.resize(static_cast<std::size_t>(size));
+        if (!in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size)))
+            throw Base::BadFormatError("Reading from stream failed");
+    }
+
+    std::size_t Size() const
+    {
+        return data.size();
+    }
+    uint64_t ReadVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos == data.size())
+                throw Base::BadFormatError("Invalid data structure");
+            unsigned char byte = data[pos++];
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        throw Base::BadFormatError("Invalid data structure");
+    }
+    static uint64_t Difference(uint64_t value)
+    {
+        return (value >> 1) ^ (~(value & 1) + 1);
+    }
+    uint64_t ReadDifference(uint64_t reference)
+    {
+        return reference + Difference(ReadVarint());
+    }
+    float ReadCoordinate(float reference)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &reference, sizeof(bits));
+        bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        bits += static_cast<uint32_t>(Difference(ReadVarint()));
+        // back from the ordered integer to the bit pattern
+        bits = (bits & 0x80000000u) ? (bits & 0x7fffffffu) : ~bits;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::string ReadString(uint64_t length)
+    {
+        if (data.size() - pos < length)
+            throw Base::BadFormatError("Invalid data structure");
+        std::string str(reinterpret_cast<const char*>(data.data() + pos), static_cast<std::size_t>(length));
+        pos += static_cast<std::size_t>(length);
+        return str;
+    }
+
+private:
+    std::vector<unsigned char> data;
+    std::size_t pos = 0;
+};
+
+}
+
+ReaderBMS::ReaderBMS(MeshKernel& kernel)
+  : _kernel(kernel)
+  , _compact(false)
+{
+    _kernel.Expand();
+}
+
+void ReaderBMS::Load(std::istream &str)
+{
+    _compact = false;
+    _groups.clear();
+    if (!str || str.bad())
+        return;
+
+    Base::InputStream is(str);
+    uint32_t magic = 0, version = 0;
+    is >> magic >> version;
+
+    uint32_t swap_magic = magic, swap_version = version;
+    Base::SwapEndian(swap_magic);
+    Base::SwapEndian(swap_version);
+    if (magic == 0xA0B0C0D0 && version == WriterBMS::Version) {
+        LoadCompact(str, false);
+    }
+    else if (swap_magic == 0xA0B0C0D0 && swap_version == WriterBMS::Version) {
+        LoadCompact(str, true);
+    }
+    else {
+        _kernel.Read(str, magic, version);
+    }
+}
+
+void ReaderBMS::LoadCompact(std::istream &str, bool swap)
+{
+    Base::InputStream is(str);
+    if (swap)
+        is.setByteOrder(Base::Stream::BigEndian);
+
+    uint32_t flags = 0;
+    uint64_t ulCtPts = 0, ulCtFts = 0;
+    is >> flags >> ulCtPts >> ulCtFts;
+
+    Base::BoundBox3f bbox;
+    is >> bbox.MinX >> bbox.MaxX;
+    is >> bbox.MinY >> bbox.MaxY;
+    is >> bbox.MinZ >> bbox.MaxZ;
+    if (!str)
+        throw Base::BadFormatError("Reading from stream failed");
+
+    // each point and facet takes at least three bytes, check the counts
+    // before allocating any memory
+    Section points(is, str);
+    if (ulCtPts > points.Size() / 3)
+        throw Base::BadFormatError("Invalid data structure");
+    MeshPointArray pointArray(static_cast<PointIndex>(ulCtPts));
+    Base::Vector3f ref;
+    for (MeshPoint& pnt : pointArray) {
+        pnt.x = points.ReadCoordinate(ref.x);
+        pnt.y = points.ReadCoordinate(ref.y);
+        pnt.z = points.ReadCoordinate(ref.z);
+        ref = pnt;
+    }
+
+    Section corners(is, str);
+    if (ulCtFts > corners.Size() / 3)
+        throw Base::BadFormatError("Invalid data structure");
+    MeshFacetArray facetArray(static_cast<FacetIndex>(ulCtFts));
+    PointIndex first = 0;
+    for (MeshFacet& face : facetArray) {
+        first = corners.ReadDifference(first);
+        face._aulPoints[0] = first;
+        face._aulPoints[1] = corners.ReadDifference(first);
+        face._aulPoints[2] = corners.ReadDifference(first);
+        for (int i = 0; i < 3; i++) {
+            if (face._aulPoints[i] >= ulCtPts)
+                throw Base::BadFormatError("Invalid data structure");
+        }
+    }
+
+    Section neighbours(is, str);
+    for (FacetIndex index = 0; index < ulCtFts; index++) {
+        MeshFacet& face = facetArray[index];
+        for (int i = 0; i < 3; i++) {
+            uint64_t value = neighbours.ReadVarint();
+            if (value == 0) {
+                face._aulNeighbours[i] = FACET_INDEX_MAX;
+            }
+            else {
+                FacetIndex neighbour = index + Section::Difference(value - 1);
+                if (neighbour >= ulCtFts)
+                    throw Base::BadFormatError("Invalid data structure");
+                face._aulNeighbours[i] = neighbour;
+            }
+        }
+    }
+
+    if (flags & 0x1) {
+        Section props(is, str);
+        unsigned long prop = 0;
+        for (MeshPoint& pnt : pointArray) {
+            prop = props.ReadDifference(prop);
+            pnt._ulProp = prop;
+        }
+    }
+
+    if (flags & 0x2) {
+        Section props(is, str);
+        unsigned long prop = 0;
+        for (MeshFacet& face : facetArray) {
+            prop = props.ReadDifference(prop);
+            face._ulProp = prop;
+        }
+    }
+
+    std::vector<Group> groups;
+    if (flags & 0x4) {
+        Section data(is, str);
+        uint64_t ulCtGroups = data.ReadVarint();
+        if (ulCtGroups > data.Size())
+            throw Base::BadFormatError("Invalid data structure");
+        groups.resize(static_cast<std::size_t>(ulCtGroups));
+        for (Group& group : groups) {
+            group.name = data.ReadString(data.ReadVarint());
+            uint64_t ulCtIndices = data.ReadVarint();
+            if (ulCtIndices > data.Size())
+                throw Base::BadFormatError("Invalid data structure");
+            group.indices.resize(static_cast<std::size_t>(ulCtIndices));
+            FacetIndex index = 0;
+            for (FacetIndex& it : group.indices) {
+                index = data.ReadDifference(index);
+                if (index >= ulCtFts)
+                    throw Base::BadFormatError("Invalid data structure");
+                it = index;
+            }
+        }
+    }
+
+    // If we reach this block the data is valid and we can safely assign the mesh
+    _kernel._aclPointArray.swap(pointArray);
+    _kernel._aclFacetArray.swap(facetArray);
+    _kernel._clBoundBox = bbox;
+    _groups.swap(groups);
+    _compact = true;
+}
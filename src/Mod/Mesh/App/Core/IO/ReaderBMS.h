@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_IO_READER_BMS_H
+#define MESH_IO_READER_BMS_H
+
+#include <iosfwd>
+#include <vector>
+#include <Mod/Mesh/MeshGlobal.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+
+namespace MeshCore
+{
+
+/** Loads the mesh object from data in the binary BMS format.
+ * Both the compact version written by \ref WriterBMS and the uncompressed
+ * versions written by MeshKernel::Write() are supported.
+ */
+class MeshExport ReaderBMS
+{
+public:
+    /*!
+     * \brief ReaderBMS
+     */
+    explicit ReaderBMS(MeshKernel& kernel);
+    /*!
+     * \brief Load the mesh from the input stream.
+     * Invalid data raises a Base::BadFormatError and leaves the kernel unchanged.
+     */
+    void Load(std::istream &str);
+    /*!
+     * \brief Returns true if the data was in the compact version. Its
+     * neighbourhood and bounding box were saved with the mesh.
+     */
+    bool IsCompact() const {
+        return _compact;
+    }
+    /*!
+     * \brief Returns the mesh groups saved with the compact version.
+     */
+    const std::vector<Group>& GetGroups() const {
+        return _groups;
+    }
+
+private:
+    void LoadCompact(std::istream &str, bool swap);
+
+private:
+    MeshKernel& _kernel;
+    std::vector<Group> _groups;
+    bool _compact;
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_BMS_H
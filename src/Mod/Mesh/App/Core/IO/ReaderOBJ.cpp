@@ -22,9 +22,9 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 # include <istream>
 # include <boost/lexical_cast.hpp>
-# include <boost/regex.hpp>
 # include <boost/tokenizer.hpp>
 #endif
 
@@ -33,6 +33,7 @@
 #include "Core/MeshKernel.h"
 
 #include "ReaderOBJ.h"
+#include "TextParser.h"
 
 
 using namespace MeshCore;
@@ -43,42 +44,146 @@ ReaderOBJ::ReaderOBJ(MeshKernel& kernel, Material* material)
 {
 }
 
-bool ReaderOBJ::Load(std::istream &str)
+namespace {
+
+/* The content of a chunk of lines of an OBJ file. Negative face indices are
+ * resolved against the points of the chunk and get the offset of the chunk
+ * added when merging the chunks.
+ */
+struct ChunkOBJ
 {
-    boost::regex rx_m("^mtllib\\s+(.+)\\s*$");
-    boost::regex rx_u("^usemtl\\s+([\\x21-\\x7E]+)\\s*$");
-    boost::regex rx_g("^g\\s+([\\x21-\\x7E]+)\\s*$");
-    boost::regex rx_p("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_c("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+(\\d{1,3})\\s+(\\d{1,3})\\s+(\\d{1,3})\\s*$");
-    boost::regex rx_t("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                        "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_f3("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::regex rx_f4("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                         "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::cmatch what;
+    enum Kind {
+        Group, Library, UseMaterial
+    };
+    struct Face
+    {
+        long index[4];
+        bool relative[4];
+        int count;
+    };
+    struct Directive
+    {
+        std::size_t face;  // index of the next face
+        Kind kind;
+        std::string name;
+    };
 
-    unsigned long segment=0;
-    MeshPointArray meshPoints;
-    MeshFacetArray meshFacets;
+    MeshPointArray points;
+    bool colors = false;
+    std::vector<Face> faces;
+    std::vector<Directive> directives;
 
-    std::string line;
-    float fX, fY, fZ;
-    int  i1=1, i2=1, i3=1, i4=1;
-    MeshFacet item;
+    void ParseLine(const char* first, const char* last);
+
+private:
+    void ParseVertex(const char* pos, const char* last);
+    void ParseFace(const char* pos, const char* last);
+    void ParseName(const char* pos, const char* last, Kind kind, bool singleToken);
+};
+
+void ChunkOBJ::ParseLine(const char* first, const char* last)
+{
+    const char* pos = TextParser::SkipBlanks(first, last);
+    const char* next = nullptr;
+    if ((next = TextParser::ParseKeyword(pos, last, "v")) != pos)
+        ParseVertex(next, last);
+    else if ((next = TextParser::ParseKeyword(pos, last, "f")) != pos)
+        ParseFace(next, last);
+    else if ((next = TextParser::ParseKeyword(pos, last, "g")) != pos)
+        ParseName(next, last, Group, true);
+    else if ((next = TextParser::ParseKeyword(pos, last, "mtllib")) != pos)
+        ParseName(next, last, Library, false);
+    else if ((next = TextParser::ParseKeyword(pos, last, "usemtl")) != pos)
+        ParseName(next, last, UseMaterial, true);
+}
+
+void ChunkOBJ::ParseVertex(const char* pos, const char* last)
+{
+    // x y z, optionally followed by an RGB color either as integers in [0, 255] or as floats
+    float values[6];
+    const char* tokens[6];
+    int count = 0;
+    while (count < 6) {
+        pos = TextParser::SkipBlanks(pos, last);
+        const char* next = TextParser::ParseNumber(pos, last, values[count]);
+        if (next == pos)
+            break;
+        tokens[count++] = pos;
+        pos = next;
+    }
+    if (!TextParser::AtEnd(pos, last) || (count != 3 && count != 6))
+        return;
+
+    points.push_back(MeshPoint(Base::Vector3f(values[0], values[1], values[2])));
+    if (count == 6) {
+        // a token with up to three digits is an 8-bit value
+        auto isByte = [last](const char* token) {
+            const char* end = TextParser::SkipToken(token, last);
+            return end - token <= 3 && std::all_of(token, end, [](char c) { return c >= '0' && c <= '9'; });
+        };
+        float r = values[3], g = values[4], b = values[5];
+        if (isByte(tokens[3]) && isByte(tokens[4]) && isByte(tokens[5])) {
+            r = std::min(r, 255.0f) / 255.0f;
+            g = std::min(g, 255.0f) / 255.0f;
+            b = std::min(b, 255.0f) / 255.0f;
+        }
 
+        App::Color c(r,g,b);
+        unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
+        points.back().SetProperty(prop);
+        colors = true;
+    }
+}
+
+void ChunkOBJ::ParseFace(const char* pos, const char* last)
+{
+    // a vertex is given as v, v/vt, v//vn or v/vt/vn
+    Face face;
+    face.count = 0;
+    while (face.count < 5) {
+        pos = TextParser::SkipBlanks(pos, last);
+        long index;
+        const char* next = TextParser::ParseInteger(pos, last, index);
+        if (next == pos)
+            break;
+        for (int i = 0; i < 2 && next != last && *next == '/'; i++) {
+            long skip;
+            next = TextParser::ParseInteger(next + 1, last, skip);
+        }
+        if (next != last && !TextParser::IsBlank(*next))
+            return;
+        if (face.count < 4) {
+            face.relative[face.count] = (index <= 0);
+            face.index[face.count] = index > 0 ? index - 1 : index + static_cast<long>(points.size());
+        }
+        face.count++;
+        pos = next;
+    }
+    if (TextParser::AtEnd(pos, last) && (face.count == 3 || face.count == 4))
+        faces.push_back(face);
+}
+
+void ChunkOBJ::ParseName(const char* pos, const char* last, Kind kind, bool singleToken)
+{
+    pos = TextParser::SkipBlanks(pos, last);
+    while (last != pos && TextParser::IsBlank(*(last - 1)))
+        --last;
+    if (pos == last)
+        return;
+    if (singleToken && TextParser::SkipToken(pos, last) != last)
+        return;
+
+    Directive directive;
+    directive.face = faces.size();
+    directive.kind = kind;
+    directive.name = Base::Tools::escapedUnicodeToUtf8(std::string(pos, last));
+    directives.push_back(directive);
+}
+
+}
+
+bool ReaderOBJ::Load(std::istream &str)
+{
     if (!str || str.bad())
         return false;
 
@@ -86,86 +191,68 @@ bool ReaderOBJ::Load(std::istream &str)
     if (!buf)
         return false;
 
+    // parse the chunks of lines in parallel
+    TextParser parser(str);
+    std::vector<ChunkOBJ> chunks(parser.CountChunks());
+    parser.ParseChunks([&chunks](std::size_t chunk, const char* first, const char* last) {
+        ChunkOBJ& data = chunks[chunk];
+        TextParser::ForEachLine(first, last, [&data](const char* pos, const char* eol) {
+            data.ParseLine(pos, eol);
+        });
+    });
+
+    unsigned long segment=0;
+    MeshPointArray meshPoints;
+    MeshFacetArray meshFacets;
+    MeshFacet item;
+
     MeshIO::Binding rgb_value = MeshIO::OVERALL;
     bool new_segment = true;
     std::string groupName;
     std::string materialName;
     unsigned long countMaterialFacets = 0;
 
-    while (std::getline(str, line)) {
-        if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_c)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            float r = std::min<int>(std::atof(what[10].first), 255) / 255.0f;
-            float g = std::min<int>(std::atof(what[11].first), 255) / 255.0f;
-            float b = std::min<int>(std::atof(what[12].first), 255) / 255.0f;
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-
-            App::Color c(r,g,b);
-            unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
-            rgb_value = MeshIO::PER_VERTEX;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_t)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            float r = static_cast<float>(std::atof(what[10].first));
-            float g = static_cast<float>(std::atof(what[13].first));
-            float b = static_cast<float>(std::atof(what[16].first));
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-
-            App::Color c(r,g,b);
-            unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
+    std::size_t ulCtPoints = 0, ulCtFacets = 0;
+    for (const auto& it : chunks) {
+        ulCtPoints += it.points.size();
+        ulCtFacets += 2 * it.faces.size();
+    }
+    meshPoints.reserve(ulCtPoints);
+    meshFacets.reserve(ulCtFacets);
+
+    // merge the chunks in file order
+    for (auto& chunk : chunks) {
+        long offset = static_cast<long>(meshPoints.size());
+        meshPoints.insert(meshPoints.end(), chunk.points.begin(), chunk.points.end());
+        MeshPointArray().swap(chunk.points);
+        if (chunk.colors)
             rgb_value = MeshIO::PER_VERTEX;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_g)) {
-            new_segment = true;
-            groupName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_m)) {
-            if (_material)
-                _material->library = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_u)) {
-            if (!materialName.empty()) {
-                _materialNames.emplace_back(materialName, countMaterialFacets);
-            }
-            materialName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-            countMaterialFacets = 0;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_f3)) {
-            // starts a new segment
-            if (new_segment) {
-                if (!groupName.empty()) {
-                    _groupNames.push_back(groupName);
-                    groupName.clear();
+
+        auto directive = chunk.directives.begin();
+        for (std::size_t index = 0; index <= chunk.faces.size(); index++) {
+            for (; directive != chunk.directives.end() && directive->face == index; ++directive) {
+                switch (directive->kind) {
+                case ChunkOBJ::Group:
+                    new_segment = true;
+                    groupName = directive->name;
+                    break;
+                case ChunkOBJ::Library:
+                    if (_material)
+                        _material->library = directive->name;
+                    break;
+                case ChunkOBJ::UseMaterial:
+                    if (!materialName.empty()) {
+                        _materialNames.emplace_back(materialName, countMaterialFacets);
+                    }
+                    materialName = directive->name;
+                    countMaterialFacets = 0;
+                    break;
                 }
-                new_segment = false;
-                segment++;
             }
 
-            // 3-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1-1 : i1+static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2-1 : i2+static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3-1 : i3+static_cast<int>(meshPoints.size());
-            item.SetVertices(i1,i2,i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_f4)) {
+            if (index == chunk.faces.size())
+                break;
+
             // starts a new segment
             if (new_segment) {
                 if (!groupName.empty()) {
@@ -176,25 +263,23 @@ bool ReaderOBJ::Load(std::istream &str)
                 segment++;
             }
 
-            // 4-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1-1 : i1+static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2-1 : i2+static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3-1 : i3+static_cast<int>(meshPoints.size());
-            i4 = std::atoi(what[4].first);
-            i4 = i4 > 0 ? i4-1 : i4+static_cast<int>(meshPoints.size());
-
-            item.SetVertices(i1,i2,i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
+            const ChunkOBJ::Face& face = chunk.faces[index];
+            PointIndex i[4];
+            for (int j = 0; j < face.count; j++)
+                i[j] = static_cast<PointIndex>(face.relative[j] ? face.index[j] + offset : face.index[j]);
 
-            item.SetVertices(i3,i4,i1);
+            // 3-vertex or 4-vertex face
+            item.SetVertices(i[0],i[1],i[2]);
             item.SetProperty(segment);
             meshFacets.push_back(item);
             countMaterialFacets++;
+
+            if (face.count == 4) {
+                item.SetVertices(i[2],i[3],i[0]);
+                item.SetProperty(segment);
+                meshFacets.push_back(item);
+                countMaterialFacets++;
+            }
         }
     }
 
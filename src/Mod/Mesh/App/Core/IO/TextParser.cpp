@@ -0,0 +1,266 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <cstdint>
+# include <cstdlib>
+# include <istream>
+# include <string>
+#endif
+
+#include "TextParser.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+// powers of ten that are exactly representable as double
+const double exactPowers[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+char toLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+}
+
+}
+
+TextParser::TextParser(const char* data, std::size_t size)
+  : _pData(data)
+  , _ulSize(size)
+{
+}
+
+TextParser::TextParser(std::istream &str)
+  : _pData(nullptr)
+  , _ulSize(0)
+{
+    std::streambuf* buf = str.rdbuf();
+    if (buf) {
+        const std::streamsize blockSize = 1 << 20;
+        std::size_t size = 0;
+        while (true) {
+            _buffer.resize(size + blockSize);
+            std::streamsize count = buf->sgetn(_buffer.data() + size, blockSize);
+            size += static_cast<std::size_t>(count);
+            if (count < blockSize)
+                break;
+        }
+        _buffer.resize(size);
+    }
+
+    _pData = _buffer.data();
+    _ulSize = _buffer.size();
+}
+
+TextParser::Rows TextParser::ParseRows() const
+{
+    std::vector<Rows> chunks(CountChunks());
+    ParseChunks([&chunks](std::size_t chunk, const char* first, const char* last) {
+        Rows& rows = chunks[chunk];
+        ForEachLine(first, last, [&rows](const char* pos, const char* eol) {
+            std::size_t count = rows.values.size();
+            double value;
+            while (true) {
+                pos = SkipBlanks(pos, eol);
+                const char* next = ParseNumber(pos, eol, value);
+                if (next == pos)
+                    break;
+                rows.values.push_back(value);
+                pos = next;
+            }
+            // skip lines without numbers
+            if (rows.values.size() > count)
+                rows.offsets.push_back(count);
+        });
+    });
+
+    // merge the chunks in file order
+    Rows rows;
+    std::size_t ulCtValues = 0, ulCtRows = 0;
+    for (const auto& it : chunks) {
+        ulCtValues += it.values.size();
+        ulCtRows += it.offsets.size();
+    }
+    rows.values.reserve(ulCtValues);
+    rows.offsets.reserve(ulCtRows + 1);
+    for (const auto& it : chunks) {
+        std::size_t offset = rows.values.size();
+        for (std::size_t pos : it.offsets)
+            rows.offsets.push_back(offset + pos);
+        rows.values.insert(rows.values.end(), it.values.begin(), it.values.end());
+    }
+    rows.offsets.push_back(rows.values.size());
+
+    return rows;
+}
+
+const char* TextParser::SkipBlanks(const char* first, const char* last)
+{
+    while (first != last && IsBlank(*first))
+        ++first;
+    return first;
+}
+
+const char* TextParser::SkipToken(const char* first, const char* last)
+{
+    while (first != last && !IsBlank(*first))
+        ++first;
+    return first;
+}
+
+const char* TextParser::ParseKeyword(const char* first, const char* last, const char* keyword, bool ignoreCase)
+{
+    const char* pos = first;
+    for (; *keyword; ++keyword, ++pos) {
+        if (pos == last)
+            return first;
+        char c = ignoreCase ? toLower(*pos) : *pos;
+        char k = ignoreCase ? toLower(*keyword) : *keyword;
+        if (c != k)
+            return first;
+    }
+
+    if (pos != last && !IsBlank(*pos))
+        return first;
+    return pos;
+}
+
+const char* TextParser::ParseNumber(const char* first, const char* last, double& value)
+{
+    const char* pos = first;
+    bool negative = false;
+    if (pos != last && (*pos == '+' || *pos == '-')) {
+        negative = (*pos == '-');
+        ++pos;
+    }
+
+    // collect up to 19 significant digits, the rest only shifts the exponent
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    for (; pos != last && isDigit(*pos); ++pos) {
+        hasDigits = true;
+        if (digits < 19) {
+            mantissa = 10 * mantissa + (*pos - '0');
+            if (mantissa > 0)
+                digits++;
+        }
+        else {
+            exponent++;
+        }
+    }
+    if (pos != last && *pos == '.') {
+        for (++pos; pos != last && isDigit(*pos); ++pos) {
+            hasDigits = true;
+            if (digits < 19) {
+                mantissa = 10 * mantissa + (*pos - '0');
+                if (mantissa > 0)
+                    digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!hasDigits)
+        return first;
+
+    if (pos != last && (*pos == 'e' || *pos == 'E')) {
+        const char* exp = pos + 1;
+        bool negativeExp = false;
+        if (exp != last && (*exp == '+' || *exp == '-')) {
+            negativeExp = (*exp == '-');
+            ++exp;
+        }
+        if (exp != last && isDigit(*exp)) {
+            int value = 0;
+            for (; exp != last && isDigit(*exp); ++exp) {
+                if (value < 10000)
+                    value = 10 * value + (*exp - '0');
+            }
+            exponent += negativeExp ? -value : value;
+            pos = exp;
+        }
+    }
+
+    if (digits <= 15 && exponent >= -22 && exponent <= 22) {
+        // mantissa and power of ten are exact so that a single operation
+        // gives the correctly rounded result
+        double result = static_cast<double>(mantissa);
+        if (exponent < 0)
+            result /= exactPowers[-exponent];
+        else
+            result *= exactPowers[exponent];
+        value = negative ? -result : result;
+    }
+    else {
+        // rare case of long mantissas or large exponents
+        char buf[64];
+        std::size_t length = static_cast<std::size_t>(pos - first);
+        if (length < sizeof(buf)) {
+            std::memcpy(buf, first, length);
+            buf[length] = '\0';
+            value = std::strtod(buf, nullptr);
+        }
+        else {
+            value = std::strtod(std::string(first, pos).c_str(), nullptr);
+        }
+    }
+
+    return pos;
+}
+
+const char* TextParser::ParseNumber(const char* first, const char* last, float& value)
+{
+    double number;
+    const char* pos = ParseNumber(first, last, number);
+    if (pos != first)
+        value = static_cast<float>(number);
+    return pos;
+}
+
+const char* TextParser::ParseInteger(const char* first, const char* last, long& value)
+{
+    const char* pos = first;
+    bool negative = false;
+    if (pos != last && (*pos == '+' || *pos == '-')) {
+        negative = (*pos == '-');
+        ++pos;
+    }
+    if (pos == last || !isDigit(*pos))
+        return first;
+
+    long result = 0;
+    for (; pos != last && isDigit(*pos); ++pos)
+        result = 10 * result + (*pos - '0');
+    value = negative ? -result : result;
+    return pos;
+}
@@ -0,0 +1,159 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_IO_TEXT_PARSER_H
+#define MESH_IO_TEXT_PARSER_H
+
+#include <cstring>
+#include <iosfwd>
+#include <vector>
+#include <Mod/Mesh/App/Core/Functional.h>
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+/** Tokenizer for the ASCII mesh formats.
+ * The text is split into chunks at line boundaries which are parsed in parallel. The chunks are
+ * numbered in file order so that results collected per chunk can be merged deterministically.
+ * The number parsing works in place like std::from_chars and doesn't allocate memory.
+ */
+class MeshExport TextParser
+{
+public:
+    /*!
+     * \brief Uses the memory block [data, data+size), e.g. a memory-mapped file.
+     * The memory block must outlive the parser.
+     */
+    TextParser(const char* data, std::size_t size);
+    /*!
+     * \brief Reads the remaining content of the stream into an internal buffer.
+     */
+    explicit TextParser(std::istream &str);
+
+    const char* Data() const {
+        return _pData;
+    }
+    std::size_t Size() const {
+        return _ulSize;
+    }
+
+    /*!
+     * \brief Returns the number of chunks the text is split into by \ref ParseChunks().
+     */
+    std::size_t CountChunks() const {
+        return parallel_block_count(_ulSize, MinChunkSize);
+    }
+    /*!
+     * \brief Splits the text into chunks at line boundaries and calls \a func(chunk, first, last)
+     * for each of them in parallel.
+     * \return the number of chunks
+     */
+    template <class Func>
+    std::size_t ParseChunks(Func func) const
+    {
+        const char* data = _pData;
+        std::size_t size = _ulSize;
+        // a chunk holds all lines that start in its range
+        auto lineStart = [data, size](std::size_t pos) -> std::size_t {
+            if (pos == 0 || pos >= size)
+                return pos;
+            const void* nl = std::memchr(data + pos - 1, '\n', size - pos + 1);
+            return nl ? static_cast<const char*>(nl) - data + 1 : size;
+        };
+        return parallel_blocks(size, MinChunkSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            func(chunk, data + lineStart(begin), data + lineStart(end));
+        });
+    }
+    /*!
+     * \brief Calls \a func(first, last) for each line in [first, last) without the line break.
+     */
+    template <class Func>
+    static void ForEachLine(const char* first, const char* last, Func func)
+    {
+        while (first != last) {
+            const char* eol = static_cast<const char*>(std::memchr(first, '\n', last - first));
+            if (!eol) {
+                func(first, last);
+                break;
+            }
+            func(first, eol);
+            first = eol + 1;
+        }
+    }
+
+    /*!
+     * \brief The numbers of all lines of the text that start with a number.
+     * Each line is read up to the first token that is not a number.
+     */
+    struct Rows
+    {
+        std::vector<double> values;
+        std::vector<std::size_t> offsets;
+
+        std::size_t Count() const {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+        std::size_t Size(std::size_t row) const {
+            return offsets[row + 1] - offsets[row];
+        }
+        const double* operator[](std::size_t row) const {
+            return values.data() + offsets[row];
+        }
+    };
+    Rows ParseRows() const;
+
+    /** @name Tokenizer
+     * The functions get the range [first, last) of a line and return the position behind the
+     * parsed token, or \a first if the token doesn't match.
+     */
+    //@{
+    static bool IsBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+    static const char* SkipBlanks(const char* first, const char* last);
+    static const char* SkipToken(const char* first, const char* last);
+    /// Returns true if there are only blanks left.
+    static bool AtEnd(const char* first, const char* last) {
+        return SkipBlanks(first, last) == last;
+    }
+    /// Matches the token \a keyword that must be followed by a blank or the line end.
+    static const char* ParseKeyword(const char* first, const char* last, const char* keyword, bool ignoreCase = false);
+    /// Parses a decimal floating point number.
+    static const char* ParseNumber(const char* first, const char* last, double& value);
+    static const char* ParseNumber(const char* first, const char* last, float& value);
+    /// Parses a decimal integer with optional sign.
+    static const char* ParseInteger(const char* first, const char* last, long& value);
+    //@}
+
+private:
+    static const std::size_t MinChunkSize = 256 * 1024;
+
+    std::vector<char> _buffer;
+    const char* _pData;
+    std::size_t _ulSize;
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_IO_TEXT_PARSER_H
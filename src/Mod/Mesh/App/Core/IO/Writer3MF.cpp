@@ -22,12 +22,15 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <cstdio>
 # include <ostream>
 # include <sstream>
 #endif
 
 #include <Base/Tools.h>
 #include "Core/Evaluation.h"
+#include "Core/Functional.h"
 #include "Core/MeshKernel.h"
 
 #include "Writer3MF.h"
@@ -35,6 +38,36 @@
 
 using namespace MeshCore;
 
+namespace {
+
+// Number of elements formatted before the text is passed on to the zip entry
+// so that the memory needed doesn't grow with the size of the mesh.
+const std::size_t WriteChunkSize = 65536;
+const std::size_t WriteBlockSize = 8192;
+
+/// Formats the elements chunk by chunk in parallel and writes the text in order.
+template <class Format>
+void writeElements(std::ostream& str, std::size_t count, Format format)
+{
+    std::vector<std::string> blocks;
+    for (std::size_t first = 0; first < count; first += WriteChunkSize) {
+        std::size_t size = std::min(WriteChunkSize, count - first);
+        blocks.assign(parallel_block_count(size, WriteBlockSize), std::string());
+        parallel_blocks(size, WriteBlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+            std::string& text = blocks[block];
+            char line[256];
+            for (std::size_t i = first + begin; i < first + end; i++) {
+                int len = format(i, line, sizeof(line));
+                text.append(line, static_cast<std::size_t>(len));
+            }
+        });
+        for (const auto& text : blocks)
+            str.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+}
+
+}
+
 Writer3MF::Writer3MF(std::ostream &str)
   : zip(str)
   , objectIndex(0)
@@ -116,24 +149,22 @@ bool Writer3MF::SaveObject(std::ostream &str, int id, const MeshKernel& mesh) co
     str << Base::blanks(3) << "<mesh>\n";
 
     // vertices
+    // %g gives the same text as streaming the values with the default precision
     str << Base::blanks(4) << "<vertices>\n";
-    std::size_t index = 0;
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it, ++index) {
-        str << Base::blanks(5) << "<vertex x=\"" << it->x
-                                    << "\" y=\"" << it->y
-                                    << "\" z=\"" << it->z
-                                    << "\" />\n";
-    }
+    writeElements(str, rPoints.size(), [&rPoints](std::size_t i, char* line, std::size_t size) {
+        const MeshPoint& pnt = rPoints[i];
+        return std::snprintf(line, size, "     <vertex x=\"%g\" y=\"%g\" z=\"%g\" />\n",
+                             pnt.x, pnt.y, pnt.z);
+    });
     str << Base::blanks(4) << "</vertices>\n";
 
     // facet indices
     str << Base::blanks(4) << "<triangles>\n";
-    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        str << Base::blanks(5) << "<triangle v1=\"" << it->_aulPoints[0]
-                                      << "\" v2=\"" << it->_aulPoints[1]
-                                      << "\" v3=\"" << it->_aulPoints[2]
-                                      << "\" />\n";
-    }
+    writeElements(str, rFacets.size(), [&rFacets](std::size_t i, char* line, std::size_t size) {
+        const MeshFacet& face = rFacets[i];
+        return std::snprintf(line, size, "     <triangle v1=\"%lu\" v2=\"%lu\" v3=\"%lu\" />\n",
+                             face._aulPoints[0], face._aulPoints[1], face._aulPoints[2]);
+    });
     str << Base::blanks(4) << "</triangles>\n";
 
     str << Base::blanks(3) << "</mesh>\n";
@@ -0,0 +1,216 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cstring>
+# include <ostream>
+#endif
+
+#include <Base/Stream.h>
+#include "Core/Functional.h"
+#include "Core/MeshKernel.h"
+
+#include "WriterBMS.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+using Buffer = std::vector<unsigned char>;
+
+void writeVarint(Buffer& buf, uint64_t value)
+{
+    while (value >= 0x80) {
+        buf.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(static_cast<unsigned char>(value));
+}
+
+// maps signed differences to unsigned values with small magnitudes
+void writeDifference(Buffer& buf, uint64_t value, uint64_t reference)
+{
+    int64_t diff = static_cast<int64_t>(value - reference);
+    writeVarint(buf, (static_cast<uint64_t>(diff) << 1) ^ static_cast<uint64_t>(diff >> 63));
+}
+
+// maps the bit pattern of a float to an integer of the same order
+uint32_t orderedBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+void writeCoordinate(Buffer& buf, float value, float reference)
+{
+    int32_t diff = static_cast<int32_t>(orderedBits(value) - orderedBits(reference));
+    writeVarint(buf, (static_cast<uint32_t>(diff) << 1) ^ static_cast<uint32_t>(diff >> 31));
+}
+
+/* Encodes the elements [0, count) with func(buffer, index) in parallel blocks. As each element
+ * only refers to its predecessors in the array the blocks can simply be concatenated. */
+template <class Func>
+Buffer encode(std::size_t count, Func func)
+{
+    std::vector<Buffer> blocks(parallel_block_count(count, 10000));
+    parallel_blocks(count, 10000, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        Buffer& buf = blocks[block];
+        buf.reserve(4 * (end - begin));
+        for (std::size_t i = begin; i < end; i++)
+            func(buf, i);
+    });
+
+    Buffer data;
+    if (blocks.size() == 1) {
+        data.swap(blocks.front());
+    }
+    else {
+        for (const auto& it : blocks)
+            data.insert(data.end(), it.begin(), it.end());
+    }
+    return data;
+}
+
+void writeSection(Base::OutputStream& str, std::ostream& out, const Buffer& buf)
+{
+    str << static_cast<uint64_t>(buf.size());
+    out.write(reinterpret_cast<const char*>(buf.data()), static_cast<std::streamsize>(buf.size()));
+}
+
+}
+
+WriterBMS::WriterBMS(const MeshKernel& kernel)
+  : _kernel(kernel)
+{
+}
+
+void WriterBMS::SetGroups(const std::vector<Group>& g)
+{
+    _groups = g;
+}
+
+bool WriterBMS::Save(std::ostream& out) const
+{
+    if (!out || out.bad())
+        return false;
+
+    const MeshPointArray& rPoints = _kernel.GetPoints();
+    const MeshFacetArray& rFacets = _kernel.GetFacets();
+    std::size_t ulCtPts = rPoints.size();
+    std::size_t ulCtFts = rFacets.size();
+
+    // the properties are only saved if set
+    bool pointProps = std::any_of(rPoints.begin(), rPoints.end(), [](const MeshPoint& p) {
+        return p._ulProp != 0;
+    });
+    bool facetProps = std::any_of(rFacets.begin(), rFacets.end(), [](const MeshFacet& f) {
+        return f._ulProp != 0;
+    });
+    uint32_t flags = 0;
+    if (pointProps)
+        flags |= 0x1;
+    if (facetProps)
+        flags |= 0x2;
+    if (!_groups.empty())
+        flags |= 0x4;
+
+    Base::OutputStream str(out);
+    str << static_cast<uint32_t>(0xA0B0C0D0);
+    str << Version;
+    str << flags;
+    str << static_cast<uint64_t>(ulCtPts) << static_cast<uint64_t>(ulCtFts);
+
+    const Base::BoundBox3f& bbox = _kernel.GetBoundBox();
+    str << bbox.MinX << bbox.MaxX;
+    str << bbox.MinY << bbox.MaxY;
+    str << bbox.MinZ << bbox.MaxZ;
+
+    // points as differences to the previous point
+    writeSection(str, out, encode(ulCtPts, [&rPoints](Buffer& buf, std::size_t i) {
+        const Base::Vector3f& pnt = rPoints[i];
+        Base::Vector3f ref;
+        if (i > 0)
+            ref = rPoints[i-1];
+        writeCoordinate(buf, pnt.x, ref.x);
+        writeCoordinate(buf, pnt.y, ref.y);
+        writeCoordinate(buf, pnt.z, ref.z);
+    }));
+
+    // the first corner relative to the first corner of the previous facet, the
+    // other corners relative to the first one
+    writeSection(str, out, encode(ulCtFts, [&rFacets](Buffer& buf, std::size_t i) {
+        const MeshFacet& face = rFacets[i];
+        PointIndex ref = i > 0 ? rFacets[i-1]._aulPoints[0] : 0;
+        writeDifference(buf, face._aulPoints[0], ref);
+        writeDifference(buf, face._aulPoints[1], face._aulPoints[0]);
+        writeDifference(buf, face._aulPoints[2], face._aulPoints[0]);
+    }));
+
+    // neighbours relative to the facet itself, 0 marks an open edge
+    writeSection(str, out, encode(ulCtFts, [&rFacets](Buffer& buf, std::size_t i) {
+        const MeshFacet& face = rFacets[i];
+        for (int j = 0; j < 3; j++) {
+            FacetIndex n = face._aulNeighbours[j];
+            if (n == FACET_INDEX_MAX) {
+                buf.push_back(0);
+            }
+            else {
+                int64_t diff = static_cast<int64_t>(n - i);
+                writeVarint(buf, ((static_cast<uint64_t>(diff) << 1) ^ static_cast<uint64_t>(diff >> 63)) + 1);
+            }
+        }
+    }));
+
+    if (pointProps) {
+        writeSection(str, out, encode(ulCtPts, [&rPoints](Buffer& buf, std::size_t i) {
+            writeDifference(buf, rPoints[i]._ulProp, i > 0 ? rPoints[i-1]._ulProp : 0);
+        }));
+    }
+
+    if (facetProps) {
+        writeSection(str, out, encode(ulCtFts, [&rFacets](Buffer& buf, std::size_t i) {
+            writeDifference(buf, rFacets[i]._ulProp, i > 0 ? rFacets[i-1]._ulProp : 0);
+        }));
+    }
+
+    if (!_groups.empty()) {
+        Buffer buf;
+        writeVarint(buf, _groups.size());
+        for (const auto& it : _groups) {
+            writeVarint(buf, it.name.size());
+            buf.insert(buf.end(), it.name.begin(), it.name.end());
+            writeVarint(buf, it.indices.size());
+            FacetIndex ref = 0;
+            for (FacetIndex index : it.indices) {
+                writeDifference(buf, index, ref);
+                ref = index;
+            }
+        }
+        writeSection(str, out, buf);
+    }
+
+    return out.good();
+}
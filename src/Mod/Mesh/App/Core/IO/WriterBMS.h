@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_IO_WRITER_BMS_H
+#define MESH_IO_WRITER_BMS_H
+
+#include <iosfwd>
+#include <vector>
+#include <Mod/Mesh/MeshGlobal.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+
+namespace MeshCore
+{
+
+/** Saves the mesh object in the compact version of the binary BMS format.
+ * Besides points and facets the format stores the neighbourhood of the facets,
+ * the bounding box and optionally the point and facet properties and mesh groups,
+ * so that nothing needs to be rebuilt when loading the data with \ref ReaderBMS.
+ * Coordinates are stored as differences of their ordered bit patterns and
+ * indices as differences to nearby indices, both as variable-length integers.
+ * The encoding is lossless.
+ */
+class MeshExport WriterBMS
+{
+public:
+    /*!
+     * \brief WriterBMS
+     */
+    explicit WriterBMS(const MeshKernel& kernel);
+    /*!
+     * \brief Set the mesh groups to save.
+     * A mesh group is a list of facet indices, i.e. a mesh segment.
+     * This function must be called before calling \ref Save()
+     */
+    void SetGroups(const std::vector<Group>& g);
+    /*!
+     * \brief Save the mesh to the stream.
+     * \return true if the data could be written successfully, false otherwise.
+     */
+    bool Save(std::ostream&) const;
+
+    /// The version of the compact format
+    static const uint32_t Version = 0x020000;
+
+private:
+    const MeshKernel& _kernel;
+    std::vector<Group> _groups;
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_IO_WRITER_BMS_H
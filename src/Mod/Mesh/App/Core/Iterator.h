@@ -75,40 +75,40 @@ public:
   /// Increments the iterator. It points then to the next element if the
   /// end is not reached.
   const MeshFacetIterator& operator ++ ()
-  { ++_clIter; return *this; }
+  { ++_ulIndex; return *this; }
   /// Decrements the iterator. It points then to the previous element if the beginning
   /// is not reached.
   const MeshFacetIterator& operator -- ()
-  { --_clIter; return *this; }
+  { --_ulIndex; return *this; }
   /// Increments the iterator by \a k positions.
   const MeshFacetIterator& operator += (int k)
-  { _clIter += k; return *this; }
+  { _ulIndex += k; return *this; }
   /// Decrements the iterator by \a k positions.
   const MeshFacetIterator& operator -= (int k)
-  { _clIter -= k; return *this; }
+  { _ulIndex -= k; return *this; }
   /// Assignment.
   inline MeshFacetIterator& operator = (const MeshFacetIterator &rpI);
   /// Compares if this iterator points to a lower element than the other one.
   bool operator < (const MeshFacetIterator &rclI) const
-  { return _clIter < rclI._clIter; }
+  { return _ulIndex < rclI._ulIndex; }
   /// Compares if this iterator points to a higher element than the other one.
   bool operator > (const MeshFacetIterator &rclI) const
-  { return _clIter > rclI._clIter; }
+  { return _ulIndex > rclI._ulIndex; }
   /// Checks if the iterators points to the same element.
   bool operator == (const MeshFacetIterator &rclI) const
-  { return _clIter == rclI._clIter; }
+  { return _ulIndex == rclI._ulIndex; }
   /// Sets the iterator to the beginning of the array.
   void Begin ()
-  { _clIter = _rclFAry.begin(); }
+  { _ulIndex = 0; }
   /// Sets the iterator to the end of the array.
   void End ()
-  { _clIter = _rclFAry.end(); }
+  { _ulIndex = _rclMesh.CountFacets(); }
   /// Returns the current position of the iterator in the array.
   FacetIndex Position () const
-  { return _clIter - _rclFAry.begin(); }
+  { return _ulIndex; }
   /// Checks if the end is already reached.
   bool EndReached () const
-  { return !(_clIter < _rclFAry.end()); }
+  { return !(_ulIndex < _rclMesh.CountFacets()); }
   /// Sets the iterator to the beginning of the array.
   void  Init ()
   { Begin(); }
@@ -121,11 +121,11 @@ public:
   /// Sets the iterator to a given position.
   inline bool Set (FacetIndex ulIndex);
   /// Returns the topologic facet.
-  inline MeshFacet GetIndices () const
-  { return *_clIter; }
-  /// Returns the topologic facet.
-  inline const MeshFacet& GetReference () const
-  { return *_clIter; }
+  inline MeshFacet GetIndices () const;
+  /** Returns the topologic facet. If the mesh is compact the reference is only valid
+   * until the iterator is moved.
+   */
+  inline const MeshFacet& GetReference () const;
   /// Returns iterators pointing to the current facet's neighbours.
   inline void GetNeighbours (MeshFacetIterator &rclN0, MeshFacetIterator &rclN1, MeshFacetIterator &rclN2) const;
   /// Sets the iterator to the current facet's neighbour of the side \a usN.
@@ -134,19 +134,19 @@ public:
   inline unsigned long GetProperty () const;
   /// Checks if the iterator points to a valid element inside the array.
   inline bool IsValid () const
-  { return (_clIter >= _rclFAry.begin()) && (_clIter < _rclFAry.end()); }
+  { return _ulIndex < _rclMesh.CountFacets(); }
   //@}
   /** @name Flag state
+   * Setting a flag or property restores the facet array of a compact mesh.
    */
   //@{
   void SetFlag (MeshFacet::TFlagType tF) const
-  { this->_clIter->SetFlag(tF); }
+  { _rclMesh.Unpack(); _rclFAry[_ulIndex].SetFlag(tF); }
   void ResetFlag (MeshFacet::TFlagType tF) const
-  { this->_clIter->ResetFlag(tF); }
-  bool IsFlag (MeshFacet::TFlagType tF) const
-  { return this->_clIter->IsFlag(tF); }
+  { _rclMesh.Unpack(); _rclFAry[_ulIndex].ResetFlag(tF); }
+  inline bool IsFlag (MeshFacet::TFlagType tF) const;
   void SetProperty(unsigned long uP) const
-  { this->_clIter->SetProperty(uP); }
+  { _rclMesh.Unpack(); _rclFAry[_ulIndex].SetProperty(uP); }
   //@}
 
 protected:
@@ -156,8 +156,9 @@ protected:
   const MeshKernel&     _rclMesh;
   const MeshFacetArray& _rclFAry;
   const MeshPointArray& _rclPAry;
-  MeshFacetArray::_TConstIterator _clIter;
+  FacetIndex _ulIndex;
   MeshGeomFacet _clFacet;
+  mutable MeshFacet _clIndices;
   bool _bApply;
   Base::Matrix4D _clTrf;
 
@@ -197,34 +198,34 @@ public:
   /// Increments the iterator. It points then to the next element if the
   /// end is not reached.
   const MeshPointIterator& operator ++ ()
-  { ++_clIter; return *this; }
+  { ++_ulIndex; return *this; }
   /// Decrements the iterator. It points then to the previous element if the beginning
   /// is not reached.
   const MeshPointIterator& operator -- ()
-  { --_clIter; return *this; }
+  { --_ulIndex; return *this; }
   /// Assignment.
   inline MeshPointIterator& operator = (const MeshPointIterator &rpI);
   /// Compares if this iterator points to a lower element than the other one.
   bool operator < (const MeshPointIterator &rclI) const
-  { return _clIter < rclI._clIter; }
+  { return _ulIndex < rclI._ulIndex; }
   /// Compares if this iterator points to a higher element than the other one.
   bool operator > (const MeshPointIterator &rclI) const
-  { return _clIter > rclI._clIter; }
+  { return _ulIndex > rclI._ulIndex; }
   /// Checks if the iterators points to the same element.
   bool operator == (const MeshPointIterator &rclI) const
-  { return _clIter == rclI._clIter; }
+  { return _ulIndex == rclI._ulIndex; }
   /// Sets the iterator to the beginning of the array.
   void Begin ()
-  { _clIter = _rclPAry.begin(); }
+  { _ulIndex = 0; }
   /// Sets the iterator to the end of the array.
   void End ()
-  { _clIter = _rclPAry.end(); }
+  { _ulIndex = _rclMesh.CountPoints(); }
   /// Returns the current position of the iterator in the array.
   PointIndex Position () const
-  { return _clIter - _rclPAry.begin(); }
+  { return _ulIndex; }
   /// Checks if the end is already reached.
   bool EndReached () const
-  { return !(_clIter < _rclPAry.end()); }
+  { return !(_ulIndex < _rclMesh.CountPoints()); }
   /// Sets the iterator to the beginning of the array.
   void  Init ()
   { Begin(); }
@@ -238,19 +239,19 @@ public:
   inline bool Set (PointIndex ulIndex);
   /// Checks if the iterator points to a valid element inside the array.
   inline bool IsValid () const
-  { return (_clIter >= _rclPAry.begin()) && (_clIter < _rclPAry.end()); }
+  { return _ulIndex < _rclMesh.CountPoints(); }
   //@}
   /** @name Flag state
+   * Setting a flag or property restores the point array of a compact mesh.
    */
   //@{
   void SetFlag (MeshPoint::TFlagType tF) const
-  { this->_clIter->SetFlag(tF); }
+  { _rclMesh.Unpack(); _rclPAry[_ulIndex].SetFlag(tF); }
   void ResetFlag (MeshPoint::TFlagType tF) const
-  { this->_clIter->ResetFlag(tF); }
-  bool IsFlag (MeshPoint::TFlagType tF) const
-  { return this->_clIter->IsFlag(tF); }
+  { _rclMesh.Unpack(); _rclPAry[_ulIndex].ResetFlag(tF); }
+  inline bool IsFlag (MeshPoint::TFlagType tF) const;
   void SetProperty(unsigned long uP) const
-  { this->_clIter->SetProperty(uP); }
+  { _rclMesh.Unpack(); _rclPAry[_ulIndex].SetProperty(uP); }
   //@}
 
 protected:
@@ -260,7 +261,7 @@ protected:
   const MeshKernel& _rclMesh;
   const MeshPointArray& _rclPAry;
   mutable MeshPoint _clPoint;
-  MeshPointArray::_TConstIterator _clIter;
+  PointIndex _ulIndex;
   bool _bApply;
   Base::Matrix4D _clTrf;
 
@@ -274,17 +275,16 @@ public:
   inline explicit MeshFastFacetIterator (const MeshKernel &rclM);
   virtual ~MeshFastFacetIterator () {}
 
-  void Init () { _clIter = _rclFAry.begin(); }
+  void Init () { _ulIndex = 0; }
+  /// Loads the points of the current facet into \a _afPoints and moves to the next facet.
   inline void Next ();
-  bool More () { return _clIter != _rclFAry.end(); }
+  bool More () { return _ulIndex < _rclMesh.CountFacets(); }
 
   Base::Vector3f _afPoints[3];
 
 protected:
   const MeshKernel&     _rclMesh;
-  const MeshFacetArray& _rclFAry;
-  const MeshPointArray& _rclPAry;
-  MeshFacetArray::_TConstIterator _clIter;
+  FacetIndex _ulIndex;
 
 private:
   MeshFastFacetIterator (const MeshFastFacetIterator&);
@@ -293,26 +293,25 @@ private:
 
 inline MeshFastFacetIterator::MeshFastFacetIterator (const MeshKernel &rclM)
 : _rclMesh(rclM),
-  _rclFAry(rclM._aclFacetArray),
-  _rclPAry(rclM._aclPointArray),
-  _clIter(_rclFAry.begin())
+  _ulIndex(0)
 {
 }
 
 inline void MeshFastFacetIterator::Next ()
 {
-  const PointIndex *paulPt = _clIter->_aulPoints;
-  Base::Vector3f *pfPt = _afPoints;
-  *(pfPt++)      = _rclPAry[*(paulPt++)];
-  *(pfPt++)      = _rclPAry[*(paulPt++)];
-  *pfPt          = _rclPAry[*paulPt];
+  PointIndex ulP0, ulP1, ulP2;
+  _rclMesh.GetFacetPoints(_ulIndex, ulP0, ulP1, ulP2);
+  _afPoints[0] = _rclMesh.GetPoint(ulP0);
+  _afPoints[1] = _rclMesh.GetPoint(ulP1);
+  _afPoints[2] = _rclMesh.GetPoint(ulP2);
+  ++_ulIndex;
 }
 
 inline MeshFacetIterator::MeshFacetIterator (const MeshKernel &rclM)
 : _rclMesh(rclM),
   _rclFAry(rclM._aclFacetArray),
   _rclPAry(rclM._aclPointArray),
-  _clIter(rclM._aclFacetArray.begin()),
+  _ulIndex(0),
   _bApply(false)
 {
 }
@@ -321,7 +320,7 @@ inline MeshFacetIterator::MeshFacetIterator (const MeshKernel &rclM, FacetIndex
 : _rclMesh(rclM),
   _rclFAry(rclM._aclFacetArray),
   _rclPAry(rclM._aclPointArray),
-  _clIter(rclM._aclFacetArray.begin() + ulPos),
+  _ulIndex(ulPos),
   _bApply(false)
 {
 }
@@ -330,7 +329,7 @@ inline MeshFacetIterator::MeshFacetIterator (const MeshFacetIterator &rclI)
 : _rclMesh(rclI._rclMesh),
   _rclFAry(rclI._rclFAry),
   _rclPAry(rclI._rclPAry),
-  _clIter(rclI._clIter),
+  _ulIndex(rclI._ulIndex),
   _bApply(rclI._bApply),
   _clTrf(rclI._clTrf)
 {
@@ -346,14 +345,21 @@ inline void MeshFacetIterator::Transform( const Base::Matrix4D& rclTrf )
 
 inline const MeshGeomFacet& MeshFacetIterator::Dereference ()
 {
-  MeshFacet rclF             = *_clIter;
-  const PointIndex *paulPt        = &(_clIter->_aulPoints[0]);
-  Base::Vector3f  *pclPt = _clFacet._aclPoints;
-  *(pclPt++)       = _rclPAry[*(paulPt++)];
-  *(pclPt++)       = _rclPAry[*(paulPt++)];
-  *pclPt           = _rclPAry[*paulPt];
-  _clFacet._ulProp = rclF._ulProp;
-  _clFacet._ucFlag = rclF._ucFlag;
+  if (_rclMesh.IsCompact())
+  {
+    _clFacet = _rclMesh._pcCompact->GetFacet(_ulIndex);
+  }
+  else
+  {
+    const MeshFacet& rclF      = _rclFAry[_ulIndex];
+    const PointIndex *paulPt        = &(rclF._aulPoints[0]);
+    Base::Vector3f  *pclPt = _clFacet._aclPoints;
+    *(pclPt++)       = _rclPAry[*(paulPt++)];
+    *(pclPt++)       = _rclPAry[*(paulPt++)];
+    *pclPt           = _rclPAry[*paulPt];
+    _clFacet._ulProp = rclF._ulProp;
+    _clFacet._ucFlag = rclF._ucFlag;
+  }
   _clFacet.NormalInvalid();
   if ( _bApply )
   {
@@ -366,71 +372,100 @@ inline const MeshGeomFacet& MeshFacetIterator::Dereference ()
 
 inline bool MeshFacetIterator::Set (FacetIndex ulIndex)
 {
-  if (ulIndex < _rclFAry.size())
+  if (ulIndex < _rclMesh.CountFacets())
   {
-    _clIter    = _rclFAry.begin() + ulIndex;
+    _ulIndex   = ulIndex;
     return true;
   }
   else
   {
-    _clIter    = _rclFAry.end();
+    End();
     return false;
   }
 }
 
 inline MeshFacetIterator& MeshFacetIterator::operator = (const MeshFacetIterator &rpI)
 {
-  _clIter  = rpI._clIter;
+  _ulIndex = rpI._ulIndex;
   _bApply = rpI._bApply;
   _clTrf = rpI._clTrf;
   return *this;
 }
 
+inline MeshFacet MeshFacetIterator::GetIndices () const
+{
+  if (_rclMesh.IsCompact())
+    return _rclMesh._pcCompact->GetFacetIndices(_ulIndex);
+  return _rclFAry[_ulIndex];
+}
+
+inline const MeshFacet& MeshFacetIterator::GetReference () const
+{
+  if (_rclMesh.IsCompact())
+  {
+    _clIndices = _rclMesh._pcCompact->GetFacetIndices(_ulIndex);
+    return _clIndices;
+  }
+  return _rclFAry[_ulIndex];
+}
+
 inline unsigned long MeshFacetIterator::GetProperty () const
 {
-  return _clIter->_ulProp;
+  if (_rclMesh.IsCompact())
+    return _rclMesh._pcCompact->GetFacetProperty(_ulIndex);
+  return _rclFAry[_ulIndex]._ulProp;
+}
+
+inline bool MeshFacetIterator::IsFlag (MeshFacet::TFlagType tF) const
+{
+  if (_rclMesh.IsCompact())
+    return _rclMesh._pcCompact->IsFacetFlag(_ulIndex, tF);
+  return _rclFAry[_ulIndex].IsFlag(tF);
 }
 
 inline void MeshFacetIterator::GetNeighbours (MeshFacetIterator &rclN0, MeshFacetIterator &rclN1, MeshFacetIterator &rclN2) const
 {
-  if (_clIter->_aulNeighbours[0] != FACET_INDEX_MAX)
-    rclN0.Set(_clIter->_aulNeighbours[0]);
+  FacetIndex ulN0, ulN1, ulN2;
+  _rclMesh.GetFacetNeighbours(_ulIndex, ulN0, ulN1, ulN2);
+
+  if (ulN0 != FACET_INDEX_MAX)
+    rclN0.Set(ulN0);
   else
     rclN0.End();
 
-  if (_clIter->_aulNeighbours[1] != FACET_INDEX_MAX)
-    rclN1.Set(_clIter->_aulNeighbours[1]);
+  if (ulN1 != FACET_INDEX_MAX)
+    rclN1.Set(ulN1);
   else
     rclN1.End();
 
-  if (_clIter->_aulNeighbours[2] != FACET_INDEX_MAX)
-    rclN2.Set(_clIter->_aulNeighbours[2]);
+  if (ulN2 != FACET_INDEX_MAX)
+    rclN2.Set(ulN2);
   else
     rclN2.End();
 }
 
 inline void MeshFacetIterator::SetToNeighbour (unsigned short usN)
 {
-  if (_clIter->_aulNeighbours[usN] != FACET_INDEX_MAX)
-    _clIter = _rclFAry.begin() + _clIter->_aulNeighbours[usN];
+  FacetIndex aulN[3];
+  _rclMesh.GetFacetNeighbours(_ulIndex, aulN[0], aulN[1], aulN[2]);
+  if (aulN[usN] != FACET_INDEX_MAX)
+    _ulIndex = aulN[usN];
   else
     End();
 }
 
 inline MeshPointIterator::MeshPointIterator (const MeshKernel &rclM)
-: _rclMesh(rclM), _rclPAry(_rclMesh._aclPointArray), _bApply(false)
+: _rclMesh(rclM), _rclPAry(_rclMesh._aclPointArray), _ulIndex(0), _bApply(false)
 {
-  _clIter = _rclPAry.begin();
 }
 
 inline MeshPointIterator::MeshPointIterator (const MeshKernel &rclM, PointIndex ulPos)
-: _rclMesh(rclM), _rclPAry(_rclMesh._aclPointArray), _bApply(false)
+: _rclMesh(rclM), _rclPAry(_rclMesh._aclPointArray), _ulIndex(ulPos), _bApply(false)
 {
-  _clIter = _rclPAry.begin() + ulPos;
 }
 
 inline MeshPointIterator::MeshPointIterator (const MeshPointIterator &rclI)
-: _rclMesh(rclI._rclMesh), _rclPAry(rclI._rclPAry), _clIter(rclI._clIter), _bApply(rclI._bApply), _clTrf(rclI._clTrf)
+: _rclMesh(rclI._rclMesh), _rclPAry(rclI._rclPAry), _ulIndex(rclI._ulIndex), _bApply(rclI._bApply), _clTrf(rclI._clTrf)
 {
 }
 
@@ -445,7 +480,10 @@ inline void MeshPointIterator::Transform( const Base::Matrix4D& rclTrf )
 inline const MeshPoint& MeshPointIterator::Dereference () const
 {
   // We change only the value of the point but not the actual iterator
-  _clPoint = *_clIter;
+  if (_rclMesh.IsCompact())
+    _clPoint = _rclMesh._pcCompact->GetPoint(_ulIndex);
+  else
+    _clPoint = _rclPAry[_ulIndex];
   if ( _bApply )
     _clPoint = _clTrf * _clPoint;
   return _clPoint;
@@ -453,21 +491,28 @@ inline const MeshPoint& MeshPointIterator::Dereference () const
 
 inline bool MeshPointIterator::Set (PointIndex ulIndex)
 {
-  if (ulIndex < _rclPAry.size())
+  if (ulIndex < _rclMesh.CountPoints())
   {
-    _clIter = _rclPAry.begin() + ulIndex;
+    _ulIndex = ulIndex;
     return true;
   }
   else
   {
-    _clIter = _rclPAry.end();
+    End();
     return false;
   }
 }
 
+inline bool MeshPointIterator::IsFlag (MeshPoint::TFlagType tF) const
+{
+  if (_rclMesh.IsCompact())
+    return _rclMesh._pcCompact->IsPointFlag(_ulIndex, tF);
+  return _rclPAry[_ulIndex].IsFlag(tF);
+}
+
 inline MeshPointIterator& MeshPointIterator::operator = (const MeshPointIterator &rpI)
 {
-  _clIter  = rpI._clIter;
+  _ulIndex = rpI._ulIndex;
   _bApply = rpI._bApply;
   _clTrf = rpI._clTrf;
   return *this;
@@ -21,73 +21,321 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
-#ifdef _MSC_VER
-# pragma warning(disable : 4396)
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <cmath>
+# include <mutex>
 #endif
 
-#include <kdtree++/kdtree.hpp>
 #include "KDTree.h"
+#include "Functional.h"
 
 
 using namespace MeshCore;
 
+namespace {
+// ranges with up to this number of points are leaves and are searched linearly
+const std::size_t LeafSize = 8;
+// subtrees with at least this number of points are built in parallel
+const std::size_t ParallelBuildSize = 32768;
+// minimum number of query points per thread for batch queries
+const std::size_t MinBatchSize = 1024;
+
 struct Point3d
 {
-   using value_type = float;
-
-   Point3d(const Base::Vector3f& f, PointIndex i) : p(f), i(i)
-   {
-   }
-
-   Point3d(const Point3d& pnt) : p(pnt.p), i(pnt.i)
-   {
-   }
-
-   Point3d(Point3d&& pnt) : p(pnt.p), i(pnt.i)
-   {
-   }
-
-   ~Point3d()
-   {
-   }
-
-   inline value_type operator[](const int N) const
-   {
-       return p[N];
-   }
-
-   inline bool operator==(const Point3d& other) const
-   {
-      return (this->p) == (other.p);
-   }
-
-   inline bool operator!=(const Point3d& other) const
-   {
-      return (this->p) != (other.p);
-   }
-
-   inline void operator=(const Point3d& other)
-   {
-       this->p = other.p;
-       this->i = other.i;
-   }
-
-   inline void operator=(Point3d&& other)
-   {
-       this->p = other.p;
-       this->i = other.i;
-   }
-
-   Base::Vector3f p;
-   PointIndex i;
+    Point3d(const Base::Vector3f& f, PointIndex i) : p(f), i(i)
+    {
+    }
+
+    Base::Vector3f p;
+    unsigned int axis = 0;
+    PointIndex i;
 };
 
-using MyKDTree = KDTree::KDTree<3, Point3d>;
+inline float coord(const Base::Vector3f& v, unsigned int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+inline float boxMin(const Base::BoundBox3f& box, unsigned int axis)
+{
+    return axis == 0 ? box.MinX : (axis == 1 ? box.MinY : box.MinZ);
+}
+
+inline float boxMax(const Base::BoundBox3f& box, unsigned int axis)
+{
+    return axis == 0 ? box.MaxX : (axis == 1 ? box.MaxY : box.MaxZ);
+}
+
+inline float& coordMin(Base::BoundBox3f& box, unsigned int axis)
+{
+    return axis == 0 ? box.MinX : (axis == 1 ? box.MinY : box.MinZ);
+}
+
+inline float& coordMax(Base::BoundBox3f& box, unsigned int axis)
+{
+    return axis == 0 ? box.MaxX : (axis == 1 ? box.MaxY : box.MaxZ);
+}
+
+/*
+ * The tree is implicit: the points of a subtree occupy the range [begin, end)
+ * of the array, its root is the median at mid = begin + (end - begin) / 2 and
+ * splits the range into the left [begin, mid) and the right subtree [mid + 1, end).
+ */
+void buildTree(std::vector<Point3d>& tree, std::size_t begin, std::size_t end,
+               Base::BoundBox3f box, int threads)
+{
+    while (end - begin > LeafSize) {
+        // split the cell along its longest side
+        unsigned int axis = 0;
+        if (box.LengthY() > box.LengthX())
+            axis = 1;
+        if (box.LengthZ() > (axis == 0 ? box.LengthX() : box.LengthY()))
+            axis = 2;
+
+        std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(tree.begin() + begin, tree.begin() + mid, tree.begin() + end,
+                         [axis](const Point3d& a, const Point3d& b) {
+            return coord(a.p, axis) < coord(b.p, axis);
+        });
+        tree[mid].axis = axis;
+
+        float split = coord(tree[mid].p, axis);
+        Base::BoundBox3f left = box;
+        coordMax(left, axis) = split;
+        coordMin(box, axis) = split;
+
+        if (threads > 1 && end - begin >= ParallelBuildSize) {
+            QFuture<void> future = QtConcurrent::run([&tree, begin, mid, left, threads]() {
+                buildTree(tree, begin, mid, left, threads / 2);
+            });
+            buildTree(tree, mid + 1, end, box, threads - threads / 2);
+            future.waitForFinished();
+            return;
+        }
+
+        buildTree(tree, begin, mid, left, 1);
+        begin = mid + 1;
+    }
+}
+
+/*
+ * Keeps the k nearest points found so far as a max-heap of (squared distance, position).
+ */
+class NearestPoints
+{
+public:
+    NearestPoints(std::size_t k, float max_dist)
+      : k(k), bound(max_dist * max_dist)
+    {
+        heap.reserve(k);
+    }
+    void Reset(float max_dist)
+    {
+        heap.clear();
+        bound = max_dist * max_dist;
+    }
+    float Bound() const
+    {
+        return bound;
+    }
+    void Add(float dist2, std::size_t pos)
+    {
+        if (dist2 > bound)
+            return;
+        if (heap.size() == k)
+            std::pop_heap(heap.begin(), heap.end());
+        else
+            heap.emplace_back();
+        heap.back() = std::make_pair(dist2, pos);
+        std::push_heap(heap.begin(), heap.end());
+        if (heap.size() == k)
+            bound = heap.front().first;
+    }
+    std::vector<std::pair<float, std::size_t> >& Sorted()
+    {
+        std::sort_heap(heap.begin(), heap.end());
+        return heap;
+    }
+
+private:
+    std::size_t k;
+    float bound;
+    std::vector<std::pair<float, std::size_t> > heap;
+};
+
+void findNearest(const std::vector<Point3d>& tree, std::size_t begin, std::size_t end,
+                 const Base::Vector3f& p, NearestPoints& nearest)
+{
+    while (end - begin > LeafSize) {
+        std::size_t mid = begin + (end - begin) / 2;
+        const Point3d& node = tree[mid];
+        nearest.Add(Base::DistanceP2(p, node.p), mid);
+
+        // search the side containing the point first and the other side only
+        // if it can contain a nearer point
+        float diff = coord(p, node.axis) - coord(node.p, node.axis);
+        if (diff < 0.0f) {
+            findNearest(tree, begin, mid, p, nearest);
+            begin = mid + 1;
+        }
+        else {
+            findNearest(tree, mid + 1, end, p, nearest);
+            end = mid;
+        }
+        if (diff * diff > nearest.Bound())
+            return;
+    }
+
+    for (std::size_t pos = begin; pos < end; ++pos)
+        nearest.Add(Base::DistanceP2(p, tree[pos].p), pos);
+}
+
+template <class Func>
+void findInBox(const std::vector<Point3d>& tree, std::size_t begin, std::size_t end,
+               const Base::BoundBox3f& box, Func& func)
+{
+    while (end - begin > LeafSize) {
+        std::size_t mid = begin + (end - begin) / 2;
+        const Point3d& node = tree[mid];
+        if (box.IsInBox(node.p))
+            func(mid);
+
+        float split = coord(node.p, node.axis);
+        float low = boxMin(box, node.axis);
+        float high = boxMax(box, node.axis);
+        if (low <= split && split <= high) {
+            findInBox(tree, begin, mid, box, func);
+            begin = mid + 1;
+        }
+        else if (low <= split) {
+            end = mid;
+        }
+        else {
+            begin = mid + 1;
+        }
+    }
+
+    for (std::size_t pos = begin; pos < end; ++pos) {
+        if (box.IsInBox(tree[pos].p))
+            func(pos);
+    }
+}
+template <class Points>
+void findNearest(const std::vector<Point3d>& tree, const Points& points, std::size_t k,
+                 float max_dist, std::vector<PointIndex>& indices, std::vector<float>& distances)
+{
+    indices.assign(points.size() * k, POINT_INDEX_MAX);
+    distances.assign(points.size() * k, FLOAT_MAX);
+    if (k == 0)
+        return;
+
+    parallel_blocks(points.size(), MinBatchSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        NearestPoints nearest(k, max_dist);
+        for (std::size_t i = begin; i < end; ++i) {
+            nearest.Reset(max_dist);
+            findNearest(tree, 0, tree.size(), points[i], nearest);
+            std::size_t slot = i * k;
+            for (const auto& it : nearest.Sorted()) {
+                indices[slot] = tree[it.second].i;
+                distances[slot] = std::sqrt(it.first);
+                ++slot;
+            }
+        }
+    });
+}
+
+template <class Points>
+void findInRadius(const std::vector<Point3d>& tree, const Points& points, float radius,
+                  std::vector<std::size_t>& offsets, std::vector<PointIndex>& indices,
+                  std::vector<float>& distances)
+{
+    struct Found {
+        std::vector<PointIndex> indices;
+        std::vector<float> distances;
+    };
+
+    // each block collects the results of its consecutive range of points which
+    // are then concatenated in block order
+    std::size_t count = points.size();
+    std::vector<Found> blocks(parallel_block_count(count, MinBatchSize));
+    offsets.assign(count + 1, 0);
+    float radius2 = radius * radius;
+
+    parallel_blocks(count, MinBatchSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        Found& result = blocks[block];
+        std::vector<std::pair<float, PointIndex> > found;
+        for (std::size_t i = begin; i < end; ++i) {
+            const Base::Vector3f& p = points[i];
+            found.clear();
+            auto func = [&](std::size_t pos) {
+                float dist2 = Base::DistanceP2(p, tree[pos].p);
+                if (dist2 <= radius2)
+                    found.emplace_back(dist2, tree[pos].i);
+            };
+            findInBox(tree, 0, tree.size(), Base::BoundBox3f(p, radius), func);
+            std::sort(found.begin(), found.end());
+
+            offsets[i + 1] = found.size();
+            for (const auto& it : found) {
+                result.indices.push_back(it.second);
+                result.distances.push_back(std::sqrt(it.first));
+            }
+        }
+    });
+
+    for (std::size_t i = 0; i < count; ++i)
+        offsets[i + 1] += offsets[i];
+
+    indices.clear();
+    distances.clear();
+    indices.reserve(offsets.back());
+    distances.reserve(offsets.back());
+    for (const auto& it : blocks) {
+        indices.insert(indices.end(), it.indices.begin(), it.indices.end());
+        distances.insert(distances.end(), it.distances.begin(), it.distances.end());
+    }
+}
+}
 
 class MeshKDTree::Private
 {
 public:
-    MyKDTree kd_tree;
+    void Insert(const Base::Vector3f& p)
+    {
+        points.emplace_back(p, static_cast<PointIndex>(points.size()));
+        dirty = true;
+    }
+    void Clear()
+    {
+        points.clear();
+        dirty = false;
+    }
+    bool IsEmpty() const
+    {
+        return points.empty();
+    }
+    /** Returns the points in tree order and rebuilds the tree if needed. */
+    const std::vector<Point3d>& Tree()
+    {
+        if (dirty) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (dirty) {
+                Base::BoundBox3f box;
+                for (const auto& it : points)
+                    box.Add(it.p);
+                buildTree(points, 0, points.size(), box, std::max(1, QThread::idealThreadCount()));
+                dirty = false;
+            }
+        }
+        return points;
+    }
+
+private:
+    std::vector<Point3d> points;
+    std::atomic<bool> dirty{false};
+    std::mutex mutex;
 };
 
 MeshKDTree::MeshKDTree() : d(new Private)
@@ -96,18 +344,12 @@ MeshKDTree::MeshKDTree() : d(new Private)
 
 MeshKDTree::MeshKDTree(const std::vector<Base::Vector3f>& points) : d(new Private)
 {
-    PointIndex index=0;
-    for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    AddPoints(points);
 }
 
 MeshKDTree::MeshKDTree(const MeshPointArray& points) : d(new Private)
 {
-    PointIndex index=0;
-    for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    AddPoints(points);
 }
 
 MeshKDTree::~MeshKDTree()
@@ -117,81 +359,105 @@ MeshKDTree::~MeshKDTree()
 
 void MeshKDTree::AddPoint(Base::Vector3f& point)
 {
-    PointIndex index=d->kd_tree.size();
-    d->kd_tree.insert(Point3d(point, index));
+    d->Insert(point);
 }
 
 void MeshKDTree::AddPoints(const std::vector<Base::Vector3f>& points)
 {
-    PointIndex index=d->kd_tree.size();
     for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
+        d->Insert(*it);
     }
 }
 
 void MeshKDTree::AddPoints(const MeshPointArray& points)
 {
-    PointIndex index=d->kd_tree.size();
     for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
+        d->Insert(*it);
     }
 }
 
 bool MeshKDTree::IsEmpty() const
 {
-    return d->kd_tree.empty();
+    return d->IsEmpty();
 }
 
 void MeshKDTree::Clear()
 {
-    d->kd_tree.clear();
+    d->Clear();
 }
 
 void MeshKDTree::Optimize()
 {
-    d->kd_tree.optimize();
+    d->Tree();
 }
 
 PointIndex MeshKDTree::FindNearest(const Base::Vector3f& p, Base::Vector3f& n, float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p,0));
-    if (it.first == d->kd_tree.end())
-        return POINT_INDEX_MAX;
-    PointIndex index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
-    return index;
+    return FindNearest(p, FLOAT_MAX, n, dist);
 }
 
 PointIndex MeshKDTree::FindNearest(const Base::Vector3f& p, float max_dist,
                                    Base::Vector3f& n, float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p,0), max_dist);
-    if (it.first == d->kd_tree.end())
+    const std::vector<Point3d>& tree = d->Tree();
+    NearestPoints nearest(1, max_dist);
+    findNearest(tree, 0, tree.size(), p, nearest);
+    const auto& found = nearest.Sorted();
+    if (found.empty())
         return POINT_INDEX_MAX;
-    PointIndex index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
-    return index;
+    const Point3d& pnt = tree[found.front().second];
+    n = pnt.p;
+    dist = std::sqrt(found.front().first);
+    return pnt.i;
 }
 
 PointIndex MeshKDTree::FindExact(const Base::Vector3f& p) const
 {
-    MyKDTree::const_iterator it =
-        d->kd_tree.find_exact(Point3d(p,0));
-    if (it == d->kd_tree.end())
-        return POINT_INDEX_MAX;
-    PointIndex index = it->i;
+    const std::vector<Point3d>& tree = d->Tree();
+    Base::BoundBox3f box(p, Base::Vector3f::epsilon());
+    PointIndex index = POINT_INDEX_MAX;
+    auto func = [&](std::size_t pos) {
+        if (index == POINT_INDEX_MAX && tree[pos].p == p)
+            index = tree[pos].i;
+    };
+    findInBox(tree, 0, tree.size(), box, func);
     return index;
 }
 
 void MeshKDTree::FindInRange(const Base::Vector3f& p, float range, std::vector<PointIndex>& indices) const
 {
-    std::vector<Point3d> v;
-    d->kd_tree.find_within_range(Point3d(p,0), range, std::back_inserter(v));
-    indices.reserve(v.size());
-    for (std::vector<Point3d>::iterator it = v.begin(); it != v.end(); ++it)
-        indices.push_back(it->i);
+    const std::vector<Point3d>& tree = d->Tree();
+    Base::BoundBox3f box(p, range);
+    auto func = [&](std::size_t pos) {
+        indices.push_back(tree[pos].i);
+    };
+    findInBox(tree, 0, tree.size(), box, func);
+}
+
+void MeshKDTree::FindNearest(const std::vector<Base::Vector3f>& points, std::size_t k,
+                             std::vector<PointIndex>& indices, std::vector<float>& distances,
+                             float max_dist) const
+{
+    ::findNearest(d->Tree(), points, k, max_dist, indices, distances);
+}
+
+void MeshKDTree::FindNearest(const MeshPointArray& points, std::size_t k,
+                             std::vector<PointIndex>& indices, std::vector<float>& distances,
+                             float max_dist) const
+{
+    ::findNearest(d->Tree(), points, k, max_dist, indices, distances);
+}
+
+void MeshKDTree::FindInRadius(const std::vector<Base::Vector3f>& points, float radius,
+                              std::vector<std::size_t>& offsets, std::vector<PointIndex>& indices,
+                              std::vector<float>& distances) const
+{
+    ::findInRadius(d->Tree(), points, radius, offsets, indices, distances);
+}
+
+void MeshKDTree::FindInRadius(const MeshPointArray& points, float radius,
+                              std::vector<std::size_t>& offsets, std::vector<PointIndex>& indices,
+                              std::vector<float>& distances) const
+{
+    ::findInRadius(d->Tree(), points, radius, offsets, indices, distances);
 }
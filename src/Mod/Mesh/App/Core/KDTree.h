@@ -29,6 +29,12 @@
 namespace MeshCore
 {
 
+/**
+ * The MeshKDTree class is a kd-tree for fast nearest-neighbour and range queries
+ * on a set of points. The points are kept in a flat array in tree order, the tree
+ * is (re-)built on demand after adding points. All queries are const and can be
+ * run concurrently from several threads.
+ */
 class MeshExport MeshKDTree
 {
 public:
@@ -49,8 +55,36 @@ public:
     PointIndex FindNearest(const Base::Vector3f& p, float max_dist,
                               Base::Vector3f& n, float&) const;
     PointIndex FindExact(const Base::Vector3f& p) const;
+    /** Finds all points inside the axis-aligned box around \a p with half edge length \a range. */
     void FindInRange(const Base::Vector3f&, float, std::vector<PointIndex>&) const;
 
+    /** @name Batch queries
+     * The queries are run in parallel for all \a points.
+     */
+    //@{
+    /** Finds the \a k nearest points not farther than \a max_dist for each of the
+     * \a points. The results of the i-th point are stored at [i*k, (i+1)*k) in
+     * \a indices and \a distances sorted by distance. Unused slots are set to
+     * POINT_INDEX_MAX and FLOAT_MAX.
+     */
+    void FindNearest(const std::vector<Base::Vector3f>& points, std::size_t k,
+                     std::vector<PointIndex>& indices, std::vector<float>& distances,
+                     float max_dist = FLOAT_MAX) const;
+    void FindNearest(const MeshPointArray& points, std::size_t k,
+                     std::vector<PointIndex>& indices, std::vector<float>& distances,
+                     float max_dist = FLOAT_MAX) const;
+    /** Finds all points within the distance \a radius for each of the \a points.
+     * The results of the i-th point are stored at [offsets[i], offsets[i+1]) in
+     * \a indices and \a distances sorted by distance.
+     */
+    void FindInRadius(const std::vector<Base::Vector3f>& points, float radius,
+                      std::vector<std::size_t>& offsets, std::vector<PointIndex>& indices,
+                      std::vector<float>& distances) const;
+    void FindInRadius(const MeshPointArray& points, float radius,
+                      std::vector<std::size_t>& offsets, std::vector<PointIndex>& indices,
+                      std::vector<float>& distances) const;
+    //@}
+
 private:
     class Private;
     Private* d;
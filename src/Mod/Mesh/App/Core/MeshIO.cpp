@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 # include <algorithm>
 # include <cmath>
+# include <cstring>
 # include <iomanip>
 # include <sstream>
 # include <string_view>
@@ -35,6 +36,7 @@
 #include <boost/convert/spirit.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
+#include <QFile>
 
 #include <Base/Builder3D.h>
 #include <Base/Console.h>
@@ -47,7 +49,9 @@
 #include <Base/Tools.h>
 #include <Base/Writer.h>
 #include "IO/Reader3MF.h"
+#include "IO/ReaderBMS.h"
 #include "IO/ReaderOBJ.h"
+#include "IO/TextParser.h"
 #include "IO/Writer3MF.h"
 #include "IO/WriterOBJ.h"
 #include <zipios++/gzipoutputstream.h>
@@ -57,6 +61,7 @@
 #include "Builder.h"
 #include "Definitions.h"
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 
@@ -95,6 +100,78 @@ struct NODE {float x, y, z;};
 struct TRIA {int iV[3];};
 struct QUAD {int iV[4];};
 
+/* Checks the upper-cased characters following the header of an STL file for keywords
+ * like 'SOLID', 'FACET', 'NORMAL', 'VERTEX', 'ENDFACET' or 'ENDLOOP'.
+ */
+bool hasAsciiSTLKeyword(char* szBuf)
+{
+    boost::algorithm::to_upper(szBuf);
+    return strstr(szBuf, "SOLID") || strstr(szBuf, "FACET") || strstr(szBuf, "NORMAL") ||
+           strstr(szBuf, "VERTEX") || strstr(szBuf, "ENDFACET") || strstr(szBuf, "ENDLOOP");
+}
+
+enum class STLFormat {
+    Unknown, Ascii, Binary
+};
+
+/* Checks if the memory block holds a binary or ASCII STL file. The same bytes as in
+ * MeshInput::LoadSTL are checked. The format of files that are too short is unknown.
+ */
+STLFormat checkSTLFormat(const char* pData, std::size_t ulSize)
+{
+    char szBuf[200];
+    uint32_t ulCt, ulBytes=50;
+    if (ulSize < 84)
+        return STLFormat::Unknown;
+    memcpy(&ulCt, pData + 80, sizeof(ulCt));
+    if (ulCt > 1)
+        ulBytes = 100;
+    if (ulSize < 84 + ulBytes)
+        return STLFormat::Unknown;
+    memcpy(szBuf, pData + 84, ulBytes);
+    szBuf[ulBytes] = 0;
+    return hasAsciiSTLKeyword(szBuf) ? STLFormat::Ascii : STLFormat::Binary;
+}
+
+/* Reads the corner points of a facet record of a binary STL file. The normal
+ * is skipped and the points are stored in the order p3, p1, p2.
+ */
+void readBinarySTLFacet(const char* pFacet, Base::Vector3f* points)
+{
+    float v[9];
+    memcpy(v, pFacet + 3 * sizeof(float), sizeof(v));
+    points[0].Set(v[6], v[7], v[8]);
+    points[1].Set(v[0], v[1], v[2]);
+    points[2].Set(v[3], v[4], v[5]);
+}
+
+/* Runs \a load and clears the mesh if it fails. An abort by the user is not
+ * passed on but makes the load return false.
+ */
+template <class Load>
+bool loadOrClear(MeshKernel& kernel, Load&& load)
+{
+    try {
+        return load();
+    }
+    catch (const Base::MemoryException&) {
+        kernel.Clear();
+        throw; // Throw the same instance of Base::MemoryException
+    }
+    catch (const Base::AbortException&) {
+        kernel.Clear();
+        return false;
+    }
+    catch (const Base::Exception&) {
+        kernel.Clear();
+        throw;  // Throw the same instance of Base::Exception
+    }
+    catch (...) {
+        kernel.Clear();
+        throw;
+    }
+}
+
 }
 
 // --------------------------------------------------------------
@@ -178,19 +255,32 @@ bool MeshInput::LoadAny(const char* FileName)
     if (!fi.isReadable())
         throw Base::FileException("No permission on the file", FileName);
 
+    if (fi.hasExtension("stl") || fi.hasExtension("ast")) {
+        // map the file into memory to read the facets in parallel
+        QFile file(QString::fromUtf8(fi.filePath().c_str()));
+        if (!file.open(QIODevice::ReadOnly))
+            throw Base::FileException("Failed to open file", FileName);
+        QByteArray content;
+        const char* pData = reinterpret_cast<const char*>(file.map(0, file.size()));
+        if (!pData) {
+            // not every file can be mapped, read it at once then
+            content = file.readAll();
+            pData = content.constData();
+        }
+        return LoadSTL(pData, static_cast<std::size_t>(file.size()));
+    }
+
     Base::ifstream str(fi, std::ios::in | std::ios::binary);
 
     if (fi.hasExtension("bms")) {
-        _rclMesh.Read(str);
+        ReaderBMS reader(_rclMesh);
+        reader.Load(str);
         return true;
     }
     else {
         // read file
         bool ok = false;
-        if (fi.hasExtension("stl") || fi.hasExtension("ast")) {
-            ok = LoadSTL(str);
-        }
-        else if (fi.hasExtension("iv")) {
+        if (fi.hasExtension("iv")) {
             ok = LoadInventor( str );
             if (ok && _rclMesh.CountFacets() == 0)
                 Base::Console().Warning("No usable mesh found in file '%s'", FileName);
@@ -225,7 +315,10 @@ bool  MeshInput::LoadFormat(std::istream &str, MeshIO::Format fmt)
 {
     switch (fmt) {
     case MeshIO::BMS:
-        _rclMesh.Read(str);
+        {
+            ReaderBMS reader(_rclMesh);
+            reader.Load(str);
+        }
         return true;
     case MeshIO::APLY:
     case MeshIO::PLY:
@@ -281,39 +374,37 @@ bool MeshInput::LoadSTL (std::istream &rstrIn)
     if (!rstrIn.read(szBuf, ulBytes))
         return (ulCt==0);
     szBuf[ulBytes] = 0;
-    boost::algorithm::to_upper(szBuf);
 
-    try {
-        if (!strstr(szBuf, "SOLID") && !strstr(szBuf, "FACET") && !strstr(szBuf, "NORMAL") &&
-            !strstr(szBuf, "VERTEX") && !strstr(szBuf, "ENDFACET") && !strstr(szBuf, "ENDLOOP")) {
+    return loadOrClear(_rclMesh, [&]() {
+        buf->pubseekoff(0, std::ios::beg, std::ios::in);
+        if (!hasAsciiSTLKeyword(szBuf)) {
             // probably binary STL
-            buf->pubseekoff(0, std::ios::beg, std::ios::in);
             return LoadBinarySTL(rstrIn);
         }
         else {
             // Ascii STL
-            buf->pubseekoff(0, std::ios::beg, std::ios::in);
             return LoadAsciiSTL(rstrIn);
         }
-    }
-    catch (const Base::MemoryException&) {
-        _rclMesh.Clear();
-        throw; // Throw the same instance of Base::MemoryException
-    }
-    catch (const Base::AbortException&) {
-        _rclMesh.Clear();
-        return false;
-    }
-    catch (const Base::Exception&) {
-        _rclMesh.Clear();
-        throw;  // Throw the same instance of Base::Exception
-    }
-    catch (...) {
-        _rclMesh.Clear();
-        throw;
+    });
+}
+
+bool MeshInput::LoadSTL (const char* pData, std::size_t ulSize)
+{
+    STLFormat format = checkSTLFormat(pData, ulSize);
+    if (format == STLFormat::Unknown) {
+        // Either it's really an invalid STL file or it's just empty. In this case the number of facets must be 0.
+        uint32_t ulCt = 1;
+        if (ulSize >= 84)
+            memcpy(&ulCt, pData + 80, sizeof(ulCt));
+        return (ulCt==0);
     }
 
-    return true;
+    return loadOrClear(_rclMesh, [&]() {
+        if (format == STLFormat::Binary)
+            return LoadBinarySTL(pData, ulSize);
+        else
+            return LoadAsciiSTL(pData, ulSize);
+    });
 }
 
 /** Loads an OBJ file. */
@@ -455,100 +546,70 @@ bool MeshInput::LoadOFF (std::istream &rstrIn)
     if (numPoints == 0 || numFaces == 0)
         return false;
 
+    // a color is given as r g b with an optional alpha value
+    auto readColor = [](const double* values, std::size_t count) {
+        float r = static_cast<float>(values[0]);
+        float g = static_cast<float>(values[1]);
+        float b = static_cast<float>(values[2]);
+        // no transparency
+        float a = count > 3 ? static_cast<float>(values[3]) : 0.0f;
+
+        if (r > 1.0f || g > 1.0f || b > 1.0f || a > 1.0f) {
+            r /= 255.0f;
+            g /= 255.0f;
+            b /= 255.0f;
+            a /= 255.0f;
+        }
+        return App::Color(r, g, b, a);
+    };
+
+    // the numbers of the remaining lines are parsed in parallel
+    TextParser parser(rstrIn);
+    TextParser::Rows rows = parser.ParseRows();
+
+    // lines with less than three numbers are no points
+    std::size_t row = 0;
+    std::size_t ulCtRows = rows.Count();
     meshPoints.reserve(numPoints);
-    meshFacets.reserve(numFaces);
     if (colorPerVertex)
         diffuseColor.reserve(numPoints);
-    else
-        diffuseColor.reserve(numFaces);
-
-    int cntPoints = 0;
-    while (cntPoints < numPoints) {
-        if (!std::getline(rstrIn, line))
-            break;
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-        if (str.eof())
-            continue; // empty line
-
-        float fX, fY, fZ;
-        str >> fX >> std::ws >> fY >> std::ws >> fZ;
-        if (str) {
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-            cntPoints++;
-
-            if (colorPerVertex) {
-                std::size_t pos = std::size_t(str.tellg());
-                if (line.size() > pos) {
-                    float r,g,b,a;
-                    str >> std::ws >> r >> std::ws >> g >> std::ws >> b;
-                    if (str) {
-                        str >> std::ws >> a;
-                        // no transparency
-                        if (!str)
-                            a = 0.0f;
-
-                        if (r > 1.0f || g > 1.0f || b > 1.0f || a > 1.0f) {
-                            r = static_cast<float>(r)/255.0f;
-                            g = static_cast<float>(g)/255.0f;
-                            b = static_cast<float>(b)/255.0f;
-                            a = static_cast<float>(a)/255.0f;
-                        }
-                        diffuseColor.emplace_back(r, g, b, a);
-                    }
-                }
-            }
-        }
+    for (; row < ulCtRows && static_cast<int>(meshPoints.size()) < numPoints; row++) {
+        std::size_t count = rows.Size(row);
+        if (count < 3)
+            continue;
+        const double* values = rows[row];
+        meshPoints.push_back(MeshPoint(Base::Vector3f(static_cast<float>(values[0]),
+                                                      static_cast<float>(values[1]),
+                                                      static_cast<float>(values[2]))));
+        if (colorPerVertex && count >= 6)
+            diffuseColor.push_back(readColor(values + 3, count - 3));
     }
 
-    int cntFaces = 0;
-    while (cntFaces < numFaces) {
-        if (!std::getline(rstrIn, line))
-            break;
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-        if (str.eof())
-            continue; // empty line
-        int count, index;
-        str >> count;
-        if (count >= 3) {
-            std::vector<int> faces;
-            faces.reserve(count);
-
-            for (int i = 0; i < count; i++) {
-                str >> std::ws;
-                str >> index;
-                faces.push_back(index);
-            }
+    meshFacets.reserve(numFaces);
+    if (!colorPerVertex)
+        diffuseColor.reserve(numFaces);
+    for (int cntFaces = 0; row < ulCtRows && cntFaces < numFaces; row++) {
+        std::size_t size = rows.Size(row);
+        const double* values = rows[row];
+        int count = static_cast<int>(values[0]);
+        if (count < 3 || static_cast<std::size_t>(count) >= size)
+            continue;
+
+        // negative indices become invalid and are removed below
+        auto index = [values](int i) {
+            return static_cast<PointIndex>(static_cast<long>(values[i]));
+        };
+        for (int i = 0; i < count-2; i++) {
+            item.SetVertices(index(1), index(i+2), index(i+3));
+            meshFacets.push_back(item);
+        }
+        cntFaces++;
 
+        std::size_t pos = static_cast<std::size_t>(count) + 1;
+        if (size >= pos + 3) {
+            App::Color color = readColor(values + pos, size - pos);
             for (int i = 0; i < count-2; i++) {
-                item.SetVertices(faces[0],faces[i+1],faces[i+2]);
-                meshFacets.push_back(item);
-            }
-            cntFaces++;
-
-            std::size_t pos = std::size_t(str.tellg());
-            if (line.size() > pos) {
-                float r,g,b,a;
-                str >> std::ws >> r >> std::ws >> g >> std::ws >> b;
-                if (str) {
-                    str >> std::ws >> a;
-                    // no transparency
-                    if (!str)
-                        a = 0.0f;
-
-                    if (r > 1.0f || g > 1.0f || b > 1.0f || a > 1.0f) {
-                        r = static_cast<float>(r)/255.0f;
-                        g = static_cast<float>(g)/255.0f;
-                        b = static_cast<float>(b)/255.0f;
-                        a = static_cast<float>(a)/255.0f;
-                    }
-                    for (int i = 0; i < count-2; i++) {
-                        diffuseColor.emplace_back(r, g, b, a);
-                    }
-                }
+                diffuseColor.push_back(color);
             }
         }
     }
@@ -838,85 +899,57 @@ bool MeshInput::LoadPLY (std::istream &inp)
     }
 
     if (format == ascii) {
-        boost::regex rx_d("(([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?))\\s*");
-        boost::regex rx_s("\\b([-+]?[0-9]+)\\s*");
-        boost::regex rx_u("\\b([0-9]+)\\s*");
-        boost::regex rx_f("^\\s*3\\s+([0-9]+)\\s+([0-9]+)\\s+([0-9]+)\\s*");
-        boost::smatch what;
+        // the columns of the vertex properties
+        auto column = [&vertex_props](const char* name) {
+            auto it = std::find_if(vertex_props.begin(), vertex_props.end(),
+                                   [name](const std::pair<std::string, Number>& p) { return p.first == name; });
+            return static_cast<std::size_t>(it - vertex_props.begin());
+        };
+        std::size_t col_x = column("x");
+        std::size_t col_y = column("y");
+        std::size_t col_z = column("z");
+        std::size_t col_r = column("red");
+        std::size_t col_g = column("green");
+        std::size_t col_b = column("blue");
+
+        // the numbers of the element lines are parsed in parallel
+        TextParser parser(inp);
+        TextParser::Rows rows = parser.ParseRows();
+        std::size_t ulCtRows = rows.Count();
+        std::size_t ulCtPoints = std::min(v_count, ulCtRows);
+        for (std::size_t i = 0; i < ulCtPoints; i++) {
+            if (rows.Size(i) < vertex_props.size())
+                return false;
+        }
 
-        for (std::size_t i = 0; i < v_count && std::getline(inp, line); i++) {
-            // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (std::vector<std::pair<std::string, Number> >::iterator it = vertex_props.begin(); it != vertex_props.end(); ++it) {
-                switch (it->second) {
-                case int8:
-                case int16:
-                case int32:
-                    {
-                        if (boost::regex_search(line, what, rx_s)) {
-                            int v;
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                case uint8:
-                case uint16:
-                case uint32:
-                    {
-                        if (boost::regex_search(line, what, rx_u)) {
-                            int v;
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                case float32:
-                case float64:
-                    {
-                        if (boost::regex_search(line, what, rx_d)) {
-                            double v;
-                            v = boost::lexical_cast<double>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                default:
-                    return false;
+        bool colors = (_material && (rgb_value == MeshIO::PER_VERTEX));
+        meshPoints.resize(ulCtPoints);
+        if (colors)
+            _material->diffuseColor.resize(ulCtPoints);
+        parallel_blocks(ulCtPoints, 10000, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const double* values = rows[i];
+                meshPoints[i].Set(static_cast<float>(values[col_x]),
+                                  static_cast<float>(values[col_y]),
+                                  static_cast<float>(values[col_z]));
+                if (colors) {
+                    float r = static_cast<float>(values[col_r]) / 255.0f;
+                    float g = static_cast<float>(values[col_g]) / 255.0f;
+                    float b = static_cast<float>(values[col_b]) / 255.0f;
+                    _material->diffuseColor[i] = App::Color(r, g, b);
                 }
             }
+        });
 
-            Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
-            meshPoints.push_back(pt);
-
-            if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
-                _material->diffuseColor.emplace_back(r, g, b);
-            }
-        }
-
-        int f1, f2, f3;
-        for (std::size_t i = 0; i < f_count && std::getline(inp, line); i++) {
-            if (boost::regex_search(line, what, rx_f)) {
-                f1 = boost::lexical_cast<int>(what[1]);
-                f2 = boost::lexical_cast<int>(what[2]);
-                f3 = boost::lexical_cast<int>(what[3]);
-                meshFacets.push_back(MeshFacet(f1,f2,f3));
-            }
+        // only triangles are supported, negative indices become invalid and are removed below
+        auto index = [](double value) {
+            return static_cast<PointIndex>(static_cast<long>(value));
+        };
+        std::size_t ulLastRow = std::min(ulCtRows, ulCtPoints + f_count);
+        for (std::size_t i = ulCtPoints; i < ulLastRow; i++) {
+            const double* values = rows[i];
+            if (rows.Size(i) >= 4 && values[0] == 3.0)
+                meshFacets.push_back(MeshFacet(index(values[1]), index(values[2]), index(values[3])));
         }
     }
     // binary
@@ -1117,71 +1150,63 @@ bool MeshInput::LoadMeshNode (std::istream &rstrIn)
 /** Loads an ASCII STL file. */
 bool MeshInput::LoadAsciiSTL (std::istream &rstrIn)
 {
-    boost::regex rx_p("^\\s*VERTEX\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_f("^\\s*FACET\\s+NORMAL\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::cmatch what;
-
-    std::string line;
-    float fX, fY, fZ;
-    unsigned long ulVertexCt, ulFacetCt=0;
-    MeshGeomFacet clFacet;
-
     if (!rstrIn || rstrIn.bad())
         return false;
 
-    std::streamoff ulSize = 0;
-    std::streambuf* buf = rstrIn.rdbuf();
-    ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
-    ulSize -= 20;
-
-    // count facets
-    while (std::getline(rstrIn, line)) {
-        boost::algorithm::to_upper(line);
-        if (line.find("ENDFACET") != std::string::npos)
-            ulFacetCt++;
-        // prevent from reading EOF (as I don't know how to reread the file then)
-        if (rstrIn.tellg() > ulSize)
-            break;
-        else if (line.find("ENDSOLID") != std::string::npos)
-            break;
-    }
-
-    // restart from the beginning
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
+    TextParser parser(rstrIn);
+    return LoadAsciiSTL(parser.Data(), parser.Size());
+}
 
-#if 0
-    MeshBuilder builder(this->_rclMesh);
-#else
-    MeshFastBuilder builder(this->_rclMesh);
-#endif
-    builder.Initialize(ulFacetCt);
+bool MeshInput::LoadAsciiSTL (const char* pData, std::size_t ulSize)
+{
+    if (!pData)
+        return false;
 
-    ulVertexCt = 0;
-    while (std::getline(rstrIn, line)) {
-        boost::algorithm::to_upper(line);
-        if (boost::regex_match(line.c_str(), what, rx_f)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet.SetNormal(Base::Vector3f(fX, fY, fZ));
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet._aclPoints[ulVertexCt++].Set(fX, fY, fZ);
-            if (ulVertexCt == 3) {
-                ulVertexCt = 0;
-                builder.AddFacet(clFacet);
+    // collect the points of the 'vertex' lines per chunk, every three of them form a facet
+    TextParser parser(pData, ulSize);
+    std::vector<std::vector<Base::Vector3f> > chunks(parser.CountChunks());
+    parser.ParseChunks([&chunks](std::size_t chunk, const char* first, const char* last) {
+        std::vector<Base::Vector3f>& points = chunks[chunk];
+        TextParser::ForEachLine(first, last, [&points](const char* pos, const char* eol) {
+            pos = TextParser::SkipBlanks(pos, eol);
+            const char* next = TextParser::ParseKeyword(pos, eol, "vertex", true);
+            if (next == pos)
+                return;
+            Base::Vector3f pnt;
+            for (int i = 0; i < 3; i++) {
+                pos = TextParser::SkipBlanks(next, eol);
+                next = TextParser::ParseNumber(pos, eol, pnt[i]);
+                if (next == pos)
+                    return;
             }
+            if (TextParser::AtEnd(next, eol))
+                points.push_back(pnt);
+        });
+    });
+
+    std::vector<Base::Vector3f> points;
+    if (chunks.size() == 1) {
+        points.swap(chunks.front());
+    }
+    else {
+        std::size_t ulCtPoints = 0;
+        for (const auto& it : chunks)
+            ulCtPoints += it.size();
+        points.reserve(ulCtPoints);
+        for (auto& it : chunks) {
+            points.insert(points.end(), it.begin(), it.end());
+            std::vector<Base::Vector3f>().swap(it);
         }
     }
 
+    std::size_t ulCtFacets = points.size() / 3;
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Initialize(ulCtFacets);
+    builder.AddFacets(ulCtFacets, [&points](std::size_t i, Base::Vector3f* facetPoints) {
+        facetPoints[0] = points[3 * i];
+        facetPoints[1] = points[3 * i + 1];
+        facetPoints[2] = points[3 * i + 2];
+    });
     builder.Finish();
 
     return true;
@@ -1191,8 +1216,6 @@ bool MeshInput::LoadAsciiSTL (std::istream &rstrIn)
 bool MeshInput::LoadBinarySTL (std::istream &rstrIn)
 {
     char szInfo[80];
-    Base::Vector3f clVects[4];
-    uint16_t usAtt = 0;
     uint32_t ulCt = 0;
 
     if (!rstrIn || rstrIn.bad())
@@ -1222,24 +1245,45 @@ bool MeshInput::LoadBinarySTL (std::istream &rstrIn)
     if (ulCt > ulFac)
         return false;// not a valid STL file
 
-#if 0
-    MeshBuilder builder(this->_rclMesh);
-#else
     MeshFastBuilder builder(this->_rclMesh);
-#endif
     builder.Initialize(ulCt);
 
-    for (uint32_t i = 0; i < ulCt; i++) {
-        // read normal, points
-        rstrIn.read((char*)&clVects, sizeof(clVects));
+    // read the facet records (normal, points and 2 bytes attribute) in chunks
+    const uint32_t ulChunk = 65536;
+    std::vector<char> chunk(50 * static_cast<std::size_t>(std::min(ulCt, ulChunk)));
+    for (uint32_t i = 0; i < ulCt; i += ulChunk) {
+        uint32_t ulCtChunk = std::min(ulChunk, ulCt - i);
+        if (!rstrIn.read(chunk.data(), 50 * static_cast<std::streamsize>(ulCtChunk)))
+            return false;
+        const char* pFacets = chunk.data();
+        builder.AddFacets(ulCtChunk, [pFacets](std::size_t j, Base::Vector3f* points) {
+            readBinarySTLFacet(pFacets + 50 * j, points);
+        });
+    }
 
-        std::swap(clVects[0], clVects[3]);
-        builder.AddFacet(clVects);
+    builder.Finish();
 
-        // overread 2 bytes attribute
-        rstrIn.read((char*)&usAtt, sizeof(usAtt));
-    }
+    return true;
+}
+
+bool MeshInput::LoadBinarySTL (const char* pData, std::size_t ulSize)
+{
+    const std::size_t ulHeader = 80 + sizeof(uint32_t);
+    if (!pData || ulSize < ulHeader)
+        return false;
+
+    uint32_t ulCt = 0;
+    memcpy(&ulCt, pData + 80, sizeof(ulCt));
+
+    // compare the calculated with the read value
+    if (ulCt > (ulSize - ulHeader) / 50)
+        return false;// not a valid STL file
 
+    MeshFastBuilder builder(this->_rclMesh);
+    const char* pFacets = pData + ulHeader;
+    builder.AddFacets(ulCt, [pFacets](std::size_t i, Base::Vector3f* points) {
+        readBinarySTLFacet(pFacets + 50 * i, points);
+    });
     builder.Finish();
 
     return true;
@@ -1268,15 +1312,17 @@ void MeshInput::LoadXML (Base::XMLReader &reader)
     reader.readElement("Faces");
     Cnt = reader.getAttributeAsInteger("Count");
 
+    // Use the unsigned accessor for the indices because a missing neighbour
+    // is written as FACET_INDEX_MAX which doesn't fit into a signed long
     cFacets.resize(Cnt);
     for (int i=0 ;i<Cnt ;i++) {
         reader.readElement("F");
-        cFacets[i]._aulPoints[0] = reader.getAttributeAsInteger("p0");
-        cFacets[i]._aulPoints[1] = reader.getAttributeAsInteger("p1");
-        cFacets[i]._aulPoints[2] = reader.getAttributeAsInteger("p2");
-        cFacets[i]._aulNeighbours[0] = reader.getAttributeAsInteger("n0");
-        cFacets[i]._aulNeighbours[1] = reader.getAttributeAsInteger("n1");
-        cFacets[i]._aulNeighbours[2] = reader.getAttributeAsInteger("n2");
+        cFacets[i]._aulPoints[0] = reader.getAttributeAsUnsigned("p0");
+        cFacets[i]._aulPoints[1] = reader.getAttributeAsUnsigned("p1");
+        cFacets[i]._aulPoints[2] = reader.getAttributeAsUnsigned("p2");
+        cFacets[i]._aulNeighbours[0] = reader.getAttributeAsUnsigned("n0");
+        cFacets[i]._aulNeighbours[1] = reader.getAttributeAsUnsigned("n1");
+        cFacets[i]._aulNeighbours[2] = reader.getAttributeAsUnsigned("n2");
     }
 
     reader.readEndElement("Faces");
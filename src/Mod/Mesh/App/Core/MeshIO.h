@@ -118,10 +118,22 @@ public:
      * Therefore the file header gets checked to decide if the file is binary or not.
      */
     bool LoadSTL (std::istream &rstrIn);
+    /** Loads an STL file from the memory block \a pData of \a ulSize bytes,
+     * e.g. a memory-mapped file, in binary or ASCII format.
+     */
+    bool LoadSTL (const char* pData, std::size_t ulSize);
     /** Loads an ASCII STL file. */
     bool LoadAsciiSTL (std::istream &rstrIn);
+    /** Loads an ASCII STL file from the memory block \a pData of \a ulSize bytes,
+     * e.g. a memory-mapped file. The text is parsed in parallel.
+     */
+    bool LoadAsciiSTL (const char* pData, std::size_t ulSize);
     /** Loads a binary STL file. */
     bool LoadBinarySTL (std::istream &rstrIn);
+    /** Loads a binary STL file from the memory block \a pData of \a ulSize bytes,
+     * e.g. a memory-mapped file. The facets are read in parallel.
+     */
+    bool LoadBinarySTL (const char* pData, std::size_t ulSize);
     /** Loads an OBJ Mesh file. */
     bool LoadOBJ (std::istream &rstrIn);
     /** Loads an OBJ Mesh file. */
@@ -179,6 +191,9 @@ public:
      * automatically filled up with spaces.
      */
     static void SetSTLHeaderData(const std::string&);
+    /// Returns the 80 characters of the header of a binary STL.
+    static const std::string& GetSTLHeaderData()
+    { return stl_header; }
     /**
      * Change the image size of the asymptote output.
      */
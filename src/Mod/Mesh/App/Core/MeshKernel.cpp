@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 # include <algorithm>
 # include <map>
+# include <mutex>
 # include <queue>
 # include <stdexcept>
 #endif
@@ -58,8 +59,18 @@ MeshKernel::MeshKernel (const MeshKernel &rclMesh)
 MeshKernel& MeshKernel::operator = (const MeshKernel &rclMesh)
 {
     if (this != &rclMesh) { // must be a different instance
-        this->_aclPointArray  = rclMesh._aclPointArray;
-        this->_aclFacetArray  = rclMesh._aclFacetArray;
+        if (rclMesh.IsCompact()) {
+            // the copy stays compact
+            MeshPointArray().swap(this->_aclPointArray);
+            MeshFacetArray().swap(this->_aclFacetArray);
+            this->_pcCompact.reset(new MeshCompactStorage(*rclMesh._pcCompact));
+            this->_bCompact.store(true, std::memory_order_release);
+        }
+        else {
+            ReleaseStorage();
+            this->_aclPointArray  = rclMesh._aclPointArray;
+            this->_aclFacetArray  = rclMesh._aclFacetArray;
+        }
         this->_clBoundBox     = rclMesh._clBoundBox;
         this->_bValid         = rclMesh._bValid;
     }
@@ -81,6 +92,7 @@ MeshKernel& MeshKernel::operator = (const std::vector<MeshGeomFacet> &rclFAry)
 
 void MeshKernel::Assign(const MeshPointArray& rPoints, const MeshFacetArray& rFacets, bool checkNeighbourHood)
 {
+    ReleaseStorage();
     _aclPointArray = rPoints;
     _aclFacetArray = rFacets;
     RecalcBoundBox();
@@ -90,6 +102,7 @@ void MeshKernel::Assign(const MeshPointArray& rPoints, const MeshFacetArray& rFa
 
 void MeshKernel::Adopt(MeshPointArray& rPoints, MeshFacetArray& rFacets, bool checkNeighbourHood)
 {
+    ReleaseStorage();
     _aclPointArray.swap(rPoints);
     _aclFacetArray.swap(rFacets);
     RecalcBoundBox();
@@ -101,9 +114,44 @@ void MeshKernel::Swap(MeshKernel& mesh)
 {
     this->_aclPointArray.swap(mesh._aclPointArray);
     this->_aclFacetArray.swap(mesh._aclFacetArray);
+    this->_pcCompact.swap(mesh._pcCompact);
+    bool bCompact = this->IsCompact();
+    this->_bCompact.store(mesh.IsCompact(), std::memory_order_release);
+    mesh._bCompact.store(bCompact, std::memory_order_release);
     this->_clBoundBox = mesh._clBoundBox;
 }
 
+void MeshKernel::Compact()
+{
+    if (IsCompact())
+        return;
+    std::unique_ptr<MeshCompactStorage> storage(new MeshCompactStorage);
+    storage->Assign(_aclPointArray, _aclFacetArray);
+    _pcCompact = std::move(storage);
+
+    // release memory
+    MeshPointArray().swap(_aclPointArray);
+    MeshFacetArray().swap(_aclFacetArray);
+    _bCompact.store(true, std::memory_order_release);
+}
+
+void MeshKernel::UnpackStorage() const
+{
+    // several threads may read from the same kernel
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!IsCompact())
+        return;
+    _pcCompact->Restore(_aclPointArray, _aclFacetArray);
+    _bCompact.store(false, std::memory_order_release);
+}
+
+void MeshKernel::ReleaseStorage()
+{
+    _bCompact.store(false, std::memory_order_release);
+    _pcCompact.reset();
+}
+
 MeshKernel& MeshKernel::operator += (const MeshGeomFacet &rclSFacet)
 {
     this->AddFacet(rclSFacet);
@@ -112,6 +160,7 @@ MeshKernel& MeshKernel::operator += (const MeshGeomFacet &rclSFacet)
 
 void MeshKernel::AddFacet(const MeshGeomFacet &rclSFacet)
 {
+    Expand();
     MeshFacet clFacet;
 
     // set corner points
@@ -161,6 +210,7 @@ MeshKernel& MeshKernel::operator += (const std::vector<MeshGeomFacet> &rclFAry)
 
 void MeshKernel::AddFacets(const std::vector<MeshGeomFacet> &rclFAry)
 {
+    Expand();
     // Create a temp. kernel to get the topology of the passed triangles
     // and merge them with this kernel. This keeps properties and flags
     // of this mesh.
@@ -172,6 +222,7 @@ void MeshKernel::AddFacets(const std::vector<MeshGeomFacet> &rclFAry)
 unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet> &rclFAry,
                                     bool checkManifolds)
 {
+    Expand();
     // Build map of edges of the referencing facets we want to append
 #ifdef FC_DEBUG
     unsigned long countPoints = CountPoints();
@@ -335,6 +386,7 @@ unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet> &rclFAry,
                                     const std::vector<Base::Vector3f>& rclPAry,
                                     bool checkManifolds)
 {
+    Expand();
     for (std::vector<Base::Vector3f>::const_iterator it = rclPAry.begin(); it != rclPAry.end(); ++it)
         _clBoundBox.Add(*it);
     this->_aclPointArray.insert(this->_aclPointArray.end(), rclPAry.begin(), rclPAry.end());
@@ -344,6 +396,7 @@ unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet> &rclFAry,
 void MeshKernel::Merge(const MeshKernel& rKernel)
 {
     if (this != &rKernel) {
+        rKernel.Unpack();
         const MeshPointArray& rPoints = rKernel._aclPointArray;
         const MeshFacetArray& rFacets  = rKernel._aclFacetArray;
         Merge(rPoints, rFacets);
@@ -352,6 +405,7 @@ void MeshKernel::Merge(const MeshKernel& rKernel)
 
 void MeshKernel::Merge(const MeshPointArray& rPoints, const MeshFacetArray& rFaces)
 {
+    Expand();
     if (rPoints.empty() || rFaces.empty())
         return; // nothing to do
     std::vector<unsigned long> increments(rPoints.size());
@@ -406,12 +460,14 @@ void MeshKernel::Merge(const MeshPointArray& rPoints, const MeshFacetArray& rFac
 
 void MeshKernel::Cleanup()
 {
+    Expand();
     MeshCleanup meshCleanup(_aclPointArray, _aclFacetArray);
     meshCleanup.RemoveInvalids();
 }
 
 void MeshKernel::Clear ()
 {
+    ReleaseStorage();
     _aclPointArray.clear();
     _aclFacetArray.clear();
 
@@ -424,17 +480,19 @@ void MeshKernel::Clear ()
 
 bool MeshKernel::DeleteFacet (const MeshFacetIterator &rclIter)
 {
+    Expand();
     FacetIndex ulNFacet, ulInd;
 
-    if (rclIter._clIter >= _aclFacetArray.end())
+    if (rclIter.Position() >= _aclFacetArray.size())
         return false;
 
     // index of the facet to delete
-    ulInd = rclIter._clIter - _aclFacetArray.begin();
+    ulInd = rclIter.Position();
+    const MeshFacet& rclFacet = _aclFacetArray[ulInd];
 
     // invalidate neighbour indices of the neighbour facet to this facet
     for (int i = 0; i < 3; i++) {
-        ulNFacet = rclIter._clIter->_aulNeighbours[i];
+        ulNFacet = rclFacet._aulNeighbours[i];
         if (ulNFacet != FACET_INDEX_MAX) {
             for (int j = 0; j < 3; j++) {
                 if (_aclFacetArray[ulNFacet]._aulNeighbours[j] == ulInd) {
@@ -447,10 +505,10 @@ bool MeshKernel::DeleteFacet (const MeshFacetIterator &rclIter)
 
     // erase corner point if needed
     for (int i = 0; i < 3; i++) {
-        if ((rclIter._clIter->_aulNeighbours[i] == FACET_INDEX_MAX) &&
-            (rclIter._clIter->_aulNeighbours[(i+1)%3] == FACET_INDEX_MAX)) {
+        if ((rclFacet._aulNeighbours[i] == FACET_INDEX_MAX) &&
+            (rclFacet._aulNeighbours[(i+1)%3] == FACET_INDEX_MAX)) {
             // no neighbours, possibly delete point
-            ErasePoint(rclIter._clIter->_aulPoints[(i+1)%3], ulInd);
+            ErasePoint(rclFacet._aulPoints[(i+1)%3], ulInd);
         }
     }
 
@@ -462,6 +520,7 @@ bool MeshKernel::DeleteFacet (const MeshFacetIterator &rclIter)
 
 bool MeshKernel::DeleteFacet (FacetIndex ulInd)
 {
+    Expand();
     if (ulInd >= _aclFacetArray.size())
         return false;
 
@@ -473,6 +532,7 @@ bool MeshKernel::DeleteFacet (FacetIndex ulInd)
 
 void MeshKernel::DeleteFacets (const std::vector<FacetIndex> &raulFacets)
 {
+    Expand();
     _aclPointArray.SetProperty(0);
 
     // number of referencing facets per point
@@ -505,6 +565,7 @@ void MeshKernel::DeleteFacets (const std::vector<FacetIndex> &raulFacets)
 
 bool MeshKernel::DeletePoint (PointIndex ulInd)
 {
+    Expand();
     if (ulInd >= _aclPointArray.size())
         return false;
 
@@ -516,12 +577,13 @@ bool MeshKernel::DeletePoint (PointIndex ulInd)
 
 bool MeshKernel::DeletePoint (const MeshPointIterator &rclIter)
 {
+    Expand();
     MeshFacetIterator pFIter(*this), pFEnd(*this);
     std::vector<MeshFacetIterator>  clToDel;
     PointIndex ulInd;
 
     // index of the point to delete
-    ulInd = rclIter._clIter - _aclPointArray.begin();
+    ulInd = rclIter.Position();
 
     pFIter.Begin();
     pFEnd.End();
@@ -529,7 +591,7 @@ bool MeshKernel::DeletePoint (const MeshPointIterator &rclIter)
     // check corner points of all facets
     while (pFIter < pFEnd) {
         for (size_t i = 0; i < 3; i++) {
-            if (ulInd == pFIter._clIter->_aulPoints[i])
+            if (ulInd == pFIter.GetIndices()._aulPoints[i])
                 clToDel.push_back(pFIter);
         }
         ++pFIter;
@@ -547,6 +609,7 @@ bool MeshKernel::DeletePoint (const MeshPointIterator &rclIter)
 
 void MeshKernel::DeletePoints (const std::vector<PointIndex> &raulPoints)
 {
+    Expand();
     _aclPointArray.ResetInvalid();
     for (std::vector<PointIndex>::const_iterator pI = raulPoints.begin(); pI != raulPoints.end(); ++pI)
         _aclPointArray[*pI].SetInvalid();
@@ -581,6 +644,7 @@ void MeshKernel::DeletePoints (const std::vector<PointIndex> &raulPoints)
 
 void MeshKernel::ErasePoint (PointIndex ulIndex, FacetIndex ulFacetIndex, bool bOnlySetInvalid)
 {
+    Expand();
     std::vector<MeshFacet>::iterator pFIter, pFEnd, pFNot;
 
     pFIter = _aclFacetArray.begin();
@@ -626,6 +690,7 @@ void MeshKernel::ErasePoint (PointIndex ulIndex, FacetIndex ulFacetIndex, bool b
 
 void MeshKernel::RemoveInvalids ()
 {
+    Expand();
     std::vector<unsigned long> aulDecrements;
     std::vector<unsigned long>::iterator pDIter;
     unsigned long ulDec;
@@ -717,6 +782,7 @@ void MeshKernel::RemoveInvalids ()
 void MeshKernel::CutFacets(const MeshFacetGrid& rclGrid, const Base::ViewProjMethod* pclProj,
                            const Base::Polygon2d& rclPoly, bool bCutInner, std::vector<MeshGeomFacet> &raclFacets)
 {
+    Expand();
     std::vector<FacetIndex> aulFacets;
 
     MeshAlgorithm(*this).CheckFacets(rclGrid, pclProj, rclPoly, bCutInner, aulFacets );
@@ -730,12 +796,14 @@ void MeshKernel::CutFacets(const MeshFacetGrid& rclGrid, const Base::ViewProjMet
 void MeshKernel::CutFacets(const MeshFacetGrid& rclGrid, const Base::ViewProjMethod* pclProj,
                            const Base::Polygon2d& rclPoly, bool bInner, std::vector<FacetIndex> &raclCutted)
 {
+    Expand();
     MeshAlgorithm(*this).CheckFacets(rclGrid, pclProj, rclPoly, bInner, raclCutted);
     DeleteFacets(raclCutted);
 }
 
 std::vector<PointIndex> MeshKernel::GetFacetPoints(const std::vector<FacetIndex>& facets) const
 {
+    Unpack();
     std::vector<PointIndex> points;
     for (std::vector<FacetIndex>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
         PointIndex p0, p1, p2;
@@ -752,6 +820,7 @@ std::vector<PointIndex> MeshKernel::GetFacetPoints(const std::vector<FacetIndex>
 
 std::vector<FacetIndex> MeshKernel::GetPointFacets(const std::vector<PointIndex>& points) const
 {
+    Unpack();
     _aclPointArray.ResetFlag(MeshPoint::TMP0);
     _aclFacetArray.ResetFlag(MeshFacet::TMP0);
     for (std::vector<PointIndex>::const_iterator pI = points.begin(); pI != points.end(); ++pI)
@@ -777,6 +846,7 @@ std::vector<FacetIndex> MeshKernel::GetPointFacets(const std::vector<PointIndex>
 
 std::vector<FacetIndex> MeshKernel::HasFacets (const MeshPointIterator &rclIter) const
 {
+    Unpack();
     PointIndex ulPtInd = rclIter.Position();
     std::vector<MeshFacet>::const_iterator  pFIter = _aclFacetArray.begin();
     std::vector<MeshFacet>::const_iterator  pFBegin = _aclFacetArray.begin();
@@ -798,6 +868,7 @@ std::vector<FacetIndex> MeshKernel::HasFacets (const MeshPointIterator &rclIter)
 
 MeshPointArray MeshKernel::GetPoints(const std::vector<PointIndex>& indices) const
 {
+    Unpack();
     MeshPointArray ary;
     ary.reserve(indices.size());
     for (std::vector<PointIndex>::const_iterator it = indices.begin(); it != indices.end(); ++it)
@@ -807,6 +878,7 @@ MeshPointArray MeshKernel::GetPoints(const std::vector<PointIndex>& indices) con
 
 MeshFacetArray MeshKernel::GetFacets(const std::vector<FacetIndex>& indices) const
 {
+    Unpack();
     MeshFacetArray ary;
     ary.reserve(indices.size());
     for (std::vector<FacetIndex>::const_iterator it = indices.begin(); it != indices.end(); ++it)
@@ -816,6 +888,7 @@ MeshFacetArray MeshKernel::GetFacets(const std::vector<FacetIndex>& indices) con
 
 void MeshKernel::Write (std::ostream &rclOut) const
 {
+    Unpack();
     if (!rclOut || rclOut.bad())
         return;
 
@@ -856,6 +929,7 @@ void MeshKernel::Write (std::ostream &rclOut) const
 
 void MeshKernel::Read (std::istream &rclIn)
 {
+    Expand();
     if (!rclIn || rclIn.bad())
         return;
 
@@ -863,8 +937,16 @@ void MeshKernel::Read (std::istream &rclIn)
     Base::InputStream str(rclIn);
 
     // Read the header with a "magic number" and a version
-    uint32_t magic, version, swap_magic, swap_version;
+    uint32_t magic, version;
     str >> magic >> version;
+    Read(rclIn, magic, version);
+}
+
+void MeshKernel::Read (std::istream &rclIn, uint32_t magic, uint32_t version)
+{
+    Expand();
+    Base::InputStream str(rclIn);
+    uint32_t swap_magic, swap_version;
     swap_magic = magic; Base::SwapEndian(swap_magic);
     swap_version = version; Base::SwapEndian(swap_version);
     uint32_t open_edge = 0xffffffff; // value to mark an open edge
@@ -1033,6 +1115,13 @@ void MeshKernel::operator *= (const Base::Matrix4D &rclMat)
 
 void MeshKernel::Transform (const Base::Matrix4D &rclMat)
 {
+    if (IsCompact()) {
+        _pcCompact->Transform(rclMat);
+        _clBoundBox = _pcCompact->CalcBoundBox();
+        return;
+    }
+
+    Expand();
     MeshPointArray::_TIterator  clPIter = _aclPointArray.begin(), clPEIter = _aclPointArray.end();
     Base::Matrix4D clMatrix(rclMat);
 
@@ -1046,12 +1135,18 @@ void MeshKernel::Transform (const Base::Matrix4D &rclMat)
 
 void MeshKernel::Smooth(int iterations, float stepsize)
 {
+    Expand();
     (void)stepsize;
     LaplaceSmoothing(*this).Smooth(iterations);
 }
 
 void MeshKernel::RecalcBoundBox () const
 {
+    if (IsCompact()) {
+        _clBoundBox = _pcCompact->CalcBoundBox();
+        return;
+    }
+
     _clBoundBox.SetVoid();
     for (MeshPointArray::_TConstIterator pI = _aclPointArray.begin(); pI != _aclPointArray.end(); pI++)
         _clBoundBox.Add(*pI);
@@ -1059,6 +1154,7 @@ void MeshKernel::RecalcBoundBox () const
 
 std::vector<Base::Vector3f> MeshKernel::CalcVertexNormals() const
 {
+    Unpack();
     std::vector<Base::Vector3f> normals;
 
     normals.resize(CountPoints());
@@ -1079,6 +1175,7 @@ std::vector<Base::Vector3f> MeshKernel::CalcVertexNormals() const
 
 std::vector<Base::Vector3f> MeshKernel::GetFacetNormals(const std::vector<FacetIndex>& facets) const
 {
+    Unpack();
     std::vector<Base::Vector3f> normals;
     normals.reserve(facets.size());
 
@@ -1100,6 +1197,7 @@ std::vector<Base::Vector3f> MeshKernel::GetFacetNormals(const std::vector<FacetI
 // Evaluation
 float MeshKernel::GetSurface() const
 {
+    Unpack();
     float fSurface = 0.0;
     MeshFacetIterator cIter(*this);
     for (cIter.Init(); cIter.More(); cIter.Next())
@@ -1110,6 +1208,7 @@ float MeshKernel::GetSurface() const
 
 float MeshKernel::GetSurface( const std::vector<FacetIndex>& aSegment ) const
 {
+    Unpack();
     float fSurface = 0.0;
     MeshFacetIterator cIter(*this);
 
@@ -1123,6 +1222,7 @@ float MeshKernel::GetSurface( const std::vector<FacetIndex>& aSegment ) const
 
 float MeshKernel::GetVolume() const
 {
+    Unpack();
     //MeshEvalSolid cSolid(*this);
     //if ( !cSolid.Evaluate() )
     //    return 0.0f; // no solid
@@ -1178,6 +1278,7 @@ MeshPointIterator MeshKernel::PointIterator() const
 
 void MeshKernel::GetEdges (std::vector<MeshGeomEdge>& edges) const
 {
+    Unpack();
     std::set<MeshBuilder::Edge> tmp;
 
     for (MeshFacetArray::_TConstIterator it = _aclFacetArray.begin(); it != _aclFacetArray.end(); ++it) {
@@ -1199,6 +1300,7 @@ void MeshKernel::GetEdges (std::vector<MeshGeomEdge>& edges) const
 
 unsigned long MeshKernel::CountEdges () const
 {
+    Unpack();
     unsigned long openEdges = 0, closedEdges = 0;
 
     for (MeshFacetArray::_TConstIterator it = _aclFacetArray.begin(); it != _aclFacetArray.end(); ++it) {
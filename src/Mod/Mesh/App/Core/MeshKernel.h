@@ -23,13 +23,17 @@
 #ifndef MESH_KERNEL_H
 #define MESH_KERNEL_H
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <iosfwd>
+#include <memory>
 
 #include <Base/BoundBox.h>
 #include <Base/Matrix.h>
 
 #include "Helpers.h"
+#include "Storage.h"
 
 
 namespace Base{
@@ -46,6 +50,7 @@ class MeshGeomFacet;
 class MeshFacet;
 class MeshFacetVisitor;
 class MeshPointVisitor;
+class MeshVisitState;
 class MeshFacetGrid;
 
 
@@ -81,16 +86,17 @@ public:
     //@{
     /// Returns the number of facets
     unsigned long CountFacets () const
-    { return static_cast<unsigned long>(_aclFacetArray.size()); }
+    { return IsCompact() ? _pcCompact->CountFacets() : static_cast<unsigned long>(_aclFacetArray.size()); }
     /// Returns the number of edge
     unsigned long CountEdges () const;
     // Returns the number of points
     unsigned long CountPoints () const
-    { return static_cast<unsigned long>(_aclPointArray.size()); }
+    { return IsCompact() ? _pcCompact->CountPoints() : static_cast<unsigned long>(_aclPointArray.size()); }
     /// Returns the number of required memory in bytes
     unsigned int GetMemSize () const
-    { return static_cast<unsigned int>(_aclPointArray.size() * sizeof(MeshPoint) +
-                                       _aclFacetArray.size() * sizeof(MeshFacet)); }
+    { return IsCompact() ? static_cast<unsigned int>(_pcCompact->GetMemSize())
+                         : static_cast<unsigned int>(_aclPointArray.size() * sizeof(MeshPoint) +
+                                                     _aclFacetArray.size() * sizeof(MeshFacet)); }
     /// Determines the bounding box
     const Base::BoundBox3f& GetBoundBox () const
     { return _clBoundBox; }
@@ -143,7 +149,7 @@ public:
     { return _bValid; }
 
     /** Returns the array of all data points. */
-    const MeshPointArray& GetPoints () const { return _aclPointArray; }
+    const MeshPointArray& GetPoints () const { Unpack(); return _aclPointArray; }
     /** Returns an array of points to the given indices. The indices
      * must not be out of range.
      */
@@ -152,11 +158,12 @@ public:
     /** Returns a modifier for the point array */
     MeshPointModifier ModifyPoints()
     {
+        Expand();
         return MeshPointModifier(_aclPointArray);
     }
 
     /** Returns the array of all facets */
-    const MeshFacetArray& GetFacets () const { return _aclFacetArray; }
+    const MeshFacetArray& GetFacets () const { Unpack(); return _aclFacetArray; }
     /** Returns an array of facets to the given indices. The indices
      * must not be out of range.
      */
@@ -165,6 +172,7 @@ public:
     /** Returns a modifier for the facet array */
     MeshFacetModifier ModifyFacets()
     {
+        Expand();
         return MeshFacetModifier(_aclFacetArray);
     }
 
@@ -218,11 +226,23 @@ public:
      * the facet gets marked as VISIT.
      */
     unsigned long VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet) const;
+    /**
+     * Does the same as the method above but uses \a rclVisited instead of the VISIT flag to
+     * ignore and mark facets. The flags of the mesh are not touched, so several of these
+     * traversals can run on the same mesh at the same time.
+     */
+    unsigned long VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet,
+                                        MeshVisitState &rclVisited) const;
     /**
      * Does basically the same as the method above unless the facets that share just a common point
      * are regared as neighbours.
      */
     unsigned long VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet) const;
+    /**
+     * Does the same as the method above but uses \a rclVisited instead of the VISIT flag.
+     */
+    unsigned long VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet,
+                                                   MeshVisitState &rclVisited) const;
     //@}
 
     /** @name Point visitors
@@ -245,6 +265,11 @@ public:
      * the point gets marked as VISIT.
      */
     unsigned long VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, PointIndex ulStartPoint) const;
+    /**
+     * Does the same as the method above but uses \a rclVisited instead of the VISIT flag.
+     */
+    unsigned long VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, PointIndex ulStartPoint,
+                                        MeshVisitState &rclVisited) const;
     //@}
 
     /** @name Iterators
@@ -427,7 +452,28 @@ public:
                     bool bCutInner, std::vector<FacetIndex> &raclCutted);
     //@}
 
+    /** @name Storage */
+    //@{
+    /** Moves the points and facets into the compact storage with 32-bit indices, see
+     * MeshCompactStorage. For big meshes this takes less than half of the memory.
+     * Counting, GetPoint(), GetFacet(), GetFacetPoints(), GetFacetNeighbours(), the bounding box,
+     * the iterators and Transform() work on the compact storage directly. Any other method
+     * restores the point and facet arrays first.
+     * Throws Base::ValueError if the mesh has too many points or facets.
+     */
+    void Compact ();
+    /** Restores the point and facet arrays of a compact mesh and releases the compact storage. */
+    inline void Expand ();
+    /** Checks whether the mesh is in compact storage mode. */
+    bool IsCompact () const
+    { return _bCompact.load(std::memory_order_acquire); }
+    //@}
+
 protected:
+    /** Reads the data of the uncompressed binary formats whose header with \a magic
+     * and \a version has already been read from \a rclIn.
+     */
+    void Read (std::istream &rclIn, std::uint32_t magic, std::uint32_t version);
     /** Rebuilds the neighbour indices for subset of all facets from index \a index on. */
     void RebuildNeighbours (FacetIndex);
     /** Checks if this point is associated to no other facet and deletes if so.
@@ -444,11 +490,22 @@ protected:
     inline Base::Vector3f GetNormal (const MeshFacet &rclFacet) const;
     /** Calculates the gravity point to the given facet. */
     inline Base::Vector3f GetGravityPoint (const MeshFacet &rclFacet) const;
+    /** Restores the point and facet arrays of a compact mesh for read access. The compact
+     * storage is kept until the next modification so that concurrent readers stay valid.
+     */
+    inline void Unpack () const;
 
-    MeshPointArray   _aclPointArray; /**< Holds the array of geometric points. */
-    MeshFacetArray   _aclFacetArray; /**< Holds the array of facets. */
+private:
+    void UnpackStorage () const;
+    void ReleaseStorage ();
+
+protected:
+    mutable MeshPointArray   _aclPointArray; /**< Holds the array of geometric points. */
+    mutable MeshFacetArray   _aclFacetArray; /**< Holds the array of facets. */
     mutable Base::BoundBox3f _clBoundBox;    /**< The current calculated bounding box. */
     bool            _bValid; /**< Current state of validality. */
+    std::unique_ptr<MeshCompactStorage> _pcCompact; /**< The compact storage, see Compact(). */
+    mutable std::atomic<bool> _bCompact{false}; /**< True if \a _pcCompact holds the data. */
 
     // friends
     friend class MeshPointIterator;
@@ -459,16 +516,38 @@ protected:
     friend class MeshFixDuplicatePoints;
     friend class MeshBuilder;
     friend class MeshTrimming;
+    friend class ReaderBMS;
 };
 
+inline void MeshKernel::Unpack () const
+{
+    if (IsCompact())
+        UnpackStorage();
+}
+
+inline void MeshKernel::Expand ()
+{
+    if (_pcCompact) {
+        Unpack();
+        _pcCompact.reset();
+    }
+}
+
 inline MeshPoint MeshKernel::GetPoint (PointIndex ulIndex) const
 {
+    if (IsCompact())
+        return _pcCompact->GetPoint(ulIndex);
     assert(ulIndex < _aclPointArray.size());
     return _aclPointArray[ulIndex];
 }
 
 inline MeshGeomFacet MeshKernel::GetFacet (FacetIndex ulIndex) const
 {
+    if (IsCompact()) {
+        MeshGeomFacet clFacet = _pcCompact->GetFacet(ulIndex);
+        clFacet.CalcNormal();
+        return clFacet;
+    }
     assert(ulIndex < _aclFacetArray.size());
 
     const MeshFacet *pclF = &_aclFacetArray[ulIndex];
@@ -485,11 +564,21 @@ inline MeshGeomFacet MeshKernel::GetFacet (FacetIndex ulIndex) const
 
 inline MeshGeomFacet MeshKernel::GetFacet (const MeshFacet &rclFacet) const
 {
+    MeshGeomFacet  clFacet;
+    if (IsCompact()) {
+        clFacet._aclPoints[0] = _pcCompact->GetPoint(rclFacet._aulPoints[0]);
+        clFacet._aclPoints[1] = _pcCompact->GetPoint(rclFacet._aulPoints[1]);
+        clFacet._aclPoints[2] = _pcCompact->GetPoint(rclFacet._aulPoints[2]);
+        clFacet._ulProp       = rclFacet._ulProp;
+        clFacet._ucFlag       = rclFacet._ucFlag;
+        clFacet.CalcNormal();
+        return  clFacet;
+    }
+
     assert(rclFacet._aulPoints[0] < _aclPointArray.size());
     assert(rclFacet._aulPoints[1] < _aclPointArray.size());
     assert(rclFacet._aulPoints[2] < _aclPointArray.size());
 
-    MeshGeomFacet  clFacet;
     clFacet._aclPoints[0] = _aclPointArray[rclFacet._aulPoints[0]];
     clFacet._aclPoints[1] = _aclPointArray[rclFacet._aulPoints[1]];
     clFacet._aclPoints[2] = _aclPointArray[rclFacet._aulPoints[2]];
@@ -502,6 +591,10 @@ inline MeshGeomFacet MeshKernel::GetFacet (const MeshFacet &rclFacet) const
 inline void MeshKernel::GetFacetNeighbours (FacetIndex ulIndex, FacetIndex &rulNIdx0,
                                             FacetIndex &rulNIdx1, FacetIndex &rulNIdx2) const
 {
+    if (IsCompact()) {
+        _pcCompact->GetFacetNeighbours(ulIndex, rulNIdx0, rulNIdx1, rulNIdx2);
+        return;
+    }
     assert(ulIndex < _aclFacetArray.size());
 
     rulNIdx0 = _aclFacetArray[ulIndex]._aulNeighbours[0];
@@ -511,21 +604,25 @@ inline void MeshKernel::GetFacetNeighbours (FacetIndex ulIndex, FacetIndex &rulN
 
 inline void MeshKernel::MovePoint (PointIndex ulPtIndex, const Base::Vector3f &rclTrans)
 {
+    Expand();
     _aclPointArray[ulPtIndex] += rclTrans;
 }
 
 inline void MeshKernel::SetPoint (PointIndex ulPtIndex, const Base::Vector3f &rPoint)
 {
+    Expand();
     _aclPointArray[ulPtIndex] = rPoint;
 }
 
 inline void MeshKernel::SetPoint (PointIndex ulPtIndex, float x, float y, float z)
 {
+    Expand();
     _aclPointArray[ulPtIndex].Set(x,y,z);
 }
 
 inline void MeshKernel::AdjustNormal (MeshFacet &rclFacet, const Base::Vector3f &rclNormal)
 {
+    Expand();
     Base::Vector3f clN = (_aclPointArray[rclFacet._aulPoints[1]] - _aclPointArray[rclFacet._aulPoints[0]]) %
                          (_aclPointArray[rclFacet._aulPoints[2]] - _aclPointArray[rclFacet._aulPoints[0]]);
     if ((clN * rclNormal) < 0.0f) {
@@ -535,6 +632,7 @@ inline void MeshKernel::AdjustNormal (MeshFacet &rclFacet, const Base::Vector3f
 
 inline Base::Vector3f MeshKernel::GetNormal (const MeshFacet &rclFacet) const
 {
+    Unpack();
     Base::Vector3f clN = (_aclPointArray[rclFacet._aulPoints[1]] - _aclPointArray[rclFacet._aulPoints[0]]) %
                          (_aclPointArray[rclFacet._aulPoints[2]] - _aclPointArray[rclFacet._aulPoints[0]]);
     clN.Normalize();
@@ -543,6 +641,7 @@ inline Base::Vector3f MeshKernel::GetNormal (const MeshFacet &rclFacet) const
 
 inline Base::Vector3f MeshKernel::GetGravityPoint (const MeshFacet &rclFacet) const
 {
+    Unpack();
     const Base::Vector3f& p0 = _aclPointArray[rclFacet._aulPoints[0]];
     const Base::Vector3f& p1 = _aclPointArray[rclFacet._aulPoints[1]];
     const Base::Vector3f& p2 = _aclPointArray[rclFacet._aulPoints[2]];
@@ -554,6 +653,10 @@ inline Base::Vector3f MeshKernel::GetGravityPoint (const MeshFacet &rclFacet) co
 inline void MeshKernel::GetFacetPoints (FacetIndex ulFaIndex, PointIndex &rclP0,
                                         PointIndex &rclP1, PointIndex &rclP2) const
 {
+    if (IsCompact()) {
+        _pcCompact->GetFacetPoints(ulFaIndex, rclP0, rclP1, rclP2);
+        return;
+    }
     assert(ulFaIndex < _aclFacetArray.size());
     const MeshFacet& rclFacet = _aclFacetArray[ulFaIndex];
     rclP0 = rclFacet._aulPoints[0];
@@ -564,6 +667,7 @@ inline void MeshKernel::GetFacetPoints (FacetIndex ulFaIndex, PointIndex &rclP0,
 inline void MeshKernel::SetFacetPoints (FacetIndex ulFaIndex, PointIndex rclP0,
                                         PointIndex rclP1, PointIndex rclP2)
 {
+    Expand();
     assert(ulFaIndex < _aclFacetArray.size());
     MeshFacet& rclFacet = _aclFacetArray[ulFaIndex];
     rclFacet._aulPoints[0] = rclP0;
@@ -28,9 +28,22 @@
 #include "Segmentation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 
 using namespace MeshCore;
 
+namespace {
+
+// The non-linear cylinder and sphere fits are repeated only after the number of
+// points has grown by a tenth since the last successful fit. As long as no fit
+// succeeded it's tried again with every new point.
+bool needsRefit(std::size_t points, std::size_t fittedPoints)
+{
+    return fittedPoints == 0 || points - fittedPoints > fittedPoints / 10;
+}
+
+}
+
 void MeshSurfaceSegment::Initialize(FacetIndex)
 {
 }
@@ -196,6 +209,7 @@ std::vector<float> PlaneSurfaceFit::Parameters() const
 
 CylinderSurfaceFit::CylinderSurfaceFit()
     : fitter(new CylinderFit)
+    , fittedPoints(0)
 {
     axis.Set(0,0,0);
     radius = FLOAT_MAX;
@@ -210,6 +224,7 @@ CylinderSurfaceFit::CylinderSurfaceFit(const Base::Vector3f& b, const Base::Vect
     , axis(a)
     , radius(r)
     , fitter(nullptr)
+    , fittedPoints(0)
 {
 }
 
@@ -221,6 +236,7 @@ CylinderSurfaceFit::~CylinderSurfaceFit()
 void CylinderSurfaceFit::Initialize(const MeshCore::MeshGeomFacet& tria)
 {
     if (fitter) {
+        fittedPoints = 0;
         fitter->Clear();
         fitter->AddPoint(tria._aclPoints[0]);
         fitter->AddPoint(tria._aclPoints[1]);
@@ -248,7 +264,7 @@ bool CylinderSurfaceFit::TestTriangle(const MeshGeomFacet& tria) const
 bool CylinderSurfaceFit::Done() const
 {
     if (fitter) {
-        return fitter->Done();
+        return fitter->Done() || !needsRefit(fitter->CountPoints(), fittedPoints);
     }
 
     return true;
@@ -261,6 +277,7 @@ float CylinderSurfaceFit::Fit()
 
     float fit = fitter->Fit();
     if (fit < FLOAT_MAX) {
+        fittedPoints = fitter->CountPoints();
         basepoint = fitter->GetBase();
         axis = fitter->GetAxis();
         radius = fitter->GetRadius();
@@ -270,7 +287,7 @@ float CylinderSurfaceFit::Fit()
 
 float CylinderSurfaceFit::GetDistanceToSurface(const Base::Vector3f& pnt) const
 {
-    if (fitter && !fitter->Done()) {
+    if (fitter && fittedPoints == 0) {
         // collect some points
         return 0;
     }
@@ -304,6 +321,7 @@ std::vector<float> CylinderSurfaceFit::Parameters() const
 
 SphereSurfaceFit::SphereSurfaceFit()
     : fitter(new SphereFit)
+    , fittedPoints(0)
 {
     center.Set(0,0,0);
     radius = FLOAT_MAX;
@@ -313,6 +331,7 @@ SphereSurfaceFit::SphereSurfaceFit(const Base::Vector3f& c, float r)
     : center(c)
     , radius(r)
     , fitter(nullptr)
+    , fittedPoints(0)
 {
 
 }
@@ -325,6 +344,7 @@ SphereSurfaceFit::~SphereSurfaceFit()
 void SphereSurfaceFit::Initialize(const MeshCore::MeshGeomFacet& tria)
 {
     if (fitter) {
+        fittedPoints = 0;
         fitter->Clear();
         fitter->AddPoint(tria._aclPoints[0]);
         fitter->AddPoint(tria._aclPoints[1]);
@@ -350,7 +370,7 @@ bool SphereSurfaceFit::TestTriangle(const MeshGeomFacet&) const
 bool SphereSurfaceFit::Done() const
 {
     if (fitter) {
-        return fitter->Done();
+        return fitter->Done() || !needsRefit(fitter->CountPoints(), fittedPoints);
     }
 
     return true;
@@ -363,6 +383,7 @@ float SphereSurfaceFit::Fit()
 
     float fit = fitter->Fit();
     if (fit < FLOAT_MAX) {
+        fittedPoints = fitter->CountPoints();
         center = fitter->GetCenter();
         radius = fitter->GetRadius();
     }
@@ -536,59 +557,240 @@ bool MeshSurfaceVisitor::Visit (const MeshFacet & face, const MeshFacet &,
 
 // --------------------------------------------------------
 
-void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
+namespace {
+
+// Minimum number of facets a thread tests per block
+constexpr std::size_t SegmentBlockSize = 8192;
+
+/*
+ * Disjoint sets of facets. A set is always represented by its smallest facet.
+ */
+class FacetSets
 {
-    // reset VISIT flags
-    FacetIndex startFacet;
-    MeshCore::MeshAlgorithm cAlgo(myKernel);
-    cAlgo.ResetFacetFlag(MeshCore::MeshFacet::VISIT);
+public:
+    explicit FacetSets(std::size_t count) : parent(count) {}
+    void MakeSet(FacetIndex index)
+    {
+        parent[index] = index;
+    }
+    FacetIndex Find(FacetIndex index)
+    {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    }
+    void Unite(FacetIndex index1, FacetIndex index2)
+    {
+        index1 = Find(index1);
+        index2 = Find(index2);
+        if (index1 < index2)
+            parent[index2] = index1;
+        else if (index2 < index1)
+            parent[index1] = index2;
+    }
 
-    const MeshCore::MeshFacetArray& rFAry = myKernel.GetFacets();
-    MeshCore::MeshFacetArray::_TConstIterator iCur = rFAry.begin();
-    MeshCore::MeshFacetArray::_TConstIterator iBeg = rFAry.begin();
-    MeshCore::MeshFacetArray::_TConstIterator iEnd = rFAry.end();
+private:
+    std::vector<FacetIndex> parent;
+};
+
+/*
+ * Grows the regions of a segment whose test depends on the facets added so far. The
+ * neighbours are visited ring by ring and only facets not visited yet are tested.
+ */
+std::size_t growRegions(const MeshKernel& kernel, MeshSurfaceSegment& segm,
+                        MeshVisitState& visited, std::vector<FacetIndex>& resetVisited)
+{
+    const MeshFacetArray& facets = kernel.GetFacets();
+    std::size_t countRegions = 0;
+    std::vector<FacetIndex> currentLevel, nextLevel;
 
     // start from the first not visited facet
-    cAlgo.CountFacetFlag(MeshCore::MeshFacet::VISIT);
-    std::vector<FacetIndex> resetVisited;
+    FacetIndex startFacet = visited.FindNotVisited();
+    while (startFacet != FACET_INDEX_MAX) {
+        // collect all facets of the same geometry
+        std::vector<FacetIndex> indices;
+        segm.Initialize(startFacet);
+        if (segm.TestInitialFacet(startFacet))
+            indices.push_back(startFacet);
+
+        visited.SetVisited(startFacet);
+        currentLevel.assign(1, startFacet);
+        while (!currentLevel.empty()) {
+            for (auto index : currentLevel) {
+                for (auto neighbour : facets[index]._aulNeighbours) {
+                    if (neighbour >= facets.size() || visited.IsVisited(neighbour))
+                        continue;
+                    if (!segm.TestFacet(facets[neighbour]))
+                        continue;
+                    visited.SetVisited(neighbour);
+                    nextLevel.push_back(neighbour);
+                    indices.push_back(neighbour);
+                    segm.AddFacet(facets[neighbour]);
+                }
+            }
+            currentLevel.swap(nextLevel);
+            nextLevel.clear();
+        }
 
-    for (std::vector<MeshSurfaceSegmentPtr>::iterator it = segm.begin(); it != segm.end(); ++it) {
-        cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
-        resetVisited.clear();
+        // add or discard the segment
+        if (indices.size() <= 1) {
+            resetVisited.push_back(startFacet);
+        }
+        else {
+            segm.AddSegment(indices);
+            countRegions++;
+        }
+
+        // search for the next start facet
+        startFacet = visited.FindNotVisited(startFacet);
+    }
+
+    return countRegions;
+}
+
+/*
+ * Finds the regions of a stateless segment. The facets are tested in parallel and
+ * adjacent facets that pass the test are joined per block of facets. The sets are then
+ * merged over the block borders and handed out in the same order as growRegions()
+ * would do, i.e. a start facet that fails the test joins the sets around it.
+ */
+std::size_t joinRegions(const MeshKernel& kernel, MeshSurfaceSegment& segm,
+                        MeshVisitState& visited, std::vector<FacetIndex>& resetVisited)
+{
+    const MeshFacetArray& facets = kernel.GetFacets();
+    std::size_t count = facets.size();
 
-        MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
-        iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
-            return flag(f, MeshFacet::VISIT);
-        });
-        if (iCur < iEnd)
-            startFacet = iCur - iBeg;
-        else
-            startFacet = FACET_INDEX_MAX;
-        while (startFacet != FACET_INDEX_MAX) {
-            // collect all facets of the same geometry
-            std::vector<FacetIndex> indices;
-            (*it)->Initialize(startFacet);
-            if ((*it)->TestInitialFacet(startFacet))
-                indices.push_back(startFacet);
-            MeshSurfaceVisitor pv(**it, indices);
-            myKernel.VisitNeighbourFacets(pv, startFacet);
-
-            // add or discard the segment
-            if (indices.size() <= 1) {
-                resetVisited.push_back(startFacet);
+    std::vector<char> accepted(count);
+    parallel_blocks(count, SegmentBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            accepted[index] = !visited.IsVisited(index) && segm.TestFacet(facets[index]);
+        }
+    });
+
+    // a thread only modifies the sets of its own facets, edges to other blocks are merged afterwards
+    FacetSets sets(count);
+    std::vector<std::vector<std::pair<FacetIndex, FacetIndex>>> borderEdges(parallel_block_count(count, SegmentBlockSize));
+    parallel_blocks(count, SegmentBlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            sets.MakeSet(index);
+        }
+        for (std::size_t index = begin; index < end; index++) {
+            if (!accepted[index])
+                continue;
+            for (auto neighbour : facets[index]._aulNeighbours) {
+                if (neighbour <= index || neighbour >= count || !accepted[neighbour])
+                    continue;
+                if (neighbour < end)
+                    sets.Unite(index, neighbour);
+                else
+                    borderEdges[block].emplace_back(index, neighbour);
+            }
+        }
+    });
+
+    for (const auto& edges : borderEdges) {
+        for (const auto& edge : edges) {
+            sets.Unite(edge.first, edge.second);
+        }
+    }
+
+    // the facets of each set in ascending order
+    std::vector<FacetIndex> roots(count, FACET_INDEX_MAX);
+    std::vector<std::size_t> offsets(count + 1, 0);
+    for (std::size_t index = 0; index < count; index++) {
+        if (accepted[index]) {
+            roots[index] = sets.Find(index);
+            offsets[roots[index] + 1]++;
+        }
+    }
+    for (std::size_t index = 0; index < count; index++) {
+        offsets[index + 1] += offsets[index];
+    }
+    std::vector<FacetIndex> members(offsets[count]);
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t index = 0; index < count; index++) {
+        if (accepted[index])
+            members[fill[roots[index]]++] = index;
+    }
+
+    std::size_t countRegions = 0;
+    FacetIndex startFacet = visited.FindNotVisited();
+    while (startFacet != FACET_INDEX_MAX) {
+        std::vector<FacetIndex> indices;
+        segm.Initialize(startFacet);
+        if (segm.TestInitialFacet(startFacet))
+            indices.push_back(startFacet);
+        visited.SetVisited(startFacet);
+
+        // sets are always taken as a whole, so a set is free as long as its root isn't visited
+        auto addSet = [&](FacetIndex root) {
+            for (std::size_t pos = offsets[root]; pos < offsets[root + 1]; pos++) {
+                FacetIndex index = members[pos];
+                if (!visited.IsVisited(index)) {
+                    visited.SetVisited(index);
+                    indices.push_back(index);
+                    segm.AddFacet(facets[index]);
+                }
             }
-            else {
-                (*it)->AddSegment(indices);
+        };
+
+        if (accepted[startFacet]) {
+            addSet(roots[startFacet]);
+        }
+        else {
+            for (auto neighbour : facets[startFacet]._aulNeighbours) {
+                if (neighbour < count && accepted[neighbour] && !visited.IsVisited(neighbour))
+                    addSet(roots[neighbour]);
             }
+        }
+
+        // add or discard the segment
+        if (indices.size() <= 1) {
+            resetVisited.push_back(startFacet);
+        }
+        else {
+            segm.AddSegment(indices);
+            countRegions++;
+        }
+
+        // search for the next start facet
+        startFacet = visited.FindNotVisited(startFacet);
+    }
+
+    return countRegions;
+}
+
+}
+
+void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
+{
+    // the visited facets are tracked outside of the mesh so that its flags stay untouched
+    MeshVisitState visited(myKernel.CountFacets());
+    std::vector<FacetIndex> resetVisited;
+    statistics.clear();
+
+    for (std::vector<MeshSurfaceSegmentPtr>::iterator it = segm.begin(); it != segm.end(); ++it) {
+        for (auto index : resetVisited)
+            visited.ResetVisited(index);
+        resetVisited.clear();
 
-            // search for the next start facet
-            iCur = std::find_if(iCur, iEnd, [flag](const MeshFacet& f) {
-                return flag(f, MeshFacet::VISIT);
-            });
-            if (iCur < iEnd)
-                startFacet = iCur - iBeg;
-            else
-                startFacet = FACET_INDEX_MAX;
+        std::size_t countBefore = (*it)->GetSegments().size();
+        std::size_t countRegions = (*it)->IsStateless()
+            ? joinRegions(myKernel, **it, visited, resetVisited)
+            : growRegions(myKernel, **it, visited, resetVisited);
+
+        MeshSegmentStatistics stat;
+        const std::vector<MeshSegment>& segments = (*it)->GetSegments();
+        stat.countSegments = segments.size() - countBefore;
+        stat.countRejected = countRegions - stat.countSegments;
+        for (std::size_t i = countBefore; i < segments.size(); i++) {
+            stat.countFacets += segments[i].size();
+            stat.maxFacets = std::max(stat.maxFacets, segments[i].size());
+            for (auto index : segments[i])
+                stat.area += myKernel.GetFacet(index).Area();
         }
+        statistics.push_back(stat);
     }
 }
@@ -50,6 +50,11 @@ public:
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
+    /** Returns true if TestFacet() only depends on the tested facet and neither on the
+     * start facet nor on the facets added so far. The facets of such segments are tested
+     * and joined in parallel.
+     */
+    virtual bool IsStateless() const { return false; }
     void AddSegment(const std::vector<FacetIndex>&);
     const std::vector<MeshSegment>& GetSegments() const { return segments; }
     MeshSegment FindSegment(FacetIndex) const;
@@ -145,6 +150,7 @@ private:
     Base::Vector3f axis;
     float radius;
     CylinderFit* fitter;
+    std::size_t fittedPoints;
 };
 
 class MeshExport SphereSurfaceFit : public AbstractSurfaceFit
@@ -166,6 +172,7 @@ private:
     Base::Vector3f center;
     float radius;
     SphereFit* fitter;
+    std::size_t fittedPoints;
 };
 
 class MeshExport MeshDistanceGenericSurfaceFitSegment : public MeshDistanceSurfaceSegment
@@ -192,6 +199,7 @@ class MeshExport MeshCurvatureSurfaceSegment : public MeshSurfaceSegment
 public:
     MeshCurvatureSurfaceSegment(const std::vector<CurvatureInfo>& ci, unsigned long minFacets)
         : MeshSurfaceSegment(minFacets), info(ci) {}
+    bool IsStateless() const override { return true; }
 
 protected:
     const std::vector<CurvatureInfo>& info;
@@ -268,14 +276,30 @@ protected:
     MeshSurfaceSegment& segm;
 };
 
+/** Statistics of the segments found for one surface type. */
+struct MeshExport MeshSegmentStatistics
+{
+    std::size_t countSegments = 0;  /**< Number of found segments. */
+    std::size_t countFacets = 0;    /**< Number of facets of the found segments. */
+    std::size_t countRejected = 0;  /**< Number of regions with less than the minimum number of facets. */
+    std::size_t maxFacets = 0;      /**< Number of facets of the largest segment. */
+    double area = 0.0;              /**< Area of the found segments. */
+};
+
 class MeshExport MeshSegmentAlgorithm
 {
 public:
     explicit MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel) {}
+    /** Grows the segments of the given surface types in this order. A facet is
+     * assigned to at most one segment.
+     */
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
+    /** Returns the statistics of the last FindSegments() call, one entry per surface type. */
+    const std::vector<MeshSegmentStatistics>& GetStatistics() const { return statistics; }
 
 private:
     const MeshKernel& myKernel;
+    std::vector<MeshSegmentStatistics> statistics;
 };
 
 } // MeshCore
@@ -32,6 +32,7 @@
 
 #include "SetOperations.h"
 #include "Algorithm.h"
+#include "BVH.h"
 #include "Builder.h"
 #include "Definitions.h"
 #include "Elements.h"
@@ -189,10 +190,9 @@ void SetOperations::Cut (std::set<FacetIndex>& facetsCuttingEdge0, std::set<Face
 
           if (!vecFacets2.empty())
           {
-            std::set<FacetIndex> vecFacets1;
-            grid1.GetElements(gx1, gy1, gz1, vecFacets1);
+            MeshFacetGrid::Cell vecFacets1 = grid1.GetCell(gx1, gy1, gz1);
 
-            std::set<FacetIndex>::iterator it1;
+            const FacetIndex* it1;
             for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
             {
               FacetIndex fidx1 = *it1;
@@ -631,108 +631,27 @@ bool MeshIntersection::hasIntersection() const
 
 void MeshIntersection::getIntersection(std::list<MeshIntersection::Tuple>& intsct) const
 {
-    const MeshKernel& k1 = kernel1;
-    const MeshKernel& k2 = kernel2;
-
-    // Contains bounding boxes for every facet of 'k1'
-    std::vector<Base::BoundBox3f> boxes1;
-    MeshFacetIterator cMFI1(k1);
-    for (cMFI1.Begin(); cMFI1.More(); cMFI1.Next()) {
-        boxes1.push_back((*cMFI1).GetBoundBox());
-    }
-
-    // Contains bounding boxes for every facet of 'k2'
-    std::vector<Base::BoundBox3f> boxes2;
-    MeshFacetIterator cMFI2(k2);
-    for (cMFI2.Begin(); cMFI2.More(); cMFI2.Next()) {
-        boxes2.push_back((*cMFI2).GetBoundBox());
-    }
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(k1);
-
-    const MeshFacetArray& rFaces2 = k2.GetFacets();
-    Base::SequencerLauncher seq("Checking for intersections...", rFaces2.size());
-    int index = 0;
-    MeshGeomFacet facet1, facet2;
-    Base::Vector3f pt1, pt2;
-
-    // Iterate over the facets of the 2nd mesh and find the grid elements of the 1st mesh
-    for (MeshFacetArray::_TConstIterator it = rFaces2.begin(); it != rFaces2.end(); ++it, index++) {
-        seq.next();
-        std::vector<FacetIndex> elements;
-        cMeshFacetGrid.Inside(boxes2[index], elements, true);
-
-        cMFI2.Set(index);
-        facet2 = *cMFI2;
-
-        for (std::vector<FacetIndex>::iterator jt = elements.begin(); jt != elements.end(); ++jt) {
-            if (boxes2[index] && boxes1[*jt]) {
-                cMFI1.Set(*jt);
-                facet1 = *cMFI1;
-                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                if (ret == 2) {
-                    Tuple d;
-                    d.p1 = pt1;
-                    d.p2 = pt2;
-                    d.f1 = *jt;
-                    d.f2 = index;
-                    intsct.push_back(d);
-                }
-            }
-        }
+    MeshFacetBVH bvh1(kernel1);
+    MeshFacetBVH bvh2(kernel2);
+    std::vector<MeshFacetBVH::Intersection> sections;
+    bvh1.GetIntersections(bvh2, sections);
+
+    for (const auto& it : sections) {
+        Tuple d;
+        d.p1 = it.p1;
+        d.p2 = it.p2;
+        d.f1 = it.f1;
+        d.f2 = it.f2;
+        intsct.push_back(d);
     }
 }
 
 bool MeshIntersection::testIntersection(const MeshKernel& k1,
                                         const MeshKernel& k2)
 {
-    // Contains bounding boxes for every facet of 'k1'
-    std::vector<Base::BoundBox3f> boxes1;
-    MeshFacetIterator cMFI1(k1);
-    for (cMFI1.Begin(); cMFI1.More(); cMFI1.Next()) {
-        boxes1.push_back((*cMFI1).GetBoundBox());
-    }
-
-    // Contains bounding boxes for every facet of 'k2'
-    std::vector<Base::BoundBox3f> boxes2;
-    MeshFacetIterator cMFI2(k2);
-    for (cMFI2.Begin(); cMFI2.More(); cMFI2.Next()) {
-        boxes2.push_back((*cMFI2).GetBoundBox());
-    }
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(k1);
-
-    const MeshFacetArray& rFaces2 = k2.GetFacets();
-    Base::SequencerLauncher seq("Checking for intersections...", rFaces2.size());
-    int index = 0;
-    MeshGeomFacet facet1, facet2;
-    Base::Vector3f pt1, pt2;
-
-    // Iterate over the facets of the 2nd mesh and find the grid elements of the 1st mesh
-    for (MeshFacetArray::_TConstIterator it = rFaces2.begin(); it != rFaces2.end(); ++it, index++) {
-        seq.next();
-        std::vector<FacetIndex> elements;
-        cMeshFacetGrid.Inside(boxes2[index], elements, true);
-
-        cMFI2.Set(index);
-        facet2 = *cMFI2;
-
-        for (std::vector<FacetIndex>::iterator jt = elements.begin(); jt != elements.end(); ++jt) {
-            if (boxes2[index] && boxes1[*jt]) {
-                cMFI1.Set(*jt);
-                facet1 = *cMFI1;
-                int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                if (ret == 2) {
-                    // abort after the first detected self-intersection
-                    return true;
-                }
-            }
-        }
-    }
-
-    return false;
+    MeshFacetBVH bvh1(k1);
+    MeshFacetBVH bvh2(k2);
+    return bvh1.HasIntersection(bvh2);
 }
 
 void MeshIntersection::connectLines(bool onlyclosed, const std::list<MeshIntersection::Tuple>& rdata,
@@ -9,7 +9,11 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Allow to lock vertices, to limit the error of a collapse and keep the index map of compact_mesh()
+// * Allow to report progress and to stop the iterations early
 
+#include <functional>
+#include <limits>
 #include <vector>
 
 
@@ -84,11 +88,18 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;};
     struct Ref { int tid,tvertex; };
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
     std::vector<Ref> refs;
+    // edges whose collapse has a higher quadric error are kept
+    double max_error = std::numeric_limits<double>::max();
+    // the new index of each vertex after compact_mesh() or -1 if it has been removed
+    std::vector<int> vertex_map;
+    // called at the start of each of the max_iterations iterations, returning true stops the simplification
+    std::function<bool()> canceled;
+    static const int max_iterations = 100;
 
     void simplify_mesh(int target_count, double tolerance, double aggressiveness=7);
 
@@ -131,8 +142,11 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
     std::vector<int> deleted0,deleted1;
     int triangle_count=triangles.size();
 
-    for (int iteration=0;iteration<100;++iteration)
+    for (int iteration=0;iteration<max_iterations;++iteration)
     {
+        if (canceled && canceled())
+            break;
+
         // target number of triangles reached ? Then break
         //printf("iteration %d - triangles %d\n",iteration,triangle_count-deleted_triangles);
         if (triangle_count-deleted_triangles<=target_count)
@@ -198,9 +212,14 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     if (v0.border != v1.border)
                         continue;
 
+                    // Locked vertices must keep their position
+                    if (v0.locked || v1.locked)
+                        continue;
+
                     // Compute vertex to collapse to
                     vec3f p;
-                    calculate_error(i0,i1,p);
+                    if (calculate_error(i0,i1,p) > max_error)
+                        continue;
 
                     deleted0.resize(v0.tcount); // normals temporarily
                     deleted1.resize(v1.tcount); // normals temporarily
@@ -474,10 +493,12 @@ void Simplify::compact_mesh()
 
     triangles.resize(dst);
     dst=0;
+    vertex_map.assign(vertices.size(), -1);
     for (std::size_t i=0;i<vertices.size();++i)
     {
         if (vertices[i].tcount)
         {
+            vertex_map[i]=dst;
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
             dst++;
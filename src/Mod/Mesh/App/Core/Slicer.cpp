@@ -0,0 +1,361 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <cstdint>
+#endif
+
+#include "Slicer.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+const std::size_t BlockSize = 4096;
+
+/// An intersection point of a layer is identified by the mesh edge it lies on.
+using EdgeKey = std::uint64_t;
+
+EdgeKey edgeKey(PointIndex p, PointIndex q)
+{
+    if (p > q)
+        std::swap(p, q);
+    return (static_cast<EdgeKey>(p) << 32) | static_cast<EdgeKey>(q);
+}
+
+/// A segment of a layer. It runs from the edge where the facet crosses the plane downwards
+/// to the edge where it crosses upwards.
+struct Segment
+{
+    EdgeKey from, to;
+    Base::Vector3f p1, p2;
+};
+
+/// Maps the start edges of the segments of a layer to the segments. It's a table with
+/// open addressing because the layers are too small to amortize node allocations.
+class EdgeTable
+{
+public:
+    static constexpr std::size_t NoValue = ~std::size_t(0);
+
+    void Reset(std::size_t count)
+    {
+        std::size_t size = 16;
+        while (size < 2 * count)
+            size *= 2;
+        _mask = size - 1;
+        _keys.assign(size, Empty);
+        _values.resize(size);
+    }
+
+    /// Keeps the first value of a key.
+    void Insert(EdgeKey key, std::size_t value)
+    {
+        std::size_t i = Slot(key);
+        for (; _keys[i] != Empty; i = (i + 1) & _mask) {
+            if (_keys[i] == key)
+                return;
+        }
+        _keys[i] = key;
+        _values[i] = value;
+    }
+
+    std::size_t Find(EdgeKey key) const
+    {
+        for (std::size_t i = Slot(key); _keys[i] != Empty; i = (i + 1) & _mask) {
+            if (_keys[i] == key)
+                return _values[i];
+        }
+        return NoValue;
+    }
+
+private:
+    std::size_t Slot(EdgeKey key) const
+    {
+        return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ULL) >> 32) & _mask;
+    }
+
+    static constexpr EdgeKey Empty = ~EdgeKey(0);
+    std::vector<EdgeKey> _keys;
+    std::vector<std::size_t> _values;
+    std::size_t _mask = 0;
+};
+
+/// The extent of a facet along the normal.
+struct Extent
+{
+    float min, max;
+    FacetIndex index;
+};
+
+/// The polylines of one layer.
+struct Layer
+{
+    std::vector<Base::Vector3f> points;
+    std::vector<std::size_t> sizes;
+};
+
+class LayerCutter
+{
+public:
+    LayerCutter(const MeshKernel& kernel, const std::vector<float>& heights)
+      : _points(kernel.GetPoints())
+      , _facets(kernel.GetFacets())
+      , _heights(heights)
+    {
+    }
+
+    void Cut(const std::vector<Extent>& facets, float dist, Layer& layer)
+    {
+        _segments.clear();
+        for (const auto& it : facets)
+            CutFacet(_facets[it.index], dist);
+        Chain(layer);
+    }
+
+private:
+    /// A point is regarded as above the plane if its height is not less than the distance
+    /// of the plane. So each cut facet has exactly one edge crossing the plane upwards and
+    /// one crossing it downwards, also if a point lies in the plane.
+    void CutFacet(const MeshFacet& facet, float dist)
+    {
+        Segment segment;
+        int found = 0;
+        for (int i = 0; i < 3; i++) {
+            PointIndex p = facet._aulPoints[i];
+            PointIndex q = facet._aulPoints[(i + 1) % 3];
+            bool above1 = _heights[p] >= dist;
+            bool above2 = _heights[q] >= dist;
+            if (above1 == above2)
+                continue;
+            if (above2) {
+                segment.to = edgeKey(p, q);
+                segment.p2 = CutEdge(p, q, dist);
+            }
+            else {
+                segment.from = edgeKey(p, q);
+                segment.p1 = CutEdge(p, q, dist);
+            }
+            found++;
+        }
+        if (found == 2)
+            _segments.push_back(segment);
+    }
+
+    /// The point is computed in the same order for both facets of an edge, so both
+    /// get exactly the same point.
+    Base::Vector3f CutEdge(PointIndex p, PointIndex q, float dist) const
+    {
+        if (p > q)
+            std::swap(p, q);
+        float t = (dist - _heights[p]) / (_heights[q] - _heights[p]);
+        return _points[p] + (_points[q] - _points[p]) * t;
+    }
+
+    void Chain(Layer& layer)
+    {
+        std::size_t count = _segments.size();
+        _start.Reset(count);
+        for (std::size_t i = 0; i < count; i++)
+            _start.Insert(_segments[i].from, i);
+
+        // open polylines begin with a segment without predecessor
+        _visited.assign(count, false);
+        _successor.assign(count, false);
+        for (const auto& it : _segments) {
+            std::size_t next = _start.Find(it.to);
+            if (next != EdgeTable::NoValue)
+                _successor[next] = true;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            if (!_successor[i])
+                Follow(i, layer);
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            if (!_visited[i])
+                Follow(i, layer);
+        }
+    }
+
+    void Follow(std::size_t index, Layer& layer)
+    {
+        std::size_t first = layer.points.size();
+        layer.points.push_back(_segments[index].p1);
+        for (;;) {
+            _visited[index] = true;
+            const Segment& segment = _segments[index];
+            // segments through a point lying in the plane have zero length
+            if (segment.p2 != layer.points.back())
+                layer.points.push_back(segment.p2);
+            std::size_t next = _start.Find(segment.to);
+            if (next == EdgeTable::NoValue || _visited[next])
+                break;
+            index = next;
+        }
+
+        std::size_t size = layer.points.size() - first;
+        if (size < 2)
+            layer.points.resize(first);
+        else
+            layer.sizes.push_back(size);
+    }
+
+private:
+    const MeshPointArray& _points;
+    const MeshFacetArray& _facets;
+    const std::vector<float>& _heights;
+    std::vector<Segment> _segments;
+    EdgeTable _start;
+    std::vector<bool> _visited;
+    std::vector<bool> _successor;
+};
+
+}
+
+// ----------------------------------------------------------------------------
+
+MeshSlicer::MeshSlicer(const MeshKernel& rclMesh)
+  : _rclMesh(rclMesh)
+{
+}
+
+void MeshSlicer::Slice(const Base::Vector3f& rclNormal, float first, float step,
+                       std::size_t count, Layers& rclLayers) const
+{
+    std::vector<float> distances(count);
+    for (std::size_t i = 0; i < count; i++)
+        distances[i] = first + step * static_cast<float>(i);
+    Slice(rclNormal, distances, rclLayers);
+}
+
+void MeshSlicer::Slice(const Base::Vector3f& rclNormal, const std::vector<float>& distances,
+                       Layers& rclLayers) const
+{
+    rclLayers.points.clear();
+    rclLayers.polylines.assign(1, 0);
+    rclLayers.layers.assign(distances.size() + 1, 0);
+
+    Base::Vector3f normal(rclNormal);
+    normal.Normalize();
+    std::size_t countLayers = distances.size();
+    if (countLayers == 0 || _rclMesh.CountFacets() == 0 || normal.Length() == 0.0f)
+        return;
+
+    // the layers sorted by their distance
+    std::vector<std::pair<float, std::size_t> > order(countLayers);
+    for (std::size_t i = 0; i < countLayers; i++)
+        order[i] = std::make_pair(distances[i], i);
+    std::sort(order.begin(), order.end());
+    std::vector<float> sorted(countLayers);
+    for (std::size_t i = 0; i < countLayers; i++)
+        sorted[i] = order[i].first;
+
+    // the heights of the points along the normal
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<float> heights(rPoints.size());
+    parallel_blocks(rPoints.size(), BlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            heights[i] = rPoints[i] * normal;
+    });
+
+    // the extents of the facets along the normal, sorted by their lower end
+    std::size_t countFacets = rFacets.size();
+    std::vector<Extent> extents(countFacets);
+    std::vector<float> maxSize(parallel_block_count(countFacets, BlockSize), 0.0f);
+    parallel_blocks(countFacets, BlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& rFace = rFacets[i];
+            float h0 = heights[rFace._aulPoints[0]];
+            float h1 = heights[rFace._aulPoints[1]];
+            float h2 = heights[rFace._aulPoints[2]];
+            Extent& extent = extents[i];
+            extent.min = std::min(h0, std::min(h1, h2));
+            extent.max = std::max(h0, std::max(h1, h2));
+            extent.index = i;
+            maxSize[block] = std::max(maxSize[block], extent.max - extent.min);
+        }
+    });
+    float maxExtent = *std::max_element(maxSize.begin(), maxSize.end());
+    int threads = std::max(1, QThread::idealThreadCount());
+    MeshCore::parallel_sort(extents.begin(), extents.end(), [](const Extent& a, const Extent& b) {
+        return a.min < b.min || (a.min == b.min && a.index < b.index);
+    }, threads);
+
+    // Sweep chunks of consecutive layers in parallel. A facet is cut by a layer if the
+    // distance d of the layer is in (min, max] of its extent. The facets cut by the first
+    // layer of a chunk start at most the largest extent below it, with some margin for
+    // the rounding errors of the extents.
+    std::size_t chunkSize = std::max<std::size_t>(1, countLayers / (8 * static_cast<std::size_t>(threads)));
+    std::size_t countChunks = (countLayers + chunkSize - 1) / chunkSize;
+    std::vector<Layer> result(countLayers);
+    std::atomic<std::size_t> pending(0);
+    parallel_blocks(countChunks, 1, [&](std::size_t, std::size_t, std::size_t) {
+        LayerCutter cutter(_rclMesh, heights);
+        std::vector<Extent> active;
+        for (std::size_t chunk = pending++; chunk < countChunks; chunk = pending++) {
+            std::size_t first = chunk * chunkSize;
+            std::size_t last = std::min(first + chunkSize, countLayers);
+            auto next = std::lower_bound(extents.begin(), extents.end(), sorted[first] - 1.01f * maxExtent,
+                                         [](const Extent& e, float value) {
+                return e.min < value;
+            });
+            active.clear();
+            for (std::size_t j = first; j < last; j++) {
+                float dist = sorted[j];
+                for (; next != extents.end() && next->min < dist; ++next) {
+                    if (next->max >= dist)
+                        active.push_back(*next);
+                }
+                // the layers ascend, so a facet below this layer is below all others
+                active.erase(std::remove_if(active.begin(), active.end(), [dist](const Extent& e) {
+                    return e.max < dist;
+                }), active.end());
+                cutter.Cut(active, dist, result[order[j].second]);
+            }
+        }
+    });
+
+    // concatenate the layers in their original order
+    std::size_t countPoints = 0;
+    std::size_t countPolylines = 0;
+    for (const auto& it : result) {
+        countPoints += it.points.size();
+        countPolylines += it.sizes.size();
+    }
+    rclLayers.points.reserve(countPoints);
+    rclLayers.polylines.reserve(countPolylines + 1);
+    for (std::size_t j = 0; j < countLayers; j++) {
+        Layer& layer = result[j];
+        rclLayers.points.insert(rclLayers.points.end(), layer.points.begin(), layer.points.end());
+        for (std::size_t size : layer.sizes)
+            rclLayers.polylines.push_back(rclLayers.polylines.back() + size);
+        rclLayers.layers[j + 1] = rclLayers.polylines.size() - 1;
+        layer = Layer();
+    }
+}
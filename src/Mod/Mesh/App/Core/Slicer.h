@@ -0,0 +1,86 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_SLICER_H
+#define MESH_SLICER_H
+
+#include <vector>
+
+#include "Elements.h"
+
+
+namespace MeshCore {
+
+class MeshKernel;
+
+/**
+ * The MeshSlicer class cuts a mesh with a stack of parallel planes, e.g. to compute
+ * the layers for additive manufacturing.
+ *
+ * The facets are sorted once by their extent along the normal and the layers are swept
+ * in ascending order with a list of the facets cut by the current layer, so a layer only
+ * visits the facets it actually cuts. Chunks of consecutive layers are swept in parallel.
+ * Unlike MeshAlgorithm::CutWithPlane the segments are chained by the mesh edges they
+ * start and end on, so no tolerance is needed. The polylines of a closed, consistently
+ * oriented mesh are closed and the outer ones run counter-clockwise around the normal.
+ */
+class MeshExport MeshSlicer
+{
+public:
+    /**
+     * The polylines of all layers in flat arrays. The points of polyline \a i are
+     * the range [polylines[i], polylines[i+1]) of \a points and the polylines of layer
+     * \a j are the range [layers[j], layers[j+1]) of the polylines. A closed polyline
+     * repeats its first point at the end.
+     */
+    struct Layers
+    {
+        std::vector<Base::Vector3f> points;
+        std::vector<std::size_t> polylines;
+        std::vector<std::size_t> layers;
+
+        std::size_t CountLayers() const
+        { return layers.empty() ? 0 : layers.size() - 1; }
+        std::size_t CountPolylines() const
+        { return polylines.empty() ? 0 : polylines.size() - 1; }
+    };
+
+    explicit MeshSlicer(const MeshKernel& rclMesh);
+
+    /** Cuts the mesh with the planes of normal \a rclNormal and the signed distances
+     * \a distances to the origin. The layers are returned in the order of \a distances.
+     */
+    void Slice(const Base::Vector3f& rclNormal, const std::vector<float>& distances,
+               Layers& rclLayers) const;
+    /** Cuts the mesh with \a count planes of normal \a rclNormal. The first plane has the
+     * signed distance \a first to the origin and each other is \a step further.
+     */
+    void Slice(const Base::Vector3f& rclNormal, float first, float step, std::size_t count,
+               Layers& rclLayers) const;
+
+private:
+    const MeshKernel& _rclMesh;
+};
+
+} // namespace MeshCore
+
+#endif // MESH_SLICER_H
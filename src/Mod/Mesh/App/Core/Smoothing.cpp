@@ -21,18 +21,102 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+#endif
 
 #include <Base/Tools.h>
 
 #include "Smoothing.h"
 #include "Algorithm.h"
 #include "Approximation.h"
-#include "Iterator.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 
 
 using namespace MeshCore;
 
+namespace {
+
+// Minimum number of points or facets a thread handles per smoothing step
+constexpr std::size_t SmoothingBlockSize = 4096;
+
+/*
+ * The point coordinates in separate arrays. A smoothing step reads the positions
+ * of one buffer and writes the new positions into a second one (Jacobi iteration),
+ * so the result depends neither on the order of the points nor on the number of
+ * threads.
+ */
+struct PointBuffer
+{
+    explicit PointBuffer(const MeshPointArray& points)
+      : x(points.size()), y(points.size()), z(points.size())
+    {
+        for (std::size_t i = 0; i < points.size(); i++) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+            z[i] = points[i].z;
+        }
+    }
+    Base::Vector3f operator[] (PointIndex index) const
+    {
+        return Base::Vector3f(x[index], y[index], z[index]);
+    }
+    void Set(PointIndex index, const Base::Vector3f& pnt)
+    {
+        x[index] = pnt.x;
+        y[index] = pnt.y;
+        z[index] = pnt.z;
+    }
+
+    std::vector<float> x, y, z;
+};
+
+/*
+ * The neighbours of the points a smoothing step moves in compressed row form.
+ */
+struct PointRows
+{
+    void Add(PointIndex point, const MeshIndexRange& range)
+    {
+        points.push_back(point);
+        neighbours.insert(neighbours.end(), range.begin(), range.end());
+        offsets.push_back(neighbours.size());
+    }
+
+    std::vector<PointIndex> points;
+    std::vector<std::size_t> offsets{0};
+    std::vector<PointIndex> neighbours;
+};
+
+std::vector<PointIndex> allPoints(const MeshKernel& kernel)
+{
+    std::vector<PointIndex> points(kernel.CountPoints());
+    std::generate(points.begin(), points.end(), Base::iotaGen<PointIndex>(0));
+    return points;
+}
+
+// Valid, sorted indices without duplicates so that every point is written by one thread only
+std::vector<PointIndex> uniquePoints(const MeshKernel& kernel, const std::vector<PointIndex>& point_indices)
+{
+    std::vector<PointIndex> points;
+    points.reserve(point_indices.size());
+    PointIndex count = kernel.CountPoints();
+    std::copy_if(point_indices.begin(), point_indices.end(), std::back_inserter(points),
+                 [count](PointIndex index) { return index < count; });
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    return points;
+}
+
+void assignPoints(MeshKernel& kernel, const PointBuffer& buffer, const std::vector<PointIndex>& points)
+{
+    for (auto pos : points) {
+        kernel.SetPoint(pos, buffer[pos]);
+    }
+}
+
+}
 
 AbstractSmoothing::AbstractSmoothing(MeshKernel& m)
   : kernel(m)
@@ -63,109 +147,64 @@ PlaneFitSmoothing::~PlaneFitSmoothing()
 
 void PlaneFitSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
-            center.Scale(scale,scale,scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0f)
-                N.Scale(-1.0, -1.0, -1.0);
-
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->maximum),fabs(N*L));
-            N.Scale(d,d,d);
-
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
-
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
     MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+
+    PointRows rows;
+    for (auto pos : uniquePoints(kernel, point_indices)) {
+        MeshIndexRange cv = vv_it[pos];
+        if (cv.size() >= 3)
+            rows.Add(pos, cv);
+    }
+
+    PointBuffer source(kernel.GetPoints());
+    PointBuffer target(source);
+    float max = std::fabs(this->maximum);
 
     for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (std::vector<PointIndex>::const_iterator it = point_indices.begin(); it != point_indices.end(); ++it) {
-            v_it.Set(*it);
+        parallel_blocks(rows.points.size(), SmoothingBlockSize,
+                        [&](std::size_t, std::size_t begin, std::size_t end) {
             MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+            for (std::size_t j = begin; j < end; j++) {
+                PointIndex pos = rows.points[j];
+                Base::Vector3f pnt = source[pos];
+                Base::Vector3f center = pnt;
+                pf.Clear();
+                pf.AddPoint(pnt);
+                for (std::size_t k = rows.offsets[j]; k < rows.offsets[j+1]; k++) {
+                    Base::Vector3f neighbour = source[rows.neighbours[k]];
+                    pf.AddPoint(neighbour);
+                    center += neighbour;
+                }
 
-            float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
-            center.Scale(scale,scale,scale);
+                float scale = 1.0f/(static_cast<float>(rows.offsets[j+1] - rows.offsets[j])+1.0f);
+                center.Scale(scale,scale,scale);
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+                // get the mean plane of the current vertex with the surrounding vertices
+                pf.Fit();
+                Base::Vector3f N = pf.GetNormal();
+                N.Normalize();
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0f)
-                N.Scale(-1.0, -1.0, -1.0);
+                // look in which direction we should move the vertex
+                Base::Vector3f L = pnt - center;
+                if (N*L < 0.0f)
+                    N.Scale(-1.0, -1.0, -1.0);
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->maximum),fabs(N*L));
-            N.Scale(d,d,d);
+                // maximum value to move is distance to mean plane
+                float d = std::min<float>(max,fabs(N*L));
+                N.Scale(d,d,d);
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
-
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+                target.Set(pos, pnt - N);
+            }
+        });
+        std::swap(source, target);
     }
+
+    assignPoints(kernel, source, rows.points);
 }
 
 LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
@@ -177,95 +216,69 @@ LaplaceSmoothing::~LaplaceSmoothing()
 {
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize)
+void LaplaceSmoothing::Umbrella(unsigned int iterations, const std::vector<double>& stepsizes,
+                                const std::vector<PointIndex>& point_indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
+    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshRefPointToFacets vf_it(kernel);
 
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
+    PointRows rows;
+    for (auto pos : uniquePoints(kernel, point_indices)) {
+        MeshIndexRange cv = vv_it[pos];
         if (cv.size() < 3)
             continue;
         if (cv.size() != vf_it[pos].size()) {
             // do nothing for border points
             continue;
         }
-
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-v_it->x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-v_it->y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-v_it->z);
-        }
-
-        float x = static_cast<float>(static_cast<double>(v_it->x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z)+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
+        rows.Add(pos, cv);
     }
-}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize,
-                                const std::vector<PointIndex>& point_indices)
-{
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
+    PointBuffer source(kernel.GetPoints());
+    PointBuffer target(source);
 
-    for (std::vector<PointIndex>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<PointIndex>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-(v_beg[*pos]).z);
+    for (unsigned int i=0; i<iterations; i++) {
+        for (double stepsize : stepsizes) {
+            parallel_blocks(rows.points.size(), SmoothingBlockSize,
+                            [&](std::size_t, std::size_t begin, std::size_t end) {
+                const float* sx = source.x.data();
+                const float* sy = source.y.data();
+                const float* sz = source.z.data();
+                for (std::size_t j = begin; j < end; j++) {
+                    PointIndex pos = rows.points[j];
+                    std::size_t first = rows.offsets[j];
+                    std::size_t last = rows.offsets[j+1];
+                    float px = sx[pos], py = sy[pos], pz = sz[pos];
+
+                    double delx=0.0,dely=0.0,delz=0.0;
+                    for (std::size_t k = first; k < last; k++) {
+                        PointIndex n = rows.neighbours[k];
+                        delx += static_cast<double>(sx[n]-px);
+                        dely += static_cast<double>(sy[n]-py);
+                        delz += static_cast<double>(sz[n]-pz);
+                    }
+
+                    double w = stepsize/double(last - first);
+                    target.x[pos] = static_cast<float>(static_cast<double>(px)+w*delx);
+                    target.y[pos] = static_cast<float>(static_cast<double>(py)+w*dely);
+                    target.z[pos] = static_cast<float>(static_cast<double>(pz)+w*delz);
+                }
+            });
+            std::swap(source, target);
         }
-
-        float x = static_cast<float>(static_cast<double>((v_beg[*pos]).x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[*pos]).y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[*pos]).z)+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
     }
+
+    assignPoints(kernel, source, rows.points);
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-    }
+    Umbrella(iterations, {lambda}, allPoints(kernel));
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-    }
+    Umbrella(iterations, {lambda}, point_indices);
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -279,28 +292,14 @@ TaubinSmoothing::~TaubinSmoothing()
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    // Theoretically Taubin does not shrink the surface
-    iterations = (iterations+1)/2; // two steps per iteration
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
-    }
+    SmoothPoints(iterations, allPoints(kernel));
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
-    for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
-    }
+    Umbrella(iterations, {lambda, -(lambda+micro)}, point_indices);
 }
 
 namespace {
@@ -337,93 +336,111 @@ MedianFilterSmoothing::~MedianFilterSmoothing()
 
 void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
-    std::vector<unsigned long> point_indices(kernel.CountPoints());
-    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i=0; i<iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
-    }
+    UpdatePoints(iterations, allPoints(kernel));
 }
 
 void MedianFilterSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i=0; i<iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
-    }
+    UpdatePoints(iterations, point_indices);
 }
 
-void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
-                                         const MeshRefPointToFacets& vf_it,
+void MedianFilterSmoothing::UpdatePoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    MeshCore::MeshRefFacetToFacets ff_it(kernel);
+    MeshCore::MeshRefPointToFacets vf_it(kernel);
     const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
 
-    // Initialize the array with the real normals
-    std::vector<Base::Vector3d> faceNormals;
-    faceNormals.reserve(facets.size());
-    MeshCore::MeshFacetIterator iter(kernel);
-    for (iter.Init(); iter.More(); iter.Next()) {
-        faceNormals.emplace_back(Base::toVector<double>(iter->GetNormal()));
-    }
-
-    // Step 1: determine face normals
-    for (FacetIndex pos = 0; pos < facets.size(); pos++) {
-        iter.Set(pos);
-        Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
-        const MeshCore::MeshFacet& facet = facets[pos];
-
-        std::vector<AngleNormal> anglesWithFaces;
-        for (auto fi : cv) {
-            iter.Set(fi);
-            Base::Vector3d faceNormal = Base::toVector<double>(iter->GetNormal());
-            double angle = refNormal.GetAngle(faceNormal);
-
-            int absWeight = std::abs(weights);
-            if (absWeight > 1 && facet.IsNeighbour(fi)) {
-                if (weights < 0) {
-                    angle = -angle;
-                }
-                for (int i = 0; i < absWeight; i++) {
-                    anglesWithFaces.emplace_back(angle, faceNormal);
-                }
-            }
-            else {
-                anglesWithFaces.emplace_back(angle, faceNormal);
-            }
-        }
-
-        faceNormals[pos] = find_median(anglesWithFaces);
+    // points without facets keep their position
+    PointRows rows;
+    for (auto pos : uniquePoints(kernel, point_indices)) {
+        MeshIndexRange cv = vf_it[pos];
+        if (!cv.empty())
+            rows.Add(pos, cv);
     }
 
-    // Step 2: move vertices
-    for (auto pos : point_indices) {
-        Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
+    PointBuffer source(kernel.GetPoints());
+    PointBuffer target(source);
 
-        double totalArea = 0.0;
-        Base::Vector3d totalvT;
-        for (auto it : cv) {
-            iter.Set(it);
+    std::vector<Base::Vector3d> realNormals(facets.size());
+    std::vector<Base::Vector3d> faceNormals(facets.size());
+    std::vector<Base::Vector3d> gravityPoints(facets.size());
+    std::vector<double> faceAreas(facets.size());
 
-            double faceArea = iter->Area();
-            totalArea += faceArea;
-
-            Base::Vector3d C = Base::toVector<double>(iter->GetGravityPoint());
+    for (unsigned int i=0; i<iterations; i++) {
+        // Initialize the arrays with the real normals, centers and areas
+        parallel_blocks(facets.size(), SmoothingBlockSize,
+                        [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (FacetIndex pos = begin; pos < end; pos++) {
+                const MeshCore::MeshFacet& facet = facets[pos];
+                MeshCore::MeshGeomFacet triangle(source[facet._aulPoints[0]],
+                                                 source[facet._aulPoints[1]],
+                                                 source[facet._aulPoints[2]]);
+                realNormals[pos] = Base::toVector<double>(triangle.GetNormal());
+                gravityPoints[pos] = Base::toVector<double>(triangle.GetGravityPoint());
+                faceAreas[pos] = triangle.Area();
+            }
+        });
+
+        // Step 1: determine face normals
+        parallel_blocks(facets.size(), SmoothingBlockSize,
+                        [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::vector<AngleNormal> anglesWithFaces;
+            for (FacetIndex pos = begin; pos < end; pos++) {
+                const Base::Vector3d& refNormal = realNormals[pos];
+                MeshIndexRange cv = ff_it[pos];
+                const MeshCore::MeshFacet& facet = facets[pos];
+
+                anglesWithFaces.clear();
+                for (auto fi : cv) {
+                    const Base::Vector3d& faceNormal = realNormals[fi];
+                    double angle = refNormal.GetAngle(faceNormal);
+
+                    int absWeight = std::abs(weights);
+                    if (absWeight > 1 && facet.IsNeighbour(fi)) {
+                        if (weights < 0) {
+                            angle = -angle;
+                        }
+                        for (int k = 0; k < absWeight; k++) {
+                            anglesWithFaces.emplace_back(angle, faceNormal);
+                        }
+                    }
+                    else {
+                        anglesWithFaces.emplace_back(angle, faceNormal);
+                    }
+                }
 
-            Base::Vector3d PC = C - P;
-            Base::Vector3d mT = faceNormals[it];
-            Base::Vector3d vT = (PC * mT) * mT;
-            totalvT += vT * faceArea;
-        }
+                faceNormals[pos] = anglesWithFaces.empty() ? refNormal : find_median(anglesWithFaces);
+            }
+        });
+
+        // Step 2: move vertices
+        parallel_blocks(rows.points.size(), SmoothingBlockSize,
+                        [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t j = begin; j < end; j++) {
+                PointIndex pos = rows.points[j];
+                Base::Vector3d P = Base::toVector<double>(source[pos]);
+
+                double totalArea = 0.0;
+                Base::Vector3d totalvT;
+                for (std::size_t k = rows.offsets[j]; k < rows.offsets[j+1]; k++) {
+                    FacetIndex it = rows.neighbours[k];
+                    double faceArea = faceAreas[it];
+                    totalArea += faceArea;
+
+                    Base::Vector3d PC = gravityPoints[it] - P;
+                    const Base::Vector3d& mT = faceNormals[it];
+                    Base::Vector3d vT = (PC * mT) * mT;
+                    totalvT += vT * faceArea;
+                }
 
-        P = P + totalvT / totalArea;
-        kernel.SetPoint(pos, Base::toVector<float>(P));
+                if (totalArea > 0.0)
+                    P = P + totalvT / totalArea;
+                target.Set(pos, Base::toVector<float>(P));
+            }
+        });
+        std::swap(source, target);
     }
+
+    assignPoints(kernel, source, rows.points);
 }
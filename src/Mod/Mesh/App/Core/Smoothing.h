@@ -35,7 +35,11 @@ class MeshRefPointToPoints;
 class MeshRefPointToFacets;
 class MeshRefFacetToFacets;
 
-/** Base class for smoothing algorithms. */
+/** Base class for smoothing algorithms.
+ * The algorithms compute the new positions of all points from the positions of the
+ * previous step (Jacobi iteration) in parallel, so the result doesn't depend on the
+ * number of threads. SmoothPoints() moves only the given points, all others are fixed.
+ */
 class MeshExport AbstractSmoothing
 {
 public:
@@ -91,10 +95,10 @@ public:
     void SetLambda(double l) { lambda = l;}
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double,
+    /** Applies the umbrella operator with each of the step sizes in turn, \a iterations times.
+     * All points are moved simultaneously, border points keep their position.
+     */
+    void Umbrella(unsigned int iterations, const std::vector<double>& stepsizes,
                   const std::vector<PointIndex>&);
 
 protected:
@@ -131,9 +135,7 @@ public:
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
 private:
-    void UpdatePoints(const MeshRefFacetToFacets&,
-                      const MeshRefPointToFacets&,
-                      const std::vector<PointIndex>&);
+    void UpdatePoints(unsigned int iterations, const std::vector<PointIndex>&);
 
 private:
     int weights;
@@ -0,0 +1,166 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Matrix.h>
+
+#include "Storage.h"
+
+
+using namespace MeshCore;
+
+bool MeshCompactStorage::CanStore(const MeshPointArray& rPoints, const MeshFacetArray& rFacets)
+{
+    // INDEX_MAX is reserved to mark missing neighbours
+    return rPoints.size() < INDEX_MAX && rFacets.size() < INDEX_MAX;
+}
+
+void MeshCompactStorage::Assign(const MeshPointArray& rPoints, const MeshFacetArray& rFacets)
+{
+    if (!CanStore(rPoints, rFacets))
+        throw Base::ValueError("Mesh is too big for 32-bit indices");
+
+    Clear();
+
+    std::size_t ulCtPoints = rPoints.size();
+    _afX.resize(ulCtPoints);
+    _afY.resize(ulCtPoints);
+    _afZ.resize(ulCtPoints);
+    bool bFlags = false, bProps = false;
+    for (std::size_t i = 0; i < ulCtPoints; i++) {
+        const MeshPoint& rPt = rPoints[i];
+        _afX[i] = rPt.x;
+        _afY[i] = rPt.y;
+        _afZ[i] = rPt.z;
+        bFlags = bFlags || rPt._ucFlag != 0;
+        bProps = bProps || rPt._ulProp != 0;
+    }
+
+    if (bFlags) {
+        _aucPointFlags.resize(ulCtPoints);
+        for (std::size_t i = 0; i < ulCtPoints; i++)
+            _aucPointFlags[i] = rPoints[i]._ucFlag;
+    }
+    if (bProps) {
+        _aulPointProps.resize(ulCtPoints);
+        for (std::size_t i = 0; i < ulCtPoints; i++)
+            _aulPointProps[i] = rPoints[i]._ulProp;
+    }
+
+    std::size_t ulCtFacets = rFacets.size();
+    _aulPoints.resize(3 * ulCtFacets);
+    _aulNeighbours.resize(3 * ulCtFacets);
+    bFlags = false;
+    bProps = false;
+    for (std::size_t i = 0; i < ulCtFacets; i++) {
+        const MeshFacet& rFace = rFacets[i];
+        for (int j = 0; j < 3; j++) {
+            _aulPoints[3 * i + j] = ToIndex(rFace._aulPoints[j]);
+            _aulNeighbours[3 * i + j] = ToIndex(rFace._aulNeighbours[j]);
+        }
+        bFlags = bFlags || rFace._ucFlag != 0;
+        bProps = bProps || rFace._ulProp != 0;
+    }
+
+    if (bFlags) {
+        _aucFacetFlags.resize(ulCtFacets);
+        for (std::size_t i = 0; i < ulCtFacets; i++)
+            _aucFacetFlags[i] = rFacets[i]._ucFlag;
+    }
+    if (bProps) {
+        _aulFacetProps.resize(ulCtFacets);
+        for (std::size_t i = 0; i < ulCtFacets; i++)
+            _aulFacetProps[i] = rFacets[i]._ulProp;
+    }
+}
+
+void MeshCompactStorage::Restore(MeshPointArray& rPoints, MeshFacetArray& rFacets) const
+{
+    std::size_t ulCtPoints = _afX.size();
+    rPoints.clear();
+    rPoints.resize(ulCtPoints);
+    for (std::size_t i = 0; i < ulCtPoints; i++)
+        rPoints[i] = GetPoint(i);
+
+    std::size_t ulCtFacets = CountFacets();
+    rFacets.clear();
+    rFacets.resize(ulCtFacets);
+    for (std::size_t i = 0; i < ulCtFacets; i++)
+        rFacets[i] = GetFacetIndices(i);
+}
+
+void MeshCompactStorage::Clear()
+{
+    // release the memory, too
+    std::vector<float>().swap(_afX);
+    std::vector<float>().swap(_afY);
+    std::vector<float>().swap(_afZ);
+    std::vector<Index>().swap(_aulPoints);
+    std::vector<Index>().swap(_aulNeighbours);
+    std::vector<unsigned char>().swap(_aucPointFlags);
+    std::vector<unsigned char>().swap(_aucFacetFlags);
+    std::vector<unsigned long>().swap(_aulPointProps);
+    std::vector<unsigned long>().swap(_aulFacetProps);
+}
+
+std::size_t MeshCompactStorage::GetMemSize() const
+{
+    return 3 * _afX.size() * sizeof(float) +
+           (_aulPoints.size() + _aulNeighbours.size()) * sizeof(Index) +
+           (_aucPointFlags.size() + _aucFacetFlags.size()) * sizeof(unsigned char) +
+           (_aulPointProps.size() + _aulFacetProps.size()) * sizeof(unsigned long);
+}
+
+Base::BoundBox3f MeshCompactStorage::CalcBoundBox() const
+{
+    Base::BoundBox3f clBoundBox;
+    if (_afX.empty())
+        return clBoundBox;
+
+    auto x = std::minmax_element(_afX.begin(), _afX.end());
+    auto y = std::minmax_element(_afY.begin(), _afY.end());
+    auto z = std::minmax_element(_afZ.begin(), _afZ.end());
+    return Base::BoundBox3f(*x.first, *y.first, *z.first, *x.second, *y.second, *z.second);
+}
+
+void MeshCompactStorage::Transform(const Base::Matrix4D& rclMat)
+{
+    double m[16];
+    rclMat.getMatrix(m);
+
+    // the coordinate arrays are processed component-wise so that the loop can be vectorized
+    std::size_t ulCtPoints = _afX.size();
+    float* x = _afX.data();
+    float* y = _afY.data();
+    float* z = _afZ.data();
+    for (std::size_t i = 0; i < ulCtPoints; i++) {
+        double sx = x[i], sy = y[i], sz = z[i];
+        x[i] = static_cast<float>(m[0] * sx + m[1] * sy + m[2] * sz + m[3]);
+        y[i] = static_cast<float>(m[4] * sx + m[5] * sy + m[6] * sz + m[7]);
+        z[i] = static_cast<float>(m[8] * sx + m[9] * sy + m[10] * sz + m[11]);
+    }
+}
@@ -0,0 +1,166 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_STORAGE_H
+#define MESH_STORAGE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Elements.h"
+
+
+namespace Base {
+class Matrix4D;
+}
+
+namespace MeshCore {
+
+/**
+ * The MeshCompactStorage class keeps the points and facets of a mesh kernel in a
+ * structure-of-arrays layout: one array per coordinate, and 32-bit arrays for the corner
+ * points and the neighbours of the facets. Flags and properties are only allocated if
+ * a non-zero value is stored. Compared to the MeshPoint and MeshFacet records this takes
+ * less than half of the memory and allows tight loops over single components.
+ *
+ * It's the compact storage mode of MeshKernel, see MeshKernel::Compact().
+ * \note Only meshes with less than 2^32-1 points and facets can be stored, see CanStore().
+ */
+class MeshExport MeshCompactStorage
+{
+public:
+    using Index = std::uint32_t;
+    /// Marks a missing neighbour, the counterpart to FACET_INDEX_MAX.
+    static const Index INDEX_MAX = UINT32_MAX;
+
+    /** @name Conversion */
+    //@{
+    /// Checks whether the points and facets can be addressed with 32-bit indices.
+    static bool CanStore(const MeshPointArray& rPoints, const MeshFacetArray& rFacets);
+    /// Copies the points and facets. Throws Base::ValueError if CanStore() fails.
+    void Assign(const MeshPointArray& rPoints, const MeshFacetArray& rFacets);
+    /// Replaces the content of the arrays with the stored points and facets.
+    void Restore(MeshPointArray& rPoints, MeshFacetArray& rFacets) const;
+    /// Removes all data.
+    void Clear();
+    //@}
+
+    /** @name Querying */
+    //@{
+    unsigned long CountPoints() const
+    { return static_cast<unsigned long>(_afX.size()); }
+    unsigned long CountFacets() const
+    { return static_cast<unsigned long>(_aulPoints.size() / 3); }
+    /// Returns the number of required memory in bytes.
+    std::size_t GetMemSize() const;
+    Base::BoundBox3f CalcBoundBox() const;
+    inline MeshPoint GetPoint(PointIndex ulIndex) const;
+    inline MeshFacet GetFacetIndices(FacetIndex ulIndex) const;
+    inline MeshGeomFacet GetFacet(FacetIndex ulIndex) const;
+    inline void GetFacetPoints(FacetIndex ulIndex, PointIndex& rclP0, PointIndex& rclP1, PointIndex& rclP2) const;
+    inline void GetFacetNeighbours(FacetIndex ulIndex, FacetIndex& rclN0, FacetIndex& rclN1, FacetIndex& rclN2) const;
+    bool IsPointFlag(PointIndex ulIndex, MeshPoint::TFlagType tF) const
+    { return !_aucPointFlags.empty() && (_aucPointFlags[ulIndex] & tF) == tF; }
+    bool IsFacetFlag(FacetIndex ulIndex, MeshFacet::TFlagType tF) const
+    { return !_aucFacetFlags.empty() && (_aucFacetFlags[ulIndex] & tF) == tF; }
+    unsigned long GetFacetProperty(FacetIndex ulIndex) const
+    { return _aulFacetProps.empty() ? 0 : _aulFacetProps[ulIndex]; }
+    //@}
+
+    /** @name Modification */
+    //@{
+    void Transform(const Base::Matrix4D& rclMat);
+    //@}
+
+private:
+    static Index ToIndex(ElementIndex ulIndex)
+    { return ulIndex == ELEMENT_INDEX_MAX ? INDEX_MAX : static_cast<Index>(ulIndex); }
+    static ElementIndex FromIndex(Index ulIndex)
+    { return ulIndex == INDEX_MAX ? ELEMENT_INDEX_MAX : static_cast<ElementIndex>(ulIndex); }
+
+private:
+    std::vector<float> _afX, _afY, _afZ;
+    std::vector<Index> _aulPoints;
+    std::vector<Index> _aulNeighbours;
+    std::vector<unsigned char> _aucPointFlags; /**< Empty if no point has a flag set. */
+    std::vector<unsigned char> _aucFacetFlags; /**< Empty if no facet has a flag set. */
+    std::vector<unsigned long> _aulPointProps; /**< Empty if no point has a property. */
+    std::vector<unsigned long> _aulFacetProps; /**< Empty if no facet has a property. */
+};
+
+inline MeshPoint MeshCompactStorage::GetPoint(PointIndex ulIndex) const
+{
+    MeshPoint clPoint(_afX[ulIndex], _afY[ulIndex], _afZ[ulIndex]);
+    if (!_aucPointFlags.empty())
+        clPoint._ucFlag = _aucPointFlags[ulIndex];
+    if (!_aulPointProps.empty())
+        clPoint._ulProp = _aulPointProps[ulIndex];
+    return clPoint;
+}
+
+inline MeshFacet MeshCompactStorage::GetFacetIndices(FacetIndex ulIndex) const
+{
+    const Index* p = &_aulPoints[3 * ulIndex];
+    const Index* n = &_aulNeighbours[3 * ulIndex];
+    MeshFacet clFacet(p[0], p[1], p[2], FromIndex(n[0]), FromIndex(n[1]), FromIndex(n[2]));
+    if (!_aucFacetFlags.empty())
+        clFacet._ucFlag = _aucFacetFlags[ulIndex];
+    if (!_aulFacetProps.empty())
+        clFacet._ulProp = _aulFacetProps[ulIndex];
+    return clFacet;
+}
+
+inline MeshGeomFacet MeshCompactStorage::GetFacet(FacetIndex ulIndex) const
+{
+    const Index* p = &_aulPoints[3 * ulIndex];
+    MeshGeomFacet clFacet;
+    for (int i = 0; i < 3; i++)
+        clFacet._aclPoints[i].Set(_afX[p[i]], _afY[p[i]], _afZ[p[i]]);
+    if (!_aucFacetFlags.empty())
+        clFacet._ucFlag = _aucFacetFlags[ulIndex];
+    if (!_aulFacetProps.empty())
+        clFacet._ulProp = _aulFacetProps[ulIndex];
+    return clFacet;
+}
+
+inline void MeshCompactStorage::GetFacetPoints(FacetIndex ulIndex, PointIndex& rclP0,
+                                               PointIndex& rclP1, PointIndex& rclP2) const
+{
+    const Index* p = &_aulPoints[3 * ulIndex];
+    rclP0 = p[0];
+    rclP1 = p[1];
+    rclP2 = p[2];
+}
+
+inline void MeshCompactStorage::GetFacetNeighbours(FacetIndex ulIndex, FacetIndex& rclN0,
+                                                   FacetIndex& rclN1, FacetIndex& rclN2) const
+{
+    const Index* n = &_aulNeighbours[3 * ulIndex];
+    rclN0 = FromIndex(n[0]);
+    rclN1 = FromIndex(n[1]);
+    rclN2 = FromIndex(n[2]);
+}
+
+} // namespace MeshCore
+
+
+#endif // MESH_STORAGE_H
@@ -0,0 +1,1119 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cctype>
+# include <cmath>
+# include <cstdint>
+# include <cstdio>
+# include <cstring>
+# include <exception>
+# include <istream>
+# include <ostream>
+# include <sstream>
+# include <string>
+# include <unordered_map>
+# include <unordered_set>
+# include <utility>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Sequencer.h>
+#include <Base/Swap.h>
+
+#include "Streaming.h"
+#include "Builder.h"
+#include "Decimation.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+#include "IO/TextParser.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+/// The minimum number of facets a thread processes.
+const std::size_t StreamBlockSize = 65536;
+/// The facets of a chunk are simplified in parts of this size.
+const std::size_t DecimationPartSize = 262144;
+/// The number of bytes read at once from a stream.
+const std::size_t ReadBlockSize = 4 * 1024 * 1024;
+
+inline std::size_t hashKey(std::uint64_t x, std::uint64_t y, std::uint64_t z)
+{
+    std::uint64_t h = (x * 73856093ULL) ^ (y * 19349663ULL) ^ (z * 83492791ULL);
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 32;
+    return static_cast<std::size_t>(h);
+}
+
+/// Hashes and compares points by their exact coordinates.
+struct PointKey
+{
+    static std::uint32_t bits(float value)
+    {
+        // +0 and -0 are the same coordinate
+        value += 0.0f;
+        std::uint32_t result;
+        std::memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+    std::size_t operator()(const Base::Vector3f& p) const
+    {
+        return hashKey(bits(p.x), bits(p.y), bits(p.z));
+    }
+    bool operator()(const Base::Vector3f& p, const Base::Vector3f& q) const
+    {
+        return p.x == q.x && p.y == q.y && p.z == q.z;
+    }
+};
+
+/// Hashes an edge given by the indices of its end points.
+struct EdgeKey
+{
+    std::size_t operator()(const std::pair<std::size_t, std::size_t>& edge) const
+    {
+        return hashKey(edge.first, edge.second, 0);
+    }
+};
+
+/// Reads the lines of a text stream through a buffer.
+class LineReader
+{
+public:
+    explicit LineReader(std::istream& str)
+        : str(str), pos(0), size(0)
+    {
+    }
+    /// Gets the next line without the line break, returns false at the end of the stream.
+    bool Next(const char*& first, const char*& last)
+    {
+        for (;;) {
+            const char* data = buffer.data();
+            const void* eol = pos < size ? std::memchr(data + pos, '\n', size - pos) : nullptr;
+            if (eol) {
+                first = data + pos;
+                last = static_cast<const char*>(eol);
+                pos = static_cast<std::size_t>(last - data) + 1;
+                return true;
+            }
+            if (!str) {
+                if (pos == size)
+                    return false;
+                first = data + pos;
+                last = data + size;
+                pos = size;
+                return true;
+            }
+
+            // move the incomplete line to the front and append the next block
+            std::size_t rest = size - pos;
+            if (rest > 0)
+                std::memmove(buffer.data(), data + pos, rest);
+            buffer.resize(rest + ReadBlockSize);
+            str.read(buffer.data() + rest, static_cast<std::streamsize>(ReadBlockSize));
+            size = rest + static_cast<std::size_t>(str.gcount());
+            pos = 0;
+        }
+    }
+
+private:
+    std::istream& str;
+    std::vector<char> buffer;
+    std::size_t pos, size;
+};
+
+/// Reads a binary stream through a buffer.
+class ByteReader
+{
+public:
+    explicit ByteReader(std::istream& str)
+        : str(str), pos(0), size(0)
+    {
+    }
+    /// Returns the next \a count bytes, throws Base::BadFormatError at the end of the stream.
+    const char* Next(std::size_t count)
+    {
+        if (size - pos < count) {
+            std::size_t rest = size - pos;
+            if (rest > 0)
+                std::memmove(buffer.data(), buffer.data() + pos, rest);
+            buffer.resize(std::max(rest + ReadBlockSize, count));
+            str.read(buffer.data() + rest, static_cast<std::streamsize>(buffer.size() - rest));
+            size = rest + static_cast<std::size_t>(str.gcount());
+            pos = 0;
+            if (size < count)
+                throw Base::BadFormatError("Reading from stream failed");
+        }
+        const char* data = buffer.data() + pos;
+        pos += count;
+        return data;
+    }
+
+private:
+    std::istream& str;
+    std::vector<char> buffer;
+    std::size_t pos, size;
+};
+
+// ----------------------------------------------------------------------------
+
+class BinarySTLReader : public MeshStreamReader
+{
+public:
+    explicit BinarySTLReader(std::istream& str)
+        : bytes(str), remaining(0)
+    {
+        uint32_t count;
+        std::memcpy(&count, bytes.Next(84) + 80, sizeof(count));
+        remaining = count;
+    }
+    std::size_t Read(std::vector<MeshGeomFacet>& chunk, std::size_t maxFacets) override
+    {
+        std::size_t count = std::min(remaining, maxFacets);
+        const char* records = count > 0 ? bytes.Next(50 * count) : nullptr;
+        remaining -= count;
+
+        // a record consists of the normal, the three points and an attribute
+        chunk.resize(count);
+        parallel_blocks(count, StreamBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                float v[9];
+                std::memcpy(v, records + 50 * i + 3 * sizeof(float), sizeof(v));
+                chunk[i] = MeshGeomFacet(Base::Vector3f(v[0], v[1], v[2]),
+                                         Base::Vector3f(v[3], v[4], v[5]),
+                                         Base::Vector3f(v[6], v[7], v[8]));
+            }
+        });
+        return count;
+    }
+
+private:
+    ByteReader bytes;
+    std::size_t remaining;
+};
+
+class AsciiSTLReader : public MeshStreamReader
+{
+public:
+    explicit AsciiSTLReader(std::istream& str)
+        : lines(str), corner(0)
+    {
+    }
+    std::size_t Read(std::vector<MeshGeomFacet>& chunk, std::size_t maxFacets) override
+    {
+        // every three 'vertex' lines form a facet
+        chunk.clear();
+        const char *first, *last;
+        while (chunk.size() < maxFacets && lines.Next(first, last)) {
+            const char* pos = TextParser::SkipBlanks(first, last);
+            const char* next = TextParser::ParseKeyword(pos, last, "vertex", true);
+            if (next == pos)
+                continue;
+            Base::Vector3f pnt;
+            for (int i = 0; i < 3 && next != pos; i++) {
+                pos = TextParser::SkipBlanks(next, last);
+                next = TextParser::ParseNumber(pos, last, pnt[i]);
+            }
+            if (next == pos || !TextParser::AtEnd(next, last))
+                continue;
+            points[corner++] = pnt;
+            if (corner == 3) {
+                chunk.emplace_back(points[0], points[1], points[2]);
+                corner = 0;
+            }
+        }
+        return chunk.size();
+    }
+
+private:
+    LineReader lines;
+    Base::Vector3f points[3];
+    int corner;
+};
+
+/// Adds the polygon \a polygon as a fan of triangles.
+void addPolygon(const std::vector<long>& polygon, const MeshPointArray& points,
+                std::vector<MeshGeomFacet>& chunk)
+{
+    for (long index : polygon) {
+        if (index < 0 || static_cast<std::size_t>(index) >= points.size())
+            return;
+    }
+    for (std::size_t i = 2; i < polygon.size(); i++) {
+        chunk.emplace_back(points[polygon[0]], points[polygon[i - 1]], points[polygon[i]]);
+    }
+}
+
+class OBJReader : public MeshStreamReader
+{
+public:
+    explicit OBJReader(std::istream& str)
+        : lines(str)
+    {
+    }
+    std::size_t Read(std::vector<MeshGeomFacet>& chunk, std::size_t maxFacets) override
+    {
+        // the points are kept because the facets may refer to any of the previous points
+        chunk.clear();
+        const char *first, *last;
+        while (chunk.size() < maxFacets && lines.Next(first, last)) {
+            const char* pos = TextParser::SkipBlanks(first, last);
+            const char* next = TextParser::ParseKeyword(pos, last, "v");
+            if (next != pos) {
+                Base::Vector3f pnt;
+                for (int i = 0; i < 3 && next != pos; i++) {
+                    pos = TextParser::SkipBlanks(next, last);
+                    next = TextParser::ParseNumber(pos, last, pnt[i]);
+                }
+                if (next != pos)
+                    points.push_back(pnt);
+                continue;
+            }
+
+            next = TextParser::ParseKeyword(pos, last, "f");
+            if (next == pos)
+                continue;
+            // a corner is 'v', 'v/vt', 'v//vn' or 'v/vt/vn' and negative indices are relative
+            polygon.clear();
+            for (;;) {
+                pos = TextParser::SkipBlanks(next, last);
+                long index;
+                next = TextParser::ParseInteger(pos, last, index);
+                if (next == pos)
+                    break;
+                polygon.push_back(index < 0 ? static_cast<long>(points.size()) + index : index - 1);
+                next = TextParser::SkipToken(next, last);
+            }
+            addPolygon(polygon, points, chunk);
+        }
+        return chunk.size();
+    }
+
+private:
+    LineReader lines;
+    MeshPointArray points;
+    std::vector<long> polygon;
+};
+
+// ----------------------------------------------------------------------------
+
+enum class PlyNumber {
+    Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64
+};
+
+bool getPlyNumber(const std::string& type, PlyNumber& number)
+{
+    static const std::pair<const char*, PlyNumber> types[] = {
+        {"char", PlyNumber::Int8}, {"int8", PlyNumber::Int8},
+        {"uchar", PlyNumber::UInt8}, {"uint8", PlyNumber::UInt8},
+        {"short", PlyNumber::Int16}, {"int16", PlyNumber::Int16},
+        {"ushort", PlyNumber::UInt16}, {"uint16", PlyNumber::UInt16},
+        {"int", PlyNumber::Int32}, {"int32", PlyNumber::Int32},
+        {"uint", PlyNumber::UInt32}, {"uint32", PlyNumber::UInt32},
+        {"float", PlyNumber::Float32}, {"float32", PlyNumber::Float32},
+        {"double", PlyNumber::Float64}, {"float64", PlyNumber::Float64}
+    };
+    for (const auto& it : types) {
+        if (type == it.first) {
+            number = it.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t getPlySize(PlyNumber number)
+{
+    switch (number) {
+    case PlyNumber::Int8:
+    case PlyNumber::UInt8:
+        return 1;
+    case PlyNumber::Int16:
+    case PlyNumber::UInt16:
+        return 2;
+    case PlyNumber::Int32:
+    case PlyNumber::UInt32:
+    case PlyNumber::Float32:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+template <class T>
+double convertPly(const char* data, bool swap)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    if (swap)
+        Base::SwapEndian(value);
+    return static_cast<double>(value);
+}
+
+double getPlyValue(const char* data, PlyNumber number, bool swap)
+{
+    switch (number) {
+    case PlyNumber::Int8:
+        return convertPly<int8_t>(data, swap);
+    case PlyNumber::UInt8:
+        return convertPly<uint8_t>(data, swap);
+    case PlyNumber::Int16:
+        return convertPly<int16_t>(data, swap);
+    case PlyNumber::UInt16:
+        return convertPly<uint16_t>(data, swap);
+    case PlyNumber::Int32:
+        return convertPly<int32_t>(data, swap);
+    case PlyNumber::UInt32:
+        return convertPly<uint32_t>(data, swap);
+    case PlyNumber::Float32:
+        return convertPly<float>(data, swap);
+    default:
+        return convertPly<double>(data, swap);
+    }
+}
+
+class PLYReader : public MeshStreamReader
+{
+    struct Property
+    {
+        std::string name;
+        PlyNumber number = PlyNumber::Float32;
+        bool list = false;
+        PlyNumber count = PlyNumber::UInt8;
+    };
+    struct Element
+    {
+        std::string name;
+        std::size_t count = 0;
+        std::vector<Property> properties;
+    };
+
+public:
+    explicit PLYReader(std::istream& str)
+        : lines(str), bytes(str), ascii(false), swap(false), face(nullptr), remaining(0)
+    {
+        readHeader(str);
+
+        // read all elements in front of the faces, the points are kept
+        for (const auto& element : elements) {
+            bool vertex = element.name == "vertex";
+            if (vertex)
+                points.reserve(element.count);
+            if (element.name == "face") {
+                face = &element;
+                remaining = element.count;
+                break;
+            }
+            for (std::size_t i = 0; i < element.count; i++) {
+                readInstance(element);
+                if (vertex)
+                    points.emplace_back(static_cast<float>(values[x]), static_cast<float>(values[y]),
+                                        static_cast<float>(values[z]));
+            }
+        }
+    }
+    std::size_t Read(std::vector<MeshGeomFacet>& chunk, std::size_t maxFacets) override
+    {
+        chunk.clear();
+        while (chunk.size() < maxFacets && remaining > 0) {
+            readInstance(*face);
+            remaining--;
+            addPolygon(polygon, points, chunk);
+        }
+        return chunk.size();
+    }
+
+private:
+    void readHeader(std::istream& str)
+    {
+        std::string line;
+        if (!std::getline(str, line) || line.compare(0, 3, "ply") != 0)
+            throw Base::BadFormatError("Invalid PLY header");
+
+        bool format = false;
+        while (std::getline(str, line)) {
+            std::istringstream in(line);
+            std::string kw;
+            in >> kw;
+            if (kw == "format") {
+                std::string type;
+                in >> type;
+                ascii = type == "ascii";
+                if (type == "binary_little_endian")
+                    swap = Base::SwapOrder() != LOW_ENDIAN;
+                else if (type == "binary_big_endian")
+                    swap = Base::SwapOrder() == LOW_ENDIAN;
+                else if (!ascii)
+                    throw Base::BadFormatError("Unsupported PLY format");
+                format = true;
+            }
+            else if (kw == "element") {
+                Element element;
+                in >> element.name >> element.count;
+                elements.push_back(element);
+            }
+            else if (kw == "property" && !elements.empty()) {
+                Property prop;
+                std::string type;
+                in >> type;
+                if (type == "list") {
+                    std::string count;
+                    in >> count >> type;
+                    prop.list = true;
+                    if (!getPlyNumber(count, prop.count))
+                        throw Base::BadFormatError("Unsupported PLY property type");
+                }
+                in >> prop.name;
+                if (!getPlyNumber(type, prop.number))
+                    throw Base::BadFormatError("Unsupported PLY property type");
+                elements.back().properties.push_back(prop);
+            }
+            else if (kw == "end_header") {
+                break;
+            }
+        }
+        if (!format || !str)
+            throw Base::BadFormatError("Invalid PLY header");
+
+        for (const auto& element : elements) {
+            if (element.name != "vertex")
+                continue;
+            x = y = z = element.properties.size();
+            for (std::size_t i = 0; i < element.properties.size(); i++) {
+                const Property& prop = element.properties[i];
+                if (prop.list)
+                    continue;
+                if (prop.name == "x")
+                    x = i;
+                else if (prop.name == "y")
+                    y = i;
+                else if (prop.name == "z")
+                    z = i;
+            }
+            if (x == element.properties.size() || y == element.properties.size() ||
+                z == element.properties.size())
+                throw Base::BadFormatError("PLY vertices without coordinates");
+        }
+    }
+    /// Reads the scalar properties of an instance of \a element into values and
+    /// the vertex indices of a face into polygon.
+    void readInstance(const Element& element)
+    {
+        values.resize(element.properties.size());
+        polygon.clear();
+        if (ascii) {
+            const char *first, *last;
+            if (!lines.Next(first, last))
+                throw Base::BadFormatError("Reading from stream failed");
+            const char* next = first;
+            for (std::size_t i = 0; i < element.properties.size(); i++) {
+                const Property& prop = element.properties[i];
+                std::size_t count = 1;
+                if (prop.list)
+                    count = static_cast<std::size_t>(readAscii(next, last));
+                for (std::size_t j = 0; j < count; j++) {
+                    values[i] = readAscii(next, last);
+                    if (prop.list && isIndexList(prop))
+                        polygon.push_back(static_cast<long>(values[i]));
+                }
+            }
+        }
+        else {
+            for (std::size_t i = 0; i < element.properties.size(); i++) {
+                const Property& prop = element.properties[i];
+                std::size_t count = 1;
+                if (prop.list)
+                    count = static_cast<std::size_t>(getPlyValue(bytes.Next(getPlySize(prop.count)), prop.count, swap));
+                std::size_t size = getPlySize(prop.number);
+                const char* data = bytes.Next(count * size);
+                for (std::size_t j = 0; j < count; j++) {
+                    values[i] = getPlyValue(data + j * size, prop.number, swap);
+                    if (prop.list && isIndexList(prop))
+                        polygon.push_back(static_cast<long>(values[i]));
+                }
+            }
+        }
+    }
+    static bool isIndexList(const Property& prop)
+    {
+        return prop.name == "vertex_indices" || prop.name == "vertex_index";
+    }
+    static double readAscii(const char*& next, const char* last)
+    {
+        const char* pos = TextParser::SkipBlanks(next, last);
+        double value;
+        next = TextParser::ParseNumber(pos, last, value);
+        if (next == pos)
+            throw Base::BadFormatError("Invalid data structure");
+        return value;
+    }
+
+private:
+    LineReader lines;
+    ByteReader bytes;
+    bool ascii;
+    bool swap;
+    std::vector<Element> elements;
+    const Element* face;
+    std::size_t remaining;
+    std::size_t x = 0, y = 0, z = 0;
+    std::vector<double> values;
+    std::vector<long> polygon;
+    MeshPointArray points;
+};
+
+/** Checks the upper-cased characters following the header of an STL file for keywords,
+ * the same bytes as in MeshInput::LoadSTL are checked.
+ */
+bool isAsciiSTL(std::istream& str)
+{
+    char szBuf[200];
+    uint32_t ulCt = 0, ulBytes = 50;
+    str.seekg(80, std::ios::beg);
+    str.read(reinterpret_cast<char*>(&ulCt), sizeof(ulCt));
+    if (ulCt > 1)
+        ulBytes = 100;
+    str.read(szBuf, ulBytes);
+    std::size_t size = static_cast<std::size_t>(str.gcount());
+    str.clear();
+    str.seekg(0, std::ios::beg);
+
+    std::transform(szBuf, szBuf + size, szBuf, [](char c) {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    });
+    szBuf[size] = 0;
+    return strstr(szBuf, "SOLID") || strstr(szBuf, "FACET") || strstr(szBuf, "NORMAL") ||
+           strstr(szBuf, "VERTEX") || strstr(szBuf, "ENDFACET") || strstr(szBuf, "ENDLOOP");
+}
+
+// ----------------------------------------------------------------------------
+
+/// Formats the facets of \a chunk in parallel and writes the text in order.
+template <class Format>
+void writeText(std::ostream& str, std::size_t count, Format format)
+{
+    std::vector<std::string> blocks(parallel_block_count(count, StreamBlockSize));
+    parallel_blocks(count, StreamBlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::string& text = blocks[block];
+        char line[256];
+        for (std::size_t i = begin; i < end; i++)
+            format(i, line, text);
+    });
+    for (const auto& text : blocks)
+        str.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+class BinarySTLWriter : public MeshStreamWriter
+{
+public:
+    explicit BinarySTLWriter(std::ostream& str)
+        : str(str), count(0)
+    {
+        std::string header = MeshOutput::GetSTLHeaderData();
+        header.resize(80, ' ');
+        uint32_t zero = 0;
+        str.write(header.data(), 80);
+        str.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    }
+    void Write(const std::vector<MeshGeomFacet>& chunk) override
+    {
+        if (count + chunk.size() > UINT32_MAX)
+            throw Base::FileException("Too many facets for a binary STL file");
+
+        // a record consists of the normal, the three points and an attribute
+        records.resize(50 * chunk.size());
+        char* data = records.data();
+        parallel_blocks(chunk.size(), StreamBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshGeomFacet& facet = chunk[i];
+                Base::Vector3f normal = facet.GetNormal();
+                float v[12] = {normal.x, normal.y, normal.z};
+                for (int j = 0; j < 3; j++) {
+                    v[3 * j + 3] = facet._aclPoints[j].x;
+                    v[3 * j + 4] = facet._aclPoints[j].y;
+                    v[3 * j + 5] = facet._aclPoints[j].z;
+                }
+                std::memcpy(data + 50 * i, v, sizeof(v));
+                std::memset(data + 50 * i + sizeof(v), 0, 2);
+            }
+        });
+        str.write(data, static_cast<std::streamsize>(records.size()));
+        count += chunk.size();
+    }
+    void Finish() override
+    {
+        // the number of facets follows the header
+        uint32_t ulCt = static_cast<uint32_t>(count);
+        str.seekp(80, std::ios::beg);
+        str.write(reinterpret_cast<const char*>(&ulCt), sizeof(ulCt));
+        str.seekp(0, std::ios::end);
+        if (!str)
+            throw Base::FileException("Writing binary STL failed, the stream must be seekable");
+    }
+
+private:
+    std::ostream& str;
+    std::size_t count;
+    std::vector<char> records;
+};
+
+class AsciiSTLWriter : public MeshStreamWriter
+{
+public:
+    explicit AsciiSTLWriter(std::ostream& str)
+        : str(str)
+    {
+        str << "solid Mesh\n";
+    }
+    void Write(const std::vector<MeshGeomFacet>& chunk) override
+    {
+        writeText(str, chunk.size(), [&chunk](std::size_t i, char* line, std::string& text) {
+            const MeshGeomFacet& facet = chunk[i];
+            Base::Vector3f normal = facet.GetNormal();
+            std::snprintf(line, 256, "  facet normal %.6f %.6f %.6f\n    outer loop\n",
+                          normal.x, normal.y, normal.z);
+            text += line;
+            for (const auto& pnt : facet._aclPoints) {
+                std::snprintf(line, 256, "      vertex %.6f %.6f %.6f\n", pnt.x, pnt.y, pnt.z);
+                text += line;
+            }
+            text += "    endloop\n  endfacet\n";
+        });
+    }
+    void Finish() override
+    {
+        str << "endsolid Mesh\n";
+        if (!str)
+            throw Base::FileException("Writing ASCII STL failed");
+    }
+
+private:
+    std::ostream& str;
+};
+
+class OBJWriter : public MeshStreamWriter
+{
+public:
+    explicit OBJWriter(std::ostream& str)
+        : str(str), offset(1)
+    {
+    }
+    void Write(const std::vector<MeshGeomFacet>& chunk) override
+    {
+        // the coincident points of a chunk are written once, the points on the
+        // border of the chunks written so far are taken from there
+        std::size_t numCorners = 3 * chunk.size();
+        std::vector<std::size_t> order(numCorners);
+        for (std::size_t i = 0; i < numCorners; i++)
+            order[i] = i;
+        auto corner = [&chunk](std::size_t i) -> const Base::Vector3f& {
+            return chunk[i / 3]._aclPoints[i % 3];
+        };
+        int threads = std::max(1, QThread::idealThreadCount());
+        parallel_sort(order.begin(), order.end(), [&corner](std::size_t a, std::size_t b) {
+            const Base::Vector3f& p = corner(a);
+            const Base::Vector3f& q = corner(b);
+            if (p.x != q.x)
+                return p.x < q.x;
+            if (p.y != q.y)
+                return p.y < q.y;
+            if (p.z != q.z)
+                return p.z < q.z;
+            return a < b;
+        }, threads);
+
+        std::vector<std::size_t> index(numCorners);
+        std::vector<std::size_t> unique;
+        unique.reserve(numCorners);
+        std::size_t current = 0;
+        for (std::size_t i = 0; i < numCorners; i++) {
+            const Base::Vector3f& p = corner(order[i]);
+            if (i == 0 || p.x != corner(order[i - 1]).x || p.y != corner(order[i - 1]).y ||
+                p.z != corner(order[i - 1]).z) {
+                auto it = border.find(p);
+                if (it != border.end()) {
+                    current = it->second.first;
+                }
+                else {
+                    current = offset + unique.size();
+                    unique.push_back(order[i]);
+                }
+            }
+            index[order[i]] = current;
+        }
+
+        writeText(str, unique.size(), [&](std::size_t i, char* line, std::string& text) {
+            const Base::Vector3f& pnt = corner(unique[i]);
+            std::snprintf(line, 256, "v %.6f %.6f %.6f\n", pnt.x, pnt.y, pnt.z);
+            text += line;
+        });
+        writeText(str, chunk.size(), [&index](std::size_t i, char* line, std::string& text) {
+            std::snprintf(line, 256, "f %zu %zu %zu\n", index[3 * i], index[3 * i + 1], index[3 * i + 2]);
+            text += line;
+        });
+        offset += unique.size();
+        UpdateBorder(chunk, index);
+    }
+    void Finish() override
+    {
+        if (!str)
+            throw Base::FileException("Writing OBJ failed");
+    }
+
+private:
+    /*
+     * Keeps the points of the open edges of all facets written so far. Only these
+     * points can be shared with facets of later chunks, so the border stays small
+     * compared to the mesh if the facets of the file are ordered spatially.
+     */
+    void UpdateBorder(const std::vector<MeshGeomFacet>& chunk, const std::vector<std::size_t>& index)
+    {
+        auto addOpenEdge = [this](const Base::Vector3f& p, std::size_t i) {
+            auto it = border.emplace(p, std::make_pair(i, std::size_t(0))).first;
+            it->second.second++;
+        };
+        auto removeOpenEdge = [this](const Base::Vector3f& p) {
+            auto it = border.find(p);
+            if (--it->second.second == 0)
+                border.erase(it);
+        };
+
+        for (std::size_t i = 0; i < chunk.size(); i++) {
+            const MeshGeomFacet& facet = chunk[i];
+            for (int j = 0; j < 3; j++) {
+                int k = (j + 1) % 3;
+                std::size_t a = index[3 * i + j];
+                std::size_t b = index[3 * i + k];
+                if (a == b)
+                    continue;
+                // an edge is open as long as it was used an odd number of times
+                auto edge = std::make_pair(std::min(a, b), std::max(a, b));
+                if (openEdges.erase(edge) > 0) {
+                    removeOpenEdge(facet._aclPoints[j]);
+                    removeOpenEdge(facet._aclPoints[k]);
+                }
+                else {
+                    openEdges.insert(edge);
+                    addOpenEdge(facet._aclPoints[j], a);
+                    addOpenEdge(facet._aclPoints[k], b);
+                }
+            }
+        }
+    }
+
+private:
+    std::ostream& str;
+    std::size_t offset;
+    /// The points of the open edges with their index and number of open edges.
+    std::unordered_map<Base::Vector3f, std::pair<std::size_t, std::size_t>, PointKey, PointKey> border;
+    std::unordered_set<std::pair<std::size_t, std::size_t>, EdgeKey> openEdges;
+};
+
+}
+
+// ----------------------------------------------------------------------------
+
+std::unique_ptr<MeshStreamReader> MeshStreamReader::Create(std::istream& str, MeshIO::Format fmt)
+{
+    if (!str || str.bad())
+        throw Base::FileException("Reading from stream failed");
+
+    switch (fmt) {
+    case MeshIO::STL:
+        if (isAsciiSTL(str))
+            return std::unique_ptr<MeshStreamReader>(new AsciiSTLReader(str));
+        return std::unique_ptr<MeshStreamReader>(new BinarySTLReader(str));
+    case MeshIO::ASTL:
+        return std::unique_ptr<MeshStreamReader>(new AsciiSTLReader(str));
+    case MeshIO::BSTL:
+        return std::unique_ptr<MeshStreamReader>(new BinarySTLReader(str));
+    case MeshIO::OBJ:
+        return std::unique_ptr<MeshStreamReader>(new OBJReader(str));
+    case MeshIO::PLY:
+    case MeshIO::APLY:
+        return std::unique_ptr<MeshStreamReader>(new PLYReader(str));
+    default:
+        throw Base::FileException("File format not supported for streaming");
+    }
+}
+
+std::unique_ptr<MeshStreamWriter> MeshStreamWriter::Create(std::ostream& str, MeshIO::Format fmt)
+{
+    if (!str || str.bad())
+        throw Base::FileException("Writing to stream failed");
+
+    switch (fmt) {
+    case MeshIO::STL:
+    case MeshIO::BSTL:
+        return std::unique_ptr<MeshStreamWriter>(new BinarySTLWriter(str));
+    case MeshIO::ASTL:
+        return std::unique_ptr<MeshStreamWriter>(new AsciiSTLWriter(str));
+    case MeshIO::OBJ:
+        return std::unique_ptr<MeshStreamWriter>(new OBJWriter(str));
+    default:
+        throw Base::FileException("File format not supported for streaming");
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+MeshStreamTransform::MeshStreamTransform(const Base::Matrix4D& mat)
+  : _clMatrix(mat)
+{
+}
+
+void MeshStreamTransform::Process(std::vector<MeshGeomFacet>& chunk)
+{
+    parallel_blocks(chunk.size(), StreamBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshGeomFacet& facet = chunk[i];
+            for (auto& pnt : facet._aclPoints)
+                pnt = _clMatrix * pnt;
+            facet.NormalInvalid();
+        }
+    });
+}
+
+// ----------------------------------------------------------------------------
+
+MeshStreamWeld::MeshStreamWeld(float tolerance)
+  : _fTolerance(tolerance)
+{
+}
+
+void MeshStreamWeld::Process(std::vector<MeshGeomFacet>& chunk)
+{
+    if (_fTolerance <= 0.0f)
+        return;
+
+    // with cells of twice the tolerance the neighbours of a point lie in 2x2x2 cells
+    const float tolerance = _fTolerance;
+    const double cellSize = 2.0 * tolerance;
+    auto cell = [cellSize](float value) {
+        double index = std::floor(value / cellSize);
+        // non-finite coordinates are never welded
+        if (!(std::fabs(index) < 1.0e18))
+            return std::int64_t(0);
+        return static_cast<std::int64_t>(index);
+    };
+    auto cellKey = [](std::int64_t x, std::int64_t y, std::int64_t z) {
+        return hashKey(static_cast<std::uint64_t>(x), static_cast<std::uint64_t>(y),
+                       static_cast<std::uint64_t>(z));
+    };
+    const std::size_t none = std::size_t(-1);
+    // returns the nearest representative from the given one on within the tolerance
+    auto findNearest = [&](const Base::Vector3f& p, std::size_t first) {
+        std::size_t nearest = none;
+        float minDist = tolerance;
+        for (std::int64_t x = cell(p.x - tolerance); x <= cell(p.x + tolerance); x++) {
+            for (std::int64_t y = cell(p.y - tolerance); y <= cell(p.y + tolerance); y++) {
+                for (std::int64_t z = cell(p.z - tolerance); z <= cell(p.z + tolerance); z++) {
+                    auto it = _cells.find(cellKey(x, y, z));
+                    if (it == _cells.end())
+                        continue;
+                    for (std::size_t j = it->second; j != none && j >= first; j = _next[j]) {
+                        float dist = Base::Distance(p, _points[j]);
+                        if (dist <= minDist) {
+                            minDist = dist;
+                            nearest = j;
+                        }
+                    }
+                }
+            }
+        }
+        return nearest;
+    };
+
+    // the representatives of the previous chunks are only read, so they're looked up in parallel
+    std::size_t numCorners = 3 * chunk.size();
+    std::vector<std::size_t> match(numCorners);
+    std::size_t numPoints = _points.size();
+    parallel_blocks(chunk.size(), StreamBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            for (int j = 0; j < 3; j++)
+                match[3 * i + j] = findNearest(chunk[i]._aclPoints[j], 0);
+        }
+    });
+
+    // the remaining points become representatives or are welded to one of this chunk
+    for (std::size_t i = 0; i < numCorners; i++) {
+        if (match[i] != none)
+            continue;
+        const Base::Vector3f& p = chunk[i / 3]._aclPoints[i % 3];
+        match[i] = findNearest(p, numPoints);
+        if (match[i] == none) {
+            std::size_t& head = _cells.emplace(cellKey(cell(p.x), cell(p.y), cell(p.z)), none).first->second;
+            match[i] = _points.size();
+            _points.push_back(p);
+            _next.push_back(head);
+            head = match[i];
+        }
+    }
+
+    std::vector<char> collapsed(chunk.size(), 0);
+    parallel_blocks(chunk.size(), StreamBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshGeomFacet& facet = chunk[i];
+            const std::size_t* m = &match[3 * i];
+            for (int j = 0; j < 3; j++) {
+                if (!PointKey()(facet._aclPoints[j], _points[m[j]])) {
+                    facet._aclPoints[j] = _points[m[j]];
+                    facet.NormalInvalid();
+                }
+            }
+            collapsed[i] = (m[0] == m[1] || m[1] == m[2] || m[2] == m[0]) ? 1 : 0;
+        }
+    });
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < chunk.size(); i++) {
+        if (!collapsed[i])
+            chunk[count++] = chunk[i];
+    }
+    chunk.resize(count);
+}
+
+// ----------------------------------------------------------------------------
+
+MeshStreamDecimate::MeshStreamDecimate(float reduction, float maxError)
+  : _fReduction(reduction), _fMaxError(maxError)
+{
+}
+
+void MeshStreamDecimate::Process(std::vector<MeshGeomFacet>& chunk)
+{
+    if (_fReduction <= 0.0f || chunk.empty())
+        return;
+
+    std::size_t numParts = (chunk.size() + DecimationPartSize - 1) / DecimationPartSize;
+    std::vector<std::vector<MeshGeomFacet> > parts(numParts);
+    parallel_blocks(numParts, 1, [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t part = first; part < last; part++) {
+            std::size_t begin = part * DecimationPartSize;
+            std::size_t count = std::min(DecimationPartSize, chunk.size() - begin);
+
+            MeshKernel kernel;
+            MeshFastBuilder builder(kernel);
+            builder.Initialize(static_cast<MeshFastBuilder::size_type>(count));
+            builder.AddFacets(count, [&chunk, begin](std::size_t i, Base::Vector3f* points) {
+                const MeshGeomFacet& facet = chunk[begin + i];
+                std::copy(facet._aclPoints, facet._aclPoints + 3, points);
+            });
+            builder.Finish();
+
+            MeshSimplify dm(kernel);
+            dm.setKeepBoundary(true);
+            float target = (1.0f - _fReduction) * static_cast<float>(count);
+            dm.simplify(static_cast<int>(target), _fMaxError);
+
+            std::vector<MeshGeomFacet>& facets = parts[part];
+            facets.reserve(kernel.CountFacets());
+            for (FacetIndex i = 0; i < kernel.CountFacets(); i++)
+                facets.push_back(kernel.GetFacet(i));
+        }
+    });
+
+    chunk.clear();
+    for (auto& part : parts) {
+        chunk.insert(chunk.end(), part.begin(), part.end());
+        std::vector<MeshGeomFacet>().swap(part);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshStreamNormals::Process(std::vector<MeshGeomFacet>& chunk)
+{
+    parallel_blocks(chunk.size(), StreamBlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            chunk[i].CalcNormal();
+    });
+}
+
+// ----------------------------------------------------------------------------
+
+MeshStreamPipeline::MeshStreamPipeline(std::size_t chunkSize)
+  : _ulChunkSize(std::max<std::size_t>(chunkSize, 1))
+  , _ulRead(0)
+  , _ulWritten(0)
+{
+}
+
+MeshStreamPipeline::~MeshStreamPipeline()
+{
+}
+
+void MeshStreamPipeline::AddStage(std::unique_ptr<MeshStreamStage> stage)
+{
+    _stages.push_back(std::move(stage));
+}
+
+void MeshStreamPipeline::Run(MeshStreamReader& reader, MeshStreamWriter& writer)
+{
+    _ulRead = 0;
+    _ulWritten = 0;
+
+    // the number of chunks isn't known in advance
+    Base::SequencerLauncher seq("Converting mesh...", 0);
+    std::vector<MeshGeomFacet> chunk, next;
+    std::size_t count = reader.Read(chunk, _ulChunkSize);
+    while (count > 0) {
+        _ulRead += count;
+
+        // read the next chunk while this one is processed
+        std::size_t nextCount = 0;
+        std::exception_ptr error;
+        QFuture<void> future = QtConcurrent::run([&]() {
+            try {
+                nextCount = reader.Read(next, _ulChunkSize);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        });
+
+        try {
+            for (auto& stage : _stages)
+                stage->Process(chunk);
+            writer.Write(chunk);
+            _ulWritten += chunk.size();
+            seq.next(true);
+        }
+        catch (...) {
+            future.waitForFinished();
+            throw;
+        }
+
+        future.waitForFinished();
+        if (error)
+            std::rethrow_exception(error);
+        chunk.swap(next);
+        count = nextCount;
+    }
+
+    writer.Finish();
+}
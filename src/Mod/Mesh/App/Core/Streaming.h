@@ -0,0 +1,189 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_STREAMING_H
+#define MESH_STREAMING_H
+
+#include <iosfwd>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <Base/Matrix.h>
+
+#include "Elements.h"
+#include "MeshIO.h"
+
+
+namespace MeshCore {
+
+/**
+ * The MeshStreamReader class reads the facets of a mesh file in chunks without loading
+ * the whole mesh. Binary and ASCII STL, OBJ and PLY files are supported.
+ * The facets of STL files are read one by one. The indexed formats OBJ and PLY keep
+ * the points in memory, but the facets are still read in chunks.
+ */
+class MeshExport MeshStreamReader
+{
+public:
+    virtual ~MeshStreamReader() = default;
+    /** Replaces the content of \a chunk with the next facets of the file, about
+     * \a maxFacets of them. A polygon is never split between two chunks, so its
+     * triangles may exceed the limit slightly. Returns the number of facets read,
+     * 0 at the end of the file.
+     * Throws Base::BadFormatError if the data is corrupted.
+     */
+    virtual std::size_t Read(std::vector<MeshGeomFacet>& chunk, std::size_t maxFacets) = 0;
+
+    /** Creates a reader for \a str. The stream must be opened in binary mode and outlive
+     * the reader. Throws Base::FileException if the format can't be read in chunks.
+     */
+    static std::unique_ptr<MeshStreamReader> Create(std::istream& str, MeshIO::Format fmt);
+};
+
+/**
+ * The MeshStreamWriter class writes the facets of a mesh file in chunks.
+ * Binary and ASCII STL and OBJ files are supported. Binary STL files need a seekable
+ * stream to write the number of facets when finished. The OBJ writer keeps the points
+ * on the open border of the facets written so far, so that later chunks reference them
+ * instead of writing them again.
+ */
+class MeshExport MeshStreamWriter
+{
+public:
+    virtual ~MeshStreamWriter() = default;
+    /// Appends the facets of \a chunk to the file.
+    virtual void Write(const std::vector<MeshGeomFacet>& chunk) = 0;
+    /// Completes the file after the last chunk.
+    virtual void Finish() = 0;
+
+    /** Creates a writer for \a str. The stream must be opened in binary mode and outlive
+     * the writer. Throws Base::FileException if the format can't be written in chunks.
+     */
+    static std::unique_ptr<MeshStreamWriter> Create(std::ostream& str, MeshIO::Format fmt);
+};
+
+/**
+ * A MeshStreamStage modifies each chunk of facets passing the pipeline. It only sees one
+ * chunk at a time, so all operations are local to the chunk.
+ */
+class MeshExport MeshStreamStage
+{
+public:
+    virtual ~MeshStreamStage() = default;
+    /// Modifies the facets of \a chunk, facets may be added or removed.
+    virtual void Process(std::vector<MeshGeomFacet>& chunk) = 0;
+};
+
+/// Transforms the facets.
+class MeshExport MeshStreamTransform : public MeshStreamStage
+{
+public:
+    explicit MeshStreamTransform(const Base::Matrix4D& mat);
+    void Process(std::vector<MeshGeomFacet>& chunk) override;
+
+private:
+    Base::Matrix4D _clMatrix;
+};
+
+/**
+ * Welds the points of the facets that are closer than \a tolerance. The first point
+ * of a cluster becomes its representative and the points within the tolerance around
+ * it are moved onto it, points without a neighbour keep their position. The
+ * representatives are kept in a hash grid over all chunks, so points are welded across
+ * chunks, too. The grid needs much less memory than the facets but grows with the
+ * number of distinct points. Facets that collapse are removed.
+ */
+class MeshExport MeshStreamWeld : public MeshStreamStage
+{
+public:
+    explicit MeshStreamWeld(float tolerance);
+    void Process(std::vector<MeshGeomFacet>& chunk) override;
+
+private:
+    float _fTolerance;
+    /// The representatives, chained per grid cell with the first of each cell in _cells.
+    std::vector<Base::Vector3f> _points;
+    std::vector<std::size_t> _next;
+    std::unordered_map<std::size_t, std::size_t> _cells;
+};
+
+/**
+ * Simplifies the facets of each chunk by the factor \a reduction, see MeshSimplify.
+ * The chunk is split into parts that are simplified in parallel. The open edges of the
+ * parts keep their points, so no gaps arise between parts and chunks. The reduction works
+ * best if the facets of the file are ordered spatially, as it's the case for most scanners.
+ */
+class MeshExport MeshStreamDecimate : public MeshStreamStage
+{
+public:
+    MeshStreamDecimate(float reduction, float maxError);
+    void Process(std::vector<MeshGeomFacet>& chunk) override;
+
+private:
+    float _fReduction;
+    float _fMaxError;
+};
+
+/// Computes the normals of the facets.
+class MeshExport MeshStreamNormals : public MeshStreamStage
+{
+public:
+    void Process(std::vector<MeshGeomFacet>& chunk) override;
+};
+
+/**
+ * The MeshStreamPipeline class converts a mesh file chunk by chunk, so meshes larger than
+ * the main memory can be processed. Each chunk passes the stages in the order they were
+ * added. While a chunk is processed and written the next one is read in the background.
+ */
+class MeshExport MeshStreamPipeline
+{
+public:
+    explicit MeshStreamPipeline(std::size_t chunkSize = 1048576);
+    ~MeshStreamPipeline();
+
+    void AddStage(std::unique_ptr<MeshStreamStage> stage);
+    /** Reads all facets of \a reader and writes them to \a writer.
+     * The sequencer shows the number of chunks processed, it can be canceled with
+     * Base::AbortException.
+     */
+    void Run(MeshStreamReader& reader, MeshStreamWriter& writer);
+
+    /// The number of facets read by the last Run().
+    std::size_t CountRead() const
+    { return _ulRead; }
+    /// The number of facets written by the last Run().
+    std::size_t CountWritten() const
+    { return _ulWritten; }
+
+private:
+    std::size_t _ulChunkSize;
+    std::size_t _ulRead;
+    std::size_t _ulWritten;
+    std::vector<std::unique_ptr<MeshStreamStage> > _stages;
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_STREAMING_H
@@ -83,9 +83,9 @@ unsigned long MeshSearchNeighbours::NeighboursFromFacet (FacetIndex ulFacetIdx,
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (std::set<FacetIndex>::iterator pI = aclTmp.begin(); pI != aclTmp.end(); ++pI) {
-            const std::set<FacetIndex> &rclISet = _clPt2Fa[*pI];
+            MeshIndexRange rclISet = _clPt2Fa[*pI];
             // search all facets hanging on this point
-            for (std::set<FacetIndex>::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); ++pJ) {
+            for (MeshIndexRange::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); ++pJ) {
                 const MeshFacet &rclF = f_beg[*pJ];
 
                 if (!rclF.IsFlag(MeshFacet::MARKED)) {
@@ -176,9 +176,9 @@ unsigned long MeshSearchNeighbours::NeighboursFromSampledFacets (FacetIndex ulFa
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (std::set<PointIndex>::iterator pI = aclTmp.begin(); pI != aclTmp.end(); ++pI) {
-            const std::set<FacetIndex> &rclISet = _clPt2Fa[*pI];
+            MeshIndexRange rclISet = _clPt2Fa[*pI];
             // search all facets hanging on this point
-            for (std::set<FacetIndex>::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); ++pJ) {
+            for (MeshIndexRange::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); ++pJ) {
                 const MeshFacet &rclF = f_beg[*pJ];
 
                 if (!rclF.IsFlag(MeshFacet::MARKED)) {
@@ -288,9 +288,9 @@ unsigned long MeshSearchNeighbours::NeighboursFacetFromFacet (FacetIndex ulFacet
         std::set<PointIndex> aclTmp;
         aclTmp.swap(_aclOuter);
         for (std::set<PointIndex>::iterator pI = aclTmp.begin(); pI != aclTmp.end(); ++pI) {
-            const std::set<FacetIndex> &rclISet = _clPt2Fa[*pI];
+            MeshIndexRange rclISet = _clPt2Fa[*pI];
             // search all facets hanging on this point
-            for (std::set<PointIndex>::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); ++pJ) {
+            for (MeshIndexRange::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); ++pJ) {
                 const MeshFacet &rclF = f_beg[*pJ];
 
                 for (int i = 0; i < 3; i++) {
@@ -24,6 +24,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <memory>
 # include <queue>
 # include <utility>
 #endif
@@ -33,6 +34,7 @@
 
 #include "TopoAlgorithm.h"
 #include "Evaluation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Triangulation.h"
@@ -43,6 +45,7 @@ using namespace MeshCore;
 MeshTopoAlgorithm::MeshTopoAlgorithm (MeshKernel &rclM)
 : _rclMesh(rclM), _needsCleanup(false), _cache(nullptr)
 {
+    _rclMesh.Expand();
 }
 
 MeshTopoAlgorithm::~MeshTopoAlgorithm ()
@@ -1528,14 +1531,44 @@ void MeshTopoAlgorithm::FillupHoles(int level, AbstractPolygonTriangulator& cTri
     MeshRefPointToFacets cPt2Fac(_rclMesh);
     MeshAlgorithm cAlgo(_rclMesh);
 
+    struct HolePatch {
+        bool filled = false;
+        MeshFacetArray facets;
+        MeshPointArray points;
+    };
+
+    // Triangulate all holes first. The mesh isn't modified meanwhile, so if the
+    // triangulator can be cloned each thread works on its own range of holes.
+    std::vector<std::vector<PointIndex> > holes(aBorders.begin(), aBorders.end());
+    std::vector<HolePatch> patches(holes.size());
+    auto fillHoles = [&](AbstractPolygonTriangulator& tria, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            HolePatch& patch = patches[i];
+            patch.filled = cAlgo.FillupHole(holes[i], tria, patch.facets, patch.points, level, &cPt2Fac);
+        }
+    };
+
+    std::unique_ptr<AbstractPolygonTriangulator> clone(cTria.Clone());
+    if (clone && holes.size() > 1) {
+        parallel_blocks(holes.size(), 8, [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::unique_ptr<AbstractPolygonTriangulator> tria(cTria.Clone());
+            fillHoles(*tria, begin, end);
+        });
+    }
+    else {
+        fillHoles(cTria, 0, holes.size());
+    }
+
+    // merge the patches in the order of the holes
     MeshFacetArray newFacets;
     MeshPointArray newPoints;
     unsigned long numberOfOldPoints = _rclMesh._aclPointArray.size();
-    for (std::list<std::vector<PointIndex> >::const_iterator it = aBorders.begin(); it != aBorders.end(); ++it) {
-        MeshFacetArray cFacets;
-        MeshPointArray cPoints;
-        std::vector<PointIndex> bound = *it;
-        if (cAlgo.FillupHole(bound, cTria, cFacets, cPoints, level, &cPt2Fac)) {
+    std::list<std::vector<PointIndex> >::const_iterator it = aBorders.begin();
+    for (std::size_t index = 0; index < holes.size(); ++index, ++it) {
+        MeshFacetArray& cFacets = patches[index].facets;
+        MeshPointArray& cPoints = patches[index].points;
+        std::vector<PointIndex>& bound = holes[index];
+        if (patches[index].filled) {
             if (bound.front() == bound.back())
                 bound.pop_back();
             // the triangulation may produce additional points which we must take into account when appending to the mesh
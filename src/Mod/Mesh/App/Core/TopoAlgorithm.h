@@ -246,6 +246,8 @@ public:
     /**
      * This is an overloaded method provided for convenience. It takes as first argument
      * the boundaries which must be filled up.
+     * All holes are triangulated before the mesh is modified. If \a cTria can be cloned
+     * this is done in parallel, then all patches are added at once.
      */
     void FillupHoles(int level, AbstractPolygonTriangulator&,
         const std::list<std::vector<PointIndex> >& aBorders,
@@ -37,6 +37,11 @@
 using namespace MeshCore;
 
 
+TriangulationVerifier* TriangulationVerifier::Clone() const
+{
+    return new TriangulationVerifier(*this);
+}
+
 bool TriangulationVerifier::Accept(const Base::Vector3f& n,
                                    const Base::Vector3f& p1,
                                    const Base::Vector3f& p2,
@@ -53,6 +58,11 @@ bool TriangulationVerifier::MustFlip(const Base::Vector3f& n1,
     return n1.Dot(n2) <= 0.0f;
 }
 
+TriangulationVerifier* TriangulationVerifierV2::Clone() const
+{
+    return new TriangulationVerifierV2(*this);
+}
+
 bool TriangulationVerifierV2::Accept(const Base::Vector3f& n,
                                      const Base::Vector3f& p1,
                                      const Base::Vector3f& p2,
@@ -86,6 +96,16 @@ AbstractPolygonTriangulator::~AbstractPolygonTriangulator()
     delete _verifier;
 }
 
+AbstractPolygonTriangulator* AbstractPolygonTriangulator::Clone() const
+{
+    return nullptr;
+}
+
+TriangulationVerifier* AbstractPolygonTriangulator::CloneVerifier() const
+{
+    return _verifier ? _verifier->Clone() : nullptr;
+}
+
 TriangulationVerifier* AbstractPolygonTriangulator::GetVerifier() const
 {
     return _verifier;
@@ -284,6 +304,13 @@ EarClippingTriangulator::~EarClippingTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* EarClippingTriangulator::Clone() const
+{
+    EarClippingTriangulator* tria = new EarClippingTriangulator();
+    tria->SetVerifier(CloneVerifier());
+    return tria;
+}
+
 bool EarClippingTriangulator::Triangulate()
 {
     _facets.clear();
@@ -291,9 +318,10 @@ bool EarClippingTriangulator::Triangulate()
 
     std::vector<Base::Vector3f> pts = ProjectToFitPlane();
     std::vector<PointIndex> result;
+    bool invert = false;
 
     //  Invoke the triangulator to triangulate this polygon.
-    Triangulate::Process(pts,result);
+    Triangulate::Process(pts,result,invert);
 
     // print out the results.
     size_t tcount = result.size()/3;
@@ -305,7 +333,7 @@ bool EarClippingTriangulator::Triangulate()
     MeshGeomFacet clFacet;
     MeshFacet clTopFacet;
     for (size_t i=0; i<tcount; i++) {
-        if (Triangulate::_invert) {
+        if (invert) {
             clFacet._aclPoints[0] = _points[result[i*3+0]];
             clFacet._aclPoints[2] = _points[result[i*3+1]];
             clFacet._aclPoints[1] = _points[result[i*3+2]];
@@ -395,10 +423,9 @@ bool EarClippingTriangulator::Triangulate::Snip(const std::vector<Base::Vector3f
     return true;
 }
 
-bool EarClippingTriangulator::Triangulate::_invert = false;
-
 bool EarClippingTriangulator::Triangulate::Process(const std::vector<Base::Vector3f> &contour,
-                                                   std::vector<PointIndex> &result)
+                                                   std::vector<PointIndex> &result,
+                                                   bool &invert)
 {
     /* allocate and initialize list of Vertices in polygon */
 
@@ -412,12 +439,12 @@ bool EarClippingTriangulator::Triangulate::Process(const std::vector<Base::Vecto
 
     if (0.0f < Area(contour)) {
         for (int v=0; v<n; v++) V[v] = v;
-        _invert = true;
+        invert = true;
     }
 //    for(int v=0; v<n; v++) V[v] = (n-1)-v;
     else {
         for(int v=0; v<n; v++) V[v] = (n-1)-v;
-        _invert = false;
+        invert = false;
     }
 
     int nv = n;
@@ -477,6 +504,13 @@ QuasiDelaunayTriangulator::~QuasiDelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* QuasiDelaunayTriangulator::Clone() const
+{
+    QuasiDelaunayTriangulator* tria = new QuasiDelaunayTriangulator();
+    tria->SetVerifier(CloneVerifier());
+    return tria;
+}
+
 bool QuasiDelaunayTriangulator::Triangulate()
 {
     if (!EarClippingTriangulator::Triangulate())
@@ -638,6 +672,13 @@ DelaunayTriangulator::~DelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* DelaunayTriangulator::Clone() const
+{
+    DelaunayTriangulator* tria = new DelaunayTriangulator();
+    tria->SetVerifier(CloneVerifier());
+    return tria;
+}
+
 bool DelaunayTriangulator::Triangulate()
 {
     // before starting the triangulation we must make sure that all polygon
@@ -710,6 +751,13 @@ FlatTriangulator::~FlatTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* FlatTriangulator::Clone() const
+{
+    FlatTriangulator* tria = new FlatTriangulator();
+    tria->SetVerifier(CloneVerifier());
+    return tria;
+}
+
 bool FlatTriangulator::Triangulate()
 {
     _newpoints.clear();
@@ -754,6 +802,13 @@ ConstraintDelaunayTriangulator::~ConstraintDelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* ConstraintDelaunayTriangulator::Clone() const
+{
+    ConstraintDelaunayTriangulator* tria = new ConstraintDelaunayTriangulator(fMaxArea);
+    tria->SetVerifier(CloneVerifier());
+    return tria;
+}
+
 bool ConstraintDelaunayTriangulator::Triangulate()
 {
     _newpoints.clear();
@@ -35,6 +35,8 @@ class MeshExport TriangulationVerifier
 public:
     TriangulationVerifier() {}
     virtual ~TriangulationVerifier() {}
+    /** Returns a copy of this verifier. */
+    virtual TriangulationVerifier* Clone() const;
     virtual bool Accept(const Base::Vector3f& n,
                         const Base::Vector3f& p1,
                         const Base::Vector3f& p2,
@@ -46,6 +48,7 @@ public:
 class MeshExport TriangulationVerifierV2 : public TriangulationVerifier
 {
 public:
+    TriangulationVerifier* Clone() const override;
     bool Accept(const Base::Vector3f& n,
                         const Base::Vector3f& p1,
                         const Base::Vector3f& p2,
@@ -59,6 +62,13 @@ class MeshExport AbstractPolygonTriangulator
 public:
     AbstractPolygonTriangulator();
     virtual ~AbstractPolygonTriangulator();
+    /** Returns a new triangulator of the same type with the same settings
+     * and a copy of the verifier, so that several polygons can be triangulated
+     * in parallel. The caller takes ownership of the returned object.
+     * The default implementation returns null, in this case the polygons
+     * must be processed one after another.
+     */
+    virtual AbstractPolygonTriangulator* Clone() const;
 
     /** Sets the polygon to be triangulated. */
     void SetPolygon(const std::vector<Base::Vector3f>& raclPoints);
@@ -127,6 +137,8 @@ protected:
      */
     virtual bool Triangulate() = 0;
     void Done();
+    /** Returns a copy of the verifier or null if none is set. */
+    TriangulationVerifier* CloneVerifier() const;
 
 protected:
     bool                        _discard;
@@ -149,6 +161,7 @@ class MeshExport EarClippingTriangulator : public AbstractPolygonTriangulator
 public:
     EarClippingTriangulator();
     ~EarClippingTriangulator() override;
+    AbstractPolygonTriangulator* Clone() const override;
 
 protected:
     bool Triangulate() override;
@@ -167,9 +180,10 @@ private:
     {
     public:
         // triangulate a contour/polygon, places results in STL vector
-        // as series of triangles.indicating the points
+        // as series of triangles.indicating the points, invert is set
+        // if the points of the triangles must be swapped
         static bool Process(const std::vector<Base::Vector3f> &contour,
-            std::vector<PointIndex> &result);
+            std::vector<PointIndex> &result, bool &invert);
 
         // compute area of a contour/polygon
         static float Area(const std::vector<Base::Vector3f> &contour);
@@ -179,7 +193,6 @@ private:
         static bool InsideTriangle(float Ax, float Ay, float Bx, float By,
             float Cx, float Cy, float Px, float Py);
 
-        static bool _invert;
     private:
         static bool Snip(const std::vector<Base::Vector3f> &contour,
             int u,int v,int w,int n,int *V);
@@ -191,6 +204,7 @@ class MeshExport QuasiDelaunayTriangulator : public EarClippingTriangulator
 public:
     QuasiDelaunayTriangulator();
     ~QuasiDelaunayTriangulator() override;
+    AbstractPolygonTriangulator* Clone() const override;
 
 protected:
     bool Triangulate() override;
@@ -201,6 +215,7 @@ class MeshExport DelaunayTriangulator : public AbstractPolygonTriangulator
 public:
     DelaunayTriangulator();
     ~DelaunayTriangulator() override;
+    AbstractPolygonTriangulator* Clone() const override;
 
 protected:
     bool Triangulate() override;
@@ -211,6 +226,7 @@ class MeshExport FlatTriangulator : public AbstractPolygonTriangulator
 public:
     FlatTriangulator();
     ~FlatTriangulator() override;
+    AbstractPolygonTriangulator* Clone() const override;
 
     void PostProcessing(const std::vector<Base::Vector3f>&) override;
 
@@ -223,6 +239,7 @@ class MeshExport ConstraintDelaunayTriangulator : public AbstractPolygonTriangul
 public:
     explicit ConstraintDelaunayTriangulator(float area);
     ~ConstraintDelaunayTriangulator() override;
+    AbstractPolygonTriangulator* Clone() const override;
 
 protected:
     bool Triangulate() override;
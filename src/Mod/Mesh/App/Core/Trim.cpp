@@ -38,6 +38,7 @@ MeshTrimming::MeshTrimming(MeshKernel &rclM, const Base::ViewProjMethod* pclProj
                            const Base::Polygon2d& rclPoly)
   : myMesh(rclM), myInner(true), myProj(pclProj), myPoly(rclPoly)
 {
+    myMesh.Expand();
 }
 
 MeshTrimming::~MeshTrimming()
@@ -0,0 +1,467 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <functional>
+# include <iterator>
+#endif
+
+#include "Validation.h"
+#include "Degeneration.h"
+#include "Evaluation.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+#include "TopoAlgorithm.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+/// Minimum number of elements a thread processes.
+const std::size_t BlockSize = 4096;
+
+/// A facet edge with the point indices in ascending order.
+struct FacetEdge
+{
+    PointIndex p0, p1;
+    FacetIndex f;
+    unsigned short side;
+    bool reversed;
+
+    bool operator<(const FacetEdge& e) const
+    {
+        if (p0 != e.p0)
+            return p0 < e.p0;
+        if (p1 != e.p1)
+            return p1 < e.p1;
+        return f < e.f;
+    }
+    bool SameEdge(const FacetEdge& e) const
+    {
+        return p0 == e.p0 && p1 == e.p1;
+    }
+};
+
+}
+
+bool MeshValidationPipeline::Report::IsValid() const
+{
+    return std::all_of(remaining, remaining + CountChecks, [](unsigned long count) {
+        return count == 0;
+    });
+}
+
+bool MeshValidationPipeline::Defects::IsValid() const
+{
+    return std::all_of(count, count + CountChecks, [](unsigned long value) {
+        return value == 0;
+    });
+}
+
+MeshValidationPipeline::MeshValidationPipeline(MeshKernel& rclMesh)
+  : _rclMesh(rclMesh)
+  , _checks((1ul << CountChecks) - 1)
+  , _degeneratedEps(MeshDefinitions::_fMinPointDistanceP2)
+  , _maxRounds(10)
+{
+}
+
+MeshValidationPipeline::~MeshValidationPipeline()
+{
+}
+
+const char* MeshValidationPipeline::GetName(Check check)
+{
+    switch (check) {
+    case InvalidIndices:
+        return "InvalidIndices";
+    case InvalidPoints:
+        return "InvalidPoints";
+    case InvalidNeighbourhood:
+        return "InvalidNeighbourhood";
+    case DuplicatedFacets:
+        return "DuplicatedFacets";
+    case NonManifolds:
+        return "NonManifolds";
+    case SelfIntersections:
+        return "SelfIntersections";
+    case Folds:
+        return "Folds";
+    case DuplicatedPoints:
+        return "DuplicatedPoints";
+    case DegeneratedFacets:
+        return "DegeneratedFacets";
+    case WrongOrientation:
+        return "WrongOrientation";
+    default:
+        return "";
+    }
+}
+
+MeshValidationPipeline::Report MeshValidationPipeline::Evaluate() const
+{
+    Defects defects;
+    Evaluate(defects);
+
+    Report report;
+    std::copy(defects.count, defects.count + CountChecks, report.found);
+    std::copy(defects.count, defects.count + CountChecks, report.remaining);
+    return report;
+}
+
+MeshValidationPipeline::Report MeshValidationPipeline::Repair()
+{
+    Report report;
+    Defects defects;
+    Evaluate(defects);
+    std::copy(defects.count, defects.count + CountChecks, report.found);
+
+    while (!defects.IsValid() && report.rounds < _maxRounds) {
+        Fixup(defects);
+        report.rounds++;
+
+        defects = Defects();
+        Evaluate(defects);
+    }
+
+    std::copy(defects.count, defects.count + CountChecks, report.remaining);
+    return report;
+}
+
+void MeshValidationPipeline::Evaluate(Defects& defects) const
+{
+    // all other checks access the points and neighbours by index
+    EvaluateIndices(defects);
+    if ((IsEnabled(InvalidIndices) && defects.count[InvalidIndices] > 0) ||
+        (IsEnabled(InvalidPoints) && defects.count[InvalidPoints] > 0))
+        return;
+
+    // the sort based checks run as own tasks while the edge table and the
+    // facet checks are processed in parallel blocks
+    std::vector<QFuture<void> > futures;
+    if (IsEnabled(DuplicatedPoints)) {
+        futures.push_back(QtConcurrent::run([this, &defects]() {
+            MeshEvalDuplicatePoints eval(_rclMesh);
+            defects.count[DuplicatedPoints] = eval.GetIndices().size();
+        }));
+    }
+    if (IsEnabled(DuplicatedFacets)) {
+        futures.push_back(QtConcurrent::run([this, &defects]() {
+            MeshEvalDuplicateFacets eval(_rclMesh);
+            defects.duplicatedFacets = eval.GetIndices();
+            defects.count[DuplicatedFacets] = defects.duplicatedFacets.size();
+        }));
+    }
+
+    try {
+        // the self-intersection check runs on this thread because it shows its
+        // progress and thus may be aborted by the user, it is parallel by itself
+        if (IsEnabled(SelfIntersections)) {
+            MeshEvalSelfIntersection eval(_rclMesh);
+            eval.GetIntersections(defects.selfIntersections);
+            defects.count[SelfIntersections] = defects.selfIntersections.size();
+        }
+        EvaluateEdges(defects);
+        EvaluateFacets(defects);
+    }
+    catch (...) {
+        for (auto& future : futures)
+            future.waitForFinished();
+        throw;
+    }
+    for (auto& future : futures)
+        future.waitForFinished();
+}
+
+void MeshValidationPipeline::EvaluateIndices(Defects& defects) const
+{
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    std::size_t countPoints = points.size();
+    std::size_t countFacets = facets.size();
+
+    if (IsEnabled(InvalidPoints)) {
+        std::vector<unsigned long> invalidPoints(parallel_block_count(countPoints, BlockSize), 0);
+        parallel_blocks(countPoints, BlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshPoint& p = points[i];
+                if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
+                    invalidPoints[block]++;
+            }
+        });
+
+        for (auto count : invalidPoints)
+            defects.count[InvalidPoints] += count;
+    }
+
+    if (IsEnabled(InvalidIndices)) {
+        std::vector<unsigned long> invalidFacets(parallel_block_count(countFacets, BlockSize), 0);
+        parallel_blocks(countFacets, BlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                const MeshFacet& f = facets[i];
+                bool invalid = f.IsDegenerated();
+                for (int j = 0; j < 3; j++) {
+                    if (f._aulPoints[j] >= countPoints)
+                        invalid = true;
+                    if (f._aulNeighbours[j] >= countFacets && f._aulNeighbours[j] != FACET_INDEX_MAX)
+                        invalid = true;
+                }
+                if (invalid)
+                    invalidFacets[block]++;
+            }
+        });
+
+        for (auto count : invalidFacets)
+            defects.count[InvalidIndices] += count;
+    }
+}
+
+void MeshValidationPipeline::EvaluateEdges(Defects& defects) const
+{
+    if (!IsEnabled(InvalidNeighbourhood) && !IsEnabled(NonManifolds) && !IsEnabled(WrongOrientation))
+        return;
+
+    // one sorted edge table for the topological checks
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    std::vector<FacetEdge> edges(3 * facets.size());
+    parallel_blocks(facets.size(), BlockSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& f = facets[i];
+            for (unsigned short j = 0; j < 3; j++) {
+                FacetEdge& e = edges[3 * i + j];
+                PointIndex p0 = f._aulPoints[j];
+                PointIndex p1 = f._aulPoints[(j + 1) % 3];
+                e.p0 = std::min<PointIndex>(p0, p1);
+                e.p1 = std::max<PointIndex>(p0, p1);
+                e.f = i;
+                e.side = j;
+                e.reversed = p0 > p1;
+            }
+        }
+    });
+
+    parallel_sort(edges.begin(), edges.end(), std::less<FacetEdge>(), QThread::idealThreadCount());
+
+    auto begin = edges.begin();
+    while (begin != edges.end()) {
+        auto end = begin + 1;
+        while (end != edges.end() && begin->SameEdge(*end))
+            ++end;
+
+        const FacetEdge& e0 = *begin;
+        const MeshFacet& f0 = facets[e0.f];
+        switch (end - begin) {
+        case 1:
+            // an open edge must not have a neighbour
+            if (f0._aulNeighbours[e0.side] != FACET_INDEX_MAX)
+                defects.count[InvalidNeighbourhood]++;
+            break;
+        case 2:
+        {
+            const FacetEdge& e1 = *(begin + 1);
+            const MeshFacet& f1 = facets[e1.f];
+            if (f0._aulNeighbours[e0.side] != e1.f || f1._aulNeighbours[e1.side] != e0.f)
+                defects.count[InvalidNeighbourhood]++;
+            // consistently oriented facets run through the edge in opposite directions
+            if (e0.reversed == e1.reversed)
+                defects.count[WrongOrientation]++;
+        }   break;
+        default:
+        {
+            std::vector<FacetIndex> manifold;
+            for (auto it = begin; it != end; ++it)
+                manifold.push_back(it->f);
+            defects.nonManifolds.push_back(manifold);
+        }   break;
+        }
+
+        begin = end;
+    }
+
+    if (!IsEnabled(InvalidNeighbourhood))
+        defects.count[InvalidNeighbourhood] = 0;
+    if (!IsEnabled(WrongOrientation))
+        defects.count[WrongOrientation] = 0;
+    if (IsEnabled(NonManifolds))
+        defects.count[NonManifolds] = defects.nonManifolds.size();
+    else
+        defects.nonManifolds.clear();
+}
+
+void MeshValidationPipeline::EvaluateFacets(Defects& defects) const
+{
+    if (!IsEnabled(Folds) && !IsEnabled(DegeneratedFacets))
+        return;
+
+    // the normals are shared by all fold checks
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    std::size_t countFacets = facets.size();
+    std::vector<Base::Vector3f> normals(countFacets);
+    std::vector<unsigned long> degenerated(parallel_block_count(countFacets, BlockSize), 0);
+    parallel_blocks(countFacets, BlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshGeomFacet facet = _rclMesh.GetFacet(facets[i]);
+            normals[i] = facet.GetNormal();
+            if (facet.IsDegenerated(_degeneratedEps))
+                degenerated[block]++;
+        }
+    });
+
+    if (IsEnabled(DegeneratedFacets)) {
+        for (auto count : degenerated)
+            defects.count[DegeneratedFacets] += count;
+    }
+
+    if (!IsEnabled(Folds))
+        return;
+
+    // same criteria as MeshEvalFoldsOnSurface, MeshEvalFoldOversOnSurface
+    // and MeshEvalFoldsOnBoundary
+    std::vector<std::vector<FacetIndex> > folds(parallel_block_count(countFacets, BlockSize));
+    parallel_blocks(countFacets, BlockSize, [&](std::size_t block, std::size_t begin, std::size_t end) {
+        std::vector<FacetIndex>& indices = folds[block];
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& f = facets[i];
+            const Base::Vector3f& n = normals[i];
+            bool foldOver = false;
+            for (int j = 0; j < 3; j++) {
+                FacetIndex n1 = f._aulNeighbours[j];
+                FacetIndex n2 = f._aulNeighbours[(j + 1) % 3];
+                if (n1 == FACET_INDEX_MAX || n2 == FACET_INDEX_MAX)
+                    continue;
+
+                const Base::Vector3f& v1 = normals[n1];
+                const Base::Vector3f& v2 = normals[n2];
+                if (v1 * v2 > 0.0f && n * v1 < -0.1f && n * v2 < -0.1f) {
+                    indices.push_back(n1);
+                    indices.push_back(n2);
+                    indices.push_back(i);
+                }
+                if (!foldOver && v1 * v2 < -0.5f &&
+                    f.HasSameOrientation(facets[n1]) &&
+                    f.HasSameOrientation(facets[n2])) {
+                    indices.push_back(i);
+                    foldOver = true;
+                }
+            }
+
+            if (f.CountOpenEdges() == 2) {
+                for (int j = 0; j < 3; j++) {
+                    FacetIndex nb = f._aulNeighbours[j];
+                    if (nb != FACET_INDEX_MAX && n * normals[nb] <= 0.5f)
+                        indices.push_back(i);
+                }
+            }
+        }
+    });
+
+    for (const auto& block : folds)
+        defects.folds.insert(defects.folds.end(), block.begin(), block.end());
+    std::sort(defects.folds.begin(), defects.folds.end());
+    defects.folds.erase(std::unique(defects.folds.begin(), defects.folds.end()), defects.folds.end());
+    defects.count[Folds] = defects.folds.size();
+}
+
+void MeshValidationPipeline::Fixup(const Defects& defects)
+{
+    // the other defects are only known once the indices and points are valid
+    if (IsEnabled(InvalidIndices) && defects.count[InvalidIndices] > 0) {
+        MeshFixNeighbourhood fix(_rclMesh);
+        fix.Fixup();
+
+        if (!MeshEvalRangeFacet(_rclMesh).Evaluate())
+            MeshFixRangeFacet(_rclMesh).Fixup();
+        if (!MeshEvalRangePoint(_rclMesh).Evaluate())
+            MeshFixRangePoint(_rclMesh).Fixup();
+        if (!MeshEvalCorruptedFacets(_rclMesh).Evaluate())
+            MeshFixCorruptedFacets(_rclMesh).Fixup();
+        return;
+    }
+
+    if (IsEnabled(InvalidPoints) && defects.count[InvalidPoints] > 0) {
+        MeshFixNaNPoints fix(_rclMesh);
+        fix.Fixup();
+        return;
+    }
+
+    // the fold checks rely on the neighbourhood
+    if (defects.count[InvalidNeighbourhood] > 0) {
+        MeshFixNeighbourhood fix(_rclMesh);
+        fix.Fixup();
+        return;
+    }
+
+    // all facets to remove refer to the evaluated mesh, so delete them at once
+    std::vector<FacetIndex> facets = defects.duplicatedFacets;
+    std::sort(facets.begin(), facets.end());
+
+    // duplicated facets make their edges non-manifold, too, but removing them is sufficient
+    std::list<std::vector<FacetIndex> > nonManifolds;
+    for (const auto& it : defects.nonManifolds) {
+        std::vector<FacetIndex> manifold;
+        std::copy_if(it.begin(), it.end(), std::back_inserter(manifold), [&facets](FacetIndex index) {
+            return !std::binary_search(facets.begin(), facets.end(), index);
+        });
+        if (manifold.size() > 2)
+            nonManifolds.push_back(manifold);
+    }
+
+    if (!nonManifolds.empty()) {
+        MeshFixTopology fix(_rclMesh, nonManifolds);
+        std::vector<FacetIndex> indices = fix.GetFacets();
+        facets.insert(facets.end(), indices.begin(), indices.end());
+    }
+    if (!defects.selfIntersections.empty()) {
+        MeshFixSelfIntersection fix(_rclMesh, defects.selfIntersections);
+        std::vector<FacetIndex> indices = fix.GetFacets();
+        facets.insert(facets.end(), indices.begin(), indices.end());
+    }
+    // flipped facets look like folds, so fix the orientation first
+    if (defects.count[WrongOrientation] == 0)
+        facets.insert(facets.end(), defects.folds.begin(), defects.folds.end());
+
+    if (!facets.empty()) {
+        std::sort(facets.begin(), facets.end());
+        facets.erase(std::unique(facets.begin(), facets.end()), facets.end());
+        _rclMesh.DeleteFacets(facets);
+        if (!defects.nonManifolds.empty() || !defects.duplicatedFacets.empty())
+            _rclMesh.RebuildNeighbours();
+    }
+
+    // these fixes don't depend on indices of the evaluation
+    if (defects.count[DuplicatedPoints] > 0) {
+        MeshFixDuplicatePoints fix(_rclMesh);
+        fix.Fixup();
+    }
+    if (defects.count[DegeneratedFacets] > 0) {
+        MeshFixDegeneratedFacets fix(_rclMesh, _degeneratedEps);
+        fix.Fixup();
+    }
+    if (defects.count[WrongOrientation] > 0) {
+        MeshTopoAlgorithm alg(_rclMesh);
+        alg.HarmonizeNormals();
+    }
+}
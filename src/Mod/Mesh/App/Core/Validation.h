@@ -0,0 +1,142 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MESH_VALIDATION_H
+#define MESH_VALIDATION_H
+
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "Definitions.h"
+
+
+namespace MeshCore {
+
+class MeshKernel;
+
+/**
+ * The MeshValidationPipeline class checks a mesh for all kinds of defects at once and
+ * repairs them in a defined order.
+ *
+ * Unlike calling the single MeshEval* and MeshFix* classes one after another the pipeline
+ * builds the shared data only once per evaluation: one sorted edge table serves the checks
+ * for non-manifolds, the neighbourhood and the orientation and the facet normals are computed
+ * once for all fold checks. The checks run in parallel on the unmodified kernel, the repair
+ * then applies all fixes of a round and evaluates the mesh again until it's valid or the
+ * maximum number of rounds is reached.
+ */
+class MeshExport MeshValidationPipeline
+{
+public:
+    /** The checks in the order their defects are repaired. */
+    enum Check {
+        InvalidIndices,         /**< Point or neighbour indices out of range, corrupted facets. */
+        InvalidPoints,          /**< Points with NaN coordinates. */
+        InvalidNeighbourhood,   /**< Neighbour indices not matching the topology. */
+        DuplicatedFacets,       /**< Facets referencing the same points as another facet. */
+        NonManifolds,           /**< Edges shared by more than two facets. */
+        SelfIntersections,      /**< Pairs of intersecting facets. */
+        Folds,                  /**< Folds on the surface and on the boundary, repaired
+                                     once the orientation is consistent. */
+        DuplicatedPoints,       /**< Points with the same coordinates as another point. */
+        DegeneratedFacets,      /**< Facets with a zero area. */
+        WrongOrientation,       /**< Edges whose adjacent facets have opposite orientation. */
+        CountChecks
+    };
+
+    /** The result of an evaluation or repair. */
+    struct Report
+    {
+        /// Number of defects of each check before repairing.
+        unsigned long found[CountChecks] = {};
+        /// Number of defects of each check left after repairing.
+        unsigned long remaining[CountChecks] = {};
+        /// Number of repair rounds done.
+        int rounds = 0;
+
+        /// Returns true if no defects are left.
+        bool IsValid() const;
+    };
+
+    explicit MeshValidationPipeline(MeshKernel& rclMesh);
+    ~MeshValidationPipeline();
+
+    /** @name Settings */
+    //@{
+    /// Sets the checks to run as a bit mask of (1 << Check), by default all.
+    void SetChecks(unsigned long mask)
+    { _checks = mask; }
+    unsigned long GetChecks() const
+    { return _checks; }
+    /// Sets the tolerance to detect degenerated facets.
+    void SetDegeneratedEpsilon(float fEps)
+    { _degeneratedEps = fEps; }
+    /// Sets the maximum number of repair rounds.
+    void SetMaxRounds(int rounds)
+    { _maxRounds = rounds; }
+    //@}
+
+    /** Runs all enabled checks without modifying the mesh. The found and the remaining
+     * defects of the report are equal.
+     * \note While there are invalid points or indices only these are checked, because
+     * all other checks rely on them.
+     */
+    Report Evaluate() const;
+    /** Repairs the defects of all enabled checks. Each round applies the fixes in the
+     * order of Check and evaluates the mesh again.
+     */
+    Report Repair();
+
+    /// Returns the name of a check as used in reports.
+    static const char* GetName(Check check);
+
+private:
+    struct Defects
+    {
+        unsigned long count[CountChecks] = {};
+        std::vector<FacetIndex> duplicatedFacets;
+        std::list<std::vector<FacetIndex> > nonManifolds;
+        std::vector<std::pair<FacetIndex, FacetIndex> > selfIntersections;
+        std::vector<FacetIndex> folds;
+
+        bool IsValid() const;
+    };
+
+    bool IsEnabled(Check check) const
+    { return (_checks & (1ul << check)) != 0; }
+    void Evaluate(Defects&) const;
+    void EvaluateIndices(Defects&) const;
+    void EvaluateEdges(Defects&) const;
+    void EvaluateFacets(Defects&) const;
+    void Fixup(const Defects&);
+
+private:
+    MeshKernel& _rclMesh;
+    unsigned long _checks;
+    float _degeneratedEps;
+    int _maxRounds;
+};
+
+} // namespace MeshCore
+
+#endif // MESH_VALIDATION_H
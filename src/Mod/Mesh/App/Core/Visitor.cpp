@@ -31,23 +31,59 @@
 using namespace MeshCore;
 
 
-unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet) const
+namespace {
+
+// Marks visited elements with the VISIT flag of the mesh
+template <class Array, class Element>
+class FlagMarker
+{
+public:
+    explicit FlagMarker(const Array& rAry) : rAry(rAry) {}
+    bool IsVisited(ElementIndex index) const
+    { return rAry[index].IsFlag(Element::VISIT); }
+    void SetVisited(ElementIndex index)
+    { rAry[index].SetFlag(Element::VISIT); }
+
+private:
+    const Array& rAry;
+};
+
+// Marks visited elements in a caller-owned state
+class StateMarker
+{
+public:
+    explicit StateMarker(MeshVisitState& rState) : rState(rState) {}
+    bool IsVisited(ElementIndex index) const
+    { return rState.IsVisited(index); }
+    void SetVisited(ElementIndex index)
+    { rState.SetVisited(index); }
+
+private:
+    MeshVisitState& rState;
+};
+
+using FacetFlagMarker = FlagMarker<MeshFacetArray, MeshFacet>;
+using PointFlagMarker = FlagMarker<MeshPointArray, MeshPoint>;
+
+template <class Marker>
+unsigned long VisitNeighbourFacets (const MeshFacetArray& raclFAry, MeshFacetVisitor &rclFVisitor,
+                                    FacetIndex ulStartFacet, Marker& rclMarker)
 {
     unsigned long ulVisited = 0, j, ulLevel = 0;
-    unsigned long ulCount = _aclFacetArray.size();
+    unsigned long ulCount = raclFAry.size();
     std::vector<FacetIndex> clCurrentLevel, clNextLevel;
     std::vector<FacetIndex>::iterator  clCurrIter;
     MeshFacetArray::_TConstIterator clCurrFacet, clNBFacet;
 
     // pick up start point
     clCurrentLevel.push_back(ulStartFacet);
-    _aclFacetArray[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    rclMarker.SetVisited(ulStartFacet);
 
     // as long as free neighbours
     while (!clCurrentLevel.empty()) {
         // visit all neighbours of the current level
         for (clCurrIter = clCurrentLevel.begin(); clCurrIter < clCurrentLevel.end(); ++clCurrIter) {
-            clCurrFacet = _aclFacetArray.begin() + *clCurrIter;
+            clCurrFacet = raclFAry.begin() + *clCurrIter;
 
             // visit all neighbours of the current level if not yet done
             for (unsigned short i = 0; i < 3; i++) {
@@ -58,17 +94,17 @@ unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, F
                 if (j >= ulCount)
                     continue;      // error in data structure
 
-                clNBFacet = _aclFacetArray.begin() + j;
+                clNBFacet = raclFAry.begin() + j;
 
                 if (!rclFVisitor.AllowVisit(*clNBFacet, *clCurrFacet, j, ulLevel, i))
                     continue;
-                if (clNBFacet->IsFlag(MeshFacet::VISIT))
+                if (rclMarker.IsVisited(j))
                     continue; // neighbour facet already visited
                 else {
                     // visit and mark
                     ulVisited++;
                     clNextLevel.push_back(j);
-                    clNBFacet->SetFlag(MeshFacet::VISIT);
+                    rclMarker.SetVisited(j);
                     if (!rclFVisitor.Visit(*clNBFacet, *clCurrFacet, j, ulLevel))
                         return ulVisited;
                 }
@@ -83,30 +119,32 @@ unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, F
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet) const
+template <class Marker>
+unsigned long VisitNeighbourFacetsOverCorners (const MeshKernel& rclMesh, MeshFacetVisitor &rclFVisitor,
+                                               FacetIndex ulStartFacet, Marker& rclMarker)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
-    MeshRefPointToFacets clRPF(*this);
-    const MeshFacetArray& raclFAry = _aclFacetArray;
+    MeshRefPointToFacets clRPF(rclMesh);
+    const MeshFacetArray& raclFAry = rclMesh.GetFacets();
     MeshFacetArray::_TConstIterator pFBegin = raclFAry.begin();
     std::vector<FacetIndex> aclCurrentLevel, aclNextLevel;
 
     aclCurrentLevel.push_back(ulStartFacet);
-    raclFAry[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    rclMarker.SetVisited(ulStartFacet);
 
     while (!aclCurrentLevel.empty()) {
         // visit all neighbours of the current level
         for (std::vector<FacetIndex>::iterator pCurrFacet = aclCurrentLevel.begin(); pCurrFacet < aclCurrentLevel.end(); ++pCurrFacet) {
             for (int i = 0; i < 3; i++) {
                 const MeshFacet &rclFacet = raclFAry[*pCurrFacet];
-                const std::set<FacetIndex>& raclNB = clRPF[rclFacet._aulPoints[i]];
-                for (std::set<FacetIndex>::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
-                    if (!pFBegin[*pINb].IsFlag(MeshFacet::VISIT)) {
-                        // only visit if VISIT Flag not set
+                MeshIndexRange raclNB = clRPF[rclFacet._aulPoints[i]];
+                for (MeshIndexRange::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
+                    if (!rclMarker.IsVisited(*pINb)) {
+                        // only visit if not yet visited
                         ulVisited++;
                         FacetIndex ulFInd = *pINb;
                         aclNextLevel.push_back(ulFInd);
-                        pFBegin[*pINb].SetFlag(MeshFacet::VISIT);
+                        rclMarker.SetVisited(ulFInd);
                         if (!rclFVisitor.Visit(pFBegin[*pINb], raclFAry[*pCurrFacet], ulFInd, ulLevel))
                             return ulVisited;
                     }
@@ -121,28 +159,30 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rcl
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, PointIndex ulStartPoint) const
+template <class Marker>
+unsigned long VisitNeighbourPoints (const MeshKernel& rclMesh, MeshPointVisitor &rclPVisitor,
+                                    PointIndex ulStartPoint, Marker& rclMarker)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
     std::vector<PointIndex> aclCurrentLevel, aclNextLevel;
     std::vector<PointIndex>::iterator  clCurrIter;
-    MeshPointArray::_TConstIterator pPBegin = _aclPointArray.begin();
-    MeshRefPointToPoints clNPs(*this);
+    MeshPointArray::_TConstIterator pPBegin = rclMesh.GetPoints().begin();
+    MeshRefPointToPoints clNPs(rclMesh);
 
     aclCurrentLevel.push_back(ulStartPoint);
-    (pPBegin + ulStartPoint)->SetFlag(MeshPoint::VISIT);
+    rclMarker.SetVisited(ulStartPoint);
 
     while (!aclCurrentLevel.empty()) {
         // visit all neighbours of the current level
         for (clCurrIter = aclCurrentLevel.begin(); clCurrIter < aclCurrentLevel.end(); ++clCurrIter) {
-            const std::set<PointIndex>& raclNB = clNPs[*clCurrIter];
-            for (std::set<PointIndex>::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
-                if (!pPBegin[*pINb].IsFlag(MeshPoint::VISIT)) {
-                    // only visit if VISIT Flag not set
+            MeshIndexRange raclNB = clNPs[*clCurrIter];
+            for (MeshIndexRange::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
+                if (!rclMarker.IsVisited(*pINb)) {
+                    // only visit if not yet visited
                     ulVisited++;
                     PointIndex ulPInd = *pINb;
                     aclNextLevel.push_back(ulPInd);
-                    pPBegin[*pINb].SetFlag(MeshPoint::VISIT);
+                    rclMarker.SetVisited(ulPInd);
                     if (!rclPVisitor.Visit(pPBegin[*pINb], *(pPBegin + (*clCurrIter)), ulPInd, ulLevel))
                         return ulVisited;
                 }
@@ -156,6 +196,53 @@ unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, P
     return ulVisited;
 }
 
+}
+
+unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet) const
+{
+    Unpack();
+    FacetFlagMarker marker(_aclFacetArray);
+    return ::VisitNeighbourFacets(_aclFacetArray, rclFVisitor, ulStartFacet, marker);
+}
+
+unsigned long MeshKernel::VisitNeighbourFacets (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet,
+                                                MeshVisitState &rclVisited) const
+{
+    Unpack();
+    StateMarker marker(rclVisited);
+    return ::VisitNeighbourFacets(_aclFacetArray, rclFVisitor, ulStartFacet, marker);
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet) const
+{
+    Unpack();
+    FacetFlagMarker marker(_aclFacetArray);
+    return ::VisitNeighbourFacetsOverCorners(*this, rclFVisitor, ulStartFacet, marker);
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rclFVisitor, FacetIndex ulStartFacet,
+                                                           MeshVisitState &rclVisited) const
+{
+    Unpack();
+    StateMarker marker(rclVisited);
+    return ::VisitNeighbourFacetsOverCorners(*this, rclFVisitor, ulStartFacet, marker);
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, PointIndex ulStartPoint) const
+{
+    Unpack();
+    PointFlagMarker marker(_aclPointArray);
+    return ::VisitNeighbourPoints(*this, rclPVisitor, ulStartPoint, marker);
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, PointIndex ulStartPoint,
+                                                MeshVisitState &rclVisited) const
+{
+    Unpack();
+    StateMarker marker(rclVisited);
+    return ::VisitNeighbourPoints(*this, rclPVisitor, ulStartPoint, marker);
+}
+
 // -------------------------------------------------------------------------
 
 MeshSearchNeighbourFacetsVisitor::MeshSearchNeighbourFacetsVisitor (const MeshKernel &rclMesh,
@@ -23,6 +23,8 @@
 #ifndef VISITOR_H
 #define VISITOR_H
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <Mod/Mesh/MeshGlobal.h>
 
@@ -35,6 +37,57 @@ class MeshFacetVisitor;
 class MeshPoint;
 class PlaneFit;
 
+/**
+ * The MeshVisitState class keeps track of visited facets or points outside of the mesh.
+ * Unlike the VISIT flag it's owned by the caller, so that several algorithms can traverse
+ * the same const mesh at the same time.
+ * Each element stores the epoch it was visited in, so that Reset() doesn't need to touch
+ * all elements.
+ */
+class MeshExport MeshVisitState
+{
+public:
+    explicit MeshVisitState(ElementIndex ulSize = 0)
+      : _aulStamps(ulSize, 0), _ulEpoch(1)
+    { }
+
+    /// Sets the number of elements and marks all of them as not visited.
+    void Resize(ElementIndex ulSize)
+    {
+        _aulStamps.assign(ulSize, 0);
+        _ulEpoch = 1;
+    }
+    ElementIndex Size() const
+    { return static_cast<ElementIndex>(_aulStamps.size()); }
+    /// Marks all elements as not visited.
+    void Reset()
+    {
+        if (++_ulEpoch == 0) {
+            std::fill(_aulStamps.begin(), _aulStamps.end(), 0);
+            _ulEpoch = 1;
+        }
+    }
+    bool IsVisited(ElementIndex ulIndex) const
+    { return _aulStamps[ulIndex] == _ulEpoch; }
+    void SetVisited(ElementIndex ulIndex)
+    { _aulStamps[ulIndex] = _ulEpoch; }
+    void ResetVisited(ElementIndex ulIndex)
+    { _aulStamps[ulIndex] = 0; }
+    /// Returns the index of the first element from \a ulStart on that isn't visited, or ELEMENT_INDEX_MAX.
+    ElementIndex FindNotVisited(ElementIndex ulStart = 0) const
+    {
+        for (std::size_t i = ulStart; i < _aulStamps.size(); i++) {
+            if (_aulStamps[i] != _ulEpoch)
+                return static_cast<ElementIndex>(i);
+        }
+        return ELEMENT_INDEX_MAX;
+    }
+
+private:
+    std::vector<std::uint32_t> _aulStamps;
+    std::uint32_t _ulEpoch;
+};
+
 /**
  * Abstract base class for facet visitors.
  * The MeshFacetVisitor class can be used for the so called
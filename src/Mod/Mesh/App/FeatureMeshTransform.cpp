@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+# include <memory>
+#endif
 
 #include <Base/Matrix.h>
 
@@ -41,19 +44,26 @@ Transform::Transform()
 
 App::DocumentObjectExecReturn* Transform::execute()
 {
-/*
     Feature* pcFirst = dynamic_cast<Feature*>(Source.getValue());
     if (!pcFirst || pcFirst->isError())
         return new App::DocumentObjectExecReturn("Unknown Error");
 
-    Matrix4D Matrix = Position.getValue();
+    // The result shares the mesh kernel with the source, so only the
+    // placement is stored as long as the matrix is a rigid transformation
+    std::unique_ptr<MeshObject> mesh(new MeshObject(pcFirst->Mesh.getValue()));
+    Matrix4D Matrix = Position.getValue() * mesh->getTransform();
+    if (Matrix.hasScale(1e-7) == Base::ScaleType::NoScaling) {
+        mesh->setTransform(Matrix);
+    }
+    else {
+        // A scaling can't be expressed by the placement of the feature, so the
+        // placement of the source is baked into the points as well. The kernel
+        // is transformed directly because the topology and segments are kept.
+        mesh->setTransform(Matrix4D());
+        mesh->getKernel().Transform(Matrix);
+    }
 
-
-    MeshCore::MeshKernel* pcKernel =
-        new MeshCore::MeshKernel(pcFirst->Mesh.getValue());// Result Meshkernel
-    pcKernel->Transform(Matrix);
-    Mesh.setValue(pcKernel);
-*/
+    Mesh.setValuePtr(mesh.release());
     return App::DocumentObject::StdReturn;
 }
 
@@ -32,8 +32,8 @@ namespace Mesh
 {
 
 /**
- * The Import class reads the any supported mesh format
- * into the FreeCAD workspace.
+ * The Transform class applies a matrix to the mesh of the
+ * Source feature without copying its mesh data.
  * @author Werner Mayer
  */
 class Transform : public Mesh::Feature
@@ -46,10 +46,13 @@
 #include "Core/Iterator.h"
 #include "Core/MeshKernel.h"
 #include "Core/Segmentation.h"
+#include "Core/Slicer.h"
 #include "Core/SetOperations.h"
 #include "Core/TopoAlgorithm.h"
 #include "Core/Trim.h"
 #include "Core/TrimByPlane.h"
+#include "Core/IO/ReaderBMS.h"
+#include "Core/IO/WriterBMS.h"
 
 #include "Mesh.h"
 
@@ -62,17 +65,18 @@ TYPESYSTEM_SOURCE(Mesh::MeshObject, Data::ComplexGeoData)
 TYPESYSTEM_SOURCE(Mesh::MeshSegment, Data::Segment)
 
 MeshObject::MeshObject()
+  : _kernel(std::make_shared<MeshCore::MeshKernel>())
 {
 }
 
 MeshObject::MeshObject(const MeshCore::MeshKernel& Kernel)
-  : _kernel(Kernel)
+  : _kernel(std::make_shared<MeshCore::MeshKernel>(Kernel))
 {
     // copy the mesh structure
 }
 
 MeshObject::MeshObject(const MeshCore::MeshKernel& Kernel, const Base::Matrix4D &Mtrx)
-  : _Mtrx(Mtrx),_kernel(Kernel)
+  : _Mtrx(Mtrx),_kernel(std::make_shared<MeshCore::MeshKernel>(Kernel))
 {
     // copy the mesh structure
 }
@@ -80,7 +84,7 @@ MeshObject::MeshObject(const MeshCore::MeshKernel& Kernel, const Base::Matrix4D
 MeshObject::MeshObject(const MeshObject& mesh)
   : _Mtrx(mesh._Mtrx),_kernel(mesh._kernel)
 {
-    // copy the mesh structure
+    // share the mesh structure, it's copied on the first modification
     copySegments(mesh);
 }
 
@@ -88,6 +92,21 @@ MeshObject::~MeshObject()
 {
 }
 
+void MeshObject::detach() const
+{
+    // another mesh object refers to the kernel, so make a private copy before modifying it
+    if (_kernel.use_count() > 1)
+        _kernel = std::make_shared<MeshCore::MeshKernel>(*_kernel);
+}
+
+MeshCore::MeshKernel& MeshObject::replaceKernel()
+{
+    // the content will be replaced anyway, so there is no need to copy a shared kernel
+    if (_kernel.use_count() > 1)
+        _kernel = std::make_shared<MeshCore::MeshKernel>();
+    return *_kernel;
+}
+
 std::vector<const char*> MeshObject::getElementTypes() const
 {
     std::vector<const char*> temp;
@@ -163,8 +182,8 @@ Base::Matrix4D MeshObject::getTransform() const
 
 Base::BoundBox3d MeshObject::getBoundBox()const
 {
-    _kernel.RecalcBoundBox();
-    Base::BoundBox3f Bnd = _kernel.GetBoundBox();
+    getKernel().RecalcBoundBox();
+    Base::BoundBox3f Bnd = getKernel().GetBoundBox();
 
     Base::BoundBox3d Bnd2;
     if (Bnd.IsValid()) {
@@ -177,7 +196,7 @@ Base::BoundBox3d MeshObject::getBoundBox()const
 
 bool MeshObject::getCenterOfGravity(Base::Vector3d& center) const
 {
-    MeshCore::MeshAlgorithm alg(_kernel);
+    MeshCore::MeshAlgorithm alg(getKernel());
     Base::Vector3f pnt = alg.GetGravityPoint();
     center = transformPointToOutside(pnt);
     return true;
@@ -206,7 +225,7 @@ void MeshObject::swapSegments(MeshObject& mesh)
 void MeshObject::operator = (const MeshObject& mesh)
 {
     if (this != &mesh) {
-        // copy the mesh structure
+        // share the mesh structure, it's copied on the first modification
         setTransform(mesh._Mtrx);
         this->_kernel = mesh._kernel;
         copySegments(mesh);
@@ -215,13 +234,13 @@ void MeshObject::operator = (const MeshObject& mesh)
 
 void MeshObject::setKernel(const MeshCore::MeshKernel& m)
 {
-    this->_kernel = m;
+    this->_kernel = std::make_shared<MeshCore::MeshKernel>(m);
     this->_segments.clear();
 }
 
 void MeshObject::swap(MeshCore::MeshKernel& Kernel)
 {
-    this->_kernel.Swap(Kernel);
+    getKernel().Swap(Kernel);
     // clear the segments because we don't know how the new
     // topology looks like
     this->_segments.clear();
@@ -229,7 +248,7 @@ void MeshObject::swap(MeshCore::MeshKernel& Kernel)
 
 void MeshObject::swap(MeshObject& mesh)
 {
-    this->_kernel.Swap(mesh._kernel);
+    this->_kernel.swap(mesh._kernel);
     swapSegments(mesh);
     Base::Matrix4D tmp=this->_Mtrx;
     this->_Mtrx = mesh._Mtrx;
@@ -239,7 +258,7 @@ void MeshObject::swap(MeshObject& mesh)
 std::string MeshObject::representation() const
 {
     std::stringstream str;
-    MeshCore::MeshInfo info(_kernel);
+    MeshCore::MeshInfo info(getKernel());
     info.GeneralInformation(str);
     return str.str();
 }
@@ -247,24 +266,24 @@ std::string MeshObject::representation() const
 std::string MeshObject::topologyInfo() const
 {
     std::stringstream str;
-    MeshCore::MeshInfo info(_kernel);
+    MeshCore::MeshInfo info(getKernel());
     info.TopologyInformation(str);
     return str.str();
 }
 
 unsigned long MeshObject::countPoints() const
 {
-    return _kernel.CountPoints();
+    return getKernel().CountPoints();
 }
 
 unsigned long MeshObject::countFacets() const
 {
-    return _kernel.CountFacets();
+    return getKernel().CountFacets();
 }
 
 unsigned long MeshObject::countEdges () const
 {
-    return _kernel.CountEdges();
+    return getKernel().CountEdges();
 }
 
 unsigned long MeshObject::countSegments () const
@@ -274,23 +293,23 @@ unsigned long MeshObject::countSegments () const
 
 bool MeshObject::isSolid() const
 {
-    MeshCore::MeshEvalSolid cMeshEval(_kernel);
+    MeshCore::MeshEvalSolid cMeshEval(getKernel());
     return cMeshEval.Evaluate();
 }
 
 double MeshObject::getSurface() const
 {
-    return _kernel.GetSurface();
+    return getKernel().GetSurface();
 }
 
 double MeshObject::getVolume() const
 {
-    return _kernel.GetVolume();
+    return getKernel().GetVolume();
 }
 
 Base::Vector3d MeshObject::getPoint(PointIndex index) const
 {
-    Base::Vector3f vertf = _kernel.GetPoint(index);
+    Base::Vector3f vertf = getKernel().GetPoint(index);
     Base::Vector3d vertd(vertf.x, vertf.y, vertf.z);
     vertd = _Mtrx * vertd;
     return vertd;
@@ -306,28 +325,28 @@ void MeshObject::getPoints(std::vector<Base::Vector3d> &Points,
                            std::vector<Base::Vector3d> &Normals,
                            double /*Accuracy*/, uint16_t /*flags*/) const
 {
-    Points = transformPointsToOutside(_kernel.GetPoints());
-    MeshCore::MeshRefNormalToPoints ptNormals(_kernel);
+    Points = transformPointsToOutside(getKernel().GetPoints());
+    MeshCore::MeshRefNormalToPoints ptNormals(getKernel());
     Normals = transformVectorsToOutside(ptNormals.GetValues());
 }
 
 Mesh::Facet MeshObject::getMeshFacet(FacetIndex index) const
 {
-    Mesh::Facet face(_kernel.GetFacets()[index], this, index);
+    Mesh::Facet face(getKernel().GetFacets()[index], this, index);
     return face;
 }
 
 void MeshObject::getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet> &Topo,
                           double /*Accuracy*/, uint16_t /*flags*/) const
 {
-    unsigned long ctpoints = _kernel.CountPoints();
+    unsigned long ctpoints = getKernel().CountPoints();
     Points.reserve(ctpoints);
     for (unsigned long i=0; i<ctpoints; i++) {
         Points.push_back(getPoint(i));
     }
 
-    unsigned long ctfacets = _kernel.CountFacets();
-    const MeshCore::MeshFacetArray& ary = _kernel.GetFacets();
+    unsigned long ctfacets = getKernel().CountFacets();
+    const MeshCore::MeshFacetArray& ary = getKernel().GetFacets();
     Topo.reserve(ctfacets);
     for (unsigned long i=0; i<ctfacets; i++) {
         Facet face;
@@ -340,7 +359,7 @@ void MeshObject::getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet>
 
 unsigned int MeshObject::getMemSize () const
 {
-    return _kernel.GetMemSize();
+    return getKernel().GetMemSize();
 }
 
 void MeshObject::Save (Base::Writer &/*writer*/) const
@@ -350,7 +369,10 @@ void MeshObject::Save (Base::Writer &/*writer*/) const
 
 void MeshObject::SaveDocFile (Base::Writer &writer) const
 {
-    _kernel.Write(writer.Stream());
+    if (writer.getMode("CompactMesh"))
+        saveCompact(writer.Stream());
+    else
+        save(writer.Stream());
 }
 
 void MeshObject::Restore(Base::XMLReader &/*reader*/)
@@ -367,7 +389,7 @@ void MeshObject::save(const char* file, MeshCore::MeshIO::Format f,
                       const MeshCore::Material* mat,
                       const char* objectname) const
 {
-    MeshCore::MeshOutput aWriter(this->_kernel, mat);
+    MeshCore::MeshOutput aWriter(getKernel(), mat);
     if (objectname)
         aWriter.SetObjectName(objectname);
 
@@ -396,7 +418,7 @@ void MeshObject::save(std::ostream& str, MeshCore::MeshIO::Format f,
                       const MeshCore::Material* mat,
                       const char* objectname) const
 {
-    MeshCore::MeshOutput aWriter(this->_kernel, mat);
+    MeshCore::MeshOutput aWriter(getKernel(), mat);
     if (objectname)
         aWriter.SetObjectName(objectname);
 
@@ -442,12 +464,12 @@ bool MeshObject::load(std::istream& str, MeshCore::MeshIO::Format f, MeshCore::M
 void MeshObject::swapKernel(MeshCore::MeshKernel& kernel,
                             const std::vector<std::string>& g)
 {
-    _kernel.Swap(kernel);
+    replaceKernel().Swap(kernel);
     // Some file formats define several objects per file (e.g. OBJ).
     // Now we mark each object as an own segment so that we can break
     // the object into its original objects again.
     this->_segments.clear();
-    const MeshCore::MeshFacetArray& faces = _kernel.GetFacets();
+    const MeshCore::MeshFacetArray& faces = getKernel().GetFacets();
     MeshCore::MeshFacetArray::_TConstIterator it;
     std::vector<FacetIndex> segment;
     segment.reserve(faces.size());
@@ -480,14 +502,14 @@ void MeshObject::swapKernel(MeshCore::MeshKernel& kernel,
 #if 0
 #ifndef FC_DEBUG
     try {
-        MeshCore::MeshEvalNeighbourhood nb(_kernel);
+        MeshCore::MeshEvalNeighbourhood nb(getKernel());
         if (!nb.Evaluate()) {
             Base::Console().Warning("Errors in neighbourhood of mesh found...");
-            _kernel.RebuildNeighbours();
+            getKernel().RebuildNeighbours();
             Base::Console().Warning("fixed\n");
         }
 
-        MeshCore::MeshEvalTopology eval(_kernel);
+        MeshCore::MeshEvalTopology eval(getKernel());
         if (!eval.Evaluate()) {
             Base::Console().Warning("The mesh data structure has some defects\n");
         }
@@ -502,24 +524,52 @@ void MeshObject::swapKernel(MeshCore::MeshKernel& kernel,
 
 void MeshObject::save(std::ostream& out) const
 {
-    _kernel.Write(out);
+    getKernel().Write(out);
+}
+
+void MeshObject::saveCompact(std::ostream& out) const
+{
+    // the segments are saved as mesh groups
+    std::vector<MeshCore::Group> groups;
+    for (const auto& it : this->_segments) {
+        if (!it.isEmpty()) {
+            MeshCore::Group g;
+            g.indices = it.getIndices();
+            g.name = it.getName();
+            groups.push_back(g);
+        }
+    }
+
+    MeshCore::WriterBMS writer(getKernel());
+    writer.SetGroups(groups);
+    writer.Save(out);
 }
 
 void MeshObject::load(std::istream& in)
 {
-    _kernel.Read(in);
+    MeshCore::ReaderBMS reader(replaceKernel());
+    reader.Load(in);
     this->_segments.clear();
+    for (const auto& it : reader.GetGroups()) {
+        this->_segments.emplace_back(this, it.indices, true);
+        this->_segments.back().setName(it.name);
+    }
+
+    // the compact format is written from a consistent kernel
+    // with its neighbourhood, so there is nothing to check
+    if (reader.IsCompact())
+        return;
 
 #ifndef FC_DEBUG
     try {
-        MeshCore::MeshEvalNeighbourhood nb(_kernel);
+        MeshCore::MeshEvalNeighbourhood nb(getKernel());
         if (!nb.Evaluate()) {
             Base::Console().Warning("Errors in neighbourhood of mesh found...");
-            _kernel.RebuildNeighbours();
+            getKernel().RebuildNeighbours();
             Base::Console().Warning("fixed\n");
         }
 
-        MeshCore::MeshEvalTopology eval(_kernel);
+        MeshCore::MeshEvalTopology eval(getKernel());
         if (!eval.Evaluate()) {
             Base::Console().Warning("The mesh data structure has some defects\n");
         }
@@ -563,25 +613,25 @@ void MeshObject::writeInventor(std::ostream& str, float creaseangle) const
 
 void MeshObject::addFacet(const MeshCore::MeshGeomFacet& facet)
 {
-    _kernel.AddFacet(facet);
+    getKernel().AddFacet(facet);
 }
 
 void MeshObject::addFacets(const std::vector<MeshCore::MeshGeomFacet>& facets)
 {
-    _kernel.AddFacets(facets);
+    getKernel().AddFacets(facets);
 }
 
 void MeshObject::addFacets(const std::vector<MeshCore::MeshFacet> &facets,
                            bool checkManifolds)
 {
-    _kernel.AddFacets(facets, checkManifolds);
+    getKernel().AddFacets(facets, checkManifolds);
 }
 
 void MeshObject::addFacets(const std::vector<MeshCore::MeshFacet> &facets,
                            const std::vector<Base::Vector3f>& points,
                            bool checkManifolds)
 {
-    _kernel.AddFacets(facets, points, checkManifolds);
+    getKernel().AddFacets(facets, points, checkManifolds);
 }
 
 void MeshObject::addFacets(const std::vector<Data::ComplexGeoData::Facet> &facets,
@@ -605,12 +655,12 @@ void MeshObject::addFacets(const std::vector<Data::ComplexGeoData::Facet> &facet
         point_v.push_back(p);
     }
 
-    _kernel.AddFacets(facet_v, point_v, checkManifolds);
+    getKernel().AddFacets(facet_v, point_v, checkManifolds);
 }
 
 void MeshObject::setFacets(const std::vector<MeshCore::MeshGeomFacet>& facets)
 {
-    _kernel = facets;
+    replaceKernel() = facets;
 }
 
 void MeshObject::setFacets(const std::vector<Data::ComplexGeoData::Facet> &facets,
@@ -633,24 +683,24 @@ void MeshObject::setFacets(const std::vector<Data::ComplexGeoData::Facet> &facet
         point_v.push_back(p);
     }
 
-    _kernel.Adopt(point_v, facet_v, true);
+    replaceKernel().Adopt(point_v, facet_v, true);
 }
 
 void MeshObject::addMesh(const MeshObject& mesh)
 {
-    _kernel.Merge(mesh._kernel);
+    getKernel().Merge(mesh.getKernel());
 }
 
 void MeshObject::addMesh(const MeshCore::MeshKernel& kernel)
 {
-    _kernel.Merge(kernel);
+    getKernel().Merge(kernel);
 }
 
 void MeshObject::deleteFacets(const std::vector<FacetIndex>& removeIndices)
 {
     if (removeIndices.empty())
         return;
-    _kernel.DeleteFacets(removeIndices);
+    getKernel().DeleteFacets(removeIndices);
     deletedFacets(removeIndices);
 }
 
@@ -658,7 +708,7 @@ void MeshObject::deletePoints(const std::vector<PointIndex>& removeIndices)
 {
     if (removeIndices.empty())
         return;
-    _kernel.DeletePoints(removeIndices);
+    getKernel().DeletePoints(removeIndices);
     this->_segments.clear();
 }
 
@@ -669,7 +719,7 @@ void MeshObject::deletedFacets(const std::vector<FacetIndex>& remFacets)
     if (this->_segments.empty())
         return; // nothing to do
     // set an array with the original indices and mark the removed as MeshCore::FACET_INDEX_MAX
-    std::vector<FacetIndex> f_indices(_kernel.CountFacets()+remFacets.size());
+    std::vector<FacetIndex> f_indices(getKernel().CountFacets()+remFacets.size());
     for (std::vector<FacetIndex>::const_iterator it = remFacets.begin();
         it != remFacets.end(); ++it) {
         f_indices[*it] = MeshCore::FACET_INDEX_MAX;
@@ -706,60 +756,66 @@ void MeshObject::deletedFacets(const std::vector<FacetIndex>& remFacets)
 void MeshObject::deleteSelectedFacets()
 {
     std::vector<FacetIndex> facets;
-    MeshCore::MeshAlgorithm(this->_kernel).GetFacetsFlag(facets, MeshCore::MeshFacet::SELECTED);
+    MeshCore::MeshAlgorithm(getKernel()).GetFacetsFlag(facets, MeshCore::MeshFacet::SELECTED);
     deleteFacets(facets);
 }
 
 void MeshObject::deleteSelectedPoints()
 {
     std::vector<PointIndex> points;
-    MeshCore::MeshAlgorithm(this->_kernel).GetPointsFlag(points, MeshCore::MeshPoint::SELECTED);
+    MeshCore::MeshAlgorithm(getKernel()).GetPointsFlag(points, MeshCore::MeshPoint::SELECTED);
     deletePoints(points);
 }
 
 void MeshObject::clearFacetSelection() const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).ResetFacetFlag(MeshCore::MeshFacet::SELECTED);
+    detach();
+    MeshCore::MeshAlgorithm(getKernel()).ResetFacetFlag(MeshCore::MeshFacet::SELECTED);
 }
 
 void MeshObject::clearPointSelection() const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).ResetPointFlag(MeshCore::MeshPoint::SELECTED);
+    detach();
+    MeshCore::MeshAlgorithm(getKernel()).ResetPointFlag(MeshCore::MeshPoint::SELECTED);
 }
 
 void MeshObject::addFacetsToSelection(const std::vector<FacetIndex>& inds) const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).SetFacetsFlag(inds, MeshCore::MeshFacet::SELECTED);
+    detach();
+    MeshCore::MeshAlgorithm(getKernel()).SetFacetsFlag(inds, MeshCore::MeshFacet::SELECTED);
 }
 
 void MeshObject::addPointsToSelection(const std::vector<PointIndex>& inds) const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).SetPointsFlag(inds, MeshCore::MeshPoint::SELECTED);
+    detach();
+    MeshCore::MeshAlgorithm(getKernel()).SetPointsFlag(inds, MeshCore::MeshPoint::SELECTED);
 }
 
 void MeshObject::removeFacetsFromSelection(const std::vector<FacetIndex>& inds) const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).ResetFacetsFlag(inds, MeshCore::MeshFacet::SELECTED);
+    detach();
+    MeshCore::MeshAlgorithm(getKernel()).ResetFacetsFlag(inds, MeshCore::MeshFacet::SELECTED);
 }
 
 void MeshObject::removePointsFromSelection(const std::vector<PointIndex>& inds) const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).ResetPointsFlag(inds, MeshCore::MeshPoint::SELECTED);
+    detach();
+    MeshCore::MeshAlgorithm(getKernel()).ResetPointsFlag(inds, MeshCore::MeshPoint::SELECTED);
 }
 
 void MeshObject::getFacetsFromSelection(std::vector<FacetIndex>& inds) const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).GetFacetsFlag(inds, MeshCore::MeshFacet::SELECTED);
+    MeshCore::MeshAlgorithm(getKernel()).GetFacetsFlag(inds, MeshCore::MeshFacet::SELECTED);
 }
 
 void MeshObject::getPointsFromSelection(std::vector<PointIndex>& inds) const
 {
-    MeshCore::MeshAlgorithm(this->_kernel).GetPointsFlag(inds, MeshCore::MeshPoint::SELECTED);
+    MeshCore::MeshAlgorithm(getKernel()).GetPointsFlag(inds, MeshCore::MeshPoint::SELECTED);
 }
 
 unsigned long MeshObject::countSelectedFacets() const
 {
-    return MeshCore::MeshAlgorithm(this->_kernel).CountFacetFlag(MeshCore::MeshFacet::SELECTED);
+    return MeshCore::MeshAlgorithm(getKernel()).CountFacetFlag(MeshCore::MeshFacet::SELECTED);
 }
 
 bool MeshObject::hasSelectedFacets() const
@@ -769,7 +825,7 @@ bool MeshObject::hasSelectedFacets() const
 
 unsigned long MeshObject::countSelectedPoints() const
 {
-    return MeshCore::MeshAlgorithm(this->_kernel).CountPointFlag(MeshCore::MeshPoint::SELECTED);
+    return MeshCore::MeshAlgorithm(getKernel()).CountPointFlag(MeshCore::MeshPoint::SELECTED);
 }
 
 bool MeshObject::hasSelectedPoints() const
@@ -779,7 +835,7 @@ bool MeshObject::hasSelectedPoints() const
 
 std::vector<PointIndex> MeshObject::getPointsFromFacets(const std::vector<FacetIndex>& facets) const
 {
-    return _kernel.GetFacetPoints(facets);
+    return getKernel().GetFacetPoints(facets);
 }
 
 bool MeshObject::nearestFacetOnRay(const MeshObject::TRay& ray, double maxAngle, MeshObject::TFaceSection& output) const
@@ -808,6 +864,43 @@ bool MeshObject::nearestFacetOnRay(const MeshObject::TRay& ray, double maxAngle,
     return false;
 }
 
+std::vector<MeshObject::TFaceSection> MeshObject::nearestFacetsOnRays(const std::vector<TRay>& rays, double maxAngle) const
+{
+    Base::Placement plm = getPlacement();
+    Base::Placement inv = plm.inverse();
+
+    // transform the rays relative to the mesh kernel
+    std::vector<Base::Vector3f> pnts, dirs;
+    pnts.reserve(rays.size());
+    dirs.reserve(rays.size());
+    for (const auto& it : rays) {
+        Base::Vector3f pnt = Base::toVector<float>(it.first);
+        Base::Vector3f dir = Base::toVector<float>(it.second);
+        inv.multVec(pnt, pnt);
+        inv.getRotation().multVec(dir, dir);
+        pnts.push_back(pnt);
+        dirs.push_back(dir);
+    }
+
+    std::vector<MeshCore::MeshFacetBVH::RayHit> hits;
+    MeshCore::MeshAlgorithm alg(getKernel());
+    alg.NearestFacetsOnRays(pnts, dirs, static_cast<float>(maxAngle), hits);
+
+    std::vector<MeshObject::TFaceSection> output(hits.size());
+    for (std::size_t i = 0; i < hits.size(); i++) {
+        output[i].first = hits[i].facet;
+        if (hits[i].facet != MeshCore::FACET_INDEX_MAX) {
+            Base::Vector3f dir = dirs[i];
+            dir.Normalize();
+            Base::Vector3f res = pnts[i] + dir * hits[i].distance;
+            plm.multVec(res, res);
+            output[i].second = Base::toVector<double>(res);
+        }
+    }
+
+    return output;
+}
+
 std::vector<MeshObject::TFaceSection> MeshObject::foraminate(const TRay& ray, double maxAngle) const
 {
     Base::Vector3f pnt = Base::toVector<float>(ray.first);
@@ -841,23 +934,25 @@ std::vector<MeshObject::TFaceSection> MeshObject::foraminate(const TRay& ray, do
 
 void MeshObject::updateMesh(const std::vector<FacetIndex>& facets) const
 {
+    detach();
     std::vector<PointIndex> points;
-    points = _kernel.GetFacetPoints(facets);
+    points = getKernel().GetFacetPoints(facets);
 
-    MeshCore::MeshAlgorithm alg(_kernel);
+    MeshCore::MeshAlgorithm alg(getKernel());
     alg.SetFacetsFlag(facets, MeshCore::MeshFacet::SEGMENT);
     alg.SetPointsFlag(points, MeshCore::MeshPoint::SEGMENT);
 }
 
 void MeshObject::updateMesh() const
 {
-    MeshCore::MeshAlgorithm alg(_kernel);
+    detach();
+    MeshCore::MeshAlgorithm alg(getKernel());
     alg.ResetFacetFlag(MeshCore::MeshFacet::SEGMENT);
     alg.ResetPointFlag(MeshCore::MeshPoint::SEGMENT);
     for (std::vector<Segment>::const_iterator it = this->_segments.begin();
         it != this->_segments.end(); ++it) {
             std::vector<PointIndex> points;
-            points = _kernel.GetFacetPoints(it->getIndices());
+            points = getKernel().GetFacetPoints(it->getIndices());
             alg.SetFacetsFlag(it->getIndices(), MeshCore::MeshFacet::SEGMENT);
             alg.SetPointsFlag(points, MeshCore::MeshPoint::SEGMENT);
     }
@@ -866,7 +961,7 @@ void MeshObject::updateMesh() const
 std::vector<std::vector<FacetIndex> > MeshObject::getComponents() const
 {
     std::vector<std::vector<FacetIndex> > segments;
-    MeshCore::MeshComponents comp(_kernel);
+    MeshCore::MeshComponents comp(getKernel());
     comp.SearchForComponents(MeshCore::MeshComponents::OverEdge,segments);
     return segments;
 }
@@ -874,7 +969,7 @@ std::vector<std::vector<FacetIndex> > MeshObject::getComponents() const
 unsigned long MeshObject::countComponents() const
 {
     std::vector<std::vector<FacetIndex> > segments;
-    MeshCore::MeshComponents comp(_kernel);
+    MeshCore::MeshComponents comp(getKernel());
     comp.SearchForComponents(MeshCore::MeshComponents::OverEdge,segments);
     return segments.size();
 }
@@ -882,16 +977,16 @@ unsigned long MeshObject::countComponents() const
 void MeshObject::removeComponents(unsigned long count)
 {
     std::vector<FacetIndex> removeIndices;
-    MeshCore::MeshTopoAlgorithm(_kernel).FindComponents(count, removeIndices);
-    _kernel.DeleteFacets(removeIndices);
+    MeshCore::MeshTopoAlgorithm(getKernel()).FindComponents(count, removeIndices);
+    getKernel().DeleteFacets(removeIndices);
     deletedFacets(removeIndices);
 }
 
 unsigned long MeshObject::getPointDegree(const std::vector<FacetIndex>& indices,
                                          std::vector<PointIndex>& point_degree) const
 {
-    const MeshCore::MeshFacetArray& faces = _kernel.GetFacets();
-    std::vector<PointIndex> pointDeg(_kernel.CountPoints());
+    const MeshCore::MeshFacetArray& faces = getKernel().GetFacets();
+    std::vector<PointIndex> pointDeg(getKernel().CountPoints());
 
     for (MeshCore::MeshFacetArray::_TConstIterator it = faces.begin(); it != faces.end(); ++it) {
         pointDeg[it->_aulPoints[0]]++;
@@ -918,30 +1013,30 @@ void MeshObject::fillupHoles(unsigned long length, int level,
                              MeshCore::AbstractPolygonTriangulator& cTria)
 {
     std::list<std::vector<PointIndex> > aFailed;
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.FillupHoles(length, level, cTria, aFailed);
 }
 
 void MeshObject::offset(float fSize)
 {
-    std::vector<Base::Vector3f> normals = _kernel.CalcVertexNormals();
+    std::vector<Base::Vector3f> normals = getKernel().CalcVertexNormals();
 
     unsigned int i = 0;
     // go through all the vertex normals
     for (std::vector<Base::Vector3f>::iterator It= normals.begin();It != normals.end();++It,i++)
         // and move each mesh point in the normal direction
-        _kernel.MovePoint(i,It->Normalize() * fSize);
-    _kernel.RecalcBoundBox();
+        getKernel().MovePoint(i,It->Normalize() * fSize);
+    getKernel().RecalcBoundBox();
 }
 
 void MeshObject::offsetSpecial2(float fSize)
 {
     Base::Builder3D builder;
-    std::vector<Base::Vector3f> PointNormals= _kernel.CalcVertexNormals();
+    std::vector<Base::Vector3f> PointNormals= getKernel().CalcVertexNormals();
     std::vector<Base::Vector3f> FaceNormals;
     std::set<FacetIndex> fliped;
 
-    MeshCore::MeshFacetIterator it(_kernel);
+    MeshCore::MeshFacetIterator it(getKernel());
     for (it.Init(); it.More(); it.Next())
         FaceNormals.push_back(it->GetNormal().Normalize());
 
@@ -949,15 +1044,15 @@ void MeshObject::offsetSpecial2(float fSize)
 
     // go through all the vertex normals
     for (std::vector<Base::Vector3f>::iterator It= PointNormals.begin();It != PointNormals.end();++It,i++) {
-        Base::Line3f line{_kernel.GetPoint(i), _kernel.GetPoint(i) + It->Normalize() * fSize};
+        Base::Line3f line{getKernel().GetPoint(i), getKernel().GetPoint(i) + It->Normalize() * fSize};
         Base::DrawStyle drawStyle;
         builder.addSingleLine(line, drawStyle);
         // and move each mesh point in the normal direction
-        _kernel.MovePoint(i,It->Normalize() * fSize);
+        getKernel().MovePoint(i,It->Normalize() * fSize);
     }
-    _kernel.RecalcBoundBox();
+    getKernel().RecalcBoundBox();
 
-    MeshCore::MeshTopoAlgorithm alg(_kernel);
+    MeshCore::MeshTopoAlgorithm alg(getKernel());
 
     for (int l= 0; l<1 ;l++) {
         for ( it.Init(),i=0; it.More(); it.Next(),i++) {
@@ -987,7 +1082,7 @@ void MeshObject::offsetSpecial2(float fSize)
     alg.Cleanup();
 
     // search for intersected facets
-    MeshCore::MeshEvalSelfIntersection eval(_kernel);
+    MeshCore::MeshEvalSelfIntersection eval(getKernel());
     std::vector<std::pair<FacetIndex, FacetIndex> > faces;
     eval.GetIntersections(faces);
     builder.saveToLog();
@@ -995,40 +1090,40 @@ void MeshObject::offsetSpecial2(float fSize)
 
 void MeshObject::offsetSpecial(float fSize, float zmax, float zmin)
 {
-    std::vector<Base::Vector3f> normals = _kernel.CalcVertexNormals();
+    std::vector<Base::Vector3f> normals = getKernel().CalcVertexNormals();
 
     unsigned int i = 0;
     // go through all the vertex normals
     for (std::vector<Base::Vector3f>::iterator It= normals.begin();It != normals.end();++It,i++) {
-        Base::Vector3f Pnt = _kernel.GetPoint(i);
+        Base::Vector3f Pnt = getKernel().GetPoint(i);
         if (Pnt.z < zmax && Pnt.z > zmin) {
             Pnt.z = 0;
-            _kernel.MovePoint(i,Pnt.Normalize() * fSize);
+            getKernel().MovePoint(i,Pnt.Normalize() * fSize);
         }
         else {
             // and move each mesh point in the normal direction
-            _kernel.MovePoint(i,It->Normalize() * fSize);
+            getKernel().MovePoint(i,It->Normalize() * fSize);
         }
     }
 }
 
 void MeshObject::clear()
 {
-    _kernel.Clear();
+    replaceKernel().Clear();
     this->_segments.clear();
     setTransform(Base::Matrix4D());
 }
 
 void MeshObject::transformToEigenSystem()
 {
-    MeshCore::MeshEigensystem cMeshEval(_kernel);
+    MeshCore::MeshEigensystem cMeshEval(getKernel());
     cMeshEval.Evaluate();
     this->setTransform(cMeshEval.Transform());
 }
 
 Base::Matrix4D MeshObject::getEigenSystem(Base::Vector3d& v) const
 {
-    MeshCore::MeshEigensystem cMeshEval(_kernel);
+    MeshCore::MeshEigensystem cMeshEval(getKernel());
     cMeshEval.Evaluate();
     Base::Vector3f uvw = cMeshEval.GetBoundings();
     v.Set(uvw.x, uvw.y, uvw.z);
@@ -1043,34 +1138,40 @@ void MeshObject::movePoint(PointIndex index, const Base::Vector3d& v)
     vec.x += _Mtrx[0][3];
     vec.y += _Mtrx[1][3];
     vec.z += _Mtrx[2][3];
-    _kernel.MovePoint(index, transformPointToInside(vec));
+    getKernel().MovePoint(index, transformPointToInside(vec));
 }
 
 void MeshObject::setPoint(PointIndex index, const Base::Vector3d& p)
 {
-    _kernel.SetPoint(index, transformPointToInside(p));
+    getKernel().SetPoint(index, transformPointToInside(p));
 }
 
 void MeshObject::smooth(int iterations, float d_max)
 {
-    _kernel.Smooth(iterations, d_max);
+    getKernel().Smooth(iterations, d_max);
 }
 
 void MeshObject::decimate(float fTolerance, float fReduction)
 {
-    MeshCore::MeshSimplify dm(this->_kernel);
+    MeshCore::MeshSimplify dm(getKernel());
     dm.simplify(fTolerance, fReduction);
 }
 
 void MeshObject::decimate(int targetSize)
 {
-    MeshCore::MeshSimplify dm(this->_kernel);
+    MeshCore::MeshSimplify dm(getKernel());
     dm.simplify(targetSize);
 }
 
+void MeshObject::decimate(int targetSize, float maxError)
+{
+    MeshCore::MeshSimplify dm(getKernel());
+    dm.simplify(targetSize, maxError);
+}
+
 Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
 {
-    std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
+    std::vector<Base::Vector3f> temp = getKernel().CalcVertexNormals();
     Base::Vector3d normal = transformVectorToOutside(temp[index]);
     normal.Normalize();
     return normal;
@@ -1078,7 +1179,7 @@ Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
 
 std::vector<Base::Vector3d> MeshObject::getPointNormals() const
 {
-    std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
+    std::vector<Base::Vector3f> temp = getKernel().CalcVertexNormals();
 
     std::vector<Base::Vector3d> normals = transformVectorsToOutside(temp);
     for (auto& n : normals) {
@@ -1090,7 +1191,7 @@ std::vector<Base::Vector3d> MeshObject::getPointNormals() const
 void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes, std::vector<MeshObject::TPolylines> &sections,
                                float fMinEps, bool bConnectPolygons) const
 {
-    MeshCore::MeshKernel kernel(this->_kernel);
+    MeshCore::MeshKernel kernel(getKernel());
     kernel.Transform(this->_Mtrx);
 
     MeshCore::MeshFacetGrid grid(kernel);
@@ -1102,10 +1203,36 @@ void MeshObject::crossSections(const std::vector<MeshObject::TPlane>& planes, st
     }
 }
 
+void MeshObject::slices(const Base::Vector3f& normal, const std::vector<float>& distances,
+                        std::vector<MeshObject::TPolylines> &sections) const
+{
+    // avoid to copy the kernel if it's not transformed
+    const MeshCore::MeshKernel* kernel = this->_kernel.get();
+    MeshCore::MeshKernel transformed;
+    if (this->_Mtrx != Base::Matrix4D()) {
+        transformed = getKernel();
+        transformed.Transform(this->_Mtrx);
+        kernel = &transformed;
+    }
+
+    MeshCore::MeshSlicer::Layers layers;
+    MeshCore::MeshSlicer slicer(*kernel);
+    slicer.Slice(normal, distances, layers);
+
+    sections.resize(layers.CountLayers());
+    for (std::size_t i = 0; i < layers.CountLayers(); i++) {
+        for (std::size_t j = layers.layers[i]; j < layers.layers[i + 1]; j++) {
+            auto first = layers.points.begin() + layers.polylines[j];
+            auto last = layers.points.begin() + layers.polylines[j + 1];
+            sections[i].emplace_back(first, last);
+        }
+    }
+}
+
 void MeshObject::cut(const Base::Polygon2d& polygon2d,
                      const Base::ViewProjMethod& proj, MeshObject::CutType type)
 {
-    MeshCore::MeshKernel kernel(this->_kernel);
+    MeshCore::MeshKernel kernel(getKernel());
     kernel.Transform(getTransform());
 
     MeshCore::MeshAlgorithm meshAlg(kernel);
@@ -1133,7 +1260,7 @@ void MeshObject::cut(const Base::Polygon2d& polygon2d,
 void MeshObject::trim(const Base::Polygon2d& polygon2d,
                       const Base::ViewProjMethod& proj, MeshObject::CutType type)
 {
-    MeshCore::MeshKernel kernel(this->_kernel);
+    MeshCore::MeshKernel kernel(getKernel());
     kernel.Transform(getTransform());
 
     MeshCore::MeshTrimming trim(kernel, &proj, polygon2d);
@@ -1161,13 +1288,13 @@ void MeshObject::trim(const Base::Polygon2d& polygon2d,
         mat.inverse();
         for (auto& it : triangle)
             it.Transform(mat);
-        this->_kernel.AddFacets(triangle);
+        getKernel().AddFacets(triangle);
     }
 }
 
 void MeshObject::trimByPlane(const Base::Vector3f& base, const Base::Vector3f& normal)
 {
-    MeshCore::MeshTrimByPlane trim(this->_kernel);
+    MeshCore::MeshTrimByPlane trim(getKernel());
     std::vector<FacetIndex> trimFacets, removeFacets;
     std::vector<MeshCore::MeshGeomFacet> triangle;
 
@@ -1179,21 +1306,21 @@ void MeshObject::trimByPlane(const Base::Vector3f& base, const Base::Vector3f& n
     meshPlacement.multVec(base, basePlane);
     meshPlacement.getRotation().multVec(normal, normalPlane);
 
-    MeshCore::MeshFacetGrid meshGrid(this->_kernel);
+    MeshCore::MeshFacetGrid meshGrid(getKernel());
     trim.CheckFacets(meshGrid, basePlane, normalPlane, trimFacets, removeFacets);
     trim.TrimFacets(trimFacets, basePlane, normalPlane, triangle);
     if (!removeFacets.empty())
         this->deleteFacets(removeFacets);
     if (!triangle.empty())
-        this->_kernel.AddFacets(triangle);
+        getKernel().AddFacets(triangle);
 }
 
 MeshObject* MeshObject::unite(const MeshObject& mesh) const
 {
     MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
+    MeshCore::MeshKernel kernel1(getKernel());
     kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
+    MeshCore::MeshKernel kernel2(mesh.getKernel());
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Union, Epsilon);
@@ -1204,9 +1331,9 @@ MeshObject* MeshObject::unite(const MeshObject& mesh) const
 MeshObject* MeshObject::intersect(const MeshObject& mesh) const
 {
     MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
+    MeshCore::MeshKernel kernel1(getKernel());
     kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
+    MeshCore::MeshKernel kernel2(mesh.getKernel());
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Intersect, Epsilon);
@@ -1217,9 +1344,9 @@ MeshObject* MeshObject::intersect(const MeshObject& mesh) const
 MeshObject* MeshObject::subtract(const MeshObject& mesh) const
 {
     MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
+    MeshCore::MeshKernel kernel1(getKernel());
     kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
+    MeshCore::MeshKernel kernel2(mesh.getKernel());
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Difference, Epsilon);
@@ -1230,9 +1357,9 @@ MeshObject* MeshObject::subtract(const MeshObject& mesh) const
 MeshObject* MeshObject::inner(const MeshObject& mesh) const
 {
     MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
+    MeshCore::MeshKernel kernel1(getKernel());
     kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
+    MeshCore::MeshKernel kernel2(mesh.getKernel());
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Inner, Epsilon);
@@ -1243,9 +1370,9 @@ MeshObject* MeshObject::inner(const MeshObject& mesh) const
 MeshObject* MeshObject::outer(const MeshObject& mesh) const
 {
     MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
+    MeshCore::MeshKernel kernel1(getKernel());
     kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
+    MeshCore::MeshKernel kernel2(mesh.getKernel());
     kernel2.Transform(mesh._Mtrx);
     MeshCore::SetOperations setOp(kernel1, kernel2, result,
                                   MeshCore::SetOperations::Outer, Epsilon);
@@ -1256,9 +1383,9 @@ MeshObject* MeshObject::outer(const MeshObject& mesh) const
 std::vector< std::vector<Base::Vector3f> >
 MeshObject::section(const MeshObject& mesh, bool connectLines, float fMinDist) const
 {
-    MeshCore::MeshKernel kernel1(this->_kernel);
+    MeshCore::MeshKernel kernel1(getKernel());
     kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
+    MeshCore::MeshKernel kernel2(mesh.getKernel());
     kernel2.Transform(mesh._Mtrx);
     std::vector< std::vector<Base::Vector3f> > lines;
 
@@ -1293,9 +1420,9 @@ MeshObject::section(const MeshObject& mesh, bool connectLines, float fMinDist) c
 
 void MeshObject::refine()
 {
-    unsigned long cnt = _kernel.CountFacets();
-    MeshCore::MeshFacetIterator cF(_kernel);
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    unsigned long cnt = getKernel().CountFacets();
+    MeshCore::MeshFacetIterator cF(getKernel());
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
 
     // x < 30 deg => cos(x) > sqrt(3)/2 or x > 120 deg => cos(x) < -0.5
     for (unsigned long i=0; i<cnt; i++) {
@@ -1311,22 +1438,22 @@ void MeshObject::refine()
 
 void MeshObject::removeNeedles(float length)
 {
-    unsigned long count = _kernel.CountFacets();
-    MeshCore::MeshRemoveNeedles eval(_kernel, length);
+    unsigned long count = getKernel().CountFacets();
+    MeshCore::MeshRemoveNeedles eval(getKernel(), length);
     eval.Fixup();
-    if (_kernel.CountFacets() < count)
+    if (getKernel().CountFacets() < count)
         this->_segments.clear();
 }
 
 void MeshObject::validateCaps(float fMaxAngle, float fSplitFactor)
 {
-    MeshCore::MeshFixCaps eval(_kernel, fMaxAngle, fSplitFactor);
+    MeshCore::MeshFixCaps eval(getKernel(), fMaxAngle, fSplitFactor);
     eval.Fixup();
 }
 
 void MeshObject::optimizeTopology(float fMaxAngle)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     if (fMaxAngle > 0.0f)
         topalg.OptimizeTopology(fMaxAngle);
     else
@@ -1339,16 +1466,16 @@ void MeshObject::optimizeTopology(float fMaxAngle)
 
 void MeshObject::optimizeEdges()
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.AdjustEdgesToCurvatureDirection();
 }
 
 void MeshObject::splitEdges()
 {
     std::vector<std::pair<FacetIndex, FacetIndex> > adjacentFacet;
-    MeshCore::MeshAlgorithm alg(_kernel);
+    MeshCore::MeshAlgorithm alg(getKernel());
     alg.ResetFacetFlag(MeshCore::MeshFacet::VISIT);
-    const MeshCore::MeshFacetArray& rFacets = _kernel.GetFacets();
+    const MeshCore::MeshFacetArray& rFacets = getKernel().GetFacets();
     for (MeshCore::MeshFacetArray::_TConstIterator pF = rFacets.begin(); pF != rFacets.end(); ++pF) {
         int id=2;
         if (pF->_aulNeighbours[id] != MeshCore::FACET_INDEX_MAX) {
@@ -1361,8 +1488,8 @@ void MeshObject::splitEdges()
         }
     }
 
-    MeshCore::MeshFacetIterator cIter(_kernel);
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshFacetIterator cIter(getKernel());
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     for (std::vector<std::pair<FacetIndex, FacetIndex> >::iterator it = adjacentFacet.begin(); it != adjacentFacet.end(); ++it) {
         cIter.Set(it->first);
         Base::Vector3f mid = 0.5f*(cIter->_aclPoints[0]+cIter->_aclPoints[2]);
@@ -1376,25 +1503,25 @@ void MeshObject::splitEdges()
 
 void MeshObject::splitEdge(FacetIndex facet, FacetIndex neighbour, const Base::Vector3f& v)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.SplitEdge(facet, neighbour, v);
 }
 
 void MeshObject::splitFacet(FacetIndex facet, const Base::Vector3f& v1, const Base::Vector3f& v2)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.SplitFacet(facet, v1, v2);
 }
 
 void MeshObject::swapEdge(FacetIndex facet, FacetIndex neighbour)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.SwapEdge(facet, neighbour);
 }
 
 void MeshObject::collapseEdge(FacetIndex facet, FacetIndex neighbour)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.CollapseEdge(facet, neighbour);
 
     std::vector<FacetIndex> remFacets;
@@ -1405,7 +1532,7 @@ void MeshObject::collapseEdge(FacetIndex facet, FacetIndex neighbour)
 
 void MeshObject::collapseFacet(FacetIndex facet)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.CollapseFacet(facet);
 
     std::vector<FacetIndex> remFacets;
@@ -1415,7 +1542,7 @@ void MeshObject::collapseFacet(FacetIndex facet)
 
 void MeshObject::collapseFacets(const std::vector<FacetIndex>& facets)
 {
-    MeshCore::MeshTopoAlgorithm alg(_kernel);
+    MeshCore::MeshTopoAlgorithm alg(getKernel());
     for (std::vector<FacetIndex>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
         alg.CollapseFacet(*it);
     }
@@ -1425,46 +1552,46 @@ void MeshObject::collapseFacets(const std::vector<FacetIndex>& facets)
 
 void MeshObject::insertVertex(FacetIndex facet, const Base::Vector3f& v)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.InsertVertex(facet, v);
 }
 
 void MeshObject::snapVertex(FacetIndex facet, const Base::Vector3f& v)
 {
-    MeshCore::MeshTopoAlgorithm topalg(_kernel);
+    MeshCore::MeshTopoAlgorithm topalg(getKernel());
     topalg.SnapVertex(facet, v);
 }
 
 unsigned long MeshObject::countNonUniformOrientedFacets() const
 {
-    MeshCore::MeshEvalOrientation cMeshEval(_kernel);
+    MeshCore::MeshEvalOrientation cMeshEval(getKernel());
     std::vector<FacetIndex> inds = cMeshEval.GetIndices();
     return inds.size();
 }
 
 void MeshObject::flipNormals()
 {
-    MeshCore::MeshTopoAlgorithm alg(_kernel);
+    MeshCore::MeshTopoAlgorithm alg(getKernel());
     alg.FlipNormals();
 }
 
 void MeshObject::harmonizeNormals()
 {
-    MeshCore::MeshTopoAlgorithm alg(_kernel);
+    MeshCore::MeshTopoAlgorithm alg(getKernel());
     alg.HarmonizeNormals();
 }
 
 bool MeshObject::hasNonManifolds() const
 {
-    MeshCore::MeshEvalTopology cMeshEval(_kernel);
+    MeshCore::MeshEvalTopology cMeshEval(getKernel());
     return !cMeshEval.Evaluate();
 }
 
 void MeshObject::removeNonManifolds()
 {
-    MeshCore::MeshEvalTopology f_eval(_kernel);
+    MeshCore::MeshEvalTopology f_eval(getKernel());
     if (!f_eval.Evaluate()) {
-        MeshCore::MeshFixTopology f_fix(_kernel, f_eval.GetFacets());
+        MeshCore::MeshFixTopology f_fix(getKernel(), f_eval.GetFacets());
         f_fix.Fixup();
         deletedFacets(f_fix.GetDeletedFaces());
     }
@@ -1472,7 +1599,7 @@ void MeshObject::removeNonManifolds()
 
 void MeshObject::removeNonManifoldPoints()
 {
-    MeshCore::MeshEvalPointManifolds p_eval(_kernel);
+    MeshCore::MeshEvalPointManifolds p_eval(getKernel());
     if (!p_eval.Evaluate()) {
         std::vector<FacetIndex> faces;
         p_eval.GetFacetIndices(faces);
@@ -1482,7 +1609,7 @@ void MeshObject::removeNonManifoldPoints()
 
 bool MeshObject::hasSelfIntersections() const
 {
-    MeshCore::MeshEvalSelfIntersection cMeshEval(_kernel);
+    MeshCore::MeshEvalSelfIntersection cMeshEval(getKernel());
     return !cMeshEval.Evaluate();
 }
 
@@ -1515,11 +1642,11 @@ std::vector<Base::Line3d> MeshObject::getSelfIntersections(const MeshObject::TFa
 void MeshObject::removeSelfIntersections()
 {
     std::vector<std::pair<FacetIndex, FacetIndex> > selfIntersections;
-    MeshCore::MeshEvalSelfIntersection cMeshEval(_kernel);
+    MeshCore::MeshEvalSelfIntersection cMeshEval(getKernel());
     cMeshEval.GetIntersections(selfIntersections);
 
     if (!selfIntersections.empty()) {
-        MeshCore::MeshFixSelfIntersection cMeshFix(_kernel, selfIntersections);
+        MeshCore::MeshFixSelfIntersection cMeshFix(getKernel(), selfIntersections);
         deleteFacets(cMeshFix.GetFacets());
     }
 }
@@ -1529,7 +1656,7 @@ void MeshObject::removeSelfIntersections(const std::vector<FacetIndex>& indices)
     // make sure that the number of indices is even and are in range
     if (indices.size() % 2 != 0)
         return;
-    unsigned long cntfacets = _kernel.CountFacets();
+    unsigned long cntfacets = getKernel().CountFacets();
     if (std::find_if(indices.begin(), indices.end(), [cntfacets](FacetIndex v) {
         return v >= cntfacets;
     }) < indices.end())
@@ -1543,7 +1670,7 @@ void MeshObject::removeSelfIntersections(const std::vector<FacetIndex>& indices)
     }
 
     if (!selfIntersections.empty()) {
-        MeshCore::MeshFixSelfIntersection cMeshFix(_kernel, selfIntersections);
+        MeshCore::MeshFixSelfIntersection cMeshFix(getKernel(), selfIntersections);
         cMeshFix.Fixup();
         this->_segments.clear();
     }
@@ -1552,8 +1679,8 @@ void MeshObject::removeSelfIntersections(const std::vector<FacetIndex>& indices)
 void MeshObject::removeFoldsOnSurface()
 {
     std::vector<FacetIndex> indices;
-    MeshCore::MeshEvalFoldsOnSurface s_eval(_kernel);
-    MeshCore::MeshEvalFoldOversOnSurface f_eval(_kernel);
+    MeshCore::MeshEvalFoldsOnSurface s_eval(getKernel());
+    MeshCore::MeshEvalFoldOversOnSurface f_eval(getKernel());
 
     f_eval.Evaluate();
     std::vector<FacetIndex> inds  = f_eval.GetIndices();
@@ -1571,7 +1698,7 @@ void MeshObject::removeFoldsOnSurface()
 
     // do this as additional check after removing folds on closed area
     for (int i=0; i<5; i++) {
-        MeshCore::MeshEvalFoldsOnBoundary b_eval(_kernel);
+        MeshCore::MeshEvalFoldsOnBoundary b_eval(getKernel());
         if (b_eval.Evaluate())
             break;
         inds = b_eval.GetIndices();
@@ -1583,136 +1710,150 @@ void MeshObject::removeFoldsOnSurface()
 void MeshObject::removeFullBoundaryFacets()
 {
     std::vector<FacetIndex> facets;
-    if (!MeshCore::MeshEvalBorderFacet(_kernel, facets).Evaluate()) {
+    if (!MeshCore::MeshEvalBorderFacet(getKernel(), facets).Evaluate()) {
         deleteFacets(facets);
     }
 }
 
 bool MeshObject::hasInvalidPoints() const
 {
-    MeshCore::MeshEvalNaNPoints nan(_kernel);
+    MeshCore::MeshEvalNaNPoints nan(getKernel());
     return !nan.GetIndices().empty();
 }
 
 void MeshObject::removeInvalidPoints()
 {
-    MeshCore::MeshEvalNaNPoints nan(_kernel);
+    MeshCore::MeshEvalNaNPoints nan(getKernel());
     deletePoints(nan.GetIndices());
 }
 
 bool MeshObject::hasPointsOnEdge() const
 {
-    MeshCore::MeshEvalPointOnEdge nan(_kernel);
+    MeshCore::MeshEvalPointOnEdge nan(getKernel());
     return !nan.Evaluate();
 }
 
 void MeshObject::removePointsOnEdge(bool fillBoundary)
 {
-    MeshCore::MeshFixPointOnEdge nan(_kernel, fillBoundary);
+    MeshCore::MeshFixPointOnEdge nan(getKernel(), fillBoundary);
     nan.Fixup();
 }
 
 void MeshObject::mergeFacets()
 {
-    unsigned long count = _kernel.CountFacets();
-    MeshCore::MeshFixMergeFacets merge(_kernel);
+    unsigned long count = getKernel().CountFacets();
+    MeshCore::MeshFixMergeFacets merge(getKernel());
     merge.Fixup();
-    if (_kernel.CountFacets() < count)
+    if (getKernel().CountFacets() < count)
         this->_segments.clear();
 }
 
 void MeshObject::validateIndices()
 {
-    unsigned long count = _kernel.CountFacets();
+    unsigned long count = getKernel().CountFacets();
 
     // for invalid neighbour indices we don't need to check first
     // but start directly with the validation
-    MeshCore::MeshFixNeighbourhood fix(_kernel);
+    MeshCore::MeshFixNeighbourhood fix(getKernel());
     fix.Fixup();
 
-    MeshCore::MeshEvalRangeFacet rf(_kernel);
+    MeshCore::MeshEvalRangeFacet rf(getKernel());
     if (!rf.Evaluate()) {
-        MeshCore::MeshFixRangeFacet fix(_kernel);
+        MeshCore::MeshFixRangeFacet fix(getKernel());
         fix.Fixup();
     }
 
-    MeshCore::MeshEvalRangePoint rp(_kernel);
+    MeshCore::MeshEvalRangePoint rp(getKernel());
     if (!rp.Evaluate()) {
-        MeshCore::MeshFixRangePoint fix(_kernel);
+        MeshCore::MeshFixRangePoint fix(getKernel());
         fix.Fixup();
     }
 
-    MeshCore::MeshEvalCorruptedFacets cf(_kernel);
+    MeshCore::MeshEvalCorruptedFacets cf(getKernel());
     if (!cf.Evaluate()) {
-        MeshCore::MeshFixCorruptedFacets fix(_kernel);
+        MeshCore::MeshFixCorruptedFacets fix(getKernel());
         fix.Fixup();
     }
 
-    if (_kernel.CountFacets() < count)
+    if (getKernel().CountFacets() < count)
         this->_segments.clear();
 }
 
 bool MeshObject::hasInvalidNeighbourhood() const
 {
-    MeshCore::MeshEvalNeighbourhood eval(_kernel);
+    MeshCore::MeshEvalNeighbourhood eval(getKernel());
     return !eval.Evaluate();
 }
 
 bool MeshObject::hasPointsOutOfRange() const
 {
-    MeshCore::MeshEvalRangePoint eval(_kernel);
+    MeshCore::MeshEvalRangePoint eval(getKernel());
     return !eval.Evaluate();
 }
 
 bool MeshObject::hasFacetsOutOfRange() const
 {
-    MeshCore::MeshEvalRangeFacet eval(_kernel);
+    MeshCore::MeshEvalRangeFacet eval(getKernel());
     return !eval.Evaluate();
 }
 
 bool MeshObject::hasCorruptedFacets() const
 {
-    MeshCore::MeshEvalCorruptedFacets eval(_kernel);
+    MeshCore::MeshEvalCorruptedFacets eval(getKernel());
     return !eval.Evaluate();
 }
 
 void MeshObject::validateDeformations(float fMaxAngle, float fEps)
 {
-    unsigned long count = _kernel.CountFacets();
-    MeshCore::MeshFixDeformedFacets eval(_kernel,
+    unsigned long count = getKernel().CountFacets();
+    MeshCore::MeshFixDeformedFacets eval(getKernel(),
                                          Base::toRadians(15.0f),
                                          Base::toRadians(150.0f),
                                          fMaxAngle, fEps);
     eval.Fixup();
-    if (_kernel.CountFacets() < count)
+    if (getKernel().CountFacets() < count)
         this->_segments.clear();
 }
 
 void MeshObject::validateDegenerations(float fEps)
 {
-    unsigned long count = _kernel.CountFacets();
-    MeshCore::MeshFixDegeneratedFacets eval(_kernel, fEps);
+    unsigned long count = getKernel().CountFacets();
+    MeshCore::MeshFixDegeneratedFacets eval(getKernel(), fEps);
     eval.Fixup();
-    if (_kernel.CountFacets() < count)
+    if (getKernel().CountFacets() < count)
         this->_segments.clear();
 }
 
 void MeshObject::removeDuplicatedPoints()
 {
-    unsigned long count = _kernel.CountFacets();
-    MeshCore::MeshFixDuplicatePoints eval(_kernel);
+    unsigned long count = getKernel().CountFacets();
+    MeshCore::MeshFixDuplicatePoints eval(getKernel());
     eval.Fixup();
-    if (_kernel.CountFacets() < count)
+    if (getKernel().CountFacets() < count)
         this->_segments.clear();
 }
 
 void MeshObject::removeDuplicatedFacets()
 {
-    unsigned long count = _kernel.CountFacets();
-    MeshCore::MeshFixDuplicateFacets eval(_kernel);
+    unsigned long count = getKernel().CountFacets();
+    MeshCore::MeshFixDuplicateFacets eval(getKernel());
     eval.Fixup();
-    if (_kernel.CountFacets() < count)
+    if (getKernel().CountFacets() < count)
+        this->_segments.clear();
+}
+
+MeshCore::MeshValidationPipeline::Report MeshObject::validateAll(bool fix, float fEps, int maxRounds)
+{
+    MeshCore::MeshValidationPipeline pipeline(getKernel());
+    pipeline.SetDegeneratedEpsilon(fEps);
+    pipeline.SetMaxRounds(maxRounds);
+    if (!fix)
+        return pipeline.Evaluate();
+
+    MeshCore::MeshValidationPipeline::Report report = pipeline.Repair();
+    if (report.rounds > 0)
         this->_segments.clear();
+    return report;
 }
 
 MeshObject* MeshObject::createMeshFromList(Py::List& list)
@@ -1955,7 +2096,7 @@ void MeshObject::addSegment(const Segment& s)
 
 void MeshObject::addSegment(const std::vector<FacetIndex>& inds)
 {
-    unsigned long maxIndex = _kernel.CountFacets();
+    unsigned long maxIndex = _kernel->CountFacets();
     for (std::vector<FacetIndex>::const_iterator it = inds.begin(); it != inds.end(); ++it) {
         if (*it >= maxIndex)
             throw Base::IndexError("Index out of range");
@@ -1978,8 +2119,8 @@ MeshObject* MeshObject::meshFromSegment(const std::vector<FacetIndex>& indices)
 {
     MeshCore::MeshFacetArray facets;
     facets.reserve(indices.size());
-    const MeshCore::MeshPointArray& kernel_p = _kernel.GetPoints();
-    const MeshCore::MeshFacetArray& kernel_f = _kernel.GetFacets();
+    const MeshCore::MeshPointArray& kernel_p = getKernel().GetPoints();
+    const MeshCore::MeshFacetArray& kernel_f = getKernel().GetFacets();
     for (std::vector<FacetIndex>::const_iterator it = indices.begin(); it != indices.end(); ++it) {
         facets.push_back(kernel_f[*it]);
     }
@@ -1994,24 +2135,24 @@ std::vector<Segment> MeshObject::getSegmentsOfType(MeshObject::GeometryType type
                                                    float dev, unsigned long minFacets) const
 {
     std::vector<Segment> segm;
-    if (this->_kernel.CountFacets() == 0)
+    if (getKernel().CountFacets() == 0)
         return segm;
 
-    MeshCore::MeshSegmentAlgorithm finder(this->_kernel);
+    MeshCore::MeshSegmentAlgorithm finder(getKernel());
     std::shared_ptr<MeshCore::MeshDistanceSurfaceSegment> surf;
     switch (type) {
     case PLANE:
-        //surf.reset(new MeshCore::MeshDistancePlanarSegment(this->_kernel, minFacets, dev));
+        //surf.reset(new MeshCore::MeshDistancePlanarSegment(getKernel(), minFacets, dev));
         surf.reset(new MeshCore::MeshDistanceGenericSurfaceFitSegment(new MeshCore::PlaneSurfaceFit,
-                   this->_kernel, minFacets, dev));
+                   getKernel(), minFacets, dev));
     break;
     case CYLINDER:
         surf.reset(new MeshCore::MeshDistanceGenericSurfaceFitSegment(new MeshCore::CylinderSurfaceFit,
-                   this->_kernel, minFacets, dev));
+                   getKernel(), minFacets, dev));
         break;
     case SPHERE:
         surf.reset(new MeshCore::MeshDistanceGenericSurfaceFitSegment(new MeshCore::SphereSurfaceFit,
-                   this->_kernel, minFacets, dev));
+                   getKernel(), minFacets, dev));
         break;
     default:
         break;
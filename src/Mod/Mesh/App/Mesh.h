@@ -25,6 +25,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -38,6 +39,7 @@
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
+#include "Core/Validation.h"
 
 #include "Facet.h"
 #include "MeshPoint.h"
@@ -77,8 +79,9 @@ public:
 /**
  * The MeshObject class provides an interface for the underlying MeshKernel class and
  * most of its algorithm on it.
- * @note Each instance of MeshObject has its own instance of a MeshKernel so it's not possible
- * that several instances of MeshObject manage one instance of MeshKernel.
+ * @note Copies of a MeshObject share one instance of MeshKernel until one of them gets modified,
+ * then the modified instance makes its own copy of the kernel (copy-on-write). Thus, a reference
+ * obtained with the non-const getKernel() must not be kept across copying the MeshObject.
  */
 class MeshExport MeshObject : public Data::ComplexGeoData
 {
@@ -155,14 +158,18 @@ public:
         double Accuracy, uint16_t flags=0) const override;
     std::vector<PointIndex> getPointsFromFacets(const std::vector<FacetIndex>& facets) const;
     bool nearestFacetOnRay(const TRay& ray, double maxAngle, TFaceSection& output) const;
+    /** Casts all rays at once, see MeshCore::MeshAlgorithm::NearestFacetsOnRays.
+     * For rays missing the mesh the facet index is MeshCore::FACET_INDEX_MAX.
+     */
+    std::vector<TFaceSection> nearestFacetsOnRays(const std::vector<TRay>& rays, double maxAngle) const;
     std::vector<TFaceSection> foraminate(const TRay& ray, double maxAngle) const;
     //@}
 
     void setKernel(const MeshCore::MeshKernel& m);
     MeshCore::MeshKernel& getKernel()
-    { return _kernel; }
+    { detach(); return *_kernel; }
     const MeshCore::MeshKernel& getKernel() const
-    { return _kernel; }
+    { return *_kernel; }
 
     Base::BoundBox3d getBoundBox() const override;
     bool getCenterOfGravity(Base::Vector3d& center) const override;
@@ -185,6 +192,8 @@ public:
     bool load(std::istream&, MeshCore::MeshIO::Format f, MeshCore::Material* mat = nullptr);
     // Save and load in internal format
     void save(std::ostream&) const;
+    /// Save in the compact internal format that keeps the segments but can't be read by older versions
+    void saveCompact(std::ostream&) const;
     void load(std::istream&);
     void writeInventor(std::ostream& str, float creaseangle=0.0f) const;
     //@}
@@ -242,10 +251,16 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    void decimate(int targetSize, float maxError);
     Base::Vector3d getPointNormal(PointIndex) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&, std::vector<TPolylines> &sections,
                        float fMinEps = 1.0e-2f, bool bConnectPolygons = false) const;
+    /** Cuts the mesh with the parallel planes of normal \a normal and the signed
+     * distances \a distances to the origin, see MeshCore::MeshSlicer.
+     */
+    void slices(const Base::Vector3f& normal, const std::vector<float>& distances,
+                std::vector<TPolylines> &sections) const;
     void cut(const Base::Polygon2d& polygon, const Base::ViewProjMethod& proj, CutType);
     void trim(const Base::Polygon2d& polygon, const Base::ViewProjMethod& proj, CutType);
     void trimByPlane(const Base::Vector3f& base, const Base::Vector3f& normal);
@@ -307,6 +322,10 @@ public:
     void validateDegenerations(float fEps);
     void removeDuplicatedPoints();
     void removeDuplicatedFacets();
+    /** Checks the mesh for all defects at once and repairs them if \a fix is true.
+     * @see MeshCore::MeshValidationPipeline
+     */
+    MeshCore::MeshValidationPipeline::Report validateAll(bool fix, float fEps, int maxRounds);
     bool hasNonManifolds() const;
     bool hasInvalidNeighbourhood() const;
     bool hasPointsOutOfRange() const;
@@ -423,10 +442,12 @@ private:
     void swapKernel(MeshCore::MeshKernel& m, const std::vector<std::string>& g);
     void copySegments(const MeshObject&);
     void swapSegments(MeshObject&);
+    void detach() const;
+    MeshCore::MeshKernel& replaceKernel();
 
 private:
     Base::Matrix4D _Mtrx;
-    MeshCore::MeshKernel _kernel;
+    mutable std::shared_ptr<MeshCore::MeshKernel> _kernel;
     std::vector<Segment> _segments;
     static float Epsilon;
 };
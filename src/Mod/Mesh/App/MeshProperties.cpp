@@ -938,7 +938,11 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
 
 void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 {
-    _meshObject->save(writer.Stream());
+    // older versions can only read the legacy format
+    if (writer.getMode("CompactMesh"))
+        _meshObject->saveCompact(writer.Stream());
+    else
+        _meshObject->save(writer.Stream());
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
@@ -950,7 +954,8 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
 
 App::Property *PropertyMeshKernel::Copy() const
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: Copy the content, do NOT reference the same mesh object.
+    // The mesh objects only share the kernel until one of them gets modified.
     PropertyMeshKernel *prop = new PropertyMeshKernel();
     *(prop->_meshObject) = *(this->_meshObject);
     return prop;
@@ -958,7 +963,8 @@ App::Property *PropertyMeshKernel::Copy() const
 
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: Copy the content, do NOT reference the same mesh object.
+    // The mesh objects only share the kernel until one of them gets modified.
     aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
     *(this->_meshObject) = *(prop._meshObject);
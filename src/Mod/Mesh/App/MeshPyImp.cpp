@@ -21,9 +21,14 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+# include <cfloat>
+# include <functional>
+#endif
 
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/Interpreter.h>
 #include <Base/MatrixPy.h>
 #include <Base/Stream.h>
 #include <Base/Tools.h>
@@ -56,6 +61,35 @@ private:
     PropertyMeshKernel* prop;
 };
 
+/**
+ * Runs \a func on a copy of \a mesh without the GIL and assigns the result to \a mesh.
+ * Other Python threads can use the mesh meanwhile and see its former content.
+ * If one of them modifies the mesh in the meantime, \a func is repeated on the
+ * modified mesh with the GIL held, so that none of the modifications gets lost.
+ */
+template <typename Function>
+static void modifyWithoutGIL(MeshObject* mesh, Function&& func)
+{
+    // 'origin' shares the kernel with 'mesh', so any modification of 'mesh' detaches it
+    const MeshObject origin(*mesh);
+    MeshObject copy(*mesh);
+    // make the private copy of the kernel while holding the GIL
+    copy.getKernel();
+
+    Base::runWithoutGIL([&] {
+        func(copy);
+    });
+
+    const MeshObject& current = *mesh;
+    if (&current.getKernel() == &origin.getKernel() &&
+        current.getTransform() == origin.getTransform()) {
+        mesh->swap(copy);
+    }
+    else {
+        func(*mesh);
+    }
+}
+
 int MeshPy::PyInit(PyObject* args, PyObject*)
 {
     PyObject *pcObj=nullptr;
@@ -397,6 +431,43 @@ PyObject*  MeshPy::crossSections(PyObject *args)
     return Py::new_reference_to(crossSections);
 }
 
+PyObject*  MeshPy::slices(PyObject *args, PyObject *kwds)
+{
+    PyObject *normal;
+    PyObject *dists;
+    static char* keywords[] = {"Normal", "Distances", nullptr};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", keywords, &normal, &dists))
+        return nullptr;
+
+    PY_TRY {
+        Base::Vector3f dir = Base::convertTo<Base::Vector3f>(Py::Vector(normal, false).toVector());
+        Py::Sequence list(dists);
+        std::vector<float> distances;
+        distances.reserve(list.size());
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
+            distances.push_back(static_cast<float>(static_cast<double>(Py::Float(*it))));
+
+        std::vector<MeshObject::TPolylines> sections;
+        Base::runWithoutGIL([&]() {
+            getMeshObjectPtr()->slices(dir, distances, sections);
+        });
+
+        Py::List layers;
+        for (const auto& it : sections) {
+            Py::List section;
+            for (const auto& jt : it) {
+                Py::List polyline;
+                for (const auto& kt : jt)
+                    polyline.append(Py::asObject(new Base::VectorPy(kt)));
+                section.append(polyline);
+            }
+            layers.append(section);
+        }
+
+        return Py::new_reference_to(layers);
+    } PY_CATCH;
+}
+
 PyObject*  MeshPy::unite(PyObject *args)
 {
     MeshPy   *pcObject;
@@ -407,7 +478,9 @@ PyObject*  MeshPy::unite(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = Base::runWithoutGIL([&] {
+            return getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr());
+        });
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -424,7 +497,9 @@ PyObject*  MeshPy::intersect(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = Base::runWithoutGIL([&] {
+            return getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr());
+        });
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -441,7 +516,9 @@ PyObject*  MeshPy::difference(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = Base::runWithoutGIL([&] {
+            return getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr());
+        });
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -458,7 +535,9 @@ PyObject*  MeshPy::inner(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = Base::runWithoutGIL([&] {
+            return getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr());
+        });
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -475,7 +554,9 @@ PyObject*  MeshPy::outer(PyObject *args)
     pcObject = static_cast<MeshPy*>(pcObj);
 
     PY_TRY {
-        MeshObject* mesh = getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh = Base::runWithoutGIL([&] {
+            return getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr());
+        });
         return new MeshPy(mesh);
     } PY_CATCH;
 
@@ -495,7 +576,10 @@ PyObject*  MeshPy::section(PyObject *args, PyObject *kwds)
 
     MeshPy* pcObject = static_cast<MeshPy*>(pcObj);
 
-    std::vector< std::vector<Base::Vector3f> > curves = getMeshObjectPtr()->section(*pcObject->getMeshObjectPtr(), Base::asBoolean(connectLines), fMinDist);
+    bool connect = Base::asBoolean(connectLines);
+    std::vector< std::vector<Base::Vector3f> > curves = Base::runWithoutGIL([&] {
+        return getMeshObjectPtr()->section(*pcObject->getMeshObjectPtr(), connect, fMinDist);
+    });
     Py::List outer;
     for (const auto& it : curves) {
         Py::List inner;
@@ -1011,7 +1095,9 @@ PyObject*  MeshPy::removeNonManifolds(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
-    getMeshObjectPtr()->removeNonManifolds();
+    modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+        mesh.removeNonManifolds();
+    });
     Py_Return;
 }
 
@@ -1019,7 +1105,9 @@ PyObject*  MeshPy::removeNonManifoldPoints(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
-    getMeshObjectPtr()->removeNonManifoldPoints();
+    modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+        mesh.removeNonManifoldPoints();
+    });
     Py_Return;
 }
 
@@ -1027,7 +1115,9 @@ PyObject*  MeshPy::hasSelfIntersections(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
-    bool ok = getMeshObjectPtr()->hasSelfIntersections();
+    bool ok = Base::runWithoutGIL([&] {
+        return getMeshObjectPtr()->hasSelfIntersections();
+    });
     return Py_BuildValue("O", (ok ? Py_True : Py_False));
 }
 
@@ -1039,8 +1129,10 @@ PyObject*  MeshPy::getSelfIntersections(PyObject *args)
     std::vector<std::pair<FacetIndex, FacetIndex> > selfIndices;
     std::vector<Base::Line3d> selfLines;
 
-    selfIndices = getMeshObjectPtr()->getSelfIntersections();
-    selfLines = getMeshObjectPtr()->getSelfIntersections(selfIndices);
+    Base::runWithoutGIL([&] {
+        selfIndices = getMeshObjectPtr()->getSelfIntersections();
+        selfLines = getMeshObjectPtr()->getSelfIntersections(selfIndices);
+    });
 
     Py::Tuple tuple(selfIndices.size());
     if (selfIndices.size() == selfLines.size()) {
@@ -1062,7 +1154,9 @@ PyObject*  MeshPy::fixSelfIntersections(PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
     try {
-        getMeshObjectPtr()->removeSelfIntersections();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.removeSelfIntersections();
+        });
     }
     catch (const Base::Exception& e) {
         e.setPyException();
@@ -1076,7 +1170,9 @@ PyObject*  MeshPy::removeFoldsOnSurface(PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
     try {
-        getMeshObjectPtr()->removeFoldsOnSurface();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.removeFoldsOnSurface();
+        });
     }
     catch (const Base::Exception& e) {
         e.setPyException();
@@ -1098,7 +1194,9 @@ PyObject*  MeshPy::removeInvalidPoints(PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
     try {
-        getMeshObjectPtr()->removeInvalidPoints();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.removeInvalidPoints();
+        });
     }
     catch (const Base::Exception& e) {
         e.setPyException();
@@ -1183,7 +1281,9 @@ PyObject*  MeshPy::harmonizeNormals(PyObject *args)
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->harmonizeNormals();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.harmonizeNormals();
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1206,7 +1306,9 @@ PyObject*  MeshPy::removeComponents(PyObject *args)
 
     PY_TRY {
         if (count > 0) {
-            getMeshObjectPtr()->removeComponents(count);
+            modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+                mesh.removeComponents(count);
+            });
         }
     } PY_CATCH;
 
@@ -1233,7 +1335,9 @@ PyObject*  MeshPy::fillupHoles(PyObject *args)
 
         MeshPropertyLock lock(this->parentProperty);
         tria->SetVerifier(new MeshCore::TriangulationVerifierV2);
-        getMeshObjectPtr()->fillupHoles(len, level, *tria);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.fillupHoles(len, level, *tria);
+        });
     }
     catch (const Base::Exception& e) {
         e.setPyException();
@@ -1249,7 +1353,9 @@ PyObject*  MeshPy::fixIndices(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->validateIndices();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.validateIndices();
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1263,7 +1369,9 @@ PyObject*  MeshPy::fixCaps(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->validateCaps(fMaxAngle, fSplitFactor);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.validateCaps(fMaxAngle, fSplitFactor);
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1277,7 +1385,9 @@ PyObject*  MeshPy::fixDeformations(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->validateDeformations(fMaxAngle, fEpsilon);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.validateDeformations(fMaxAngle, fEpsilon);
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1290,7 +1400,9 @@ PyObject*  MeshPy::fixDegenerations(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->validateDegenerations(fEpsilon);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.validateDegenerations(fEpsilon);
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1302,7 +1414,9 @@ PyObject*  MeshPy::removeDuplicatedPoints(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->removeDuplicatedPoints();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.removeDuplicatedPoints();
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1314,19 +1428,54 @@ PyObject*  MeshPy::removeDuplicatedFacets(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->removeDuplicatedFacets();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.removeDuplicatedFacets();
+        });
     } PY_CATCH;
 
     Py_Return;
 }
 
+PyObject*  MeshPy::validate(PyObject *args, PyObject *kwds)
+{
+    using MeshCore::MeshValidationPipeline;
+
+    PyObject *fix = Py_False;
+    float fEpsilon = MeshCore::MeshDefinitions::_fMinPointDistanceP2;
+    int maxRounds = 10;
+    static char* keywords[] = {"Fix", "Epsilon", "MaxRounds", nullptr};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O!fi", keywords,
+                                     &PyBool_Type, &fix, &fEpsilon, &maxRounds))
+        return nullptr;
+
+    MeshValidationPipeline::Report report;
+    PY_TRY {
+        bool repair = Base::asBoolean(fix);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            report = mesh.validateAll(repair, fEpsilon, maxRounds);
+        });
+    } PY_CATCH;
+
+    Py::Dict dict;
+    for (int i = 0; i < MeshValidationPipeline::CountChecks; i++) {
+        Py::Tuple item(2);
+        item.setItem(0, Py::Long(report.found[i]));
+        item.setItem(1, Py::Long(report.remaining[i]));
+        dict.setItem(MeshValidationPipeline::GetName(MeshValidationPipeline::Check(i)), item);
+    }
+
+    return Py::new_reference_to(dict);
+}
+
 PyObject*  MeshPy::refine(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->refine();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.refine();
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1339,7 +1488,9 @@ PyObject* MeshPy::removeNeedles(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->removeNeedles(length);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.removeNeedles(length);
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1351,7 +1502,9 @@ PyObject* MeshPy::removeFullBoundaryFacets(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->removeFullBoundaryFacets();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.removeFullBoundaryFacets();
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1363,7 +1516,9 @@ PyObject* MeshPy::mergeFacets(PyObject *args)
         return nullptr;
 
     PY_TRY {
-        getMeshObjectPtr()->mergeFacets();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.mergeFacets();
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1377,7 +1532,9 @@ PyObject*  MeshPy::optimizeTopology(PyObject *args)
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->optimizeTopology(fMaxAngle);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.optimizeTopology(fMaxAngle);
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1390,7 +1547,9 @@ PyObject*  MeshPy::optimizeEdges(PyObject *args)
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->optimizeEdges();
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            mesh.optimizeEdges();
+        });
     } PY_CATCH;
 
     Py_Return;
@@ -1759,46 +1918,77 @@ PyObject* MeshPy::smooth(PyObject *args, PyObject *kwds)
         return nullptr;
 
     PY_TRY {
-        MeshPropertyLock lock(this->parentProperty);
-        MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+        // the method is checked before the GIL is released
+        std::function<void(MeshCore::MeshKernel&)> smoothKernel;
         if (strcmp(method, "Laplace") == 0) {
-            MeshCore::LaplaceSmoothing smooth(kernel);
-            if (lambda > 0)
-                smooth.SetLambda(lambda);
-            smooth.Smooth(iter);
+            smoothKernel = [=](MeshCore::MeshKernel& kernel) {
+                MeshCore::LaplaceSmoothing smooth(kernel);
+                if (lambda > 0)
+                    smooth.SetLambda(lambda);
+                smooth.Smooth(iter);
+            };
         }
         else if (strcmp(method, "Taubin") == 0) {
-            MeshCore::TaubinSmoothing smooth(kernel);
-            if (lambda > 0)
-                smooth.SetLambda(lambda);
-            if (micro > 0)
-                smooth.SetMicro(micro);
-            smooth.Smooth(iter);
+            smoothKernel = [=](MeshCore::MeshKernel& kernel) {
+                MeshCore::TaubinSmoothing smooth(kernel);
+                if (lambda > 0)
+                    smooth.SetLambda(lambda);
+                if (micro > 0)
+                    smooth.SetMicro(micro);
+                smooth.Smooth(iter);
+            };
         }
         else if (strcmp(method, "PlaneFit") == 0) {
-            MeshCore::PlaneFitSmoothing smooth(kernel);
-            smooth.SetMaximum(maximum);
-            smooth.Smooth(iter);
+            smoothKernel = [=](MeshCore::MeshKernel& kernel) {
+                MeshCore::PlaneFitSmoothing smooth(kernel);
+                smooth.SetMaximum(maximum);
+                smooth.Smooth(iter);
+            };
         }
         else if (strcmp(method, "MedianFilter") == 0) {
-            MeshCore::MedianFilterSmoothing smooth(kernel);
-            smooth.SetWeight(weight);
-            smooth.Smooth(iter);
+            smoothKernel = [=](MeshCore::MeshKernel& kernel) {
+                MeshCore::MedianFilterSmoothing smooth(kernel);
+                smooth.SetWeight(weight);
+                smooth.Smooth(iter);
+            };
         }
         else {
             throw Py::ValueError("No such smoothing algorithm");
         }
+
+        MeshPropertyLock lock(this->parentProperty);
+        modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+            smoothKernel(mesh.getKernel());
+        });
     } PY_CATCH;
 
     Py_Return;
 }
 
-PyObject*  MeshPy::decimate(PyObject *args)
+PyObject*  MeshPy::decimate(PyObject *args, PyObject *kwds)
 {
+    if (kwds && PyDict_Size(kwds) > 0) {
+        int targetSize;
+        float maxError = FLT_MAX;
+        static char* keywords[] = {"TargetSize", "MaxError", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "i|f", keywords, &targetSize, &maxError))
+            return nullptr;
+
+        PY_TRY {
+            modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+                mesh.decimate(targetSize, maxError);
+            });
+        } PY_CATCH;
+
+        Py_Return;
+    }
+
     float fTol, fRed;
     if (PyArg_ParseTuple(args, "ff", &fTol,&fRed)) {
         PY_TRY {
-            getMeshObjectPtr()->decimate(fTol, fRed);
+            modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+                mesh.decimate(fTol, fRed);
+            });
         } PY_CATCH;
 
         Py_Return;
@@ -1808,13 +1998,16 @@ PyObject*  MeshPy::decimate(PyObject *args)
     int targetSize;
     if (PyArg_ParseTuple(args, "i", &targetSize)) {
         PY_TRY {
-            getMeshObjectPtr()->decimate(targetSize);
+            modifyWithoutGIL(getMeshObjectPtr(), [&](MeshObject& mesh) {
+                mesh.decimate(targetSize);
+            });
         } PY_CATCH;
 
         Py_Return;
     }
 
-    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float), decimate(targetSize=int) "
+                                      "or decimate(TargetSize=int, MaxError=float)");
     return nullptr;
 }
 
@@ -1849,6 +2042,63 @@ PyObject* MeshPy::nearestFacetOnRay(PyObject *args)
     }
 }
 
+PyObject* MeshPy::nearestFacetsOnRays(PyObject *args)
+{
+    PyObject* pnts_p;
+    PyObject* dirs_p;
+    double maxAngle = MeshCore::Mathd::PI;
+    if (!PyArg_ParseTuple(args, "OO|d", &pnts_p, &dirs_p, &maxAngle))
+        return nullptr;
+
+    try {
+        Py::Sequence dirs(dirs_p);
+        std::vector<MeshObject::TRay> rays;
+        rays.reserve(dirs.size());
+        // a vector or a tuple of three floats is a single base point
+        bool single = PyObject_TypeCheck(pnts_p, &(Base::VectorPy::Type));
+        if (!single && PyTuple_Check(pnts_p) && PyTuple_Size(pnts_p) == 3)
+            single = PyNumber_Check(PyTuple_GetItem(pnts_p, 0)) != 0;
+        if (single) {
+            // a common base point for all rays
+            Base::Vector3d pnt = Py::Vector(pnts_p, false).toVector();
+            for (Py::Sequence::iterator it = dirs.begin(); it != dirs.end(); ++it)
+                rays.emplace_back(pnt, Py::Vector(*it, false).toVector());
+        }
+        else {
+            Py::Sequence pnts(pnts_p);
+            if (pnts.size() != dirs.size())
+                throw Py::ValueError("Number of points and directions differ");
+            for (Py::Sequence::size_type i = 0; i < pnts.size(); i++) {
+                rays.emplace_back(Py::Vector(pnts[i], false).toVector(),
+                                  Py::Vector(dirs[i], false).toVector());
+            }
+        }
+
+        std::vector<MeshObject::TFaceSection> output;
+        Base::runWithoutGIL([&]() {
+            output = getMeshObjectPtr()->nearestFacetsOnRays(rays, maxAngle);
+        });
+
+        Py::List list;
+        for (const auto& it : output) {
+            if (it.first == MeshCore::FACET_INDEX_MAX) {
+                list.append(Py::None());
+            }
+            else {
+                Py::Tuple tuple(2);
+                tuple.setItem(0, Py::Long(static_cast<unsigned long>(it.first)));
+                tuple.setItem(1, Py::Vector(it.second));
+                list.append(tuple);
+            }
+        }
+
+        return Py::new_reference_to(list);
+    }
+    catch (const Py::Exception&) {
+        return nullptr;
+    }
+}
+
 PyObject*  MeshPy::getPlanarSegments(PyObject *args)
 {
     float dev;
@@ -10,7 +10,7 @@ import io
 import FreeCAD, unittest, Mesh
 import MeshEnums
 from FreeCAD import Base
-import time, tempfile, math
+import time, tempfile, math, threading, struct, zipfile
 # http://python-kurs.eu/threads.php
 try:
     import _thread as thread
@@ -88,6 +88,53 @@ class MeshTopoTestCases(unittest.TestCase):
         mesh.fixIndices()
         self.assertEqual(mesh.CountFacets, 5)
 
+    def testValidate(self):
+        sphere = Mesh.createSphere(1.0, 20)
+        triangles = [list(f.Points) for f in sphere.Facets]
+        # duplicate a facet and flip another one
+        triangles.append(triangles[5])
+        triangles[10].reverse()
+        mesh = Mesh.Mesh(triangles)
+
+        report = mesh.validate()
+        self.assertEqual(report["DuplicatedFacets"], (1, 1))
+        self.assertGreater(report["WrongOrientation"][0], 0)
+        self.assertEqual(mesh.CountFacets, sphere.CountFacets + 1)
+
+        report = mesh.validate(Fix=True)
+        self.assertEqual(report["DuplicatedFacets"], (1, 0))
+        self.assertEqual(report["WrongOrientation"][1], 0)
+        self.assertFalse(mesh.hasNonUniformOrientedFacets())
+        self.assertEqual(mesh.CountFacets, sphere.CountFacets)
+
+    def testRemoveDuplicates(self):
+        v = FreeCAD.Vector
+        # the points of the shared edge differ by less than the tolerance
+        points = [v(0, 0, 0), v(1, 0, 0), v(0, 1, 0),
+                  v(1.0000001, 0, 0), v(0, 1.0000001, 0), v(1, 1, 0)]
+        facets = [(0, 1, 2), (3, 5, 4), (2, 1, 0)]
+        mesh = Mesh.Mesh((points, facets))
+        self.assertEqual(mesh.CountPoints, 6)
+
+        mesh.removeDuplicatedPoints()
+        self.assertEqual(mesh.CountPoints, 4)
+        self.assertEqual(mesh.CountFacets, 3)
+
+        mesh.removeDuplicatedFacets()
+        self.assertEqual(mesh.CountFacets, 2)
+        self.assertEqual(mesh.Topology[1][0], (0, 1, 2))
+
+    def testFillupHoles(self):
+        sphere = Mesh.createSphere(1.0, 50)
+        mesh = sphere.copy()
+        mesh.removeFacets(list(range(100, mesh.CountFacets - 100, 97)))
+        self.assertFalse(mesh.isSolid())
+
+        mesh.fillupHoles(10)
+        self.assertTrue(mesh.isSolid())
+        self.assertEqual(mesh.CountFacets, sphere.CountFacets)
+        self.assertFalse(mesh.hasNonManifolds())
+
 
 class MeshSplitTestCases(unittest.TestCase):
     def setUp(self):
@@ -214,6 +261,24 @@ class MeshSplitTestCases(unittest.TestCase):
         vec = plm.Rotation.multVec(vec)
         self.assertEqual(len(self.mesh.nearestFacetOnRay(pnt,vec)), 1)
 
+    def testFindNearestOnRays(self):
+        box = self.mesh.BoundBox
+        pnt = box.Center + FreeCAD.Vector(0.1 * box.XLength, 0.2 * box.YLength, 0.0)
+        above = pnt + FreeCAD.Vector(0.0, 0.0, box.ZLength)
+        result = self.mesh.nearestFacetsOnRays([above, above], [(0,0,-1), (0,0,1)])
+        self.assertEqual(len(result), 2)
+        self.assertIsNone(result[1])
+        index, point = result[0]
+        self.assertAlmostEqual(point.z, box.ZMax, 5)
+        self.assertIn(index, self.mesh.nearestFacetOnRay(above, (0,0,-1)))
+
+        # a common base point for all rays
+        result = self.mesh.nearestFacetsOnRays(pnt, [(0,0,1), (0,0,-1), (1,0,0)])
+        self.assertEqual(len([i for i in result if i is not None]), 3)
+        # the facets seen from outside have an angle of 180 degree to the ray
+        result = self.mesh.nearestFacetsOnRays(above, [(0,0,-1)], math.pi/2)
+        self.assertIsNone(result[0])
+
     def testForaminate(self):
         class FilterAngle:
             def __init__(self, mesh, vec, limit):
@@ -248,6 +313,26 @@ class MeshSplitTestCases(unittest.TestCase):
         self.assertEqual(len(results2), 4)
         self.assertEqual(list(results.keys()), list(results2.keys()))
 
+    def testSlices(self):
+        box = self.mesh.BoundBox
+        dists = [box.ZMax + 1.0, box.Center.z, box.ZMin + 0.25 * box.ZLength, box.ZMin - 1.0]
+        layers = self.mesh.slices(FreeCAD.Vector(0, 0, 1), dists)
+        self.assertEqual(len(layers), 4)
+        self.assertEqual(len(layers[0]), 0)
+        self.assertEqual(len(layers[3]), 0)
+        for layer, dist in zip(layers[1:3], dists[1:3]):
+            self.assertEqual(len(layer), 1)
+            polyline = layer[0]
+            self.assertEqual(polyline[0], polyline[-1])
+            for pnt in polyline:
+                self.assertAlmostEqual(pnt.z, dist, 5)
+
+        # the planes are in global coordinates
+        self.mesh.Placement = Base.Placement(Base.Vector(0, 0, 10), Base.Rotation())
+        layers = self.mesh.slices(FreeCAD.Vector(0, 0, 1), [box.Center.z, box.Center.z + 10])
+        self.assertEqual(len(layers[0]), 0)
+        self.assertEqual(len(layers[1]), 1)
+
 class MeshGeoTestCases(unittest.TestCase):
     def setUp(self):
         # set up a planar face with 2 triangles
@@ -463,6 +548,62 @@ endsolid Simple"""
         mesh.read(Stream=data, Format="AST")
         self.assertTrue(mesh.hasSelfIntersections())
 
+    def testSelfIntersectionOfSmallFacets(self):
+        sphere = Mesh.createSphere(0.01, 100)
+        self.assertFalse(sphere.hasSelfIntersections())
+        other = Mesh.createSphere(0.01, 100)
+        other.translate(0.01, 0.0, 0.0)
+        self.assertGreater(len(sphere.section(other, ConnectLines=False)), 0)
+        sphere.addMesh(other)
+        self.assertTrue(sphere.hasSelfIntersections())
+
+    def testDecimateWithMaxError(self):
+        sphere = Mesh.createSphere(1.0, 50)
+        count = sphere.CountFacets
+        sphere.decimate(TargetSize=100, MaxError=1.0e-3)
+        self.assertGreater(sphere.CountFacets, 100)
+        self.assertLess(sphere.CountFacets, count)
+        for pnt in sphere.Points:
+            self.assertAlmostEqual(pnt.Vector.Length, 1.0, 2)
+
+        sphere.decimate(TargetSize=100, MaxError=1.0)
+        self.assertLessEqual(sphere.CountFacets, 100)
+        self.assertTrue(sphere.isSolid())
+
+    def testSmoothMethods(self):
+        sphere = Mesh.createSphere(1.0, 30)
+        for method in ("Laplace", "Taubin", "PlaneFit", "MedianFilter"):
+            mesh = sphere.copy()
+            mesh.smooth(Method=method, Iteration=4)
+            self.assertEqual(mesh.CountPoints, sphere.CountPoints)
+            for pnt in mesh.Points:
+                self.assertAlmostEqual(pnt.Vector.Length, 1.0, 1)
+
+        # the parallel smoothing gives the same result as a serial reference
+        # where each step only uses the positions of the previous step
+        mesh = sphere.copy()
+        mesh.smooth(Method="Laplace", Iteration=3, Lambda=0.5)
+        points, facets = sphere.Topology
+        neighbours = [set() for i in points]
+        counts = [0] * len(points)
+        for facet in facets:
+            for i in range(3):
+                neighbours[facet[i]].update(facet)
+                neighbours[facet[i]].discard(facet[i])
+                counts[facet[i]] += 1
+        expected = [FreeCAD.Vector(p) for p in points]
+        for step in range(3):
+            previous = [FreeCAD.Vector(p) for p in expected]
+            for i, pnt in enumerate(previous):
+                if len(neighbours[i]) < 3 or len(neighbours[i]) != counts[i]:
+                    continue
+                delta = FreeCAD.Vector()
+                for j in neighbours[i]:
+                    delta += previous[j] - pnt
+                expected[i] = pnt + delta * (0.5 / len(neighbours[i]))
+        for pnt, ref in zip(mesh.Topology[0], expected):
+            self.assertAlmostEqual((pnt - ref).Length, 0.0, 5)
+
 
 class PivyTestCases(unittest.TestCase):
     def setUp(self):
@@ -553,10 +694,183 @@ class LoadMeshInThreadsCases(unittest.TestCase):
             thread.start_new(loadFile,(name,))
         time.sleep(1)
 
+    def testLoadBinarySTL(self):
+        mesh=Mesh.createSphere(10.0,100)
+        name=tempfile.gettempdir() + os.sep + "binary.stl"
+        mesh.write(name)
+        copy=Mesh.Mesh(name)
+        os.remove(name)
+        self.assertEqual(copy.CountPoints, mesh.CountPoints)
+        self.assertEqual(copy.CountFacets, mesh.CountFacets)
+        self.assertTrue(copy.isSolid())
+        self.assertFalse(copy.hasNonManifolds())
+
+    def testLoadAsciiFormats(self):
+        mesh=Mesh.createSphere(10.0,100)
+        for ext, fmt in [("ast", "AST"), ("obj", "OBJ"), ("off", "OFF"), ("ply", "APLY")]:
+            name=tempfile.gettempdir() + os.sep + "ascii." + ext
+            mesh.write(name, fmt)
+            copy=Mesh.Mesh(name)
+            os.remove(name)
+            self.assertEqual(copy.CountPoints, mesh.CountPoints, fmt)
+            self.assertEqual(copy.CountFacets, mesh.CountFacets, fmt)
+            self.assertTrue(copy.isSolid(), fmt)
+
+    def testLoad3MF(self):
+        mesh=Mesh.createSphere(10.0,100)
+        mesh.translate(1.0, 2.0, 3.0)
+        name=tempfile.gettempdir() + os.sep + "mesh.3mf"
+        mesh.write(name)
+        copy=Mesh.Mesh(name)
+        os.remove(name)
+        self.assertEqual(copy.CountPoints, mesh.CountPoints)
+        self.assertEqual(copy.CountFacets, mesh.CountFacets)
+        self.assertTrue(copy.isSolid())
+        self.assertAlmostEqual(copy.BoundBox.XMin, mesh.BoundBox.XMin, 3)
+        self.assertAlmostEqual(copy.BoundBox.ZMax, mesh.BoundBox.ZMax, 3)
+
+    def testLoadInvalid3MF(self):
+        # the second object has an invalid coordinate
+        vertices = '<vertex x="0" y="0" z="0"/><vertex x="1" y="0" z="0"/><vertex x="0" y="{}" z="0"/>'
+        mesh = '<object id="{}" type="model"><mesh><vertices>' + vertices + \
+               '</vertices><triangles><triangle v1="0" v2="1" v3="2"/></triangles></mesh></object>'
+        model = '<?xml version="1.0" encoding="UTF-8"?><model unit="millimeter"><resources>' + \
+                mesh.format(1, "1") + mesh.format(2, "one") + \
+                '</resources><build><item objectid="1"/><item objectid="2"/></build></model>'
+        name=tempfile.gettempdir() + os.sep + "invalid.3mf"
+        with zipfile.ZipFile(name, "w") as zip:
+            zip.writestr("3D/3dmodel.model", model)
+        copy=Mesh.Mesh(name)
+        os.remove(name)
+        # nothing of the file is loaded
+        self.assertEqual(copy.CountFacets, 0)
+
+    def testStreamConvert(self):
+        mesh=Mesh.createSphere(10.0,100)
+        input=tempfile.gettempdir() + os.sep + "stream.stl"
+        output=tempfile.gettempdir() + os.sep + "stream.obj"
+        mesh.write(input)
+        read, written = Mesh.convert(input, output, weld=0.001, reduction=0.5, maxError=0.1, chunkSize=5000)
+        copy=Mesh.Mesh(output)
+        os.remove(input)
+        os.remove(output)
+        self.assertEqual(read, mesh.CountFacets)
+        self.assertEqual(written, copy.CountFacets)
+        self.assertLess(written, read)
+        self.assertTrue(copy.isSolid())
+
     def tearDown(self):
         pass
 
 
+class MeshOperationsInThreadsCases(unittest.TestCase):
+    """
+    Long running mesh operations release the GIL so that other Python threads
+    keep running while they compute. Operations that modify a mesh in place
+    work on a copy meanwhile, so that threads sharing a mesh cannot corrupt it.
+    """
+    def setUp(self):
+        self.mesh1 = Mesh.createSphere(10.0, 100)
+        self.mesh2 = Mesh.createSphere(10.0, 100)
+        self.mesh2.translate(5.0, 0.0, 0.0)
+
+    def runConcurrently(self, operation, probe):
+        """
+        Runs probe in a second thread which can only get the GIL while operation
+        releases it and returns whether the probe has finished before operation.
+        """
+        started = threading.Event()
+        finished = threading.Event()
+        def run():
+            started.wait()
+            probe()
+            finished.set()
+
+        thr = threading.Thread(target=run)
+        thr.start()
+        interval = sys.getswitchinterval()
+        # keep the interpreter from switching threads on its own
+        sys.setswitchinterval(60.0)
+        try:
+            started.set()
+            operation()
+            result = finished.is_set()
+        finally:
+            sys.setswitchinterval(interval)
+            thr.join()
+        return result
+
+    def testThreadRunsDuringOperation(self):
+        def operation():
+            self.mesh1.unite(self.mesh2)
+        def probe():
+            pass
+
+        self.assertTrue(self.runConcurrently(operation, probe),
+                        "No Python thread ran while the operation was computing")
+
+    def testThreadRunsDuringModification(self):
+        count = self.mesh1.CountFacets
+        seen = []
+        def operation():
+            self.mesh1.decimate(1000)
+        def probe():
+            seen.append(self.mesh1.CountFacets)
+
+        self.assertTrue(self.runConcurrently(operation, probe),
+                        "No Python thread ran while the mesh was modified")
+        # the other thread sees the mesh as it was before the modification
+        self.assertEqual(seen, [count])
+        self.assertLess(self.mesh1.CountFacets, count)
+
+    def testConcurrentOperations(self):
+        results = [None] * 4
+        errors = []
+        def unite(index):
+            try:
+                results[index] = self.mesh1.unite(self.mesh2).CountFacets
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=unite, args=(i,)) for i in range(len(results))]
+        for thr in threads:
+            thr.start()
+        for thr in threads:
+            thr.join()
+
+        self.assertEqual(errors, [])
+        self.assertEqual(len(set(results)), 1)
+        self.assertGreater(results[0], 0)
+
+    def testConcurrentModifications(self):
+        errors = []
+        def smooth():
+            try:
+                for i in range(5):
+                    self.mesh1.smooth(Method="Laplace", Iteration=1)
+                    self.mesh1.removeDuplicatedPoints()
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=smooth) for i in range(2)]
+        for thr in threads:
+            thr.start()
+        for thr in threads:
+            thr.join()
+
+        # the same modifications done one after another
+        reference = Mesh.createSphere(10.0, 100)
+        for i in range(10):
+            reference.smooth(Method="Laplace", Iteration=1)
+            reference.removeDuplicatedPoints()
+
+        self.assertEqual(errors, [])
+        self.assertEqual(self.mesh1.CountPoints, reference.CountPoints)
+        self.assertEqual(self.mesh1.Topology[1], reference.Topology[1])
+        for p1, p2 in zip(self.mesh1.Points, reference.Points):
+            self.assertAlmostEqual(p1.Vector.distanceToPoint(p2.Vector), 0.0, places=4)
+
+
 class PolynomialFitCases(unittest.TestCase):
     def setUp(self):
         pass
@@ -680,6 +994,112 @@ class MeshSubElement(unittest.TestCase):
         self.assertEqual(segment.CountPoints, 7)
         self.assertEqual(segment.CountFacets, 5)
 
+    def testPlanarSegments(self):
+        segments = self.mesh.getPlanarSegments(0.01)
+        self.assertEqual(len(segments), 6)
+        facets = sorted(i for segment in segments for i in segment)
+        self.assertEqual(facets, list(range(12)))
+        # a second run must give the same result
+        self.assertEqual(self.mesh.getPlanarSegments(0.01), segments)
+
+    def testSegmentsOfType(self):
+        segments = self.mesh.getSegmentsOfType("Plane", 0.01, 2)
+        self.assertEqual(len(segments), 6)
+        facets = sorted(i for segment in segments for i in segment)
+        self.assertEqual(facets, list(range(12)))
+        self.assertEqual(len(self.mesh.getSegmentsOfType("Plane", 0.01, 3)), 0)
+
+    def testCylinderSegments(self):
+        cylinder = Mesh.createCylinder(2.0, 10.0, 0, 1.0, 32)
+        segments = cylinder.getSegmentsOfType("Cylinder", 0.01, 2)
+        self.assertEqual(len(segments), 1)
+        self.assertEqual(sorted(segments[0]), list(range(cylinder.CountFacets)))
+
+    def growCurvatureSegments(self, mesh, params):
+        """
+        Grows the segments of getSegmentsByCurvature() facet by facet
+        """
+        def f32(value):
+            return struct.unpack("f", struct.pack("f", value))[0]
+
+        curvature = [(f32(c[0]), f32(c[1])) for c in mesh.getCurvaturePerVertex()]
+        facets = mesh.Facets
+        points = [f.PointIndices for f in facets]
+        neighbours = [f.NeighbourIndices for f in facets]
+        count = len(facets)
+        visited = [False] * count
+        segments = []
+        for c1, c2, tol1, tol2, num in params:
+            c1, c2, tol1, tol2 = f32(c1), f32(c2), f32(tol1), f32(tol2)
+            def accepted(index):
+                for point in points[index]:
+                    cmax, cmin = curvature[point]
+                    if abs(f32(cmin - c2)) > tol1 or abs(f32(cmax - c1)) > tol2:
+                        return False
+                return True
+
+            # a start facet is always taken, even if it fails the test
+            reset = []
+            for start in range(count):
+                if visited[start]:
+                    continue
+                visited[start] = True
+                indices = [start]
+                level = [start]
+                while level:
+                    nextLevel = []
+                    for index in level:
+                        for neighbour in neighbours[index]:
+                            if neighbour < count and not visited[neighbour] and accepted(neighbour):
+                                visited[neighbour] = True
+                                nextLevel.append(neighbour)
+                                indices.append(neighbour)
+                    level = nextLevel
+                if len(indices) <= 1:
+                    reset.append(start)
+                elif len(indices) >= num:
+                    segments.append(sorted(indices))
+            for index in reset:
+                visited[index] = False
+        return segments
+
+    def testCurvatureSegments(self):
+        # z = sin(y) has ridges and valleys along the x axis. The facets are ordered
+        # along x, so each segment spans the blocks of facets that are tested in parallel.
+        size = 100
+        points = [FreeCAD.Vector(i * 0.2, j * 0.2, math.sin(j * 0.2))
+                  for i in range(size + 1) for j in range(size + 1)]
+        facets = []
+        for i in range(size):
+            for j in range(size):
+                p0 = i * (size + 1) + j
+                p1 = p0 + size + 1
+                facets.append((p0, p1, p1 + 1))
+                facets.append((p0, p1 + 1, p0 + 1))
+        mesh = Mesh.Mesh((points, facets))
+        self.assertGreater(mesh.CountFacets, 2 * 8192)
+
+        # ridges and valleys
+        params = [(0.0, -1.0, 0.3, 0.3, 10), (1.0, 0.0, 0.3, 0.3, 10)]
+        segments = mesh.getSegmentsByCurvature(params)
+        expected = self.growCurvatureSegments(mesh, params)
+        self.assertEqual(len(expected), 6)
+        self.assertEqual([sorted(segment) for segment in segments], expected)
+
+    def testFacesBuffer(self):
+        points, facets = self.mesh.getFacesBuffer(0.0)
+        pts = memoryview(points)
+        tri = memoryview(facets)
+        self.assertTrue(pts.readonly)
+        self.assertEqual(pts.format, "d")
+        self.assertEqual(pts.shape, (8, 3))
+        self.assertEqual(tri.format, "I")
+        self.assertEqual(tri.shape, (12, 3))
+        self.assertEqual(tri.tolist(), [list(f) for f in self.mesh.Topology[1]])
+        p = self.mesh.Points[5]
+        self.assertEqual(pts[5, 0], p.x)
+        self.assertEqual(pts[5, 2], p.z)
+
     def tearDown(self):
         pass
 
@@ -723,3 +1143,84 @@ class MeshProperty(unittest.TestCase):
         self.assertEqual(len(material2["shininess"]), len1 + len2)
         self.assertEqual(len(material2["transparency"]), len1 + len2)
 
+    def saveAndRestore(self, sphere, compact):
+        mesh = self.doc.addObject("Mesh::Feature", "Sphere")
+        mesh.Mesh = sphere
+
+        TempPath = tempfile.gettempdir()
+        SaveName = TempPath + os.sep + "mesh_persistence.FCStd"
+        hGrp = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        saveCompact = hGrp.GetBool("SaveCompactMesh", False)
+        hGrp.SetBool("SaveCompactMesh", compact)
+        try:
+            self.doc.saveAs(SaveName)
+        finally:
+            hGrp.SetBool("SaveCompactMesh", saveCompact)
+        FreeCAD.closeDocument(self.doc.Name)
+
+        self.doc = FreeCAD.openDocument(SaveName)
+        sphere2 = self.doc.Sphere.Mesh
+        self.assertEqual(sphere2.CountPoints, sphere.CountPoints)
+        self.assertEqual(sphere2.Topology, sphere.Topology)
+        self.assertTrue(sphere2.isSolid())
+        for p1, p2 in zip(sphere.Points, sphere2.Points):
+            self.assertEqual(p1.Vector, p2.Vector)
+        return sphere2
+
+    def testPersistence(self):
+        # documents are saved in the legacy format by default
+        sphere = Mesh.createSphere(1.0, 50)
+        self.saveAndRestore(sphere, False)
+
+    def testCompactPersistence(self):
+        sphere = Mesh.createSphere(1.0, 50)
+        sphere.addSegment([0, 2, 4, 6, 8])
+        sphere2 = self.saveAndRestore(sphere, True)
+        self.assertEqual(sphere2.countSegments(), 1)
+        self.assertEqual(sphere2.getSegment(0), [0, 2, 4, 6, 8])
+
+    def testSharedKernel(self):
+        mesh = self.doc.addObject("Mesh::Feature", "Sphere")
+        mesh.Mesh = Mesh.createSphere(1.0, 20)
+        copy = mesh.Mesh.copy()
+        copy.translate(1.0, 0.0, 0.0)
+        self.assertAlmostEqual(copy.BoundBox.Center.x, 1.0, 3)
+        self.assertAlmostEqual(mesh.Mesh.BoundBox.Center.x, 0.0, 3)
+
+    def testTransformFeature(self):
+        source = self.doc.addObject("Mesh::Feature", "Sphere")
+        source.Mesh = Mesh.createSphere(1.0, 20)
+        matrix = FreeCAD.Matrix()
+        matrix.move(FreeCAD.Vector(2.0, 0.0, 0.0))
+        trans = self.doc.addObject("Mesh::Transform", "Transform")
+        trans.Source = source
+        trans.Position = matrix
+        self.doc.recompute()
+
+        self.assertEqual(trans.Mesh.CountFacets, source.Mesh.CountFacets)
+        self.assertAlmostEqual(trans.Placement.Base.x, 2.0)
+        self.assertAlmostEqual(trans.Mesh.BoundBox.Center.x, 2.0, 3)
+        self.assertAlmostEqual(source.Mesh.BoundBox.Center.x, 0.0, 3)
+
+    def testTransformFeatureScaled(self):
+        mesh = Mesh.createSphere(1.0, 20)
+        mesh.addSegment([0, 1, 2])
+        source = self.doc.addObject("Mesh::Feature", "Sphere")
+        source.Mesh = mesh
+        source.Placement.Base = FreeCAD.Vector(1.0, 0.0, 0.0)
+        matrix = FreeCAD.Matrix()
+        matrix.scale(2.0, 2.0, 2.0)
+        trans = self.doc.addObject("Mesh::Transform", "Transform")
+        trans.Source = source
+        trans.Position = matrix
+        self.doc.recompute()
+
+        # the placement of the source is applied first, as for a rigid matrix
+        box1 = source.Mesh.BoundBox
+        box2 = trans.Mesh.BoundBox
+        self.assertAlmostEqual(box2.Center.x, 2.0 * box1.Center.x, 3)
+        self.assertAlmostEqual(box2.XLength, 2.0 * box1.XLength, 3)
+        self.assertTrue(trans.Placement.isIdentity())
+        self.assertEqual(trans.Mesh.countSegments(), 1)
+        self.assertEqual(trans.Mesh.getSegment(0), [0, 1, 2])
+        self.assertEqual(source.Mesh.countSegments(), 1)
@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #include "MeshTexture.h"
+#include "Core/Functional.h"
 
 
 using namespace Mesh;
@@ -82,8 +83,9 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
 
         if (binding == MeshCore::MeshIO::PER_VERTEX) {
             diffuseColor.reserve(points.size());
+            std::vector<PointIndex> found = findIndices(points, max_dist);
             for (size_t index=0; index<points.size(); index++) {
-                PointIndex pos = findIndex(points[index], max_dist);
+                PointIndex pos = found[index];
                 if (pos < countPointsRefMesh) {
                     diffuseColor.push_back(textureColor[pos]);
                 }
@@ -101,8 +103,9 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
             // the values of the map give the point indices of the original mesh
             std::vector<PointIndex> pointMap;
             pointMap.reserve(points.size());
+            std::vector<PointIndex> found = findIndices(points, max_dist);
             for (size_t index=0; index<points.size(); index++) {
-                PointIndex pos = findIndex(points[index], max_dist);
+                PointIndex pos = found[index];
                 if (pos < countPointsRefMesh) {
                     pointMap.push_back(pos);
                 }
@@ -139,3 +142,21 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
         }
     }
 }
+
+std::vector<PointIndex> MeshTexture::findIndices(const MeshCore::MeshPointArray& points, float max_dist) const
+{
+    std::vector<PointIndex> indices;
+    if (max_dist < 0.0f) {
+        indices.resize(points.size());
+        MeshCore::parallel_blocks(points.size(), 1024, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++)
+                indices[i] = kdTree->FindExact(points[i]);
+        });
+    }
+    else {
+        std::vector<float> distances;
+        kdTree->FindNearest(points, 1, indices, distances, max_dist);
+    }
+
+    return indices;
+}
@@ -74,16 +74,7 @@ public:
 
 private:
     void apply(const Mesh::MeshObject& mesh, bool addDefaultColor, const App::Color& defaultColor, float max_dist, MeshCore::Material &material);
-    PointIndex findIndex(const Base::Vector3f& p, float max_dist) const {
-        if (max_dist < 0.0f) {
-            return kdTree->FindExact(p);
-        }
-        else {
-            Base::Vector3f n;
-            float dist;
-            return kdTree->FindNearest(p, max_dist, n, dist);
-        }
-    }
+    std::vector<PointIndex> findIndices(const MeshCore::MeshPointArray& points, float max_dist) const;
 
 private:
     const MeshCore::Material &materialRefMesh;
@@ -69,6 +69,7 @@
 #include <App/PropertyStandard.h>
 #include <Base/FileInfo.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/Interpreter.h>
 #include <Base/MatrixPy.h>
 #include <Base/Rotation.h>
 #include <Base/Stream.h>
@@ -730,7 +731,9 @@ PyObject*  TopoShapePy::fuse(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a fuse operation:
-            TopoDS_Shape fusShape = this->getTopoShapePtr()->fuse(shape);
+            TopoDS_Shape fusShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->fuse(shape);
+            });
             return new TopoShapePy(new TopoShape(fusShape));
         }
         catch (Standard_Failure& e) {
@@ -751,7 +754,9 @@ PyObject*  TopoShapePy::fuse(PyObject *args)
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
             // Let's call algorithm computing a fuse operation:
-            TopoDS_Shape fuseShape = this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+            TopoDS_Shape fuseShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(fuseShape));
         }
         catch (Standard_Failure& e) {
@@ -779,7 +784,9 @@ PyObject*  TopoShapePy::fuse(PyObject *args)
            }
         }
         try {
-            TopoDS_Shape multiFusedShape = this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+            TopoDS_Shape multiFusedShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(multiFusedShape));
         }
         catch (Standard_Failure& e) {
@@ -816,7 +823,9 @@ PyObject*  TopoShapePy::multiFuse(PyObject *args)
        }
     }
     try {
-        TopoDS_Shape multiFusedShape = this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+        TopoDS_Shape multiFusedShape = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->fuse(shapeVec,tolerance);
+        });
         return new TopoShapePy(new TopoShape(multiFusedShape));
     }
     catch (Standard_Failure& e) {
@@ -838,7 +847,9 @@ PyObject*  TopoShapePy::oldFuse(PyObject *args)
     TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
     try {
         // Let's call algorithm computing a fuse operation:
-        TopoDS_Shape fusShape = this->getTopoShapePtr()->oldFuse(shape);
+        TopoDS_Shape fusShape = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->oldFuse(shape);
+        });
         return new TopoShapePy(new TopoShape(fusShape));
     }
     catch (Standard_Failure& e) {
@@ -858,7 +869,9 @@ PyObject*  TopoShapePy::common(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a common operation:
-            TopoDS_Shape comShape = this->getTopoShapePtr()->common(shape);
+            TopoDS_Shape comShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->common(shape);
+            });
             return new TopoShapePy(new TopoShape(comShape));
         }
         catch (Standard_Failure& e) {
@@ -877,7 +890,9 @@ PyObject*  TopoShapePy::common(PyObject *args)
         std::vector<TopoDS_Shape> shapeVec;
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
-            TopoDS_Shape commonShape = this->getTopoShapePtr()->common(shapeVec,tolerance);
+            TopoDS_Shape commonShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->common(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(commonShape));
         }
         catch (Standard_Failure& e) {
@@ -905,7 +920,9 @@ PyObject*  TopoShapePy::common(PyObject *args)
             }
         }
         try {
-            TopoDS_Shape multiCommonShape = this->getTopoShapePtr()->common(shapeVec,tolerance);
+            TopoDS_Shape multiCommonShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->common(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(multiCommonShape));
         }
         catch (Standard_Failure& e) {
@@ -930,7 +947,10 @@ PyObject*  TopoShapePy::section(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a section operation:
-            TopoDS_Shape secShape = this->getTopoShapePtr()->section(shape, Base::asBoolean(approx));
+            bool approximate = Base::asBoolean(approx);
+            TopoDS_Shape secShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->section(shape, approximate);
+            });
             return new TopoShapePy(new TopoShape(secShape));
         }
         catch (Standard_Failure& e) {
@@ -949,7 +969,10 @@ PyObject*  TopoShapePy::section(PyObject *args)
         std::vector<TopoDS_Shape> shapeVec;
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
-            TopoDS_Shape sectionShape = this->getTopoShapePtr()->section(shapeVec, tolerance, Base::asBoolean(approx));
+            bool approximate = Base::asBoolean(approx);
+            TopoDS_Shape sectionShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->section(shapeVec, tolerance, approximate);
+            });
             return new TopoShapePy(new TopoShape(sectionShape));
         }
         catch (Standard_Failure& e) {
@@ -977,7 +1000,10 @@ PyObject*  TopoShapePy::section(PyObject *args)
            }
         }
         try {
-            TopoDS_Shape multiSectionShape = this->getTopoShapePtr()->section(shapeVec, tolerance, Base::asBoolean(approx));
+            bool approximate = Base::asBoolean(approx);
+            TopoDS_Shape multiSectionShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->section(shapeVec, tolerance, approximate);
+            });
             return new TopoShapePy(new TopoShape(multiSectionShape));
         }
         catch (Standard_Failure& e) {
@@ -1003,7 +1029,9 @@ PyObject*  TopoShapePy::slice(PyObject *args)
 
     try {
         Base::Vector3d vec = Py::Vector(dir, false).toVector();
-        std::list<TopoDS_Wire> slice = this->getTopoShapePtr()->slice(vec, d);
+        std::list<TopoDS_Wire> slice = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->slice(vec, d);
+        });
         Py::List wire;
         for (std::list<TopoDS_Wire>::iterator it = slice.begin(); it != slice.end(); ++it) {
             wire.append(Py::asObject(new TopoShapeWirePy(new TopoShape(*it))));
@@ -1035,7 +1063,9 @@ PyObject*  TopoShapePy::slices(PyObject *args)
         d.reserve(list.size());
         for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it)
             d.push_back((double)Py::Float(*it));
-        TopoDS_Compound slice = this->getTopoShapePtr()->slices(vec, d);
+        TopoDS_Compound slice = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->slices(vec, d);
+        });
         return new TopoShapeCompoundPy(new TopoShape(slice));
     }
     catch (Standard_Failure& e) {
@@ -1055,7 +1085,9 @@ PyObject*  TopoShapePy::cut(PyObject *args)
         TopoDS_Shape shape = static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape();
         try {
             // Let's call algorithm computing a cut operation:
-            TopoDS_Shape cutShape = this->getTopoShapePtr()->cut(shape);
+            TopoDS_Shape cutShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->cut(shape);
+            });
             return new TopoShapePy(new TopoShape(cutShape));
         }
         catch (Standard_Failure& e) {
@@ -1074,7 +1106,9 @@ PyObject*  TopoShapePy::cut(PyObject *args)
         std::vector<TopoDS_Shape> shapeVec;
         shapeVec.push_back(static_cast<TopoShapePy*>(pcObj)->getTopoShapePtr()->getShape());
         try {
-            TopoDS_Shape cutShape = this->getTopoShapePtr()->cut(shapeVec,tolerance);
+            TopoDS_Shape cutShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->cut(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(cutShape));
         }
         catch (Standard_Failure& e) {
@@ -1102,7 +1136,9 @@ PyObject*  TopoShapePy::cut(PyObject *args)
            }
         }
         try {
-            TopoDS_Shape multiCutShape = this->getTopoShapePtr()->cut(shapeVec,tolerance);
+            TopoDS_Shape multiCutShape = Base::runWithoutGIL([&] {
+                return this->getTopoShapePtr()->cut(shapeVec,tolerance);
+            });
             return new TopoShapePy(new TopoShape(multiCutShape));
         }
         catch (Standard_Failure& e) {
@@ -1140,7 +1176,9 @@ PyObject*  TopoShapePy::generalFuse(PyObject *args)
     }
     try {
         std::vector<TopTools_ListOfShape> map;
-        TopoDS_Shape gfaResultShape = this->getTopoShapePtr()->generalFuse(shapeVec,tolerance,&map);
+        TopoDS_Shape gfaResultShape = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->generalFuse(shapeVec,tolerance,&map);
+        });
         Py::Object shapePy = shape2pyshape(gfaResultShape);
         Py::List mapPy;
         for (TopTools_ListOfShape& shapes : map) {
@@ -1676,8 +1714,12 @@ PyObject* TopoShapePy::makeThickness(PyObject *args)
             }
         }
 
-        TopoDS_Shape shape = this->getTopoShapePtr()->makeThickSolid(facesToRemove, offset, tolerance,
-            Base::asBoolean(inter), Base::asBoolean(self_inter), offsetMode, join);
+        bool intersection = Base::asBoolean(inter);
+        bool selfInter = Base::asBoolean(self_inter);
+        TopoDS_Shape shape = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->makeThickSolid(facesToRemove, offset, tolerance,
+                intersection, selfInter, offsetMode, join);
+        });
         return new TopoShapeSolidPy(new TopoShape(shape));
     }
     catch (Standard_Failure& e) {
@@ -1699,10 +1741,13 @@ PyObject* TopoShapePy::makeOffsetShape(PyObject *args, PyObject *keywds)
         return nullptr;
 
     try {
-        TopoDS_Shape shape = this->getTopoShapePtr()->makeOffsetShape(offset, tolerance,
-            Base::asBoolean(inter),
-            Base::asBoolean(self_inter), offsetMode, join,
-            Base::asBoolean(fill));
+        bool intersection = Base::asBoolean(inter);
+        bool selfInter = Base::asBoolean(self_inter);
+        bool fillGap = Base::asBoolean(fill);
+        TopoDS_Shape shape = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->makeOffsetShape(offset, tolerance,
+                intersection, selfInter, offsetMode, join, fillGap);
+        });
         return new TopoShapePy(new TopoShape(shape));
     }
     catch (Standard_Failure& e) {
@@ -1724,8 +1769,13 @@ PyObject* TopoShapePy::makeOffset2D(PyObject *args, PyObject *keywds)
         return nullptr;
 
     try {
-        TopoDS_Shape resultShape = this->getTopoShapePtr()->makeOffset2D(offset, join,
-            Base::asBoolean(fill), Base::asBoolean(openResult), Base::asBoolean(inter));
+        bool fillGap = Base::asBoolean(fill);
+        bool allowOpenResult = Base::asBoolean(openResult);
+        bool intersection = Base::asBoolean(inter);
+        TopoDS_Shape resultShape = Base::runWithoutGIL([&] {
+            return this->getTopoShapePtr()->makeOffset2D(offset, join,
+                fillGap, allowOpenResult, intersection);
+        });
         return new_reference_to(shape2pyshape(resultShape));
     }
     PY_CATCH_OCC;
@@ -26,6 +26,7 @@
 #include <chrono>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <TopoDS.hxx>
@@ -131,6 +132,7 @@ protected:
     bool myShapeDone;
     bool myProjecting;
     mutable int mySkippedShapes;
+    mutable std::mutex myMutex;
 
     static bool s_aborting;
     static AreaStaticParams s_params;
@@ -276,6 +278,15 @@ public:
         return mySections.size();
     }
 
+    /** Return the lock of this object
+     *
+     * The Python binding holds it while running an operation without the
+     * global interpreter lock.
+     */
+    std::mutex& getMutex() const {
+        return myMutex;
+    }
+
     /** Add a OCC wire shape to CArea
      *
      * \arg \c area: output converted curved object to here
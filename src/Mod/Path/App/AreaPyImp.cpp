@@ -22,6 +22,9 @@
 
 #include "PreCompiled.h"
 
+#include <mutex>
+
+#include <Base/Interpreter.h>
 #include <Mod/Part/App/OCCError.h>
 #include <Mod/Part/App/TopoShapePy.h>
 
@@ -191,6 +194,28 @@ static AreaPyModifier mod;
 
 using namespace Path;
 
+namespace {
+/** Locks the area for the rest of a method
+ *
+ * Methods run parts of their work without the GIL, so the area needs a lock
+ * of its own. The lock is acquired without the GIL, because its owner may be
+ * waiting for the GIL to return its result.
+ */
+class AreaLocker {
+public:
+    explicit AreaLocker(const AreaPy* pyArea)
+        : lock(pyArea->getAreaPtr()->getMutex(), std::defer_lock)
+    {
+        Base::runWithoutGIL([this] {
+            lock.lock();
+        });
+    }
+
+private:
+    std::unique_lock<std::mutex> lock;
+};
+}
+
 // returns a string which represents the object e.g. when printed in python
 std::string AreaPy::representation() const
 {
@@ -225,6 +250,7 @@ PyObject* AreaPy::setPlane(PyObject *args) {
         return nullptr;
 
 #define GET_TOPOSHAPE(_p) static_cast<Part::TopoShapePy*>(_p)->getTopoShapePtr()->getShape()
+    AreaLocker lock(this);
     getAreaPtr()->setPlane(GET_TOPOSHAPE(pcObj));
     Py_INCREF(this);
     return this;
@@ -239,9 +265,14 @@ PyObject* AreaPy::getShape(PyObject *args, PyObject *keywds)
         return nullptr;
 
     PY_TRY {
-        if (Base::asBoolean(pcObj))
-            getAreaPtr()->clean();
-        return Py::new_reference_to(Part::shape2pyshape(getAreaPtr()->getShape(index)));
+        AreaLocker lock(this);
+        bool rebuild = Base::asBoolean(pcObj);
+        TopoDS_Shape shape = Base::runWithoutGIL([&] {
+            if (rebuild)
+                getAreaPtr()->clean();
+            return getAreaPtr()->getShape(index);
+        });
+        return Py::new_reference_to(Part::shape2pyshape(shape));
     } PY_CATCH_OCC
 }
 
@@ -261,6 +292,7 @@ PyObject* AreaPy::add(PyObject *args, PyObject *keywds)
         return nullptr;
 
     PY_TRY {
+        AreaLocker lock(this);
         if (PyObject_TypeCheck(pcObj, &(Part::TopoShapePy::Type))) {
             getAreaPtr()->add(GET_TOPOSHAPE(pcObj),op);
             Py_INCREF(this);
@@ -306,8 +338,16 @@ PyObject* AreaPy::makeOffset(PyObject *args, PyObject *keywds)
         return nullptr;
 
     PY_TRY {
+        AreaLocker lock(this);
         //Expand the variable as function call arguments
-        TopoDS_Shape resultShape = getAreaPtr()->makeOffset(index,
+        //The arguments are converted while holding the GIL, only the
+        //computation itself runs without it
+        auto makeOffset = [&](auto... params) {
+            return Base::runWithoutGIL([&] {
+                return getAreaPtr()->makeOffset(index, params...);
+            });
+        };
+        TopoDS_Shape resultShape = makeOffset(
                             PARAM_PY_FIELDS(PARAM_FARG,AREA_PARAMS_OFFSET));
         return Py::new_reference_to(Part::shape2pyshape(resultShape));
     } PY_CATCH_OCC
@@ -328,7 +368,13 @@ PyObject* AreaPy::makePocket(PyObject *args, PyObject *keywds)
         return nullptr;
 
     PY_TRY {
-        TopoDS_Shape resultShape = getAreaPtr()->makePocket(index,
+        AreaLocker lock(this);
+        auto makePocket = [&](auto... params) {
+            return Base::runWithoutGIL([&] {
+                return getAreaPtr()->makePocket(index, params...);
+            });
+        };
+        TopoDS_Shape resultShape = makePocket(
                             PARAM_PY_FIELDS(PARAM_FARG,AREA_PARAMS_POCKET));
         return Py::new_reference_to(Part::shape2pyshape(resultShape));
     } PY_CATCH_OCC
@@ -372,7 +418,13 @@ PyObject* AreaPy::makeSections(PyObject *args, PyObject *keywds)
             }
         }
 
-        std::vector<std::shared_ptr<Area> > sections = getAreaPtr()->makeSections(
+        AreaLocker lock(this);
+        auto makeSections = [&](auto... params) {
+            return Base::runWithoutGIL([&] {
+                return getAreaPtr()->makeSections(params...);
+            });
+        };
+        std::vector<std::shared_ptr<Area> > sections = makeSections(
                             PARAM_PY_FIELDS(PARAM_FARG,AREA_PARAMS_SECTION_EXTRA),
                             h,plane?GET_TOPOSHAPE(plane):TopoDS_Shape());
 
@@ -395,6 +447,7 @@ PyObject* AreaPy::setParams(PyObject *args, PyObject *keywds)
     //Declare variables defined in the NAME field of the CONF parameter list
     PARAM_PY_DECLARE(PARAM_FNAME,AREA_PARAMS_CONF);
 
+    AreaLocker lock(this);
     AreaParams params = getAreaPtr()->getParams();
 
     //populate the CONF variables with params
@@ -421,6 +474,7 @@ PyObject* AreaPy::getParams(PyObject *args)
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
 
+    AreaLocker lock(this);
     const AreaParams &params =getAreaPtr()->getParams();
 
     PyObject *dict = PyDict_New();
@@ -445,14 +499,22 @@ PyObject* AreaPy::getParamsDesc(PyObject *, PyObject *)
 Py::List AreaPy::getSections() const {
     Py::List ret;
 	Area *area = getAreaPtr();
-    for(size_t i=0,count=area->getSectionCount(); i<count;++i)
-        ret.append(Part::shape2pyshape(getAreaPtr()->getShape(i)));
+    AreaLocker lock(this);
+    std::vector<TopoDS_Shape> sections = Base::runWithoutGIL([area] {
+        std::vector<TopoDS_Shape> shapes;
+        for(size_t i=0,count=area->getSectionCount(); i<count;++i)
+            shapes.push_back(area->getShape(i));
+        return shapes;
+    });
+    for(auto &s : sections)
+        ret.append(Part::shape2pyshape(s));
     return ret;
 }
 
 Py::List AreaPy::getShapes() const {
     Py::List ret;
 	Area *area = getAreaPtr();
+    AreaLocker lock(this);
     const std::list<Area::Shape> &shapes = area->getChildren();
     for(auto &s : shapes)
         ret.append(Py::TupleN(Part::shape2pyshape(s.shape),Py::Int(s.op)));
@@ -460,6 +522,7 @@ Py::List AreaPy::getShapes() const {
 }
 
 Py::Object AreaPy::getWorkplane() const {
+    AreaLocker lock(this);
     return Part::shape2pyshape(getAreaPtr()->getPlane());
 }
 
@@ -470,6 +533,7 @@ void AreaPy::setWorkplane(Py::Object obj) {
         error += p->ob_type->tp_name;
         throw Py::TypeError(error);
     }
+    AreaLocker lock(this);
     getAreaPtr()->setPlane(GET_TOPOSHAPE(p));
 }
 
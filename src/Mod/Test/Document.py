@@ -669,6 +669,25 @@ class DocumentSaveRestoreCases(unittest.TestCase):
     self.assertEqual(self.Doc.Label_1.Vector, Doc.Label_1.Vector)
     FreeCAD.closeDocument("DumpTest")
 
+  def testRestoreManyObjects(self):
+    # the types and the dynamic properties are looked up by name on restore
+    Doc = FreeCAD.newDocument("ManyObjects")
+    for i in range(100):
+      obj = Doc.addObject("App::FeaturePython", "Obj")
+      obj.addProperty("App::PropertyInteger", "Index")
+      obj.Index = i
+    dump = Doc.dumpContent()
+    FreeCAD.closeDocument("ManyObjects")
+
+    Doc = FreeCAD.newDocument("ManyObjects")
+    Doc.restoreContent(dump)
+    self.assertEqual(len(Doc.Objects), 100)
+    for i, obj in enumerate(Doc.Objects):
+      self.assertEqual(obj.TypeId, "App::FeaturePython")
+      self.assertEqual(obj.getTypeIdOfProperty("Index"), "App::PropertyInteger")
+      self.assertEqual(obj.Index, i)
+    FreeCAD.closeDocument("ManyObjects")
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("SaveRestoreTests")
@@ -1261,6 +1280,71 @@ class DocumentGroupCases(unittest.TestCase):
     self.prt.removeObject(self.fus1)
     self.failUnless(len(self.prt.Group)==0)
 
+  def testSubObjectResolution(self):
+    outer = self.Doc.addObject("App::Part","Outer")
+    inner = self.Doc.addObject("App::Part","Inner")
+    outer.addObject(inner)
+    outer.Placement.Base = FreeCAD.Vector(1,0,0)
+    inner.Placement.Base = FreeCAD.Vector(0,2,0)
+
+    # repeated lookups are served from the cache
+    for i in range(3):
+      self.assertEqual(outer.getSubObject("Inner.", retType=1), inner)
+      self.assertEqual(outer.getSubObject("Inner.", retType=3).Base, FreeCAD.Vector(1,2,0))
+    self.assertEqual(outer.getSubObject("Inner.", retType=3, transform=False).Base, FreeCAD.Vector(0,2,0))
+
+    # placement changes invalidate the cached transformation
+    inner.Placement.Base = FreeCAD.Vector(0,0,3)
+    self.assertEqual(outer.getSubObject("Inner.", retType=3).Base, FreeCAD.Vector(1,0,3))
+    outer.Placement.Base = FreeCAD.Vector(0,0,0)
+    self.assertEqual(outer.getSubObject("Inner.", retType=3).Base, FreeCAD.Vector(0,0,3))
+
+    # a given matrix is applied before the path's transformation
+    mat = FreeCAD.Matrix()
+    mat.move(FreeCAD.Vector(5,0,0))
+    res = outer.getSubObject("Inner.", retType=4, matrix=mat)
+    self.assertEqual(res.multVec(FreeCAD.Vector()), FreeCAD.Vector(5,0,3))
+    self.assertEqual(outer.getSubObject("Inner.", retType=3).Base, FreeCAD.Vector(0,0,3))
+
+    # subnames may refer to labels
+    self.assertEqual(outer.getSubObject("$Inner.", retType=1), inner)
+    inner.Label = "Renamed"
+    self.assertEqual(outer.getSubObject("$Inner.", retType=1), None)
+    self.assertEqual(outer.getSubObject("$Renamed.", retType=1), inner)
+
+    # group changes invalidate the cached object
+    outer.removeObject(inner)
+    self.assertEqual(outer.getSubObject("Inner.", retType=1), None)
+    outer.addObject(inner)
+    self.assertEqual(outer.getSubObject("Inner.", retType=1), inner)
+
+    # so does removing the object
+    self.Doc.removeObject("Inner")
+    self.assertEqual(outer.getSubObject("Inner.", retType=1), None)
+
+  def testSubObjectResolutionAcrossDocuments(self):
+    doc = FreeCAD.newDocument("GroupTests2")
+    try:
+      doc.saveAs(tempfile.gettempdir() + os.sep + "GroupTests2.FCStd")
+      outer = doc.addObject("App::Part","Outer")
+      inner = doc.addObject("App::Part","Inner")
+      outer.addObject(inner)
+      inner.Placement.Base = FreeCAD.Vector(0,2,0)
+      link = self.Doc.addObject("App::Link","Link")
+      link.LinkedObject = outer
+
+      base = link.getSubObject("Inner.", retType=3).Base
+      self.assertEqual(link.getSubObject("Inner.", retType=1), inner)
+
+      # changes in the linked document invalidate the results of this one
+      inner.Placement.Base = FreeCAD.Vector(0,0,3)
+      self.assertEqual(link.getSubObject("Inner.", retType=3).Base - base, FreeCAD.Vector(0,-2,3))
+      outer.removeObject(inner)
+      self.assertEqual(link.getSubObject("Inner.", retType=1), None)
+    finally:
+      self.Doc.removeObject("Link")
+      FreeCAD.closeDocument("GroupTests2")
+
   def tearDown(self):
     # closing doc
     FreeCAD.closeDocument("GroupTests")
@@ -1311,6 +1395,26 @@ class DocumentPlatformCases(unittest.TestCase):
 
     self.failUnless(len(self.Doc.Test.VectorList) == 2)
 
+  def testPropertyBuffer(self):
+    self.Doc.Test.FloatList = [-0.05, 2.5, 5.2]
+    self.Doc.Test.VectorList = [(-0.05, 2.5, 5.2),(1.0, 2.0, 3.0)]
+
+    floats = memoryview(self.Doc.Test.getPropertyBuffer("FloatList"))
+    self.assertEqual(floats.shape, (3,))
+    self.assertEqual(floats.tolist(), [-0.05, 2.5, 5.2])
+
+    vectors = memoryview(self.Doc.Test.getPropertyBuffer("VectorList"))
+    self.assertEqual(vectors.shape, (2, 3))
+    self.assertEqual(vectors.tolist(), [[-0.05, 2.5, 5.2], [1.0, 2.0, 3.0]])
+    self.assertTrue(vectors.readonly)
+
+    # the buffer is a snapshot and not affected by later changes
+    self.Doc.Test.VectorList = []
+    self.assertEqual(vectors[1, 2], 3.0)
+
+    with self.assertRaises(TypeError):
+      self.Doc.Test.getPropertyBuffer("Integer")
+
   def testPoints(self):
     try:
       self.Doc.addObject("Points::Feature", "Points")
@@ -0,0 +1,45 @@
+#! python
+# -*- coding: utf-8 -*-
+# FreeCAD benchmark of restoring a document with many objects.
+#
+# Restoring looks up the type of every object and the name of every property.
+# Run it with the command line version of FreeCAD:
+#   FreeCADCmd RestoreBenchmark.py [objects] [runs]
+
+import sys, time
+import FreeCAD
+
+def createDocument(count):
+    doc = FreeCAD.newDocument("RestoreBenchmark")
+    for i in range(count):
+        obj = doc.addObject("App::FeaturePython", "Obj")
+        obj.addProperty("App::PropertyInteger", "Index")
+        obj.addProperty("App::PropertyFloat", "Value")
+        obj.Index = i
+        obj.Value = i * 0.5
+    return doc
+
+def restoreTime(dump, count):
+    doc = FreeCAD.newDocument("RestoreBenchmark")
+    start = time.time()
+    doc.restoreContent(dump)
+    elapsed = time.time() - start
+    if len(doc.Objects) != count:
+        raise RuntimeError("Restored %d of %d objects" % (len(doc.Objects), count))
+    FreeCAD.closeDocument(doc.Name)
+    return elapsed
+
+def main(args):
+    count = int(args[0]) if len(args) > 0 else 10000
+    runs = int(args[1]) if len(args) > 1 else 5
+
+    doc = createDocument(count)
+    dump = doc.dumpContent()
+    FreeCAD.closeDocument(doc.Name)
+
+    times = [restoreTime(dump, count) for i in range(runs)]
+    print("Restored %d objects: best %.3fs, mean %.3fs of %d runs"
+          % (count, min(times), sum(times) / len(times), runs))
+
+# FreeCADCmd keeps its own options in sys.argv, so only take the numbers
+main([arg for arg in sys.argv[1:] if arg.isdigit()])
@@ -0,0 +1,265 @@
+#include <QTest>
+#include <cmath>
+#include <list>
+#include <vector>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+using MeshCore::MeshKernel;
+using MeshCore::MeshFacet;
+using MeshCore::MeshFacetIterator;
+using MeshCore::MeshPointIterator;
+using MeshCore::FacetIndex;
+using MeshCore::PointIndex;
+
+class testMeshCompactKernel : public QObject
+{
+    Q_OBJECT
+
+public:
+    testMeshCompactKernel()
+    {
+    }
+    ~testMeshCompactKernel()
+    {
+    }
+
+    /** Creates a wavy grid of \a size x \a size cells with two triangles per cell. */
+    static MeshKernel createGrid(unsigned long size)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                float x = static_cast<float>(i) * 0.5f;
+                float y = static_cast<float>(j) * 0.5f;
+                points.push_back(MeshCore::MeshPoint(x, y, std::sin(x) * std::cos(y)));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                PointIndex p0 = i * (size + 1) + j;
+                PointIndex p1 = p0 + size + 1;
+                facets.push_back(MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+
+        MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    static bool isSame(const Base::Vector3f& a, const Base::Vector3f& b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    static bool isSame(const Base::BoundBox3f& a, const Base::BoundBox3f& b)
+    {
+        return a.MinX == b.MinX && a.MinY == b.MinY && a.MinZ == b.MinZ &&
+               a.MaxX == b.MaxX && a.MaxY == b.MaxY && a.MaxZ == b.MaxZ;
+    }
+
+    static bool isSame(const MeshFacet& a, const MeshFacet& b)
+    {
+        for (int i = 0; i < 3; i++) {
+            if (a._aulPoints[i] != b._aulPoints[i] || a._aulNeighbours[i] != b._aulNeighbours[i])
+                return false;
+        }
+        return a._ucFlag == b._ucFlag && a._ulProp == b._ulProp;
+    }
+
+    /** Checks that \a kernel holds the same points and facets as the reference mesh. */
+    void compareWithReference(const MeshKernel& kernel, const MeshKernel& ref) const
+    {
+        QCOMPARE(kernel.CountPoints(), ref.CountPoints());
+        QCOMPARE(kernel.CountFacets(), ref.CountFacets());
+        for (PointIndex i = 0; i < ref.CountPoints(); i++)
+            QVERIFY(isSame(kernel.GetPoint(i), ref.GetPoint(i)));
+
+        for (FacetIndex i = 0; i < ref.CountFacets(); i++) {
+            MeshCore::MeshGeomFacet f1 = kernel.GetFacet(i);
+            MeshCore::MeshGeomFacet f2 = ref.GetFacet(i);
+            for (int j = 0; j < 3; j++)
+                QVERIFY(isSame(f1._aclPoints[j], f2._aclPoints[j]));
+            QCOMPARE(f1._ulProp, f2._ulProp);
+            QCOMPARE(f1._ucFlag, f2._ucFlag);
+
+            PointIndex p[3], q[3];
+            kernel.GetFacetPoints(i, p[0], p[1], p[2]);
+            ref.GetFacetPoints(i, q[0], q[1], q[2]);
+            FacetIndex n[3], m[3];
+            kernel.GetFacetNeighbours(i, n[0], n[1], n[2]);
+            ref.GetFacetNeighbours(i, m[0], m[1], m[2]);
+            for (int j = 0; j < 3; j++) {
+                QCOMPARE(p[j], q[j]);
+                QCOMPARE(n[j], m[j]);
+            }
+        }
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        reference = createGrid(40);
+        // flags and properties on a few elements only
+        const MeshCore::MeshFacetArray& facets = reference.GetFacets();
+        for (FacetIndex i = 0; i < facets.size(); i += 97) {
+            facets[i].SetFlag(MeshFacet::MARKED);
+            facets[i].SetProperty(i);
+        }
+        reference.GetPoints()[5].SetFlag(MeshCore::MeshPoint::VISIT);
+    }
+
+    void testCompact()
+    {
+        MeshKernel kernel(reference);
+        kernel.Compact();
+        QVERIFY(kernel.IsCompact());
+        QVERIFY(kernel.GetMemSize() < reference.GetMemSize());
+        // without flags and properties less than half of the memory is needed
+        MeshKernel plain = createGrid(40);
+        unsigned int size = plain.GetMemSize();
+        plain.Compact();
+        QVERIFY(plain.GetMemSize() * 2 < size);
+        QVERIFY(isSame(kernel.GetBoundBox(), reference.GetBoundBox()));
+        compareWithReference(kernel, reference);
+        kernel.RecalcBoundBox();
+        QVERIFY(isSame(kernel.GetBoundBox(), reference.GetBoundBox()));
+        // none of the methods above needs the records
+        QVERIFY(kernel.IsCompact());
+
+        kernel.Expand();
+        QVERIFY(!kernel.IsCompact());
+        QVERIFY(kernel.GetFacets().size() == reference.GetFacets().size());
+        for (FacetIndex i = 0; i < reference.CountFacets(); i++)
+            QVERIFY(isSame(kernel.GetFacets()[i], reference.GetFacets()[i]));
+        for (PointIndex i = 0; i < reference.CountPoints(); i++)
+            QCOMPARE(kernel.GetPoints()[i]._ucFlag, reference.GetPoints()[i]._ucFlag);
+    }
+
+    void testIterators()
+    {
+        MeshKernel kernel(reference);
+        kernel.Compact();
+
+        MeshFacetIterator it(kernel), jt(reference);
+        for (it.Init(), jt.Init(); it.More(); it.Next(), jt.Next()) {
+            QVERIFY(jt.More());
+            QCOMPARE(it.Position(), jt.Position());
+            for (int j = 0; j < 3; j++)
+                QVERIFY(isSame(it->_aclPoints[j], jt->_aclPoints[j]));
+            QVERIFY(isSame(it.GetIndices(), jt.GetIndices()));
+            QVERIFY(isSame(it.GetReference(), jt.GetReference()));
+            QCOMPARE(it.GetProperty(), jt.GetProperty());
+            QCOMPARE(it.IsFlag(MeshFacet::MARKED), jt.IsFlag(MeshFacet::MARKED));
+        }
+        QVERIFY(!jt.More());
+
+        MeshFacetIterator n0(kernel), n1(kernel), n2(kernel);
+        it.Set(100);
+        it.GetNeighbours(n0, n1, n2);
+        const MeshFacet& face = reference.GetFacets()[100];
+        QCOMPARE(n0.IsValid() ? n0.Position() : MeshCore::FACET_INDEX_MAX, face._aulNeighbours[0]);
+        QCOMPARE(n1.IsValid() ? n1.Position() : MeshCore::FACET_INDEX_MAX, face._aulNeighbours[1]);
+        QCOMPARE(n2.IsValid() ? n2.Position() : MeshCore::FACET_INDEX_MAX, face._aulNeighbours[2]);
+        it.SetToNeighbour(1);
+        QCOMPARE(it.Position(), face._aulNeighbours[1]);
+
+        MeshPointIterator pt(kernel), qt(reference);
+        for (pt.Init(), qt.Init(); pt.More(); pt.Next(), qt.Next()) {
+            QVERIFY(isSame(*pt, *qt));
+            QCOMPARE(pt.IsFlag(MeshCore::MeshPoint::VISIT), qt.IsFlag(MeshCore::MeshPoint::VISIT));
+        }
+        QVERIFY(!qt.More());
+        QVERIFY(kernel.IsCompact());
+
+        // writing a flag restores the records
+        it.Set(1);
+        it.SetFlag(MeshFacet::VISIT);
+        QVERIFY(!kernel.IsCompact());
+        QVERIFY(it.IsFlag(MeshFacet::VISIT));
+        QVERIFY(kernel.GetFacets()[1].IsFlag(MeshFacet::VISIT));
+    }
+
+    void testTransform()
+    {
+        Base::Matrix4D mat;
+        mat.rotZ(0.3);
+        mat.rotX(-1.1);
+        mat.scale(2.0, 0.5, 1.5);
+        mat.move(Base::Vector3d(1.0, -2.0, 3.0));
+
+        MeshKernel kernel(reference);
+        MeshKernel transformed(reference);
+        kernel.Compact();
+        kernel.Transform(mat);
+        transformed.Transform(mat);
+        QVERIFY(kernel.IsCompact());
+        QVERIFY(isSame(kernel.GetBoundBox(), transformed.GetBoundBox()));
+        compareWithReference(kernel, transformed);
+    }
+
+    void testCopy()
+    {
+        MeshKernel kernel(reference);
+        kernel.Compact();
+        MeshKernel copy(kernel);
+        QVERIFY(copy.IsCompact());
+        compareWithReference(copy, reference);
+
+        MeshKernel swapped;
+        swapped.Swap(copy);
+        QVERIFY(swapped.IsCompact());
+        QVERIFY(!copy.IsCompact());
+        QCOMPARE(copy.CountFacets(), 0UL);
+        compareWithReference(swapped, reference);
+    }
+
+    void testAlgorithms()
+    {
+        MeshKernel kernel(reference);
+        kernel.Compact();
+        QCOMPARE(kernel.GetSurface(), reference.GetSurface());
+        QCOMPARE(kernel.CountEdges(), reference.CountEdges());
+        QCOMPARE(kernel.HasOpenEdges(), reference.HasOpenEdges());
+
+        kernel.Compact();
+        std::list<std::vector<PointIndex>> borders1, borders2;
+        MeshCore::MeshAlgorithm(kernel).GetMeshBorders(borders1);
+        MeshCore::MeshAlgorithm(reference).GetMeshBorders(borders2);
+        QCOMPARE(borders1.size(), std::size_t(1));
+        QVERIFY(borders1 == borders2);
+    }
+
+    void testModification()
+    {
+        MeshKernel kernel(reference);
+        MeshKernel modified(reference);
+        kernel.Compact();
+        QVERIFY(kernel.DeleteFacet(10));
+        QVERIFY(modified.DeleteFacet(10));
+        QVERIFY(!kernel.IsCompact());
+        compareWithReference(kernel, modified);
+
+        kernel.Compact();
+        kernel.SetPoint(3, 1.0f, 2.0f, 3.0f);
+        QVERIFY(!kernel.IsCompact());
+        QVERIFY(isSame(kernel.GetPoint(3), Base::Vector3f(1.0f, 2.0f, 3.0f)));
+
+        kernel.Compact();
+        kernel.Clear();
+        QVERIFY(!kernel.IsCompact());
+        QCOMPARE(kernel.CountPoints(), 0UL);
+        QCOMPARE(kernel.CountFacets(), 0UL);
+    }
+
+private:
+    MeshKernel reference;
+};
+
+QTEST_GUILESS_MAIN(testMeshCompactKernel)
+
+#include "MeshCompactKernel.moc"
@@ -0,0 +1,301 @@
+#include <QTest>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+#include <Mod/Mesh/App/Core/KDTree.h>
+
+using MeshCore::MeshKDTree;
+using MeshCore::PointIndex;
+
+class testMeshKDTree : public QObject
+{
+    Q_OBJECT
+
+public:
+    testMeshKDTree()
+    {
+    }
+    ~testMeshKDTree()
+    {
+    }
+
+    static std::vector<Base::Vector3f> randomPoints(std::size_t count, unsigned int seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+        std::vector<Base::Vector3f> points;
+        points.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+            points.emplace_back(dist(gen), dist(gen), dist(gen));
+        return points;
+    }
+
+    /** Returns the sorted distances of all points to \a p. */
+    std::vector<float> bruteForceDistances(const Base::Vector3f& p) const
+    {
+        std::vector<float> dists;
+        dists.reserve(points.size());
+        for (const auto& it : points)
+            dists.push_back(Base::Distance(it, p));
+        std::sort(dists.begin(), dists.end());
+        return dists;
+    }
+
+    static bool isEqual(float a, float b)
+    {
+        return std::fabs(a - b) <= 1e-5f * std::max(1.0f, std::fabs(b));
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        points = randomPoints(5000, 1);
+        queries = randomPoints(200, 2);
+        // some queries hit a point exactly
+        for (std::size_t i = 0; i < queries.size(); i += 10)
+            queries[i] = points[i * 7];
+        tree.AddPoints(points);
+    }
+
+    void testFindNearest()
+    {
+        for (const auto& q : queries) {
+            Base::Vector3f n;
+            float dist = -1.0f;
+            PointIndex index = tree.FindNearest(q, n, dist);
+            std::vector<float> dists = bruteForceDistances(q);
+            QVERIFY(index < points.size());
+            QVERIFY(isEqual(dist, dists.front()));
+            QCOMPARE(n, points[index]);
+            QVERIFY(isEqual(Base::Distance(points[index], q), dists.front()));
+        }
+    }
+
+    void testFindNearestMaxDist()
+    {
+        Base::Vector3f n;
+        float dist;
+        Base::Vector3f far(100.0f, 100.0f, 100.0f);
+        QCOMPARE(tree.FindNearest(far, 1.0f, n, dist), MeshCore::POINT_INDEX_MAX);
+        QVERIFY(tree.FindNearest(points[3], 1.0f, n, dist) < points.size());
+        QCOMPARE(dist, 0.0f);
+    }
+
+    void testFindNearestBatch()
+    {
+        const std::size_t k = 8;
+        std::vector<PointIndex> indices;
+        std::vector<float> distances;
+        tree.FindNearest(queries, k, indices, distances);
+        QCOMPARE(indices.size(), queries.size() * k);
+        QCOMPARE(distances.size(), queries.size() * k);
+
+        for (std::size_t i = 0; i < queries.size(); i++) {
+            std::vector<float> dists = bruteForceDistances(queries[i]);
+            std::set<PointIndex> unique;
+            for (std::size_t j = 0; j < k; j++) {
+                PointIndex index = indices[i * k + j];
+                QVERIFY(index < points.size());
+                unique.insert(index);
+                QVERIFY(isEqual(distances[i * k + j], dists[j]));
+                QVERIFY(isEqual(Base::Distance(points[index], queries[i]), dists[j]));
+            }
+            QCOMPARE(unique.size(), k);
+
+            // the batch query agrees with the single query
+            Base::Vector3f n;
+            float dist;
+            tree.FindNearest(queries[i], n, dist);
+            QVERIFY(isEqual(distances[i * k], dist));
+        }
+    }
+
+    void testFindNearestBatchMaxDist()
+    {
+        const std::size_t k = 4;
+        const float max_dist = 1.0f;
+        std::vector<PointIndex> indices;
+        std::vector<float> distances;
+        tree.FindNearest(queries, k, indices, distances, max_dist);
+
+        for (std::size_t i = 0; i < queries.size(); i++) {
+            std::vector<float> dists = bruteForceDistances(queries[i]);
+            for (std::size_t j = 0; j < k; j++) {
+                if (dists[j] < max_dist) {
+                    QVERIFY(indices[i * k + j] < points.size());
+                    QVERIFY(isEqual(distances[i * k + j], dists[j]));
+                }
+                else if (dists[j] > max_dist) {
+                    QCOMPARE(indices[i * k + j], MeshCore::POINT_INDEX_MAX);
+                    QCOMPARE(distances[i * k + j], FLOAT_MAX);
+                }
+            }
+        }
+    }
+
+    void testFindInRadius()
+    {
+        const float radius = 1.5f;
+        std::vector<std::size_t> offsets;
+        std::vector<PointIndex> indices;
+        std::vector<float> distances;
+        tree.FindInRadius(queries, radius, offsets, indices, distances);
+        QCOMPARE(offsets.size(), queries.size() + 1);
+        QCOMPARE(offsets.front(), std::size_t(0));
+        QCOMPARE(offsets.back(), indices.size());
+        QCOMPARE(distances.size(), indices.size());
+
+        for (std::size_t i = 0; i < queries.size(); i++) {
+            QVERIFY(offsets[i] <= offsets[i + 1]);
+            QVERIFY(std::is_sorted(distances.begin() + offsets[i], distances.begin() + offsets[i + 1]));
+
+            std::set<PointIndex> expected;
+            for (std::size_t j = 0; j < points.size(); j++) {
+                if (Base::Distance(points[j], queries[i]) <= radius)
+                    expected.insert(j);
+            }
+            std::set<PointIndex> found(indices.begin() + offsets[i], indices.begin() + offsets[i + 1]);
+            QCOMPARE(offsets[i + 1] - offsets[i], found.size());
+            QVERIFY(found == expected);
+            for (std::size_t j = offsets[i]; j < offsets[i + 1]; j++)
+                QVERIFY(isEqual(distances[j], Base::Distance(points[indices[j]], queries[i])));
+        }
+    }
+
+    void testFindExact()
+    {
+        for (std::size_t i = 0; i < points.size(); i += 50) {
+            PointIndex index = tree.FindExact(points[i]);
+            QVERIFY(index < points.size());
+            QCOMPARE(points[index], points[i]);
+        }
+
+        Base::Vector3f far(100.0f, 100.0f, 100.0f);
+        QCOMPARE(tree.FindExact(far), MeshCore::POINT_INDEX_MAX);
+        QCOMPARE(tree.FindExact(points[0] + Base::Vector3f(0.01f, 0.0f, 0.0f)), MeshCore::POINT_INDEX_MAX);
+    }
+
+    void testFindInRange()
+    {
+        const float range = 1.0f;
+        for (const auto& q : queries) {
+            std::vector<PointIndex> indices;
+            tree.FindInRange(q, range, indices);
+
+            // all points inside the axis-aligned box around q
+            std::set<PointIndex> expected;
+            for (std::size_t j = 0; j < points.size(); j++) {
+                Base::Vector3f d = points[j] - q;
+                if (std::fabs(d.x) <= range && std::fabs(d.y) <= range && std::fabs(d.z) <= range)
+                    expected.insert(j);
+            }
+            std::set<PointIndex> found(indices.begin(), indices.end());
+            QCOMPARE(indices.size(), found.size());
+            QVERIFY(found == expected);
+        }
+    }
+
+    void testLargeTree()
+    {
+        // enough points to build the tree in parallel and enough queries for several blocks
+        std::vector<Base::Vector3f> cloud = randomPoints(40000, 3);
+        std::vector<Base::Vector3f> probes = randomPoints(4500, 4);
+        MeshKDTree kdtree(cloud);
+
+        const std::size_t k = 4;
+        std::vector<PointIndex> indices;
+        std::vector<float> distances;
+        kdtree.FindNearest(probes, k, indices, distances);
+        QCOMPARE(indices.size(), probes.size() * k);
+
+        const float radius = 0.5f;
+        std::vector<std::size_t> offsets;
+        std::vector<PointIndex> found;
+        std::vector<float> radii;
+        kdtree.FindInRadius(probes, radius, offsets, found, radii);
+        QCOMPARE(offsets.size(), probes.size() + 1);
+        QCOMPARE(offsets.back(), found.size());
+
+        for (std::size_t i = 0; i < probes.size(); i++) {
+            // the batch queries agree with the single queries
+            Base::Vector3f n;
+            float dist;
+            PointIndex index = kdtree.FindNearest(probes[i], n, dist);
+            QCOMPARE(indices[i * k], index);
+            QVERIFY(isEqual(distances[i * k], dist));
+            for (std::size_t j = 1; j < k; j++)
+                QVERIFY(distances[i * k + j - 1] <= distances[i * k + j]);
+
+            std::vector<PointIndex> range;
+            kdtree.FindInRange(probes[i], radius, range);
+            std::set<PointIndex> expected;
+            for (PointIndex it : range) {
+                if (Base::Distance(cloud[it], probes[i]) <= radius)
+                    expected.insert(it);
+            }
+            std::set<PointIndex> inRadius(found.begin() + offsets[i], found.begin() + offsets[i + 1]);
+            QCOMPARE(offsets[i + 1] - offsets[i], inRadius.size());
+            QVERIFY(inRadius == expected);
+        }
+
+        // the tree built in parallel finds the true nearest points
+        for (std::size_t i = 0; i < probes.size(); i += 100) {
+            float nearest = FLOAT_MAX;
+            for (const auto& it : cloud)
+                nearest = std::min(nearest, Base::Distance(it, probes[i]));
+            QVERIFY(isEqual(distances[i * k], nearest));
+        }
+        for (std::size_t i = 0; i < cloud.size(); i += 37)
+            QCOMPARE(kdtree.FindExact(cloud[i]), PointIndex(i));
+    }
+
+    void testRebuildAfterAddPoints()
+    {
+        MeshKDTree kdtree;
+        QVERIFY(kdtree.IsEmpty());
+
+        std::vector<Base::Vector3f> first(points.begin(), points.begin() + 1000);
+        kdtree.AddPoints(first);
+        QVERIFY(!kdtree.IsEmpty());
+
+        Base::Vector3f n;
+        float dist;
+        Base::Vector3f p = points[1500];
+        PointIndex index = kdtree.FindNearest(p, n, dist);
+        QVERIFY(index < 1000);
+        QVERIFY(dist > 0.0f);
+
+        // the new points are found after adding them to a built tree
+        std::vector<Base::Vector3f> second(points.begin() + 1000, points.end());
+        kdtree.AddPoints(second);
+        QCOMPARE(kdtree.FindNearest(p, n, dist), PointIndex(1500));
+        QCOMPARE(dist, 0.0f);
+        QCOMPARE(kdtree.FindExact(p), PointIndex(1500));
+
+        Base::Vector3f single(20.0f, 20.0f, 20.0f);
+        kdtree.AddPoint(single);
+        QCOMPARE(kdtree.FindExact(single), PointIndex(points.size()));
+
+        // the rebuilt tree gives the same results as a tree built at once
+        std::vector<PointIndex> expected, indices;
+        std::vector<float> distances;
+        tree.FindNearest(queries, 3, expected, distances);
+        kdtree.FindNearest(queries, 3, indices, distances);
+        QVERIFY(indices == expected);
+
+        kdtree.Clear();
+        QVERIFY(kdtree.IsEmpty());
+        QCOMPARE(kdtree.FindNearest(p, n, dist), MeshCore::POINT_INDEX_MAX);
+    }
+
+private:
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Vector3f> queries;
+    MeshKDTree tree;
+};
+
+QTEST_GUILESS_MAIN(testMeshKDTree)
+
+#include "MeshKDTree.moc"
@@ -0,0 +1,180 @@
+#include <QTest>
+#include <algorithm>
+#include <vector>
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Segmentation.h>
+
+using MeshCore::CurvatureInfo;
+using MeshCore::FacetIndex;
+using MeshCore::MeshCurvatureFreeformSegment;
+using MeshCore::MeshFacet;
+using MeshCore::MeshKernel;
+using MeshCore::MeshSegment;
+using MeshCore::MeshSegmentAlgorithm;
+using MeshCore::MeshSegmentStatistics;
+using MeshCore::MeshSurfaceSegmentPtr;
+using MeshCore::PointIndex;
+
+/** Tests the facets in the same way but grows the segments one facet after another. */
+class SerialFreeformSegment : public MeshCurvatureFreeformSegment
+{
+public:
+    using MeshCurvatureFreeformSegment::MeshCurvatureFreeformSegment;
+    bool IsStateless() const override { return false; }
+};
+
+class testMeshSegmentation : public QObject
+{
+    Q_OBJECT
+
+public:
+    testMeshSegmentation()
+    {
+    }
+    ~testMeshSegmentation()
+    {
+    }
+
+    /** Creates a flat grid of \a size x \a size cells with two triangles per cell. */
+    static MeshKernel createGrid(unsigned long size)
+    {
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (unsigned long i = 0; i <= size; i++) {
+            for (unsigned long j = 0; j <= size; j++) {
+                points.push_back(MeshCore::MeshPoint(i * 0.5f, j * 0.5f, 0.0f));
+            }
+        }
+        for (unsigned long i = 0; i < size; i++) {
+            for (unsigned long j = 0; j < size; j++) {
+                PointIndex p0 = i * (size + 1) + j;
+                PointIndex p1 = p0 + size + 1;
+                facets.push_back(MeshFacet(p0, p1, p1 + 1));
+                facets.push_back(MeshFacet(p0, p1 + 1, p0 + 1));
+            }
+        }
+
+        MeshKernel kernel;
+        kernel.Adopt(points, facets, true);
+        return kernel;
+    }
+
+    /** Returns the facets of the segments, each segment in ascending order. */
+    static std::vector<MeshSegment> sortedSegments(const MeshSurfaceSegmentPtr& segm)
+    {
+        std::vector<MeshSegment> segments = segm->GetSegments();
+        for (auto& it : segments)
+            std::sort(it.begin(), it.end());
+        return segments;
+    }
+
+    void compareStatistics(const MeshSegmentStatistics& s1, const MeshSegmentStatistics& s2) const
+    {
+        QCOMPARE(s1.countSegments, s2.countSegments);
+        QCOMPARE(s1.countFacets, s2.countFacets);
+        QCOMPARE(s1.countRejected, s2.countRejected);
+        QCOMPARE(s1.maxFacets, s2.maxFacets);
+        QCOMPARE(s1.area, s2.area);
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        // more facets than a thread tests per block, so that the regions cross the blocks
+        grid = createGrid(Size);
+        QVERIFY(grid.CountFacets() > 2 * 8192);
+
+        // a row of curved points splits the grid into two regions
+        CurvatureInfo flat{};
+        CurvatureInfo curved{};
+        curved.fMaxCurvature = 1.0f;
+        curved.fMinCurvature = 1.0f;
+        curvature.assign(grid.CountPoints(), flat);
+        for (unsigned long j = 0; j <= Size; j++)
+            curvature[CurvedRow * (Size + 1) + j] = curved;
+    }
+
+    void testJoinedSegments()
+    {
+        std::vector<MeshSurfaceSegmentPtr> segm;
+        segm.emplace_back(std::make_shared<MeshCurvatureFreeformSegment>(curvature, 10, 0.1f, 0.1f, 0.0f, 0.0f));
+        segm.emplace_back(std::make_shared<MeshCurvatureFreeformSegment>(curvature, 10, 0.1f, 0.1f, 1.0f, 1.0f));
+        MeshSegmentAlgorithm finder(grid);
+        finder.FindSegments(segm);
+
+        // the cells below the curved row
+        MeshSegment lower;
+        for (FacetIndex index = 0; index < 2 * (CurvedRow - 1) * Size; index++)
+            lower.push_back(index);
+        // the cells above the curved row and the first facet of the row that borders them,
+        // this start facet fails the test but joins the facets around it
+        MeshSegment upper;
+        upper.push_back(2 * CurvedRow * Size);
+        for (FacetIndex index = 2 * (CurvedRow + 1) * Size; index < grid.CountFacets(); index++)
+            upper.push_back(index);
+
+        std::vector<MeshSegment> segments = sortedSegments(segm[0]);
+        QCOMPARE(segments.size(), std::size_t(2));
+        QVERIFY(segments[0] == lower);
+        QVERIFY(segments[1] == upper);
+        // no facet lies only on the curved row
+        QVERIFY(segm[1]->GetSegments().empty());
+
+        const std::vector<MeshSegmentStatistics>& stats = finder.GetStatistics();
+        QCOMPARE(stats.size(), std::size_t(2));
+        QCOMPARE(stats[0].countSegments, std::size_t(2));
+        QCOMPARE(stats[0].countFacets, lower.size() + upper.size());
+        QCOMPARE(stats[0].countRejected, std::size_t(0));
+        QCOMPARE(stats[0].maxFacets, upper.size());
+        // each facet has an area of 0.125
+        QCOMPARE(stats[0].area, 0.125 * (lower.size() + upper.size()));
+        compareStatistics(stats[1], MeshSegmentStatistics());
+    }
+
+    void testRejectedSegments()
+    {
+        std::vector<MeshSurfaceSegmentPtr> segm;
+        // only the region above the curved row is big enough
+        std::size_t lowerSize = 2 * (CurvedRow - 1) * Size;
+        std::size_t upperSize = grid.CountFacets() - 2 * (CurvedRow + 1) * Size + 1;
+        segm.emplace_back(std::make_shared<MeshCurvatureFreeformSegment>(curvature, lowerSize + 1, 0.1f, 0.1f, 0.0f, 0.0f));
+        MeshSegmentAlgorithm finder(grid);
+        finder.FindSegments(segm);
+
+        QCOMPARE(segm[0]->GetSegments().size(), std::size_t(1));
+        const std::vector<MeshSegmentStatistics>& stats = finder.GetStatistics();
+        QCOMPARE(stats.size(), std::size_t(1));
+        QCOMPARE(stats[0].countSegments, std::size_t(1));
+        QCOMPARE(stats[0].countRejected, std::size_t(1));
+        QCOMPARE(stats[0].countFacets, upperSize);
+    }
+
+    void testSerialSegments()
+    {
+        std::vector<MeshSurfaceSegmentPtr> joined, grown;
+        for (float c : {0.0f, 1.0f}) {
+            joined.emplace_back(std::make_shared<MeshCurvatureFreeformSegment>(curvature, 2, 0.1f, 0.1f, c, c));
+            grown.emplace_back(std::make_shared<SerialFreeformSegment>(curvature, 2, 0.1f, 0.1f, c, c));
+        }
+        MeshSegmentAlgorithm finder1(grid), finder2(grid);
+        finder1.FindSegments(joined);
+        finder2.FindSegments(grown);
+
+        for (std::size_t i = 0; i < joined.size(); i++) {
+            QVERIFY(sortedSegments(joined[i]) == sortedSegments(grown[i]));
+            compareStatistics(finder1.GetStatistics()[i], finder2.GetStatistics()[i]);
+        }
+    }
+
+private:
+    static constexpr unsigned long Size = 130;
+    // the curved row lies off the middle so that both regions span several blocks
+    static constexpr unsigned long CurvedRow = 40;
+    MeshKernel grid;
+    std::vector<CurvatureInfo> curvature;
+};
+
+QTEST_GUILESS_MAIN(testMeshSegmentation)
+
+#include "MeshSegmentation.moc"